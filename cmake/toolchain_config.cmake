@@ -63,6 +63,11 @@ if( WIN32 )
     add_definitions( -DNOMINMAX -DNOGDI -DNOBITMAP -DNOMB )
 endif()
 
+option( ENABLE_PROFILING "Compile the scoped profiling zones and the profiler overlay into the engine" OFF )
+if( ENABLE_PROFILING )
+    add_definitions( -DUTIL_PROFILING )
+endif()
+
 option( SANITIZE_ADDRESS "Use -fsanitize=address" OFF )
 
 if( CMAKE_CXX_COMPILER_ID STREQUAL "Clang" OR CMAKE_CXX_COMPILER_ID STREQUAL "GNU" )
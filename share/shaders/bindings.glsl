@@ -6,3 +6,5 @@
 #define BINDING_UNIFORM_CSMVSM 4
 #define BINDING_BUFFER_BONE_TRANSFORM 10
 #define BINDING_BUFFER_NEXT_BONE_TRANSFORM 11
+#define BINDING_BUFFER_ANIMATED_TILES 5
+#define BINDING_BUFFER_TEXTURE_SEQUENCES 6
@@ -3,10 +3,14 @@
 #include "camera_interface.glsl"
 
 #include "geometry_pipeline_interface.glsl"
+#include "texture_animation.glsl"
 
 void main()
 {
     gpi.texCoord = a_texCoord;
+    if (isAnimatedTexCoord(a_texCoord)) {
+        gpi.texCoord = getAnimatedTexCoord(getAnimatedTile(a_texCoord), a_texCoord);
+    }
     gpi.color = a_color;
 
     mat4 mvp = camera.viewProjection * modelTransform.m;
@@ -2,6 +2,7 @@
 #include "transform_interface.glsl"
 #include "geometry_pipeline_interface.glsl"
 #include "camera_interface.glsl"
+#include "texture_animation.glsl"
 
 #include "util.glsl"
 
@@ -32,6 +33,14 @@ void main()
     gpi.vertexPosWorld = vec3(mm * vec4(a_position, 1.0));
     gl_Position = camera.projection * mvPos;
     gpi.texCoord = a_texCoord;
+    vec4 quadUv12 = a_quadUv12;
+    vec4 quadUv34 = a_quadUv34;
+    if (isAnimatedTexCoord(a_texCoord)) {
+        AnimatedTile tile = getAnimatedTile(a_texCoord);
+        gpi.texCoord = getAnimatedTexCoord(tile, a_texCoord);
+        quadUv12 = tile.uv12;
+        quadUv34 = tile.uv34;
+    }
     #ifndef ROOM_SHADOWING
     gpi.color = gpi.texCoord.z >= 0 ? a_color : toLinear(a_color);
     #else
@@ -73,10 +82,10 @@ void main()
         tmp = mvp * vec4(a_quadVert4, 1);
         gpi.quadVerts[3] = vec3(tmp.xy / tmp.w, tmp.w);
 
-        gpi.quadUvs[0] = a_quadUv12.xy;
-        gpi.quadUvs[1] = a_quadUv12.zw;
-        gpi.quadUvs[2] = a_quadUv34.xy;
-        gpi.quadUvs[3] = a_quadUv34.zw;
+        gpi.quadUvs[0] = quadUv12.xy;
+        gpi.quadUvs[1] = quadUv12.zw;
+        gpi.quadUvs[2] = quadUv34.xy;
+        gpi.quadUvs[3] = quadUv34.zw;
     }
 
     #if SPRITEMODE == 3
@@ -0,0 +1,34 @@
+#include "bindings.glsl"
+
+struct AnimatedTile {
+    vec4 uv12;
+    vec4 uv34;
+    vec4 layer;
+};
+
+layout(std430, binding=BINDING_BUFFER_ANIMATED_TILES) readonly restrict buffer b_animatedTiles {
+    AnimatedTile animatedTiles[];
+};
+
+// x: index of the first tile, y: tile count, z: rotation
+layout(std430, binding=BINDING_BUFFER_TEXTURE_SEQUENCES) readonly restrict buffer b_textureSequences {
+    ivec4 textureSequences[];
+};
+
+// animated vertices store the tile corner in x, the offset within the sequence in y, and -2 - sequence index in z
+bool isAnimatedTexCoord(in vec3 texCoord)
+{
+    return texCoord.z < -1.5;
+}
+
+AnimatedTile getAnimatedTile(in vec3 texCoord)
+{
+    ivec4 sequence = textureSequences[int(round(-2.0 - texCoord.z))];
+    return animatedTiles[sequence.x + (int(round(texCoord.y)) + sequence.z) % sequence.y];
+}
+
+vec3 getAnimatedTexCoord(in AnimatedTile tile, in vec3 texCoord)
+{
+    vec2 uvs[4] = vec2[4](tile.uv12.xy, tile.uv12.zw, tile.uv34.xy, tile.uv34.zw);
+    return vec3(uvs[int(round(texCoord.x))], tile.layer.x);
+}
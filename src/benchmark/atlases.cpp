@@ -0,0 +1,202 @@
+#include "benchmark.h"
+
+#include "engine/world/atlastile.h"
+#include "engine/world/sprite.h"
+#include "engine/world/texturing.h"
+#include "engine/world/world.h"
+#include "loader/file/datatypes.h"
+#include "loader/file/level/game.h"
+#include "loader/file/level/level.h"
+#include "loader/file/texture.h"
+#include "loader/trx/trx.h"
+#include "render/textureatlas.h"
+#include "util/threadpool.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gl/cimgwrapper.h>
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Builds = 3;
+//! The upscaling factor of the replacement textures, which is what most texture packs use.
+constexpr int ReplacementScale = 4;
+
+struct Replacement
+{
+  size_t atlasId;
+  glm::ivec2 xy0;
+  glm::ivec2 xy1;
+};
+
+void addReplacement(std::set<std::tuple<size_t, int, int, int, int>>& rectangles,
+                    const size_t atlasId,
+                    const glm::vec2& minUv,
+                    const glm::vec2& maxUv)
+{
+  // the same rounding the atlas layout uses to find the replacement of a tile
+  const glm::ivec2 xy0{std::lround(minUv.x * 256.0f), std::lround(minUv.y * 256.0f)};
+  const glm::ivec2 xy1{std::lround(maxUv.x * 256.0f), std::lround(maxUv.y * 256.0f)};
+  if(xy0.x >= xy1.x || xy0.y >= xy1.y)
+    return;
+
+  rectangles.emplace(atlasId, xy0.x, xy0.y, xy1.x, xy1.y);
+}
+
+std::vector<Replacement> getReplacements(const loader::file::level::Level& level)
+{
+  std::set<std::tuple<size_t, int, int, int, int>> rectangles;
+  for(const auto& tile : level.m_textureTiles)
+  {
+    glm::vec2 minUv{1.0f};
+    glm::vec2 maxUv{0.0f};
+    for(const auto& uv : tile.uvCoordinates)
+    {
+      if(uv.isUnset())
+        continue;
+      minUv = glm::min(minUv, uv.toGl());
+      maxUv = glm::max(maxUv, uv.toGl());
+    }
+    addReplacement(rectangles, tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask, minUv, maxUv);
+  }
+
+  for(const auto& sprite : level.m_sprites)
+  {
+    addReplacement(rectangles,
+                   sprite.atlas_id.get(),
+                   glm::min(sprite.uv0.toGl(), sprite.uv1.toGl()),
+                   glm::max(sprite.uv0.toGl(), sprite.uv1.toGl()));
+  }
+
+  std::vector<Replacement> replacements;
+  std::ranges::transform(rectangles,
+                         std::back_inserter(replacements),
+                         [](const auto& rectangle)
+                         {
+                           const auto& [atlasId, x0, y0, x1, y1] = rectangle;
+                           return Replacement{atlasId, {x0, y0}, {x1, y1}};
+                         });
+  return replacements;
+}
+
+/**
+ * @brief Writes a texture pack in the md5 directory layout, replacing every tile and sprite of @a level with an
+ * upscaled copy of itself.
+ */
+void writeTexturePack(const loader::file::level::Level& level,
+                      const std::vector<Replacement>& replacements,
+                      const std::filesystem::path& dir)
+{
+  for(const auto& atlas : level.m_atlases)
+    std::filesystem::create_directories(dir / atlas.md5);
+
+  util::ThreadPool::getShared().parallelFor(
+    replacements.size(),
+    [&level, &replacements, &dir](const size_t i)
+    {
+      const auto& replacement = replacements[i];
+      const auto& atlas = level.m_atlases.at(replacement.atlasId);
+
+      gl::CImgWrapper image{reinterpret_cast<const uint8_t*>(&atlas.pixels[0][0]), 256, 256, true};
+      image.crop(replacement.xy0.x, replacement.xy0.y, replacement.xy1.x - 1, replacement.xy1.y - 1);
+      image.resize((replacement.xy1 - replacement.xy0) * ReplacementScale);
+      image.savePng(dir / atlas.md5
+                      / ("(" + std::to_string(replacement.xy0.x) + "--" + std::to_string(replacement.xy1.x) + ")("
+                         + std::to_string(replacement.xy0.y) + "--" + std::to_string(replacement.xy1.y) + ").png"),
+                    false);
+    });
+}
+
+std::chrono::duration<double, std::micro> measureBuild(const loader::file::level::Level& level,
+                                                       const std::unique_ptr<loader::trx::Glidos>& glidos,
+                                                       const std::filesystem::path& cacheDir)
+{
+  return measure(Builds,
+                 [&level, &glidos, &cacheDir]()
+                 {
+                   std::vector<engine::world::AtlasTile> atlasTiles;
+                   std::ranges::transform(level.m_textureTiles,
+                                          std::back_inserter(atlasTiles),
+                                          [](const loader::file::TextureTile& tile)
+                                          {
+                                            return engine::world::AtlasTile{tile.textureKey,
+                                                                            {tile.uvCoordinates[0].toGl(),
+                                                                             tile.uvCoordinates[1].toGl(),
+                                                                             tile.uvCoordinates[2].toGl(),
+                                                                             tile.uvCoordinates[3].toGl()}};
+                                          });
+
+                   std::vector<engine::world::Sprite> sprites;
+                   std::ranges::transform(level.m_sprites,
+                                          std::back_inserter(sprites),
+                                          [](const loader::file::Sprite& sprite)
+                                          {
+                                            return engine::world::Sprite{sprite.atlas_id,
+                                                                         sprite.uv0.toGl(),
+                                                                         sprite.uv1.toGl(),
+                                                                         sprite.render0,
+                                                                         sprite.render1,
+                                                                         nullptr,
+                                                                         nullptr,
+                                                                         {nullptr, nullptr}};
+                                          });
+
+                   // same page size as the world geometry
+                   render::MultiTextureAtlas atlases{3072, false};
+                   engine::world::buildAtlases(
+                     level,
+                     glidos,
+                     atlases,
+                     atlasTiles,
+                     sprites,
+                     [](const std::string&) {},
+                     cacheDir);
+                   const auto images = atlases.takeImages();
+                   gsl_Assert(!images.empty());
+                 });
+}
+} // namespace
+
+void atlasBuilding(engine::world::World& world)
+{
+  const auto level
+    = loader::file::level::Level::createLoader(world.getLevelFilename(), loader::file::level::Game::Unknown);
+  gsl_Assert(level != nullptr);
+  level->loadFileData();
+
+  const auto tempDir = std::filesystem::temp_directory_path() / "croftengine-benchmark-atlases";
+  std::filesystem::remove_all(tempDir);
+  const auto packDir = tempDir / "pack";
+  const auto cacheDir = tempDir / "cache";
+  std::filesystem::create_directories(cacheDir);
+
+  const auto replacements = getReplacements(*level);
+  writeTexturePack(*level, replacements, packDir);
+  const auto glidos = std::make_unique<loader::trx::Glidos>(packDir, [](const std::string&) {});
+
+  const auto original = measureBuild(*level, nullptr, cacheDir);
+  const auto replaced = measureBuild(*level, glidos, cacheDir);
+  std::filesystem::remove_all(tempDir);
+
+  BOOST_LOG_TRIVIAL(info) << "Building the atlases of " << level->m_atlases.size() << " level textures: "
+                          << std::chrono::duration<double, std::milli>{original}.count() << " ms, "
+                          << std::chrono::duration<double, std::milli>{replaced}.count() << " ms with "
+                          << replacements.size() << " replacements upscaled by " << ReplacementScale;
+}
+} // namespace benchmark
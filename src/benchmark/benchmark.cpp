@@ -0,0 +1,33 @@
+#include "benchmark.h"
+
+#include <array>
+#include <span>
+
+namespace benchmark
+{
+namespace
+{
+constexpr std::array benchmarks{
+  Benchmark{"objects", "game logic tick with hundreds of dynamic objects", &objects},
+  Benchmark{"pathfinding", "full path finder searches from random boxes", &pathFinding},
+  Benchmark{"heights", "floor and ceiling height queries at random positions", &heights},
+  Benchmark{"levelloading", "level file loading, memory-mapped vs. streamed", &levelLoading},
+  Benchmark{"savegame", "savegame size and save/load times, YAML vs. binary", &savegame},
+  Benchmark{"poses", "skeletal pose evaluation of all skeletal objects", &poses},
+  Benchmark{"textureanimation", "room texture animation steps", &textureAnimation},
+  Benchmark{"atlases", "texture atlas building with and without an upscaled texture pack", &atlasBuilding},
+  Benchmark{"portals", "portal tracing from the centre of every room", &portals},
+  Benchmark{"materials", "material parameter binding of all room meshes", &materials},
+  Benchmark{"bubbles", "updates of tens of thousands of bubbles in the water rooms", &bubbles},
+  Benchmark{"draws", "draw submission of all rooms, sorted vs. in scene order", &draws},
+  Benchmark{"ghosts", "ghost recording size and speed, legacy vs. delta encoded", &ghosts},
+  Benchmark{"coop", "coop state hand-off between the game and the network thread", &coop},
+  Benchmark{"collisions", "static mesh collision checks around the static meshes", &collisions},
+};
+} // namespace
+
+std::span<const Benchmark> getBenchmarks()
+{
+  return benchmarks;
+}
+} // namespace benchmark
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+
+namespace engine::world
+{
+class World;
+}
+
+namespace benchmark
+{
+struct Benchmark
+{
+  const char* name;
+  const char* description;
+  void (*run)(engine::world::World& world);
+};
+
+[[nodiscard]] extern std::span<const Benchmark> getBenchmarks();
+
+//! @brief Calls @a f @a iterations times and returns the mean duration of a single call.
+template<typename F>
+[[nodiscard]] std::chrono::duration<double, std::micro> measure(const size_t iterations, F&& f)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < iterations; ++i)
+    f();
+  return std::chrono::duration<double, std::micro>{std::chrono::high_resolution_clock::now() - start}
+         / static_cast<double>(iterations);
+}
+
+/**
+ * @brief Measures the game logic tick with hundreds of spawned dynamic objects.
+ *
+ * The objects are pickups spawned at Lara's position, and are all activated. A final run deletes and spawns some of
+ * them each tick.
+ */
+extern void objects(engine::world::World& world);
+
+/**
+ * @brief Measures searches over the whole box graph.
+ *
+ * Each search starts at a random target box and expands the path graph until all reachable boxes are known, with the
+ * movement limits of walking, climbing and flying enemies.
+ */
+extern void pathFinding(engine::world::World& world);
+
+//! @brief Measures floor and ceiling height queries at millions of random positions within the rooms.
+extern void heights(engine::world::World& world);
+
+//! @brief Measures reading the level file, once memory-mapped and once through a stream buffer.
+extern void levelLoading(engine::world::World& world);
+
+/**
+ * @brief Measures saving and loading the world state with the YAML and the binary savegame format, and their sizes.
+ *
+ * Building the document is what blocks the game when saving; encoding it is done by the savegame writer.
+ */
+extern void savegame(engine::world::World& world);
+
+//! @brief Measures evaluating the poses of all skeletal objects of the level in their initial animation frame.
+extern void poses(engine::world::World& world);
+
+/**
+ * @brief Measures an animation step of the room textures, including the upload of the sequence rotations.
+ *
+ * The water room count is logged to spot the levels with the most animated geometry.
+ */
+extern void textureAnimation(engine::world::World& world);
+
+/**
+ * @brief Measures building the texture atlases, once from the level textures and once from a texture pack.
+ *
+ * The texture pack is generated in the temp directory, and replaces every tile and sprite with an upscaled copy.
+ */
+extern void atlasBuilding(engine::world::World& world);
+
+/**
+ * @brief Measures the portal tracing from the centre of every room, looking into several horizontal directions.
+ *
+ * The rooms and portals the tracer visited and the rooms visible per view are logged as well.
+ */
+extern void portals(engine::world::World& world);
+
+//! @brief Measures binding the materials of all room meshes, for the full and the depth-only render passes.
+extern void materials(engine::world::World& world);
+
+/**
+ * @brief Measures updating tens of thousands of bubbles rising in the water rooms, including moving them between rooms.
+ *
+ * Burst bubbles are replaced each tick to keep their number steady.
+ */
+extern void bubbles(engine::world::World& world);
+
+/**
+ * @brief Measures submitting the draws of all rooms, once sorted by their keys and once in scene order.
+ *
+ * Nothing is culled, so this is the worst case of a single pass. The draw calls, state changes and program changes
+ * are logged if profiling is enabled.
+ */
+extern void draws(engine::world::World& world);
+
+/**
+ * @brief Measures the size and the write, read and seek times of a minute of ghost frames, in the legacy and in the
+ * delta encoded format.
+ *
+ * Lara idles during the recording, so the frames barely differ.
+ */
+extern void ghosts(engine::world::World& world);
+
+/**
+ * @brief Measures handing Lara's ghost states to the coop network thread, and decoding the states of several peers.
+ *
+ * The network thread is a stand-in which publishes copies of the local state instead of talking to a server, so only
+ * the hand-off between the threads is measured, not the network.
+ */
+extern void coop(engine::world::World& world);
+
+//! @brief Measures the touching room search and static mesh collision checks at random positions near static meshes.
+extern void collisions(engine::world::World& world);
+} // namespace benchmark
@@ -0,0 +1,123 @@
+#include "benchmark.h"
+
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "engine/particlecollection.h"
+#include "engine/world/room.h"
+#include "engine/world/sector.h"
+#include "engine/world/world.h"
+
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <gsl-lite/gsl-lite.hpp>
+#include <random>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Ticks = 300;
+constexpr std::array<size_t, 3> BubbleCounts{1'000, 10'000, 50'000};
+
+struct Emitter
+{
+  gsl_lite::not_null<const engine::world::Room*> room;
+  core::TRVec position;
+};
+
+//! @brief The floor centre of all inner sectors of water rooms.
+std::vector<Emitter> createEmitters(const engine::world::World& world)
+{
+  std::vector<Emitter> emitters;
+  for(const auto& room : world.getRooms())
+  {
+    if(!room.isWaterRoom)
+      continue;
+
+    // the outermost sectors are walls
+    for(int x = 1; x < room.sectorCountX - 1; ++x)
+    {
+      for(int z = 1; z < room.sectorCountZ - 1; ++z)
+      {
+        const auto sector = room.getSectorByIndex(x, z);
+        if(sector == nullptr || sector->floorHeight == core::InvalidHeight
+           || sector->ceilingHeight == core::InvalidHeight || sector->floorHeight <= sector->ceilingHeight)
+          continue;
+
+        emitters.emplace_back(Emitter{gsl_lite::not_null{&room},
+                                      core::TRVec{room.position.X + x * core::SectorSize + core::SectorSize / 2,
+                                                  sector->floorHeight - 1_len,
+                                                  room.position.Z + z * core::SectorSize + core::SectorSize / 2}});
+      }
+    }
+  }
+  return emitters;
+}
+
+size_t countBubbles(const engine::world::World& world)
+{
+  size_t count = 0;
+  for(const auto& room : world.getRooms())
+    count += room.particles.size();
+  return count;
+}
+
+void clearBubbles(const engine::world::World& world)
+{
+  for(const auto& room : world.getRooms())
+    room.particles = engine::InstancedParticleCollection{};
+}
+} // namespace
+
+void bubbles(engine::world::World& world)
+{
+  const auto emitters = createEmitters(world);
+  if(emitters.empty())
+  {
+    BOOST_LOG_TRIVIAL(info) << "Level has no water rooms";
+    return;
+  }
+
+  for(const auto target : BubbleCounts)
+  {
+    clearBubbles(world);
+
+    // fixed seed, so that all runs emit at the same positions
+    std::mt19937 rng{0};
+    std::uniform_int_distribution<size_t> emitterDistribution{0, emitters.size() - 1};
+
+    std::chrono::duration<double, std::micro> total{0};
+    size_t bubbleTicks = 0;
+    for(size_t tick = 0; tick < Ticks; ++tick)
+    {
+      // keep the number of bubbles steady, as they burst when reaching the water surface
+      for(auto count = countBubbles(world); count < target; ++count)
+      {
+        const auto& emitter = emitters[emitterDistribution(rng)];
+        emitter.room->particles.emitBubble(*emitter.room, emitter.position, true);
+      }
+      bubbleTicks += target;
+
+      // the same steps the game logic tick does
+      total += measure(1,
+                       [&world]()
+                       {
+                         for(const auto& room : world.getRooms())
+                           room.particles.update(world);
+                         for(const auto& room : world.getRooms())
+                           room.particles.transferToCurrentRooms(room);
+                       });
+    }
+
+    BOOST_LOG_TRIVIAL(info) << target << " bubbles from " << emitters.size() << " emitters: "
+                            << (total / static_cast<double>(Ticks)).count() << " us per tick, "
+                            << total.count() * 1000 / static_cast<double>(bubbleTicks) << " ns per bubble";
+  }
+
+  clearBubbles(world);
+}
+} // namespace benchmark
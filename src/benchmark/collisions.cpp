@@ -0,0 +1,104 @@
+#include "benchmark.h"
+
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "engine/collisioninfo.h"
+#include "engine/location.h"
+#include "engine/objectmanager.h"
+#include "engine/objects/laraobject.h"
+#include "engine/world/room.h"
+#include "engine/world/world.h"
+
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <gsl-lite/gsl-lite.hpp>
+#include <random>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Queries = 1'000'000;
+
+//! @brief Locations around the static meshes, so that roughly half of the queries collide.
+std::vector<engine::Location> createQueries(const engine::world::World& world)
+{
+  std::vector<engine::Location> meshLocations;
+  for(const auto& room : world.getRooms())
+  {
+    for(const auto& staticMesh : room.staticMeshes)
+      meshLocations.emplace_back(gsl_lite::not_null{&room}, staticMesh.position);
+  }
+  if(meshLocations.empty())
+    return {};
+
+  // fixed seed, so that all runs query the same positions
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<size_t> meshDistribution{0, meshLocations.size() - 1};
+  std::uniform_int_distribution<core::Length::type> offsetDistribution{-core::SectorSize.get() / 2,
+                                                                       core::SectorSize.get() / 2};
+
+  std::vector<engine::Location> queries;
+  queries.reserve(Queries);
+  while(queries.size() < Queries)
+  {
+    const auto x = core::Length{offsetDistribution(rng)};
+    const auto z = core::Length{offsetDistribution(rng)};
+    auto location = meshLocations[meshDistribution(rng)].moved(core::TRVec{x, 0_len, z});
+    location.updateRoom();
+    queries.emplace_back(location);
+  }
+  return queries;
+}
+} // namespace
+
+void collisions(engine::world::World& world)
+{
+  const auto queries = createQueries(world);
+  if(queries.empty())
+  {
+    BOOST_LOG_TRIVIAL(info) << "Level has no static meshes";
+    return;
+  }
+
+  // the touching rooms are searched starting from Lara's room, so she is moved along with the queries
+  auto& lara = world.getObjectManager().getLara();
+  const auto laraLocation = lara.m_state.location;
+
+  engine::CollisionInfo collisionInfo;
+  collisionInfo.collisionRadius = core::DefaultCollisionRadius;
+
+  size_t rooms = 0;
+  size_t i = 0;
+  const auto touchingRooms = measure(queries.size(),
+                                     [&queries, &world, &lara, &rooms, &i]()
+                                     {
+                                       const auto& query = queries[i++];
+                                       lara.m_state.location = query;
+                                       const auto touching = engine::CollisionInfo::collectTouchingRooms(
+                                         query.position, core::DefaultCollisionRadius, core::LaraWalkHeight, world);
+                                       rooms += touching.size();
+                                     });
+
+  size_t hits = 0;
+  i = 0;
+  const auto staticMeshes = measure(queries.size(),
+                                    [&queries, &world, &lara, &collisionInfo, &hits, &i]()
+                                    {
+                                      const auto& query = queries[i++];
+                                      lara.m_state.location = query;
+                                      if(collisionInfo.checkStaticMeshCollisions(
+                                           query.position, core::LaraWalkHeight, world))
+                                        ++hits;
+                                    });
+  lara.m_state.location = laraLocation;
+
+  BOOST_LOG_TRIVIAL(info) << queries.size() << " queries around static meshes, "
+                          << static_cast<double>(rooms) / static_cast<double>(queries.size())
+                          << " touching rooms per query: " << touchingRooms.count() * 1000 << " ns per room query";
+  BOOST_LOG_TRIVIAL(info) << hits << " static mesh collisions: " << staticMeshes.count() * 1000
+                          << " ns per collision check";
+}
+} // namespace benchmark
@@ -0,0 +1,144 @@
+#include "benchmark.h"
+
+#include "engine/ghosting/ghost.h"
+#include "engine/objectmanager.h"
+#include "engine/objects/laraobject.h"
+#include "engine/world/world.h"
+#include "network/hauntedcoopclient.h"
+#include "util/lockfree.h"
+
+#include <atomic>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t RecordedTicks = 300;
+constexpr size_t Messages = 2000;
+//! Much shorter than a game tick, to collect many samples in little time.
+constexpr auto MessageInterval = std::chrono::microseconds{500};
+//! The number of remote players sending their states.
+constexpr network::PeerId Peers = 8;
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Message
+{
+  Clock::time_point committed;
+  network::PeerData data;
+};
+
+/**
+ * @brief Stands in for the network thread of the coop client, which sends the local state and publishes the states of
+ * all peers, here all being copies of the local state.
+ * @return The mean latency until a state is picked up.
+ */
+std::chrono::duration<double, std::micro> runNetworkThread(util::SpscRing<Message, 4>& outgoing,
+                                                           util::TripleBuffer<network::PeerStates>& published,
+                                                           const std::atomic_bool& stop)
+{
+  std::chrono::duration<double, std::micro> latency{0};
+  size_t received = 0;
+  network::PeerStates peerStates;
+  while(true)
+  {
+    // read before polling the queue, so that no state committed before stopping is missed
+    const bool stopping = stop;
+    const auto* message = outgoing.front();
+    if(message == nullptr)
+    {
+      if(stopping)
+        break;
+      std::this_thread::yield();
+      continue;
+    }
+
+    latency += Clock::now() - message->committed;
+    for(network::PeerId peer = 0; peer < Peers; ++peer)
+      peerStates[peer] = message->data;
+    outgoing.pop();
+    ++received;
+
+    // element-wise assignment, so the back buffer keeps the capacity of its data buffers
+    published.getBack() = peerStates;
+    published.publish();
+  }
+
+  return received == 0 ? latency : latency / static_cast<double>(received);
+}
+} // namespace
+
+void coop(engine::world::World& world)
+{
+  std::vector<engine::ghosting::GhostFrame> frames;
+  frames.reserve(RecordedTicks);
+  for(size_t tick = 0; tick < RecordedTicks; ++tick)
+  {
+    world.updateGameLogic(true);
+    frames.emplace_back(world.getObjectManager().getLara().getGhostFrame());
+  }
+
+  util::SpscRing<Message, 4> outgoing;
+  util::TripleBuffer<network::PeerStates> published;
+
+  std::chrono::duration<double, std::micro> send{0};
+  std::chrono::duration<double, std::micro> receive{0};
+  size_t dropped = 0;
+  size_t decoded = 0;
+  std::atomic_bool stop{false};
+  std::chrono::duration<double, std::micro> networkLatency{0};
+  std::thread networkThread{[&outgoing, &published, &stop, &networkLatency]()
+                            {
+                              networkLatency = runNetworkThread(outgoing, published, stop);
+                            }};
+
+  const auto start = Clock::now();
+  engine::ghosting::GhostFrame remoteFrame;
+  for(size_t i = 0; i < Messages; ++i)
+  {
+    std::this_thread::sleep_until(start + i * MessageInterval);
+
+    // the same steps the game thread does each tick
+    send += measure(1,
+                    [&outgoing, &frames, &dropped, i]()
+                    {
+                      auto* message = outgoing.beginPush();
+                      if(message == nullptr)
+                      {
+                        ++dropped;
+                        return;
+                      }
+                      message->data.clear();
+                      frames[i % frames.size()].write(message->data);
+                      message->committed = Clock::now();
+                      outgoing.commitPush();
+                    });
+
+    receive += measure(1,
+                       [&published, &remoteFrame, &decoded]()
+                       {
+                         for(const auto& state : published.acquire())
+                         {
+                           std::span<const uint8_t> data{state.second};
+                           if(remoteFrame.read(data))
+                             ++decoded;
+                         }
+                       });
+  }
+
+  stop = true;
+  networkThread.join();
+
+  BOOST_LOG_TRIVIAL(info) << Messages << " states, " << dropped << " dropped: " << (send / Messages).count()
+                          << " us per send, " << networkLatency.count() << " us until picked up by the network thread";
+  BOOST_LOG_TRIVIAL(info) << decoded << " states of " << Peers << " peers decoded: " << (receive / Messages).count()
+                          << " us per tick";
+}
+} // namespace benchmark
@@ -0,0 +1,81 @@
+#include "benchmark.h"
+
+#include "engine/cameracontroller.h"
+#include "engine/world/room.h"
+#include "engine/world/world.h"
+#include "render/material/rendermode.h"
+#include "render/scene/node.h"
+#include "render/scene/rendercontext.h"
+#include "render/scene/translucency.h"
+#include "render/scene/visitor.h"
+#include "util/profiler.h"
+
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <optional>
+#include <utility>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Passes = 100;
+
+void renderRooms(const engine::world::World& world,
+                 const render::material::RenderMode mode,
+                 const std::optional<glm::vec3>& camera)
+{
+  // without a view projection nothing is culled, so every pass draws the whole level
+  render::scene::RenderContext context{mode, std::nullopt, render::scene::Translucency::Opaque};
+  render::scene::Visitor visitor{gsl_lite::not_null{&context}, false};
+  for(const auto& room : world.getRooms())
+  {
+    for(const auto& child : room.node->getChildren())
+      visitor.visit(*child);
+  }
+  visitor.render(camera);
+}
+} // namespace
+
+void draws(engine::world::World& world)
+{
+  static constexpr std::array<std::pair<render::material::RenderMode, const char*>, 2> modes{{
+    {render::material::RenderMode::FullOpaque, "opaque"},
+    {render::material::RenderMode::CSMDepthOnly, "CSM depth only"},
+  }};
+
+  for(const auto& room : world.getRooms())
+    room.node->setVisible(true);
+
+  const auto camera = world.getCameraController().getPosition();
+  for(const auto& [renderMode, modeName] : modes)
+  {
+    const auto mode = renderMode;
+    render::scene::getRenderStatistics() = {};
+    const auto sorted = measure(Passes,
+                                [&world, mode, &camera]()
+                                {
+                                  renderRooms(world, mode, camera);
+                                });
+    const auto statistics = std::exchange(render::scene::getRenderStatistics(), {});
+
+    const auto unsorted = measure(Passes,
+                                  [&world, mode]()
+                                  {
+                                    renderRooms(world, mode, std::nullopt);
+                                  });
+
+    BOOST_LOG_TRIVIAL(info) << "Submitting the " << modeName << " draws of all rooms: " << sorted.count()
+                            << " us per pass sorted, " << unsorted.count() << " us in scene order";
+    if constexpr(util::profiler::Enabled)
+    {
+      BOOST_LOG_TRIVIAL(info) << "Sorted passes: " << statistics.drawCalls / Passes << " draw calls, "
+                              << statistics.stateChanges / Passes << " state changes, "
+                              << statistics.programChanges / Passes << " program changes";
+    }
+  }
+}
+} // namespace benchmark
@@ -0,0 +1,119 @@
+#include "benchmark.h"
+
+#include "core/units.h"
+#include "engine/ghosting/ghost.h"
+#include "engine/objectmanager.h"
+#include "engine/objects/laraobject.h"
+#include "engine/world/world.h"
+
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+//! One minute of gameplay.
+constexpr size_t Ticks = 1800;
+constexpr size_t Reads = 10;
+
+void writeLegacy(const std::filesystem::path& path, const std::vector<engine::ghosting::GhostFrame>& frames)
+{
+  static constexpr uint32_t LegacyDataStreamVersion = 2;
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.write(reinterpret_cast<const char*>(&LegacyDataStreamVersion), sizeof(LegacyDataStreamVersion));
+  for(const auto& frame : frames)
+    frame.write(file);
+}
+
+void write(const std::filesystem::path& path, const std::vector<engine::ghosting::GhostFrame>& frames)
+{
+  engine::ghosting::GhostDataWriter writer{path};
+  for(const auto& frame : frames)
+    writer.append(frame);
+}
+
+std::chrono::duration<double, std::micro> measureRead(const std::filesystem::path& path, const size_t frameCount)
+{
+  return measure(Reads,
+                 [&path, frameCount]()
+                 {
+                   engine::ghosting::GhostDataReader reader{path};
+                   gsl_Assert(reader.isOpen());
+                   for(size_t i = 0; i < frameCount; ++i)
+                   {
+                     const auto& frame = reader.read();
+                     gsl_Assert(!frame.bones.empty());
+                   }
+                 });
+}
+
+std::chrono::duration<double, std::micro> measureSeek(const std::filesystem::path& path, const size_t frameCount)
+{
+  engine::ghosting::GhostDataReader reader{path};
+  gsl_Assert(reader.isOpen());
+  return measure(Reads,
+                 [&reader, frameCount]()
+                 {
+                   reader.seek(core::Frame{gsl_lite::narrow<core::Frame::type>(frameCount - 1)});
+                   const auto& frame = reader.read();
+                   gsl_Assert(!frame.bones.empty());
+                 });
+}
+} // namespace
+
+void ghosts(engine::world::World& world)
+{
+  // Lara idles without input, so the frames only differ by her breathing; this is the best case of the delta encoding
+  std::vector<engine::ghosting::GhostFrame> frames;
+  frames.reserve(Ticks);
+  for(size_t tick = 0; tick < Ticks; ++tick)
+  {
+    world.updateGameLogic(true);
+    frames.emplace_back(world.getObjectManager().getLara().getGhostFrame());
+  }
+
+  const auto tempDir = std::filesystem::temp_directory_path() / "croftengine-benchmark-ghosts";
+  std::filesystem::create_directories(tempDir);
+  const auto legacyPath = tempDir / "legacy.bin";
+  const auto path = tempDir / "ghost.bin";
+
+  const auto legacyWrite = measure(1,
+                                   [&legacyPath, &frames]()
+                                   {
+                                     writeLegacy(legacyPath, frames);
+                                   });
+  const auto deltaWrite = measure(1,
+                                  [&path, &frames]()
+                                  {
+                                    write(path, frames);
+                                  });
+
+  const auto legacyRead = measureRead(legacyPath, frames.size());
+  const auto deltaRead = measureRead(path, frames.size());
+  const auto legacySeek = measureSeek(legacyPath, frames.size());
+  const auto deltaSeek = measureSeek(path, frames.size());
+
+  BOOST_LOG_TRIVIAL(info) << "Legacy ghost format, " << frames.size() << " frames: "
+                          << std::filesystem::file_size(legacyPath) << " bytes, "
+                          << std::chrono::duration<double, std::milli>{legacyWrite}.count() << " ms write, "
+                          << std::chrono::duration<double, std::milli>{legacyRead}.count() << " ms read, "
+                          << std::chrono::duration<double, std::milli>{legacySeek}.count() << " ms seek to the end";
+  BOOST_LOG_TRIVIAL(info) << "Delta ghost format, " << frames.size() << " frames: "
+                          << std::filesystem::file_size(path) << " bytes, "
+                          << std::chrono::duration<double, std::milli>{deltaWrite}.count() << " ms write, "
+                          << std::chrono::duration<double, std::milli>{deltaRead}.count() << " ms read, "
+                          << std::chrono::duration<double, std::milli>{deltaSeek}.count() << " ms seek to the end";
+
+  std::filesystem::remove_all(tempDir);
+}
+} // namespace benchmark
@@ -0,0 +1,97 @@
+#include "benchmark.h"
+
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "engine/heightinfo.h"
+#include "engine/objectmanager.h"
+#include "engine/world/room.h"
+#include "engine/world/sector.h"
+#include "engine/world/world.h"
+
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <random>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Queries = 2'000'000;
+
+struct Query
+{
+  gsl_lite::not_null<const engine::world::Sector*> sector;
+  core::TRVec position;
+};
+
+std::vector<Query> createQueries(const engine::world::World& world)
+{
+  // fixed seed, so that all runs query the same positions
+  std::mt19937 rng{0};
+  const auto& rooms = world.getRooms();
+  std::uniform_int_distribution<size_t> roomDistribution{0, rooms.size() - 1};
+  std::uniform_int_distribution<core::Length::type> offsetDistribution{0, core::SectorSize.get() - 1};
+
+  std::vector<Query> queries;
+  queries.reserve(Queries);
+  while(queries.size() < Queries)
+  {
+    const auto& room = rooms[roomDistribution(rng)];
+    if(room.sectorCountX < 3 || room.sectorCountZ < 3)
+      continue;
+
+    // the outermost sectors are walls
+    const auto x = std::uniform_int_distribution<int>{1, room.sectorCountX - 2}(rng);
+    const auto z = std::uniform_int_distribution<int>{1, room.sectorCountZ - 2}(rng);
+    const auto sector = room.getSectorByIndex(x, z);
+    if(sector == nullptr || sector->floorHeight == core::InvalidHeight)
+      continue;
+
+    queries.emplace_back(
+      Query{gsl_lite::not_null{sector},
+            core::TRVec{room.position.X + x * core::SectorSize + core::Length{offsetDistribution(rng)},
+                        sector->floorHeight,
+                        room.position.Z + z * core::SectorSize + core::Length{offsetDistribution(rng)}}});
+  }
+  return queries;
+}
+} // namespace
+
+void heights(engine::world::World& world)
+{
+  if(world.getRooms().empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Level has no rooms";
+    return;
+  }
+
+  const auto queries = createQueries(world);
+  const auto& objects = world.getObjectManager().getObjects();
+
+  // summing up the heights keeps the queries from being optimized away
+  int64_t sum = 0;
+  size_t i = 0;
+  const auto floor = measure(queries.size(),
+                             [&queries, &objects, &sum, &i]()
+                             {
+                               const auto& query = queries[i++];
+                               sum += engine::HeightInfo::fromFloor(query.sector, query.position, objects).y.get();
+                             });
+
+  i = 0;
+  const auto ceiling = measure(queries.size(),
+                               [&queries, &objects, &sum, &i]()
+                               {
+                                 const auto& query = queries[i++];
+                                 sum += engine::HeightInfo::fromCeiling(query.sector, query.position, objects).y.get();
+                               });
+
+  BOOST_LOG_TRIVIAL(info) << queries.size() << " random positions: " << floor.count() * 1000
+                          << " ns per floor query, " << ceiling.count() * 1000 << " ns per ceiling query";
+  BOOST_LOG_TRIVIAL(debug) << "Height sum " << sum;
+}
+} // namespace benchmark
@@ -0,0 +1,58 @@
+#include "benchmark.h"
+
+#include "engine/world/world.h"
+#include "loader/file/io/sdlreader.h"
+#include "loader/file/level/game.h"
+#include "loader/file/level/level.h"
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
+#include <memory>
+#include <utility>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Loads = 5;
+
+void load(loader::file::io::SDLReader&& reader, const std::filesystem::path& filename)
+{
+  const auto level = loader::file::level::Level::createLoader(
+    std::move(reader), filename, loader::file::level::Game::Unknown);
+  gsl_Assert(level != nullptr);
+  level->loadFileData();
+}
+} // namespace
+
+void levelLoading(engine::world::World& world)
+{
+  const auto& filename = world.getLevelFilename();
+
+  const auto mapped = measure(Loads,
+                              [&filename]()
+                              {
+                                load(loader::file::io::SDLReader{filename}, filename);
+                              });
+
+  // how files were read before they were memory-mapped
+  const auto stream = measure(Loads,
+                              [&filename]()
+                              {
+                                load(loader::file::io::SDLReader{std::make_shared<loader::file::io::DataStreamBuf>(
+                                       boost::iostreams::file{filename.string(),
+                                                              std::ios::in | std::ios::binary,
+                                                              std::ios::in | std::ios::binary})},
+                                     filename);
+                              });
+
+  BOOST_LOG_TRIVIAL(info) << "Loading " << filename.filename() << ": "
+                          << std::chrono::duration<double, std::milli>{mapped}.count() << " ms memory-mapped, "
+                          << std::chrono::duration<double, std::milli>{stream}.count() << " ms through a stream";
+}
+} // namespace benchmark
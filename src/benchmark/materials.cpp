@@ -0,0 +1,77 @@
+#include "benchmark.h"
+
+#include "engine/world/room.h"
+#include "engine/world/world.h"
+#include "render/material/material.h"
+#include "render/material/materialgroup.h"
+#include "render/material/rendermode.h"
+#include "render/scene/mesh.h"
+#include "render/scene/node.h"
+
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <gsl-lite/gsl-lite.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Repetitions = 1000;
+
+struct Bind
+{
+  gsl_lite::not_null<const render::scene::Node*> node;
+  gsl_lite::not_null<const render::scene::Mesh*> mesh;
+  gsl_lite::not_null<const render::material::Material*> material;
+};
+
+void collectBinds(const render::scene::Node& node, const render::material::RenderMode mode, std::vector<Bind>& binds)
+{
+  if(const auto mesh = std::dynamic_pointer_cast<render::scene::Mesh>(node.getRenderable()); mesh != nullptr)
+  {
+    if(const auto& material = mesh->getMaterialGroup().get(mode); material != nullptr)
+      binds.emplace_back(
+        Bind{gsl_lite::not_null{&node}, gsl_lite::not_null{mesh.get()}, gsl_lite::not_null{material.get()}});
+  }
+
+  for(const auto& child : node.getChildren())
+    collectBinds(*child, mode, binds);
+}
+} // namespace
+
+void materials(engine::world::World& world)
+{
+  static constexpr std::array<std::pair<render::material::RenderMode, const char*>, 3> modes{{
+    {render::material::RenderMode::FullOpaque, "opaque"},
+    {render::material::RenderMode::DepthOnly, "depth only"},
+    {render::material::RenderMode::CSMDepthOnly, "CSM depth only"},
+  }};
+
+  for(const auto& [mode, modeName] : modes)
+  {
+    std::vector<Bind> binds;
+    for(const auto& room : world.getRooms())
+      collectBinds(*room.node, mode, binds);
+
+    if(binds.empty())
+    {
+      BOOST_LOG_TRIVIAL(info) << "No room meshes with a " << modeName << " material";
+      continue;
+    }
+
+    const auto bind = measure(Repetitions,
+                              [&binds]()
+                              {
+                                for(const auto& [node, mesh, material] : binds)
+                                  material->bind(node.get(), *mesh);
+                              });
+    BOOST_LOG_TRIVIAL(info) << "Binding " << binds.size() << " " << modeName << " room materials: " << bind.count()
+                            << " us per pass, "
+                            << bind.count() * 1000 / static_cast<double>(binds.size()) << " ns per bind";
+  }
+}
+} // namespace benchmark
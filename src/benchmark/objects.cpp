@@ -0,0 +1,92 @@
+#include "benchmark.h"
+
+#include "core/id.h"
+#include "engine/items_tr1.h"
+#include "engine/location.h"
+#include "engine/objectmanager.h"
+#include "engine/objects/laraobject.h"
+#include "engine/objects/pickupobject.h"
+#include "engine/world/sprite.h"
+#include "engine/world/world.h"
+#include "engine/world/worldgeometry.h"
+
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <deque>
+#include <gslu.h>
+#include <optional>
+#include <utility>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Ticks = 300;
+constexpr std::array<size_t, 4> DynamicObjectCounts{0, 100, 500, 1000};
+//! The number of objects deleted and spawned each tick in the final run.
+constexpr size_t ChurnPerTick = 10;
+
+std::optional<core::TypeId> findPickupType(const engine::world::World& world)
+{
+  for(const auto type : {engine::TR1ItemId::SmallMedipackSprite,
+                         engine::TR1ItemId::LargeMedipackSprite,
+                         engine::TR1ItemId::ShotgunAmmoSprite,
+                         engine::TR1ItemId::MagnumAmmoSprite,
+                         engine::TR1ItemId::UziAmmoSprite})
+  {
+    if(const auto& sequence = world.getWorldGeometry().findSpriteSequenceForType(type);
+       sequence != nullptr && !sequence->sprites.empty())
+      return type;
+  }
+  return std::nullopt;
+}
+} // namespace
+
+void objects(engine::world::World& world)
+{
+  const auto type = findPickupType(world);
+  if(!type.has_value())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "No pickup sprite found";
+    return;
+  }
+
+  auto& objectManager = world.getObjectManager();
+  const auto location = objectManager.getLara().m_state.location;
+  std::deque<gslu::nn_shared<engine::objects::PickupObject>> pickups;
+  const auto spawn = [&world, &objectManager, &type, &location, &pickups]()
+  {
+    auto pickup = world.createPickup(*type, location.room, location.position);
+    objectManager.activate(pickup.get());
+    pickups.emplace_back(std::move(pickup));
+  };
+
+  for(const auto count : DynamicObjectCounts)
+  {
+    while(pickups.size() < count)
+      spawn();
+
+    const auto tick = measure(Ticks,
+                              [&world]()
+                              {
+                                world.updateGameLogic(true);
+                              });
+    BOOST_LOG_TRIVIAL(info) << count << " dynamic objects: " << tick.count() << " us/tick";
+  }
+
+  const auto tick = measure(Ticks,
+                            [&objectManager, &pickups, &spawn, &world]()
+                            {
+                              for(size_t i = 0; i < ChurnPerTick; ++i)
+                              {
+                                objectManager.scheduleDeletion(pickups.front().get());
+                                pickups.pop_front();
+                                spawn();
+                              }
+                              world.updateGameLogic(true);
+                            });
+  BOOST_LOG_TRIVIAL(info) << pickups.size() << " dynamic objects, " << ChurnPerTick
+                          << " of them replaced each tick: " << tick.count() << " us/tick";
+}
+} // namespace benchmark
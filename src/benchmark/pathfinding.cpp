@@ -0,0 +1,86 @@
+#include "benchmark.h"
+
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "engine/ai/pathfinder.h"
+#include "engine/script/reflection.h"
+#include "engine/world/box.h"
+#include "engine/world/world.h"
+
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <gsl-lite/gsl-lite.hpp>
+#include <random>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Searches = 200;
+
+struct Profile
+{
+  const char* name;
+  core::Length step;
+  core::Length drop;
+  core::Length fly;
+};
+
+// the movement limits of wolves, gorillas and bats
+const std::array<Profile, 3> Profiles{
+  Profile{"walking", core::QuarterSectorSize, -core::SectorSize, 0_len},
+  Profile{"climbing", core::SectorSize / 2, -core::SectorSize, 0_len},
+  Profile{"flying", 20 * core::SectorSize, -20 * core::SectorSize, 16_len},
+};
+} // namespace
+
+void pathFinding(engine::world::World& world)
+{
+  const auto& boxes = world.getBoxes();
+  if(boxes.empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Level has no boxes";
+    return;
+  }
+
+  // fixed seed, so that all runs search for the same boxes
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<size_t> boxDistribution{0, boxes.size() - 1};
+
+  for(const auto& profile : Profiles)
+  {
+    engine::script::ObjectInfo objectInfo;
+    objectInfo.step_limit = profile.step.get();
+    objectInfo.drop_limit = profile.drop.get();
+    objectInfo.fly_limit = profile.fly.get();
+
+    std::chrono::high_resolution_clock::duration searchDuration{};
+    size_t steps = 0;
+    for(size_t i = 0; i < Searches; ++i)
+    {
+      const auto& box = boxes[boxDistribution(rng)];
+      engine::ai::PathFinder pathFinder;
+      pathFinder.init(world, gsl_lite::not_null{&box}, objectInfo);
+
+      // the expansion always starts at the target box, so steering from it doesn't need a separate source
+      const core::TRVec startPos{box.xInterval.mid(), box.floor, box.zInterval.mid()};
+      core::TRVec moveTarget;
+      const auto start = std::chrono::high_resolution_clock::now();
+      while(pathFinder.hasPendingExpansions())
+      {
+        pathFinder.calculateTarget(world, moveTarget, startPos, gsl_lite::not_null{&box});
+        ++steps;
+      }
+      searchDuration += std::chrono::high_resolution_clock::now() - start;
+    }
+
+    BOOST_LOG_TRIVIAL(info) << boxes.size() << " boxes, " << profile.name << ": "
+                            << std::chrono::duration<double, std::micro>{searchDuration}.count() / Searches
+                            << " us per full search, "
+                            << static_cast<double>(steps) / Searches << " expansion steps per search";
+  }
+}
+} // namespace benchmark
@@ -0,0 +1,122 @@
+#include "benchmark.h"
+
+#include "core/magic.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "engine/cameracontroller.h"
+#include "engine/location.h"
+#include "engine/world/room.h"
+#include "engine/world/sector.h"
+#include "engine/world/world.h"
+#include "render/portaltracer.h"
+#include "render/scene/camera.h"
+#include "render/scene/node.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <cmath>
+#include <cstddef>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/vec3.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Directions = 8;
+constexpr size_t Repetitions = 100;
+
+struct View
+{
+  gsl_lite::not_null<const engine::world::Room*> room;
+  core::TRVec position;
+  glm::vec3 direction;
+};
+
+//! @brief Looks around horizontally from the centre of every room which is large enough to stand in.
+std::vector<View> createViews(const engine::world::World& world)
+{
+  std::vector<View> views;
+  for(const auto& room : world.getRooms())
+  {
+    if(room.sectorCountX < 3 || room.sectorCountZ < 3)
+      continue;
+
+    const auto x = room.sectorCountX / 2;
+    const auto z = room.sectorCountZ / 2;
+    const auto sector = room.getSectorByIndex(x, z);
+    if(sector == nullptr || sector->floorHeight == core::InvalidHeight || sector->ceilingHeight == core::InvalidHeight)
+      continue;
+
+    const core::TRVec position{room.position.X + x * core::SectorSize + core::SectorSize / 2,
+                               (sector->floorHeight + sector->ceilingHeight) / 2,
+                               room.position.Z + z * core::SectorSize + core::SectorSize / 2};
+    for(size_t i = 0; i < Directions; ++i)
+    {
+      const auto angle = 2 * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(Directions);
+      views.emplace_back(View{gsl_lite::not_null{&room}, position, glm::vec3{std::sin(angle), 0, std::cos(angle)}});
+    }
+  }
+  return views;
+}
+
+void setView(engine::CameraController& cameraController, const View& view)
+{
+  cameraController.setLocation(engine::Location{view.room, view.position});
+  const auto eye = view.position.toRenderSystem();
+  cameraController.getCamera()->setViewMatrix(glm::lookAt(eye, eye + view.direction, core::RenderAxisUp));
+}
+} // namespace
+
+void portals(engine::world::World& world)
+{
+  const auto views = createViews(world);
+  if(views.empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Level has no rooms to look around in";
+    return;
+  }
+
+  auto& cameraController = world.getCameraController();
+
+  size_t visibleRooms = 0;
+  size_t waterSurfacePortals = 0;
+  render::PortalTracer::getStatistics() = {};
+  for(const auto& view : views)
+  {
+    setView(cameraController, view);
+    waterSurfacePortals += cameraController.traceWaterSurfacePortals().size();
+    visibleRooms += std::ranges::count_if(world.getRooms(),
+                                          [](const engine::world::Room& room)
+                                          {
+                                            return room.node->isVisible();
+                                          });
+  }
+
+  const auto statistics = std::exchange(render::PortalTracer::getStatistics(), {});
+  const auto perView = [&views](const size_t count)
+  {
+    return static_cast<double>(count) / static_cast<double>(views.size());
+  };
+
+  size_t i = 0;
+  const auto trace = measure(views.size() * Repetitions,
+                             [&cameraController, &views, &i]()
+                             {
+                               setView(cameraController, views[i++ % views.size()]);
+                               cameraController.traceWaterSurfacePortals();
+                             });
+
+  BOOST_LOG_TRIVIAL(info) << views.size() << " views in " << world.getRooms().size() << " rooms: " << trace.count()
+                          << " us per trace";
+  BOOST_LOG_TRIVIAL(info) << "Per view: " << perView(statistics.expansions) << " expansions, "
+                          << perView(statistics.visitedRooms) << " rooms and " << perView(statistics.visitedPortals)
+                          << " portals visited, " << perView(statistics.fallbackRooms) << " rooms not traced, "
+                          << perView(visibleRooms) << " visible rooms, " << perView(waterSurfacePortals)
+                          << " water surface portals";
+}
+} // namespace benchmark
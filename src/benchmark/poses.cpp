@@ -0,0 +1,51 @@
+#include "benchmark.h"
+
+#include "engine/objectmanager.h"
+#include "engine/objects/modelobject.h"
+#include "engine/objects/object.h"
+#include "engine/skeletalmodelnode.h"
+#include "engine/world/world.h"
+
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Iterations = 2000;
+} // namespace
+
+void poses(engine::world::World& world)
+{
+  std::vector<engine::SkeletalModelNode*> skeletons;
+  for(const auto& object : world.getObjectManager().getObjects() | std::views::values)
+  {
+    if(const auto modelObject = std::dynamic_pointer_cast<engine::objects::ModelObject>(object.get());
+       modelObject != nullptr && modelObject->getSkeleton() != nullptr)
+      skeletons.emplace_back(modelObject->getSkeleton().get());
+  }
+
+  if(skeletons.empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Level has no skeletal objects";
+    return;
+  }
+
+  for(const bool predictive : {false, true})
+  {
+    const auto duration = measure(Iterations,
+                                  [&skeletons, predictive]()
+                                  {
+                                    for(const auto skeleton : skeletons)
+                                      skeleton->calculatePoseMatrices(predictive);
+                                  });
+    BOOST_LOG_TRIVIAL(info) << skeletons.size() << " skeletons, " << (predictive ? "current and next" : "current")
+                            << " pose: " << duration.count() / static_cast<double>(skeletons.size())
+                            << " us per skeleton";
+  }
+}
+} // namespace benchmark
@@ -0,0 +1,57 @@
+#include "benchmark.h"
+
+#include "engine/world/world.h"
+#include "serialization/binarydocument.h"
+#include "serialization/yamldocument.h"
+
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+#include <gsl-lite/gsl-lite.hpp>
+#include <memory>
+#include <string>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Iterations = 20;
+
+template<template<bool> typename TDocument>
+void measureFormat(engine::world::World& world, const char* name)
+{
+  std::unique_ptr<TDocument<false>> saveDoc;
+  const auto build = measure(Iterations,
+                             [&world, &saveDoc]()
+                             {
+                               saveDoc = std::make_unique<TDocument<false>>();
+                               saveDoc->serialize("data", gsl_lite::not_null{&world}, world);
+                             });
+
+  std::string encoded;
+  const auto encode = measure(Iterations,
+                              [&saveDoc, &encoded]()
+                              {
+                                encoded = saveDoc->encode();
+                              });
+
+  const auto load = measure(Iterations,
+                            [&world, &encoded]()
+                            {
+                              TDocument<true> loadDoc{encoded};
+                              loadDoc.deserialize("data", gsl_lite::not_null{&world}, world);
+                            });
+
+  BOOST_LOG_TRIVIAL(info) << name << ": " << encoded.size() << " bytes, "
+                          << std::chrono::duration<double, std::milli>{build}.count() << " ms to build, "
+                          << std::chrono::duration<double, std::milli>{encode}.count() << " ms to encode, "
+                          << std::chrono::duration<double, std::milli>{load}.count() << " ms to decode and load";
+}
+} // namespace
+
+void savegame(engine::world::World& world)
+{
+  measureFormat<serialization::YAMLDocument>(world, "YAML");
+  measureFormat<serialization::BinaryDocument>(world, "Binary");
+}
+} // namespace benchmark
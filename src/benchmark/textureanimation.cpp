@@ -0,0 +1,39 @@
+#include "benchmark.h"
+
+#include "engine/world/room.h"
+#include "engine/world/world.h"
+#include "engine/world/worldgeometry.h"
+#include "render/textureanimator.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <gl/buffer.h>
+
+namespace benchmark
+{
+namespace
+{
+constexpr size_t Steps = 100000;
+} // namespace
+
+void textureAnimation(engine::world::World& world)
+{
+  const auto animator = world.getWorldGeometry().getTextureAnimator();
+  const auto waterRooms = std::ranges::count_if(world.getRooms(),
+                                                [](const engine::world::Room& room)
+                                                {
+                                                  return room.isWaterRoom;
+                                                });
+
+  const auto step = measure(Steps,
+                            [&animator]()
+                            {
+                              animator->step();
+                            });
+  BOOST_LOG_TRIVIAL(info) << animator->getSequencesBuffer().size() << " sequences with "
+                          << animator->getTilesBuffer().size() << " tiles, " << waterRooms << " of "
+                          << world.getRooms().size() << " rooms are water rooms: " << step.count() * 1000
+                          << " ns per step";
+}
+} // namespace benchmark
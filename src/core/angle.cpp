@@ -5,14 +5,40 @@
 #include "units.h"
 #include "util/memaccess.h"
 
+#include <array>
 #include <boost/assert.hpp>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <glm/ext/scalar_constants.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/mat4x4.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 
 namespace core
 {
+namespace
+{
+struct HalfAngle
+{
+  float cos;
+  float sin;
+};
+
+// packed angles have a resolution of 10 bits, so all half angles needed for quaternions fit into a small table
+const auto PackedHalfAngles = []()
+{
+  std::array<HalfAngle, 1024> result{};
+  for(size_t i = 0; i < result.size(); ++i)
+  {
+    const auto halfAngle = static_cast<float>(i) * glm::pi<float>() / static_cast<float>(result.size());
+    result[i] = HalfAngle{std::cos(halfAngle), std::sin(halfAngle)};
+  }
+  return result;
+}();
+} // namespace
+
 void TRRotationXY::serialize(const serialization::Serializer<engine::world::World>& ser) const
 {
   ser(S_NV("x", X), S_NV("y", Y));
@@ -67,4 +93,20 @@ glm::mat4 fromPackedAngles(const uint8_t* angleData)
 
   return r.toMatrix();
 }
+
+glm::quat quatFromPackedAngles(const uint8_t* angleData)
+{
+  const auto value = util::readUnaligned32LE(angleData);
+  const auto& x = PackedHalfAngles[(value >> 20u) & 0x3ffu];
+  const auto& y = PackedHalfAngles[(value >> 10u) & 0x3ffu];
+  const auto& z = PackedHalfAngles[value & 0x3ffu];
+
+  // yaw(-y) * pitch(x) * roll(-z), matching TRRotation::toMatrix()
+  const auto sy = -y.sin;
+  const auto sz = -z.sin;
+  return glm::quat{y.cos * x.cos * z.cos + sy * x.sin * sz,
+                   z.cos * y.cos * x.sin + x.cos * sy * sz,
+                   z.cos * x.cos * sy - y.cos * x.sin * sz,
+                   y.cos * x.cos * sz - z.cos * sy * x.sin};
+}
 } // namespace core
\ No newline at end of file
@@ -205,6 +205,12 @@ public:
 
 [[nodiscard]] extern glm::mat4 fromPackedAngles(const uint8_t* angleData);
 
+/**
+ * @brief Decodes the same rotation as fromPackedAngles(), but as a quaternion and without evaluating any trigonometric
+ * functions.
+ */
+[[nodiscard]] extern glm::quat quatFromPackedAngles(const uint8_t* angleData);
+
 struct TRRotationXY
 {
   Angle X{0_deg};
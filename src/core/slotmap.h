@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+struct SlotHandle
+{
+  static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  uint32_t index = InvalidIndex;
+  uint32_t generation = 0;
+
+  [[nodiscard]] constexpr bool isValid() const noexcept
+  {
+    return index != InvalidIndex;
+  }
+
+  constexpr bool operator==(const SlotHandle& rhs) const noexcept = default;
+};
+
+/**
+ * @brief Contiguous storage with stable, generation-checked handles.
+ *
+ * Erased slots are reused by later insertions. Each erase increments the generation of its slot, so a handle to an
+ * erased element never resolves to a newer element occupying the same slot.
+ */
+template<typename T>
+class SlotMap final
+{
+  struct Slot
+  {
+    std::optional<T> value;
+    uint32_t generation = 0;
+  };
+
+  std::vector<Slot> m_slots;
+  std::vector<uint32_t> m_freeSlots;
+  size_t m_size = 0;
+
+public:
+  SlotHandle insert(T value)
+  {
+    uint32_t index;
+    if(!m_freeSlots.empty())
+    {
+      index = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+    else
+    {
+      index = gsl_lite::narrow<uint32_t>(m_slots.size());
+      gsl_Assert(index != SlotHandle::InvalidIndex);
+      m_slots.emplace_back();
+    }
+
+    auto& slot = m_slots[index];
+    slot.value.emplace(std::move(value));
+    ++m_size;
+    return SlotHandle{index, slot.generation};
+  }
+
+  bool erase(const SlotHandle& handle)
+  {
+    if(!contains(handle))
+      return false;
+
+    auto& slot = m_slots[handle.index];
+    slot.value.reset();
+    ++slot.generation;
+    m_freeSlots.emplace_back(handle.index);
+    --m_size;
+    return true;
+  }
+
+  void clear()
+  {
+    m_freeSlots.clear();
+    for(size_t i = m_slots.size(); i > 0; --i)
+    {
+      auto& slot = m_slots[i - 1];
+      if(slot.value.has_value())
+      {
+        slot.value.reset();
+        ++slot.generation;
+      }
+      m_freeSlots.emplace_back(gsl_lite::narrow_cast<uint32_t>(i - 1));
+    }
+    m_size = 0;
+  }
+
+  [[nodiscard]] bool contains(const SlotHandle& handle) const noexcept
+  {
+    return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+           && m_slots[handle.index].value.has_value();
+  }
+
+  [[nodiscard]] T* get(const SlotHandle& handle) noexcept
+  {
+    return contains(handle) ? &*m_slots[handle.index].value : nullptr;
+  }
+
+  [[nodiscard]] const T* get(const SlotHandle& handle) const noexcept
+  {
+    return contains(handle) ? &*m_slots[handle.index].value : nullptr;
+  }
+
+  [[nodiscard]] T& at(const SlotHandle& handle)
+  {
+    gsl_Expects(contains(handle));
+    return *m_slots[handle.index].value;
+  }
+
+  [[nodiscard]] const T& at(const SlotHandle& handle) const
+  {
+    gsl_Expects(contains(handle));
+    return *m_slots[handle.index].value;
+  }
+
+  /**
+   * @brief Access by raw slot index, for intrusive structures linking slots with each other.
+   */
+  [[nodiscard]] T& atIndex(const uint32_t index)
+  {
+    gsl_Expects(index < m_slots.size() && m_slots[index].value.has_value());
+    return *m_slots[index].value;
+  }
+
+  [[nodiscard]] const T& atIndex(const uint32_t index) const
+  {
+    gsl_Expects(index < m_slots.size() && m_slots[index].value.has_value());
+    return *m_slots[index].value;
+  }
+
+  /**
+   * @brief The handle of the element in the slot at @a index.
+   */
+  [[nodiscard]] SlotHandle handleAt(const uint32_t index) const
+  {
+    gsl_Expects(index < m_slots.size() && m_slots[index].value.has_value());
+    return SlotHandle{index, m_slots[index].generation};
+  }
+
+  /**
+   * @brief Calls @a f for each element, in slot order.
+   */
+  template<typename F>
+  void forEach(F&& f)
+  {
+    for(auto& slot : m_slots)
+    {
+      if(slot.value.has_value())
+        f(*slot.value);
+    }
+  }
+
+  template<typename F>
+  void forEach(F&& f) const
+  {
+    for(const auto& slot : m_slots)
+    {
+      if(slot.value.has_value())
+        f(*slot.value);
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept
+  {
+    return m_size;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_size == 0;
+  }
+};
+} // namespace core
@@ -2,8 +2,14 @@
 
 #include "angle.h"
 #include "boundingbox.h"
+#include "slotmap.h"
 
+#include <array>
 #include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <random>
 
 namespace core
 {
@@ -272,4 +278,73 @@ BOOST_AUTO_TEST_CASE(test_rotation_lerp)
   BOOST_CHECK_EQUAL(result.Z, -90_deg);
 }
 
+BOOST_AUTO_TEST_CASE(test_quat_from_packed_angles)
+{
+  const auto check = [](const uint32_t value)
+  {
+    const std::array<uint8_t, 4> data{static_cast<uint8_t>(value),
+                                      static_cast<uint8_t>(value >> 8u),
+                                      static_cast<uint8_t>(value >> 16u),
+                                      static_cast<uint8_t>(value >> 24u)};
+    const auto expected = core::fromPackedAngles(data.data());
+    const auto actual = glm::mat4_cast(core::quatFromPackedAngles(data.data()));
+    for(int x = 0; x < 4; ++x)
+    {
+      for(int y = 0; y < 4; ++y)
+        BOOST_CHECK_SMALL(actual[x][y] - expected[x][y], 1e-5f);
+    }
+  };
+
+  // zero and the largest value of each angle
+  check(0);
+  check(0x3ffu);
+  check(0x3ffu << 10u);
+  check(0x3ffu << 20u);
+  check(0x3fffffffu);
+
+  // fixed seed, so that failures are reproducible
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<uint32_t> distribution;
+  for(int i = 0; i < 10000; ++i)
+    check(distribution(rng));
+}
+
+BOOST_AUTO_TEST_CASE(test_slotmap_handles)
+{
+  core::SlotMap<int> map;
+  const auto a = map.insert(1);
+  const auto b = map.insert(2);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.at(a), 1);
+  BOOST_CHECK_EQUAL(map.at(b), 2);
+
+  BOOST_CHECK(map.erase(a));
+  BOOST_CHECK(!map.erase(a));
+  BOOST_CHECK(!map.contains(a));
+  BOOST_CHECK(map.get(a) == nullptr);
+
+  // the slot is reused, but the stale handle must not resolve to the new element
+  const auto c = map.insert(3);
+  BOOST_CHECK_EQUAL(c.index, a.index);
+  BOOST_CHECK(!map.contains(a));
+  BOOST_CHECK_EQUAL(map.at(c), 3);
+  BOOST_CHECK_EQUAL(map.at(b), 2);
+  BOOST_CHECK(map.handleAt(c.index) == c);
+  BOOST_CHECK(map.handleAt(b.index) == b);
+
+  int sum = 0;
+  map.forEach(
+    [&sum](const int value)
+    {
+      sum += value;
+    });
+  BOOST_CHECK_EQUAL(sum, 5);
+
+  map.clear();
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(!map.contains(b));
+  BOOST_CHECK(!map.contains(c));
+  BOOST_CHECK(!core::SlotHandle{}.isValid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
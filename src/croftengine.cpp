@@ -141,7 +141,8 @@ void runGame(const std::string& localeOverride, const std::string& gameflowId, c
                         localeOverride,
                         gameflowId,
                         {1280, 800},
-                        borderlessFullscreen};
+                        borderlessFullscreen,
+                        false};
   size_t levelSequenceIndex = 0;
   enum class Mode : uint8_t
   {
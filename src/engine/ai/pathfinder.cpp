@@ -6,6 +6,7 @@
 #include "core/vec.h"
 #include "engine/script/reflection.h"
 #include "engine/world/box.h"
+#include "engine/world/boxgraph.h"
 #include "engine/world/world.h"
 #include "serialization/box_ptr.h"
 #include "serialization/deque.h"
@@ -21,10 +22,14 @@
 
 #include <algorithm>
 #include <boost/assert.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <gsl-lite/gsl-lite.hpp>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace engine::ai
 {
@@ -373,7 +378,11 @@ bool PathFinder::calculateTarget(const world::World& world,
   gsl_Expects(m_targetBox->zInterval.contains(m_target.Z));
   gsl_Expects(startBox->xInterval.contains(startPos.X));
   gsl_Expects(startBox->zInterval.contains(startPos.Z));
-  expandPathGraph(world);
+  if(m_prepared.valid && isPreparedExpansionValid(world))
+    std::swap(m_search, m_prepared.search);
+  else
+    expandPathGraph(world.roomsAreSwapped(), m_search, nullptr);
+  m_prepared.valid = false;
 
   SteeringCalculator calc{startPos};
   const auto result = calc.calculate(
@@ -393,107 +402,99 @@ bool PathFinder::calculateTarget(const world::World& world,
   return result;
 }
 
-void PathFinder::expandPathGraph(const world::World& world)
+void PathFinder::prepareExpansion(const world::World& world)
 {
-  const auto zoneRef = world::Box::getZoneRef(world.roomsAreSwapped(), isFlying(), m_step);
-
-  static constexpr uint8_t MaxExpansionsPerTick = 50;
-
-  for(uint8_t i = 0; i < MaxExpansionsPerTick && !m_expansions.empty(); ++i)
-  {
-    // This does a backwards search from the target (usually Lara) towards the source (the AI entity).
-    // The m_expansions queue is initialized with the target box.
-
-    const auto current = m_expansions.front();
-    m_expansions.pop_front();
-    const auto searchZone = current.get()->*zoneRef;
-
-    for(const auto& neighbor : current->overlaps)
-    {
-      if(neighbor == current)
-        continue;
-
-      if(searchZone != neighbor.get()->*zoneRef)
-      {
-        setReachable(neighbor, false);
-        continue;
-      }
-
-      if(const auto dy = current->floor - neighbor->floor; dy < -m_step || dy > -m_drop)
-      {
-        setReachable(neighbor, false);
-        continue;
-      }
-
-      // Update reachability and distance of the neighbor
-      if(updateEdge(current, neighbor))
-        continue;
-
-      const auto reachable = canVisit(*neighbor);
-      if(reachable)
-      {
-        // Success! Connect both boxes.
-        BOOST_ASSERT_MSG(!m_edges.contains(neighbor), "cycle in pathfinder graph detected");
-        m_edges.emplace(neighbor, current);
-        m_distances[neighbor] = m_distances[current] + 1;
-      }
+  m_prepared.valid = false;
+  if(m_search.expansions.empty())
+    return;
 
-      setReachable(neighbor, reachable);
-    }
-  }
+  m_prepared.roomsSwapped = world.roomsAreSwapped();
+  m_prepared.search = m_search;
+  m_prepared.visitChecks.clear();
+  expandPathGraph(m_prepared.roomsSwapped, m_prepared.search, &m_prepared.visitChecks);
+  m_prepared.valid = true;
 }
 
-void PathFinder::setReachable(const gsl_lite::not_null<const world::Box*>& box, const bool reachable)
+bool PathFinder::isPreparedExpansionValid(const world::World& world) const
 {
-  m_reachable[box] |= reachable;
-  if(reachable && std::ranges::find(m_expansions, box) == m_expansions.end())
-    m_expansions.emplace_back(box);
+  gsl_Expects(m_prepared.valid);
+  if(m_prepared.roomsSwapped != world.roomsAreSwapped())
+    return false;
+
+  return std::ranges::all_of(m_prepared.visitChecks,
+                             [this](const VisitCheck& check)
+                             {
+                               return canVisit(m_graph->getBox(check.box)) == check.visitable;
+                             });
 }
 
-void PathFinder::updateDistance(const gsl_lite::not_null<const world::Box*>& current,
-                                const gsl_lite::not_null<const world::Box*>& neighbor)
+void PathFinder::expandPathGraph(const bool roomsSwapped,
+                                 SearchState& search,
+                                 std::vector<VisitCheck>* visitChecks) const
 {
-  BOOST_ASSERT(m_distances.contains(neighbor));
-  BOOST_ASSERT(m_distances.contains(current));
-
-  auto& neighborDistance = m_distances[neighbor];
-  const auto newDistance = m_distances[current] + 1;
-  if(neighborDistance <= newDistance)
+  if(search.expansions.empty())
     return;
 
-  neighborDistance = newDistance;
-  m_edges.erase(current);
-  m_edges.emplace(current, neighbor);
-  m_expansions.emplace_back(neighbor);
+  gsl_Expects(m_graph != nullptr);
+  static constexpr uint8_t MaxExpansionsPerTick = 50;
+  search.expand(*m_graph,
+                m_graph->getZones(roomsSwapped, isFlying(), m_step),
+                m_step,
+                m_drop,
+                [this, visitChecks](const uint32_t box)
+                {
+                  const auto visitable = canVisit(m_graph->getBox(box));
+                  if(visitChecks != nullptr)
+                    visitChecks->emplace_back(VisitCheck{box, visitable});
+                  return visitable;
+                },
+                MaxExpansionsPerTick);
 }
 
-bool PathFinder::updateEdge(const gsl_lite::not_null<const world::Box*>& current,
-                            const gsl_lite::not_null<const world::Box*>& neighbor)
+bool PathFinder::isUnreachable(const gsl_lite::not_null<const world::Box*>& box) const
 {
-  if(!m_reachable.at(current))
-  {
-    // Propagate "unreachable" to neighbors
-    setReachable(neighbor, false);
-    return true;
-  }
+  if(m_search.visited.empty())
+    return false;
 
-  if(const auto it = m_reachable.find(neighbor); it != m_reachable.end() && it->second)
-  {
-    // Neighbor was already reachable, but we might have found a shorter path.
-    updateDistance(current, neighbor);
-    return true;
-  }
+  const auto index = m_graph->indexOf(box);
+  return m_search.visited[index] && !m_search.reachable[index];
+}
+
+const world::Box* PathFinder::getNextPathBox(const gsl_lite::not_null<const world::Box*>& box) const
+{
+  if(m_search.edges.empty())
+    return nullptr;
 
-  return false;
+  const auto next = m_search.edges[m_graph->indexOf(box)];
+  return next == world::BoxGraph::NoBox ? nullptr : &m_graph->getBox(next);
 }
 
 void PathFinder::serialize(const serialization::Serializer<world::World>& ser) const
 {
-  ser(S_NV("edges", m_edges),
+  // keeps the format of the previous, map based search state
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, gsl_lite::not_null<const world::Box*>> edges;
+  std::deque<gsl_lite::not_null<const world::Box*>> expansions;
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, size_t> distances;
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, bool> reachable;
+  for(size_t i = 0; i < m_search.expansions.size(); ++i)
+    expansions.emplace_back(&m_graph->getBox(m_search.expansions.at(i)));
+  for(uint32_t i = 0; i < m_search.visited.size(); ++i)
+  {
+    if(m_search.edges[i] != world::BoxGraph::NoBox)
+      edges.emplace(&m_graph->getBox(i), &m_graph->getBox(m_search.edges[i]));
+    if(!m_search.visited[i])
+      continue;
+
+    reachable.emplace(&m_graph->getBox(i), m_search.reachable[i]);
+    if(m_search.reachable[i])
+      distances.emplace(&m_graph->getBox(i), m_search.distances[i]);
+  }
+
+  ser(S_NV("edges", edges),
       S_NV("boxes", m_boxes),
-      S_NV("expansions", m_expansions),
-      S_NV("distances", m_distances),
-      S_NV("reachable", m_reachable),
+      S_NV("expansions", expansions),
+      S_NV("distances", distances),
+      S_NV("reachable", reachable),
       S_NV("cannotVisitBlockable", m_cannotVisitBlockable),
       S_NV("cannotVisitBlocked", m_cannotVisitBlocked),
       S_NV("step", m_step),
@@ -505,11 +506,15 @@ void PathFinder::serialize(const serialization::Serializer<world::World>& ser) c
 
 void PathFinder::deserialize(const serialization::Deserializer<world::World>& ser)
 {
-  ser(S_NV("edges", m_edges),
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, gsl_lite::not_null<const world::Box*>> edges;
+  std::deque<gsl_lite::not_null<const world::Box*>> expansions;
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, size_t> distances;
+  std::unordered_map<gsl_lite::not_null<const world::Box*>, bool> reachable;
+  ser(S_NV("edges", edges),
       S_NV("boxes", m_boxes),
-      S_NV("expansions", m_expansions),
-      S_NV("distances", m_distances),
-      S_NV("reachable", m_reachable),
+      S_NV("expansions", expansions),
+      S_NV("distances", distances),
+      S_NV("reachable", reachable),
       S_NV("cannotVisitBlockable", m_cannotVisitBlockable),
       S_NV("cannotVisitBlocked", m_cannotVisitBlocked),
       S_NV("step", m_step),
@@ -517,6 +522,22 @@ void PathFinder::deserialize(const serialization::Deserializer<world::World>& se
       S_NV("fly", m_fly),
       S_NV_VECTOR_ELEMENT("targetBox", std::cref(ser.context->getBoxes()), std::ref(m_targetBox)),
       S_NV("target", m_target));
+
+  m_graph = &ser.context->getBoxGraph();
+  m_prepared.valid = false;
+  m_search.reset(m_graph->size());
+  for(const auto& box : expansions)
+    m_search.enqueue(m_graph->indexOf(box));
+  for(const auto& [box, next] : edges)
+    m_search.edges[m_graph->indexOf(box)] = m_graph->indexOf(next);
+  for(const auto& [box, distance] : distances)
+    m_search.distances[m_graph->indexOf(box)] = gsl_lite::narrow<uint32_t>(distance);
+  for(const auto& [box, isReachable] : reachable)
+  {
+    const auto index = m_graph->indexOf(box);
+    m_search.visited[index] = true;
+    m_search.reachable[index] = isReachable;
+  }
 }
 
 void PathFinder::init(const world::World& world,
@@ -525,6 +546,7 @@ void PathFinder::init(const world::World& world,
 {
   m_cannotVisitBlockable = objectInfo.cannot_visit_blockable;
   m_cannotVisitBlocked = objectInfo.cannot_visit_blocked;
+  m_prepared.valid = false;
 
   resetBoxes(world, box);
   setLimits(world,
@@ -571,16 +593,12 @@ void PathFinder::setTargetBox(const gsl_lite::not_null<const world::Box*>& box)
   if(box == m_targetBox)
     return;
 
+  gsl_Expects(m_graph != nullptr);
   m_targetBox = box;
   setRandomSearchTarget(box);
 
-  m_expansions.clear();
-  m_expansions.emplace_back(m_targetBox);
-  m_distances.clear();
-  m_distances[box] = 0;
-  m_reachable.clear();
-  m_reachable[box] = true;
-  m_edges.clear();
+  m_search.reset(m_graph->size(), m_graph->indexOf(box));
+  m_prepared.valid = false;
 }
 
 const gsl_lite::not_null<const world::Box*>& PathFinder::getRandomBox() const
@@ -614,6 +632,7 @@ void PathFinder::setLimits(const world::World& world,
   gsl_Expects(step >= 0_len);
   gsl_Expects(drop <= 0_len);
   gsl_Expects(fly >= 0_len);
+  m_graph = &world.getBoxGraph();
   if(box == nullptr)
     return;
 
@@ -621,6 +640,7 @@ void PathFinder::setLimits(const world::World& world,
   if((std::exchange(m_step, step) != step) | (std::exchange(m_drop, drop) != drop) | (std::exchange(m_fly, fly) != fly))
   {
     resetBoxes(world, gsl_lite::not_null{box});
+    m_prepared.valid = false;
   }
   if(m_targetBox != box)
   {
@@ -4,18 +4,19 @@
 #include "core/units.h"
 #include "core/vec.h"
 #include "qs/qs.h"
+#include "searchstate.h"
 #include "serialization/serialization_fwd.h"
 
 #include <cstddef>
-#include <deque>
+#include <cstdint>
 #include <gsl-lite/gsl-lite.hpp>
-#include <unordered_map>
 #include <vector>
 
 namespace engine::world
 {
 class World;
 struct Box;
+class BoxGraph;
 } // namespace engine::world
 
 namespace engine::script
@@ -53,6 +54,19 @@ struct PathFinder
 */
   void setTargetBox(const gsl_lite::not_null<const world::Box*>& box);
 
+  /**
+* Speculatively does the path graph expansion of the next #calculateTarget call on a copy of the search state. Only
+* reads @p world and the search state, so it may run concurrently for different path finders while nothing modifies
+* the world. The result is used by #calculateTarget only if neither the search state nor the visitability of any box
+* the expansion looked at changed in the meantime; otherwise it is discarded and the expansion is done again.
+*/
+  void prepareExpansion(const world::World& world);
+
+  [[nodiscard]] bool hasPendingExpansions() const noexcept
+  {
+    return !m_search.expansions.empty();
+  }
+
   void serialize(const serialization::Serializer<world::World>& ser) const;
   void deserialize(const serialization::Deserializer<world::World>& ser);
 
@@ -75,19 +89,11 @@ struct PathFinder
   /**
 * Returns @c true if and only if the @p box is visited and marked unreachable.
 */
-  [[nodiscard]] bool isUnreachable(const gsl_lite::not_null<const world::Box*>& box) const
-  {
-    const auto it = m_reachable.find(box);
-    return it != m_reachable.end() && !it->second;
-  }
+  [[nodiscard]] bool isUnreachable(const gsl_lite::not_null<const world::Box*>& box) const;
 
   [[nodiscard]] const gsl_lite::not_null<const world::Box*>& getRandomBox() const;
 
-  [[nodiscard]] const world::Box* getNextPathBox(const gsl_lite::not_null<const world::Box*>& box) const
-  {
-    const auto it = m_edges.find(box);
-    return it == m_edges.end() ? nullptr : it->second.get();
-  }
+  [[nodiscard]] const world::Box* getNextPathBox(const gsl_lite::not_null<const world::Box*>& box) const;
 
   [[nodiscard]] const auto& getTargetBox() const noexcept
   {
@@ -120,24 +126,38 @@ struct PathFinder
   }
 
 private:
+  //! @brief A box whose visitability was checked during an expansion, and the outcome of the check.
+  struct VisitCheck
+  {
+    uint32_t box;
+    bool visitable;
+  };
+
+  struct PreparedExpansion
+  {
+    bool valid = false;
+    bool roomsSwapped = false;
+    SearchState search;
+    std::vector<VisitCheck> visitChecks;
+  };
+
   void resetBoxes(const world::World& world, const gsl_lite::not_null<const world::Box*>& box);
 
   /**
-   * Does a limited expansion of the path graph and propagates reachability information.
+   * Does a limited expansion of the path graph and propagates reachability information. If @p visitChecks is not
+   * @c nullptr, every visitability check is recorded in it.
    */
-  void expandPathGraph(const world::World& world);
+  void expandPathGraph(bool roomsSwapped, SearchState& search, std::vector<VisitCheck>* visitChecks) const;
 
-  void setReachable(const gsl_lite::not_null<const world::Box*>& box, bool reachable);
-  void updateDistance(const gsl_lite::not_null<const world::Box*>& current,
-                      const gsl_lite::not_null<const world::Box*>& neighbor);
-  bool updateEdge(const gsl_lite::not_null<const world::Box*>& current,
-                  const gsl_lite::not_null<const world::Box*>& neighbor);
+  [[nodiscard]] bool isPreparedExpansionValid(const world::World& world) const;
 
+  //! @brief The box graph of the world, set by #init, #setLimits and #deserialize.
+  const world::BoxGraph* m_graph = nullptr;
   std::vector<gsl_lite::not_null<const world::Box*>> m_boxes;
-  std::deque<gsl_lite::not_null<const world::Box*>> m_expansions;
-  std::unordered_map<gsl_lite::not_null<const world::Box*>, bool> m_reachable;
-  std::unordered_map<gsl_lite::not_null<const world::Box*>, size_t> m_distances;
-  std::unordered_map<gsl_lite::not_null<const world::Box*>, gsl_lite::not_null<const world::Box*>> m_edges;
+  SearchState m_search;
+  //! @brief Result of #prepareExpansion, invalidated whenever #m_search or the limits change. Kept as a member so
+  //! that its buffers are reused.
+  PreparedExpansion m_prepared;
   //! @brief The target box we need to reach
   const world::Box* m_targetBox = nullptr;
   core::TRVec m_target;
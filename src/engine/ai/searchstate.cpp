@@ -0,0 +1,114 @@
+#include "searchstate.h"
+
+#include "engine/world/boxgraph.h"
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+
+namespace engine::ai
+{
+void SearchState::ExpansionQueue::reset(const size_t capacity)
+{
+  m_ring.resize(std::max<size_t>(capacity, 1));
+  m_head = 0;
+  m_size = 0;
+}
+
+void SearchState::ExpansionQueue::push(const uint32_t box)
+{
+  if(m_size == m_ring.size())
+  {
+    // boxes may be enqueued multiple times, so the initial capacity might not suffice
+    std::rotate(m_ring.begin(), m_ring.begin() + gsl_lite::narrow_cast<std::ptrdiff_t>(m_head), m_ring.end());
+    m_head = 0;
+    m_ring.resize(std::max<size_t>(m_ring.size() * 2, 1));
+  }
+
+  m_ring[(m_head + m_size) % m_ring.size()] = box;
+  ++m_size;
+}
+
+uint32_t SearchState::ExpansionQueue::pop()
+{
+  gsl_Expects(m_size > 0);
+  const auto box = m_ring[m_head];
+  m_head = (m_head + 1) % m_ring.size();
+  --m_size;
+  return box;
+}
+
+void SearchState::reset(const size_t boxCount)
+{
+  expansions.reset(boxCount);
+  queued.assign(boxCount, 0);
+  visited.assign(boxCount, false);
+  reachable.assign(boxCount, false);
+  distances.assign(boxCount, 0);
+  edges.assign(boxCount, world::BoxGraph::NoBox);
+}
+
+void SearchState::reset(const size_t boxCount, const uint32_t target)
+{
+  gsl_Expects(target < boxCount);
+  reset(boxCount);
+  enqueue(target);
+  visited[target] = true;
+  reachable[target] = true;
+}
+
+void SearchState::enqueue(const uint32_t box)
+{
+  expansions.push(box);
+  ++queued[box];
+}
+
+uint32_t SearchState::dequeue()
+{
+  const auto box = expansions.pop();
+  --queued[box];
+  return box;
+}
+
+void SearchState::setReachable(const uint32_t box, const bool isReachable)
+{
+  visited[box] = true;
+  if(isReachable)
+    reachable[box] = true;
+  if(isReachable && queued[box] == 0)
+    enqueue(box);
+}
+
+void SearchState::updateDistance(const uint32_t current, const uint32_t neighbor)
+{
+  const auto newDistance = distances[current] + 1;
+  if(distances[neighbor] <= newDistance)
+    return;
+
+  distances[neighbor] = newDistance;
+  edges[current] = neighbor;
+  enqueue(neighbor);
+}
+
+bool SearchState::updateEdge(const uint32_t current, const uint32_t neighbor)
+{
+  BOOST_ASSERT(visited[current]);
+  if(!reachable[current])
+  {
+    // Propagate "unreachable" to neighbors
+    setReachable(neighbor, false);
+    return true;
+  }
+
+  if(visited[neighbor] && reachable[neighbor])
+  {
+    // Neighbor was already reachable, but we might have found a shorter path.
+    updateDistance(current, neighbor);
+    return true;
+  }
+
+  return false;
+}
+} // namespace engine::ai
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "core/units.h"
+#include "engine/world/box.h"
+#include "engine/world/boxgraph.h"
+
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <vector>
+
+namespace engine::ai
+{
+/**
+ * @brief State of the backwards search from a target box through a world::BoxGraph.
+ *
+ * All per-box state is indexed by the box index within the world::BoxGraph, and sized once when the target box is
+ * set, so expanding the graph usually doesn't allocate.
+ */
+struct SearchState
+{
+  //! @brief FIFO of the box indices to expand, stored as a ring buffer; a box may be enqueued multiple times.
+  class ExpansionQueue
+  {
+  public:
+    void reset(size_t capacity);
+    void push(uint32_t box);
+    uint32_t pop();
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+      return m_size == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] uint32_t at(size_t i) const
+    {
+      gsl_Expects(i < m_size);
+      return m_ring[(m_head + i) % m_ring.size()];
+    }
+
+  private:
+    std::vector<uint32_t> m_ring;
+    size_t m_head = 0;
+    size_t m_size = 0;
+  };
+
+  ExpansionQueue expansions;
+  //! @brief How often each box is contained in #expansions.
+  std::vector<uint32_t> queued;
+  std::vector<bool> visited;
+  //! @brief Only meaningful for visited boxes.
+  std::vector<bool> reachable;
+  //! @brief Only meaningful for reachable boxes.
+  std::vector<uint32_t> distances;
+  //! @brief The next box on the path to the target box, or world::BoxGraph::NoBox.
+  std::vector<uint32_t> edges;
+
+  void reset(size_t boxCount);
+  //! @brief Resets the state and starts a new search from @p target.
+  void reset(size_t boxCount, uint32_t target);
+  void enqueue(uint32_t box);
+  uint32_t dequeue();
+  void setReachable(uint32_t box, bool isReachable);
+  void updateDistance(uint32_t current, uint32_t neighbor);
+  bool updateEdge(uint32_t current, uint32_t neighbor);
+
+  /**
+   * Does up to @p maxExpansions expansions of the path graph and propagates reachability information. A neighbor is
+   * only connected if it's in the same zone, its floor is within @p step and @p drop, and @p canVisit returns
+   * @c true for its box index.
+   */
+  template<typename TCanVisit>
+  void expand(const world::BoxGraph& graph,
+              const std::vector<world::ZoneId>& zones,
+              const core::Length& step,
+              const core::Length& drop,
+              const TCanVisit& canVisit,
+              size_t maxExpansions)
+  {
+    gsl_Expects(zones.size() == graph.size());
+    const auto& floors = graph.getFloors();
+
+    for(size_t i = 0; i < maxExpansions && !expansions.empty(); ++i)
+    {
+      // This does a backwards search from the target (usually Lara) towards the source (the AI entity).
+      // The expansions queue is initialized with the target box.
+
+      const auto current = dequeue();
+      const auto searchZone = zones[current];
+
+      for(const auto neighbor : graph.getOverlaps(current))
+      {
+        if(neighbor == current)
+          continue;
+
+        if(searchZone != zones[neighbor])
+        {
+          setReachable(neighbor, false);
+          continue;
+        }
+
+        if(const auto dy = floors[current] - floors[neighbor]; dy < -step || dy > -drop)
+        {
+          setReachable(neighbor, false);
+          continue;
+        }
+
+        // Update reachability and distance of the neighbor
+        if(updateEdge(current, neighbor))
+          continue;
+
+        const bool isReachable = canVisit(neighbor);
+        if(isReachable)
+        {
+          // Success! Connect both boxes.
+          BOOST_ASSERT_MSG(edges[neighbor] == world::BoxGraph::NoBox, "cycle in pathfinder graph detected");
+          if(edges[neighbor] == world::BoxGraph::NoBox)
+            edges[neighbor] = current;
+          distances[neighbor] = distances[current] + 1;
+        }
+
+        setReachable(neighbor, isReachable);
+      }
+    }
+  }
+};
+} // namespace engine::ai
@@ -30,6 +30,7 @@
 #include "serialization/quantity.h"
 #include "serialization/serialization.h"
 #include "util/helpers.h"
+#include "util/profiler.h"
 #include "world/box.h"
 #include "world/room.h"
 #include "world/sector.h"
@@ -428,6 +429,8 @@ std::unordered_set<const world::Portal*> CameraController::traceWaterSurfacePort
 
 void CameraController::updateGameLogic(const bool inGameCamera)
 {
+  UTIL_PROFILE_ZONE("CameraController::updateGameLogic");
+
   m_previousLocation = m_location;
   m_previousLookAt = m_lookAt;
 
@@ -22,9 +22,10 @@
 #include "util/helpers.h" // IWYU pragma: keep
 #include "world/world.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <gsl-lite/gsl-lite.hpp>
-#include <set>
+#include <optional>
 #include <tuple>
 
 namespace engine
@@ -44,36 +45,6 @@ namespace
   return 1_sectors - (targetInSector - 1_len);
 }
 
-[[nodiscard]] core::BoundingBox
-  rotateTranslate(const core::BoundingBox& bbox, const core::TRVec& pos, const core::Angle& angle)
-{
-  auto result = bbox;
-
-  switch(axisFromAngle(angle))
-  {
-  case core::Axis::Deg0:
-    // nothing to do
-    break;
-  case core::Axis::Right90:
-    result.x = {bbox.z.min, bbox.z.max};
-    result.z = {-bbox.x.max, -bbox.x.min};
-    break;
-  case core::Axis::Deg180:
-    result.x = {-bbox.x.max, -bbox.x.min};
-    result.z = {-bbox.z.max, -bbox.z.min};
-    break;
-  case core::Axis::Left90:
-    result.x = {-bbox.z.max, -bbox.z.min};
-    result.z = {bbox.x.min, bbox.x.max};
-    break;
-  }
-
-  result.x += pos.X;
-  result.y += pos.Y;
-  result.z += pos.Z;
-  return result;
-}
-
 [[nodiscard]] core::Length minShift(const core::Length& min, const core::Length& max) noexcept
 {
   return min < max ? -min : max;
@@ -277,14 +248,21 @@ void CollisionInfo::initHeightInfo(const core::TRVec& laraPos, const world::Worl
   }
 }
 
-std::set<gsl_lite::not_null<const world::Room*>> CollisionInfo::collectTouchingRooms(const core::TRVec& position,
-                                                                                     const core::Length& radius,
-                                                                                     const core::Length& height,
-                                                                                     const world::World& world)
+CollisionInfo::TouchingRooms CollisionInfo::collectTouchingRooms(const core::TRVec& position,
+                                                                 const core::Length& radius,
+                                                                 const core::Length& height,
+                                                                 const world::World& world)
 {
-  std::set<gsl_lite::not_null<const world::Room*>> result;
+  TouchingRooms result;
+  const auto add = [&result](const gsl_lite::not_null<const world::Room*>& room)
+  {
+    // keep the rooms ordered and unique, as the order determines which collision is reported
+    if(const auto it = std::lower_bound(result.begin(), result.end(), room); it == result.end() || *it != room)
+      result.insert(it, room);
+  };
+
   auto room = world.getObjectManager().getLara().m_state.location.room;
-  result.emplace(room);
+  add(room);
 
   const auto roomAt = [position, room](const core::Length& x, const core::Length& y, const core::Length& z)
   {
@@ -293,14 +271,14 @@ std::set<gsl_lite::not_null<const world::Room*>> CollisionInfo::collectTouchingR
     return tmp.room;
   };
 
-  result.emplace(roomAt(radius, 0_len, radius));
-  result.emplace(roomAt(-radius, 0_len, radius));
-  result.emplace(roomAt(radius, 0_len, -radius));
-  result.emplace(roomAt(-radius, 0_len, -radius));
-  result.emplace(roomAt(radius, -height, radius));
-  result.emplace(roomAt(-radius, -height, radius));
-  result.emplace(roomAt(radius, -height, -radius));
-  result.emplace(roomAt(-radius, -height, -radius));
+  add(roomAt(radius, 0_len, radius));
+  add(roomAt(-radius, 0_len, radius));
+  add(roomAt(radius, 0_len, -radius));
+  add(roomAt(-radius, 0_len, -radius));
+  add(roomAt(radius, -height, radius));
+  add(roomAt(-radius, -height, radius));
+  add(roomAt(radius, -height, -radius));
+  add(roomAt(-radius, -height, -radius));
   return result;
 }
 
@@ -319,74 +297,71 @@ bool CollisionInfo::checkStaticMeshCollisions(const core::TRVec& objectPos,
 
   for(const auto& room : rooms)
   {
-    for(const world::RoomStaticMesh& rsm : room->staticMeshes)
-    {
-      if(rsm.staticMesh->doNotCollide)
-        continue;
+    const auto& collisionBoxes = room->staticMeshCollisionBoxes;
+    const auto hit = collisionBoxes.findFirstIntersection(objectBox);
+    if(!hit.has_value())
+      continue;
 
-      const auto meshBox = rotateTranslate(rsm.staticMesh->collisionBox, rsm.position, rsm.rotation);
-      if(!meshBox.intersectsExclusive(objectBox))
-        continue;
+    const auto meshBox = collisionBoxes.getBox(*hit);
 
-      // both collision boxes are in world space
-      shift.X = minShift(objectBox.x.max - meshBox.x.min, meshBox.x.max - objectBox.x.min);
-      shift.Z = minShift(objectBox.z.max - meshBox.z.min, meshBox.z.max - objectBox.z.min);
+    // both collision boxes are in world space
+    shift.X = minShift(objectBox.x.max - meshBox.x.min, meshBox.x.max - objectBox.x.min);
+    shift.Z = minShift(objectBox.z.max - meshBox.z.min, meshBox.z.max - objectBox.z.min);
 
-      switch(facingAxis)
+    switch(facingAxis)
+    {
+    case core::Axis::Deg0:
+      if(abs(shift.X) > collisionRadius)
       {
-      case core::Axis::Deg0:
-        if(abs(shift.X) > collisionRadius)
-        {
-          shift.X = initialPosition.X - objectPos.X;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.Z = 0_len;
-          collisionType = shift.X > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
-        }
-        break;
-      case core::Axis::Deg180:
-        if(abs(shift.X) > collisionRadius)
-        {
-          shift.X = initialPosition.X - objectPos.X;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.Z = 0_len;
-          collisionType = shift.X > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
-        }
-        break;
-      case core::Axis::Right90:
-        if(abs(shift.Z) > collisionRadius)
-        {
-          shift.Z = initialPosition.Z - objectPos.Z;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.X = 0_len;
-          collisionType = shift.Z > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
-        }
-        break;
-      case core::Axis::Left90:
-        if(abs(shift.Z) > collisionRadius)
-        {
-          shift.Z = initialPosition.Z - objectPos.Z;
-          collisionType = AxisColl::Front;
-        }
-        else
-        {
-          shift.X = 0_len;
-          collisionType = shift.Z > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
-        }
-        break;
+        shift.X = initialPosition.X - objectPos.X;
+        collisionType = AxisColl::Front;
       }
-
-      hasStaticMeshCollision = true;
-      return hasStaticMeshCollision;
+      else
+      {
+        shift.Z = 0_len;
+        collisionType = shift.X > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
+      }
+      break;
+    case core::Axis::Deg180:
+      if(abs(shift.X) > collisionRadius)
+      {
+        shift.X = initialPosition.X - objectPos.X;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.Z = 0_len;
+        collisionType = shift.X > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
+      }
+      break;
+    case core::Axis::Right90:
+      if(abs(shift.Z) > collisionRadius)
+      {
+        shift.Z = initialPosition.Z - objectPos.Z;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.X = 0_len;
+        collisionType = shift.Z > 0_len ? AxisColl::FrontRight : AxisColl::FrontLeft;
+      }
+      break;
+    case core::Axis::Left90:
+      if(abs(shift.Z) > collisionRadius)
+      {
+        shift.Z = initialPosition.Z - objectPos.Z;
+        collisionType = AxisColl::Front;
+      }
+      else
+      {
+        shift.X = 0_len;
+        collisionType = shift.Z > 0_len ? AxisColl::FrontLeft : AxisColl::FrontRight;
+      }
+      break;
     }
+
+    hasStaticMeshCollision = true;
+    return hasStaticMeshCollision;
   }
 
   return hasStaticMeshCollision;
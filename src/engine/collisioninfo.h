@@ -7,9 +7,9 @@
 #include "heightinfo.h"
 #include "type_safe/flag_set.hpp"
 
+#include <boost/container/small_vector.hpp>
 #include <cstdint>
 #include <gsl-lite/gsl-lite.hpp> // IWYU pragma: keep
-#include <set>
 
 namespace engine::world
 {
@@ -70,10 +70,13 @@ struct CollisionInfo
 
   void initHeightInfo(const core::TRVec& laraPos, const world::World& world, const core::Length& height);
 
-  static std::set<gsl_lite::not_null<const world::Room*>> collectTouchingRooms(const core::TRVec& position,
-                                                                               const core::Length& radius,
-                                                                               const core::Length& height,
-                                                                               const world::World& world);
+  //! @brief Sorted by address, without duplicates.
+  using TouchingRooms = boost::container::small_vector<gsl_lite::not_null<const world::Room*>, 9>;
+
+  static TouchingRooms collectTouchingRooms(const core::TRVec& position,
+                                            const core::Length& radius,
+                                            const core::Length& height,
+                                            const world::World& world);
 
   bool checkStaticMeshCollisions(const core::TRVec& objectPos,
                                  const core::Length& objectHeight,
@@ -20,6 +20,7 @@
 #include "ghostmanager.h"
 #include "hid/actions.h"
 #include "hid/inputhandler.h"
+#include "inputrecording.h"
 #include "levelloop.h"
 #include "levelloopresult.h"
 #include "loader/trx/trx.h"
@@ -39,8 +40,10 @@
 #include "render/scene/scenegraph.h"
 #include "render/scene/sprite.h"
 #include "render/scene/translucency.h"
+#include "savegameindex.h"
 #include "script/reflection.h"
 #include "script/scriptengine.h"
+#include "serialization/binarydocument.h"
 #include "serialization/serialization.h"
 #include "serialization/yamldocument.h"
 #include "soundeffects_tr1.h"
@@ -52,10 +55,10 @@
 #include "ui/ui.h"
 #include "util/datetime.h"
 #include "util/helpers.h"
+#include "util/profiler.h"
 #include "world/world.h"
 
 #include <algorithm>
-#include <array>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/locale/generator.hpp>
 #include <boost/locale/info.hpp>
@@ -83,13 +86,13 @@
 #include <glm/vec3.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
-#include <ios>
 #include <locale>
 #include <memory>
 #include <optional>
+#include <random>
 #include <ranges>
 #include <set>
-#include <sstream>
+#include <span>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -199,35 +202,30 @@ void updateGhostRoom(const std::vector<world::Room>& rooms,
   }
 }
 
-void updateRemoteGhosts(world::World& world, GhostManager& ghostManager, const network::HauntedCoopClient& coop)
+void updateRemoteGhosts(world::World& world, GhostManager& ghostManager, network::HauntedCoopClient& coop)
 {
-  const auto states = coop.getStates();
-  for(const auto& state : states)
+  const auto& states = coop.getStates();
+  ghosting::GhostFrame ghostFrame;
+  for(const auto& [peerId, stateData] : states)
   {
-    const auto peerId = std::get<0>(state);
-
-    ghosting::GhostFrame ghostFrame;
-    std::string tmp;
-    const auto& dataVec = std::get<1>(state);
-    if(dataVec.empty())
+    if(stateData.empty())
       continue;
 
-    for(const auto v : dataVec)
-      tmp += gsl_lite::narrow_cast<char>(v);
-    std::istringstream stateDataStream{tmp, std::ios::in | std::ios::binary};
-    ghostFrame.read(stateDataStream);
-
-    gsl_Assert(tmp.size() - stateDataStream.tellg() >= 3);
-    std::array<uint8_t, 3> ghostColor{};
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    stateDataStream.read(reinterpret_cast<char*>(ghostColor.data()), ghostColor.size());
-    const auto glColor = gl::SRGB8(ghostColor[0], ghostColor[1], ghostColor[2]);
+    // the frame is followed by the colour and the name of the peer
+    std::span<const uint8_t> data{stateData};
+    if(!ghostFrame.read(data) || data.size() < 4 || data.size() - 4 < data[3])
+    {
+      BOOST_LOG_TRIVIAL(debug) << "Skipping malformed state of coop peer " << peerId;
+      continue;
+    }
 
-    auto ghostUsername = network::io::readPascalString(stateDataStream);
+    const auto glColor = gl::SRGB8(data[0], data[1], data[2]);
+    const auto* ghostUsernameData = &data[3];
 
     auto it = ghostManager.getRemoteModels().find(peerId);
     if(it == ghostManager.getRemoteModels().end())
     {
+      const auto ghostUsername = network::io::readPascalString(ghostUsernameData);
       it = ghostManager.getRemoteModels().emplace(peerId, std::make_shared<ghosting::GhostModel>()).first;
 
       static const glm::ivec2 nameTextureSize{512, 128};
@@ -305,12 +303,14 @@ Engine::Engine(std::filesystem::path userDataPath,
                const std::optional<std::string>& localOverride,
                const std::string& gameflowId,
                const glm::ivec2& resolution,
-               const bool borderlessFullscreen)
+               const bool borderlessFullscreen,
+               const bool headless)
     : m_userDataPath{std::move(userDataPath)}
     , m_engineDataPath{engineDataPath}
     , m_gameflowId{gameflowId}
     , m_scriptEngine{engineDataPath / "gameflows" / gameflowId}
     , m_engineConfig{gsl_lite::make_shared<EngineConfig>()}
+    , m_savegameIndex{std::make_unique<SavegameIndex>(*this)}
 {
   {
     const auto invalid = m_scriptEngine.getGameflow().getInvalidFilepaths(getAssetDataPath());
@@ -340,6 +340,7 @@ Engine::Engine(std::filesystem::path userDataPath,
                                             resolution,
                                             m_engineConfig->renderSettings,
                                             borderlessFullscreen,
+                                            headless,
                                             [this]()
                                             {
                                               return m_throttler.getInterTickFactor();
@@ -374,6 +375,20 @@ std::pair<LevelLoopResult, std::optional<size_t>> Engine::runLevel(world::World&
   applySettings();
   m_throttler.reset();
 
+  const auto rngSeed = std::random_device{}();
+  util::seedRand15(rngSeed);
+  std::unique_ptr<InputRecordingWriter> inputRecorder;
+  if(m_engineConfig->recordInput && world.getGhostFrame() == 0_frame)
+  {
+    // replays always start at the level start, so sessions started from a savegame are not recorded
+    const auto recordingRoot = m_userDataPath / "recordings" / m_gameflowId;
+    std::filesystem::create_directories(recordingRoot);
+    inputRecorder = std::make_unique<InputRecordingWriter>(
+      recordingRoot
+        / (world.getLevelFilename().stem().string() + " " + util::getCurrentHumanReadableTimestamp() + ".input"),
+      rngSeed);
+  }
+
   const auto ghostRoot = m_userDataPath / "ghosts" / m_gameflowId;
   std::filesystem::create_directories(ghostRoot);
   GhostManager ghostManager{ghostRoot / world.getLevelFilename().stem().replace_extension(".rec"), world};
@@ -385,6 +400,8 @@ std::pair<LevelLoopResult, std::optional<size_t>> Engine::runLevel(world::World&
 
   while(true)
   {
+    UTIL_PROFILE_ZONE("frame");
+
     ghostManager.getModel()->setVisible(m_engineConfig->displaySettings.ghost);
     updateRemoteGhosts(world, ghostManager, coop);
     ghostManager.setChildrenVisibility(m_engineConfig->displaySettings.showCoopNames);
@@ -464,27 +481,37 @@ std::pair<LevelLoopResult, std::optional<size_t>> Engine::runLevel(world::World&
 
       if(ghostManager.getReader() != nullptr)
       {
-        ghostManager.getModel()->apply(world, ghostManager.getReader()->read());
+        ghostManager.applyNextFrame(world);
         updateGhostRoom(world.getRooms(), gsl_lite::not_null{ghostManager.getModel()});
       }
 
+      if(inputRecorder != nullptr)
+        inputRecorder->append(m_presenter->getInputHandler().getInputState());
+
       world.getPlayer().timeSpent += 1_frame;
       world.updateGameLogic(godMode);
 
       const auto frame = world.getObjectManager().getLara().getGhostFrame();
 
-      std::ostringstream stateDataStream{std::ios::out | std::ios::binary};
-      frame.write(stateDataStream);
-      std::vector<uint8_t> stateData;
-      for(const auto c : stateDataStream.str())
-        stateData.emplace_back(c);
-      coop.sendState(stateData);
+      if(auto* stateData = coop.beginState(); stateData != nullptr)
+      {
+        frame.write(*stateData);
+        coop.commitState();
+      }
       ghostManager.getWriter()->append(frame);
       world.nextGhostFrame();
     }
 
     if(gameLoop.menu != nullptr)
     {
+      if(inputRecorder != nullptr)
+      {
+        // menus consume random numbers and change the inventory, neither of which is recorded, so the recording ends
+        // with the last tick before the menu; replaying it reproduces the session up to that point
+        BOOST_LOG_TRIVIAL(info) << "Input recording stopped because a menu was opened";
+        inputRecorder.reset();
+      }
+
       if(const auto lara = world.getObjectManager().getLaraPtr(); lara != nullptr)
         lara->m_state.location.room->node->setVisible(true);
 
@@ -515,6 +542,49 @@ std::pair<LevelLoopResult, std::optional<size_t>> Engine::runLevel(world::World&
   }
 }
 
+SimulationStats Engine::simulateLevel(world::World& world,
+                                      const core::Frame maxFrames,
+                                      InputRecordingReader* inputReplay,
+                                      const std::function<void()>& afterFrame)
+{
+  world.getObjectManager().getLara().m_state.health = world.getPlayer().laraHealth;
+  world.getObjectManager().getLara().initWeaponAnimData();
+
+  const bool godMode = m_scriptEngine.getGameflow().isGodMode();
+  const bool allAmmoCheat = m_scriptEngine.getGameflow().hasAllAmmoCheat();
+
+  if(inputReplay != nullptr)
+    util::seedRand15(inputReplay->getRngSeed());
+
+  SimulationStats stats{};
+  const auto start = std::chrono::high_resolution_clock::now();
+  while(stats.frames < maxFrames && !world.levelFinished() && !world.getObjectManager().getLara().isDead())
+  {
+    if(inputReplay != nullptr)
+    {
+      const auto actionStates = inputReplay->read();
+      if(!actionStates.has_value())
+        break;
+      m_presenter->getInputHandler().replay(*actionStates);
+    }
+
+    if(allAmmoCheat)
+      world.getPlayer().getInventory().fillAllAmmo();
+
+    world.getPlayer().timeSpent += 1_frame;
+    world.updateGameLogic(godMode);
+    world.nextGhostFrame();
+    stats.frames += 1_frame;
+
+    if(afterFrame)
+      afterFrame();
+  }
+  stats.duration = std::chrono::high_resolution_clock::now() - start;
+  stats.levelFinished = world.levelFinished();
+  stats.laraDead = world.getObjectManager().getLara().isDead();
+  return stats;
+}
+
 std::pair<LevelLoopResult, std::optional<size_t>> Engine::runCutscene(world::World& world)
 {
   applySettings();
@@ -734,13 +804,17 @@ std::unique_ptr<loader::trx::Glidos> Engine::loadGlidosPack() const
 
 std::optional<SavegameMeta> Engine::getSavegameMeta(const std::filesystem::path& filename) const
 {
+  m_savegameWriter.wait();
   const std::filesystem::path filepath{getSavegameRootPath() / filename};
   if(!std::filesystem::is_regular_file(filepath))
     return std::nullopt;
 
-  serialization::YAMLDocument<true> doc{filepath};
   SavegameMeta meta{};
-  doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
+  serialization::withLoadingDocument(filepath,
+                                     [&meta](auto& doc)
+                                     {
+                                       doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
+                                     });
   return meta;
 }
 
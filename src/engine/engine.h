@@ -1,6 +1,9 @@
 #pragma once
 
+#include "core/magic.h"
+#include "core/units.h"
 #include "gameplayrules.h"
+#include "savegamewriter.h"
 #include "script/scriptengine.h"
 #include "serialization/serialization_fwd.h"
 #include "throttler.h"
@@ -11,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <glm/vec2.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
@@ -39,6 +43,8 @@ namespace engine
 {
 class Player;
 class Presenter;
+class SavegameIndex;
+class InputRecordingReader;
 struct EngineConfig;
 enum class LevelLoopResult : uint8_t;
 
@@ -56,6 +62,14 @@ struct SavegameInfo
   std::filesystem::file_time_type saveTime;
 };
 
+struct SimulationStats
+{
+  core::Frame frames = 0_frame;
+  std::chrono::high_resolution_clock::duration duration{};
+  bool levelFinished = false;
+  bool laraDead = false;
+};
+
 inline std::string makeSavegameFilename(const size_t n)
 {
   return "save_" + std::to_string(n) + ".yaml";
@@ -76,7 +90,8 @@ public:
                   const std::optional<std::string>& localOverride,
                   const std::string& gameflowId,
                   const glm::ivec2& resolution,
-                  bool borderlessFullscreen);
+                  bool borderlessFullscreen,
+                  bool headless);
 
   ~Engine();
 
@@ -95,6 +110,16 @@ public:
   std::pair<LevelLoopResult, std::optional<size_t>> runLevel(world::World& world, bool allowSave);
   std::pair<LevelLoopResult, std::optional<size_t>> runCutscene(world::World& world);
   std::pair<LevelLoopResult, std::optional<size_t>> runTitleMenu(world::World& world);
+  /**
+   * @brief Ticks the game logic as fast as possible, without rendering, audio updates or throttling.
+   * @param maxFrames Upper limit of logic frames to simulate; stops earlier if the level is finished or Lara died.
+   * @param inputReplay If set, provides the random seed and the input per frame; stops at the end of the recording.
+   * @param afterFrame If set, called after each simulated frame.
+   */
+  SimulationStats simulateLevel(world::World& world,
+                                core::Frame maxFrames,
+                                InputRecordingReader* inputReplay,
+                                const std::function<void()>& afterFrame = {});
 
   [[nodiscard]] const std::string& getLocale() const noexcept
   {
@@ -212,6 +237,21 @@ public:
     m_gameplayRules = {};
   }
 
+  [[nodiscard]] auto& getSavegameWriter() noexcept
+  {
+    return m_savegameWriter;
+  }
+
+  [[nodiscard]] const auto& getSavegameWriter() const noexcept
+  {
+    return m_savegameWriter;
+  }
+
+  [[nodiscard]] SavegameIndex& getSavegameIndex() const noexcept
+  {
+    return *m_savegameIndex;
+  }
+
 private:
   std::filesystem::path m_userDataPath;
   std::filesystem::path m_engineDataPath;
@@ -231,5 +271,11 @@ private:
   std::pair<std::filesystem::path, std::shared_ptr<world::WorldGeometry>> m_worldGeometryCache;
 
   Throttler m_throttler;
+
+  // must outlive the savegame writer, which updates it after writing a savegame
+  std::unique_ptr<SavegameIndex> m_savegameIndex;
+
+  // declared last so that pending savegames are written before anything else is torn down
+  SavegameWriter m_savegameWriter;
 };
 } // namespace engine
\ No newline at end of file
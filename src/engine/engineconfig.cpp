@@ -16,6 +16,7 @@
 #include "serialization/serialization.h"
 #include "serialization/variant.h"
 #include "serialization/vector.h"
+#include "util/profiler.h"
 
 #include <functional>
 #include <vector>
@@ -30,9 +31,16 @@ using hid::GlfwAxisDir;
 using hid::GlfwGamepadButton;
 using hid::GlfwKey;
 
+//! The profiler trace is only recorded in builds with ENABLE_PROFILING, so the binding is hidden in all others.
+void addProfilerTraceMapping(std::vector<NamedInputMappingConfig>& mappings)
+{
+  if constexpr(util::profiler::Enabled)
+    mappings.at(0).gameMappings.emplace(GlfwKey::F11, Action::ProfilerTrace);
+}
+
 std::vector<NamedInputMappingConfig> getDefaultModernMappings()
 {
-  return {
+  std::vector<NamedInputMappingConfig> mappings{
     {
       pgettext("Input|MappingName", /* translators: TR charmap encoding */ "Keyboard"),
       "PS",
@@ -105,11 +113,13 @@ std::vector<NamedInputMappingConfig> getDefaultModernMappings()
       },
     },
   };
+  addProfilerTraceMapping(mappings);
+  return mappings;
 }
 
 std::vector<NamedInputMappingConfig> getDefaultClassicMappings()
 {
-  return {
+  std::vector<NamedInputMappingConfig> mappings{
     {
       pgettext("Input|MappingName", /* translators: TR charmap encoding */ "Keyboard"),
       "PS",
@@ -182,6 +192,8 @@ std::vector<NamedInputMappingConfig> getDefaultClassicMappings()
       },
     },
   };
+  addProfilerTraceMapping(mappings);
+  return mappings;
 }
 } // namespace
 
@@ -226,7 +238,9 @@ void EngineConfig::serialize(const serialization::Serializer<EngineConfig>& ser)
       S_NV("delaySaveEnabled", delaySaveEnabled),
       S_NV("delaySaveDurationSeconds", delaySaveDurationSeconds),
       S_NV("mediPackPreservationEnabled", mediPackPreservationEnabled),
-      S_NV("mediPackPreservation", mediPackPreservation));
+      S_NV("mediPackPreservation", mediPackPreservation),
+      S_NV("recordInput", recordInput),
+      S_NV("yamlSavegames", yamlSavegames));
 }
 
 void EngineConfig::deserialize(const serialization::Deserializer<EngineConfig>& ser)
@@ -247,7 +261,9 @@ void EngineConfig::deserialize(const serialization::Deserializer<EngineConfig>&
       S_NVO("delaySaveEnabled", std::ref(delaySaveEnabled)),
       S_NVO("delaySaveDurationSeconds", std::ref(delaySaveDurationSeconds)),
       S_NVO("mediPackPreservationEnabled", std::ref(mediPackPreservationEnabled)),
-      S_NVO("mediPackPreservation", std::ref(mediPackPreservation)));
+      S_NVO("mediPackPreservation", std::ref(mediPackPreservation)),
+      S_NVO("recordInput", std::ref(recordInput)),
+      S_NVO("yamlSavegames", std::ref(yamlSavegames)));
 }
 
 EngineConfig::EngineConfig()
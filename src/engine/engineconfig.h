@@ -68,6 +68,8 @@ struct EngineConfig
   uint8_t delaySaveDurationSeconds = 3;
   bool mediPackPreservationEnabled = false;
   uint8_t mediPackPreservation = 50;
+  bool recordInput = false;
+  bool yamlSavegames = false;
 
   explicit EngineConfig();
 
@@ -4,26 +4,110 @@
 #include "serialization/quantity.h"
 #include "serialization/serialization.h"
 
+#include <algorithm>
 #include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <gsl-lite/gsl-lite.hpp>
+#include <ios>
 #include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <istream>
 #include <memory>
 #include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace engine::ghosting
 {
-constexpr uint32_t DataStreamVersion = 2;
+constexpr uint32_t LegacyDataStreamVersion = 2;
+constexpr uint32_t DataStreamVersion = 3;
 
 namespace
 {
 constexpr int16_t MatrixRotationScale = 32767;
 
-void writeMatrix(std::ostream& s, const glm::mat4& m)
+struct StreamSink
+{
+  std::ostream& s;
+
+  void operator()(const void* data, const size_t size) const
+  {
+    s.write(static_cast<const char*>(data), gsl_lite::narrow<std::streamsize>(size));
+  }
+};
+
+struct BufferSink
+{
+  std::vector<uint8_t>& buffer;
+
+  void operator()(const void* data, const size_t size) const
+  {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+  }
+};
+
+struct StreamSource
+{
+  std::istream& s;
+
+  void operator()(void* data, const size_t size) const
+  {
+    s.read(static_cast<char*>(data), gsl_lite::narrow<std::streamsize>(size));
+  }
+};
+
+struct BufferSource
+{
+  std::span<const uint8_t>& data;
+  //! Set when reading past the end of the data, which yields zeros instead.
+  bool& truncated;
+
+  void operator()(void* dst, const size_t size) const
+  {
+    if(data.size() < size)
+    {
+      truncated = true;
+      data = {};
+      std::memset(dst, 0, size);
+      return;
+    }
+
+    std::memcpy(dst, data.data(), size);
+    data = data.subspan(size);
+  }
+};
+
+template<typename Sink, typename T>
+void put(const Sink& sink, const T& value)
+{
+  sink(&value, sizeof(value));
+}
+
+template<typename T, typename Source>
+[[nodiscard]] T get(const Source& source)
+{
+  T value{};
+  source(&value, sizeof(value));
+  return value;
+}
+
+template<typename Sink>
+void writeMatrix(const Sink& sink, const glm::mat4& m)
 {
   BOOST_ASSERT(m[0][3] == 0);
   BOOST_ASSERT(m[1][3] == 0);
@@ -38,20 +122,18 @@ void writeMatrix(std::ostream& s, const glm::mat4& m)
       {
         BOOST_ASSERT(m[x][y] >= -1.0f);
         BOOST_ASSERT(m[x][y] <= 1.0f);
-        auto scaled = gsl_lite::narrow_cast<int16_t>(m[x][y] * MatrixRotationScale);
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.write(reinterpret_cast<const char*>(&scaled), sizeof(scaled));
+        put(sink, gsl_lite::narrow_cast<int16_t>(m[x][y] * MatrixRotationScale));
       }
       else
       {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.write(reinterpret_cast<const char*>(&m[x][y]), sizeof(m[x][y]));
+        put(sink, m[x][y]);
       }
     }
   }
 }
 
-[[nodiscard]] glm::mat4 readMatrix(std::istream& s)
+template<typename Source>
+[[nodiscard]] glm::mat4 readMatrix(const Source& source)
 {
   glm::mat4 m{1.0f};
   for(int x = 0; x < 4; ++x)
@@ -59,52 +141,191 @@ void writeMatrix(std::ostream& s, const glm::mat4& m)
     for(int y = 0; y < 3; ++y)
     {
       if(x != 3)
-      {
-        int16_t scaled = 0;
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.read(reinterpret_cast<char*>(&scaled), sizeof(scaled));
-        m[x][y] = static_cast<float>(scaled) / MatrixRotationScale;
-      }
+        m[x][y] = static_cast<float>(get<int16_t>(source)) / MatrixRotationScale;
       else
-      {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.read(reinterpret_cast<char*>(&m[x][y]), sizeof(m[x][y]));
-      }
+        m[x][y] = get<float>(source);
     }
   }
   return m;
 }
+
+template<typename Sink>
+void writeBone(const Sink& sink, const GhostFrame::BoneData& bone)
+{
+  writeMatrix(sink, bone.matrix);
+  put(sink, bone.meshIdx);
+  put(sink, static_cast<uint8_t>(bone.visible ? 1 : 0));
+}
+
+template<typename Source>
+void readBone(const Source& source, GhostFrame::BoneData& bone)
+{
+  bone.matrix = readMatrix(source);
+  bone.meshIdx = get<uint16_t>(source);
+  bone.visible = get<uint8_t>(source) != 0;
+}
+
+template<typename Sink>
+void writeFrame(const Sink& sink, const GhostFrame& frame)
+{
+  put(sink, gsl_lite::narrow<uint8_t>(frame.bones.size()));
+  for(const auto& bone : frame.bones)
+    writeBone(sink, bone);
+
+  put(sink, frame.roomId);
+  writeMatrix(sink, frame.modelMatrix);
+}
+
+template<typename Source>
+void readFrame(const Source& source, GhostFrame& frame)
+{
+  frame.bones.resize(get<uint8_t>(source));
+  for(auto& bone : frame.bones)
+    readBone(source, bone);
+
+  frame.roomId = get<uint16_t>(source);
+  frame.modelMatrix = readMatrix(source);
+}
+
+constexpr float QuaternionScale = 32767;
+constexpr float TranslationScale = 16;
+constexpr uint32_t KeyframeInterval = 300;
+// "GIDX"
+constexpr uint32_t IndexMagic = 0x58444947u;
+
+enum class RecordType : uint8_t
+{
+  Delta = 0,
+  Keyframe = 1,
+  Index = 2,
+};
+
+// quantized frame layout: room id and model transform, followed by the mesh and transform of each bone
+constexpr size_t TransformValues = 7;
+constexpr size_t FrameHeaderValues = 1 + TransformValues;
+constexpr size_t BoneValues = 1 + TransformValues;
+
+void quantizeTransform(const glm::mat4& m, const int32_t* previous, int32_t* values)
+{
+  auto q = glm::quat_cast(glm::mat3{m});
+  // q and -q are the same rotation, pick the one closer to the previous frame to keep the deltas small
+  const auto dot = previous == nullptr ? q.w
+                                       : static_cast<float>(previous[0]) * q.x + static_cast<float>(previous[1]) * q.y
+                                           + static_cast<float>(previous[2]) * q.z + static_cast<float>(previous[3]) * q.w;
+  if(dot < 0)
+    q = -q;
+
+  values[0] = static_cast<int32_t>(std::lround(q.x * QuaternionScale));
+  values[1] = static_cast<int32_t>(std::lround(q.y * QuaternionScale));
+  values[2] = static_cast<int32_t>(std::lround(q.z * QuaternionScale));
+  values[3] = static_cast<int32_t>(std::lround(q.w * QuaternionScale));
+  for(int i = 0; i < 3; ++i)
+    values[4 + i] = static_cast<int32_t>(std::lround(m[3][i] * TranslationScale));
+}
+
+[[nodiscard]] glm::mat4 dequantizeTransform(const int32_t* values)
+{
+  const glm::quat q{static_cast<float>(values[3]),
+                    static_cast<float>(values[0]),
+                    static_cast<float>(values[1]),
+                    static_cast<float>(values[2])};
+  auto m = glm::mat4_cast(glm::normalize(q));
+  m[3] = glm::vec4{glm::vec3{static_cast<float>(values[4]), static_cast<float>(values[5]), static_cast<float>(values[6])}
+                     / TranslationScale,
+                   1.0f};
+  return m;
+}
+
+void quantizeFrame(const GhostFrame& frame, const std::vector<int32_t>& previous, std::vector<int32_t>& values)
+{
+  values.resize(FrameHeaderValues + frame.bones.size() * BoneValues);
+  const bool hasPrevious = previous.size() == values.size();
+
+  values[0] = frame.roomId;
+  quantizeTransform(frame.modelMatrix, hasPrevious ? &previous[1] : nullptr, &values[1]);
+  for(size_t i = 0; i < frame.bones.size(); ++i)
+  {
+    const auto& bone = frame.bones[i];
+    const auto base = FrameHeaderValues + i * BoneValues;
+    values[base] = (static_cast<int32_t>(bone.meshIdx) << 1) | (bone.visible ? 1 : 0);
+    quantizeTransform(bone.matrix, hasPrevious ? &previous[base + 1] : nullptr, &values[base + 1]);
+  }
+}
+
+void dequantizeFrame(const std::vector<int32_t>& values, GhostFrame& frame)
+{
+  frame.roomId = gsl_lite::narrow_cast<uint16_t>(values[0]);
+  frame.modelMatrix = dequantizeTransform(&values[1]);
+  frame.bones.resize((values.size() - FrameHeaderValues) / BoneValues);
+  for(size_t i = 0; i < frame.bones.size(); ++i)
+  {
+    auto& bone = frame.bones[i];
+    const auto base = FrameHeaderValues + i * BoneValues;
+    bone.meshIdx = gsl_lite::narrow_cast<uint16_t>(values[base] >> 1);
+    bone.visible = (values[base] & 1) != 0;
+    bone.matrix = dequantizeTransform(&values[base + 1]);
+  }
+}
+
+void writeVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+  while(value >= 0x80u)
+  {
+    buffer.emplace_back(static_cast<uint8_t>(value | 0x80u));
+    value >>= 7u;
+  }
+  buffer.emplace_back(static_cast<uint8_t>(value));
+}
+
+[[nodiscard]] uint64_t readVarint(std::span<const uint8_t>& data)
+{
+  uint64_t value = 0;
+  for(uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    if(data.empty())
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of ghost data"));
+
+    const auto byte = data.front();
+    data = data.subspan(1);
+    value |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+    if((byte & 0x80u) == 0)
+      return value;
+  }
+  BOOST_THROW_EXCEPTION(std::runtime_error("invalid varint in ghost data"));
+}
+
+[[nodiscard]] uint64_t zigzagEncode(const int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1u) ^ static_cast<uint64_t>(value >> 63);
+}
+
+[[nodiscard]] int64_t zigzagDecode(const uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1u) ^ -static_cast<int64_t>(value & 1u);
+}
 } // namespace
 
 void GhostFrame::write(std::ostream& s) const
 {
-  const auto size = gsl_lite::narrow<uint8_t>(bones.size());
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&size), sizeof(size));
-  for(const auto& bone : bones)
-    bone.write(s);
-
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&roomId), sizeof(roomId));
+  writeFrame(StreamSink{s}, *this);
+}
 
-  writeMatrix(s, modelMatrix);
+void GhostFrame::write(std::vector<uint8_t>& buffer) const
+{
+  writeFrame(BufferSink{buffer}, *this);
 }
 
 void GhostFrame::read(std::istream& s)
 {
   BOOST_ASSERT(!s.eof());
+  readFrame(StreamSource{s}, *this);
+}
 
-  uint8_t size = 0;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.read(reinterpret_cast<char*>(&size), sizeof(size));
-  bones.resize(size);
-  for(auto& bone : bones)
-    bone.read(s);
-
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.read(reinterpret_cast<char*>(&roomId), sizeof(roomId));
-
-  modelMatrix = readMatrix(s);
+bool GhostFrame::read(std::span<const uint8_t>& data)
+{
+  bool truncated = false;
+  readFrame(BufferSource{data, truncated}, *this);
+  return !truncated;
 }
 
 GhostDataWriter::GhostDataWriter(const std::filesystem::path& path)
@@ -114,12 +335,43 @@ GhostDataWriter::GhostDataWriter(const std::filesystem::path& path)
   m_file->write(reinterpret_cast<const char*>(&DataStreamVersion), sizeof(DataStreamVersion));
 }
 
-GhostDataWriter::~GhostDataWriter() = default;
+GhostDataWriter::~GhostDataWriter()
+{
+  const auto indexOffset = gsl_lite::narrow<uint64_t>(static_cast<std::streamoff>(m_file->tellp()));
+  put(StreamSink{*m_file}, RecordType::Index);
+  put(StreamSink{*m_file}, gsl_lite::narrow<uint32_t>(m_keyframes.size()));
+  for(const auto& [frame, offset] : m_keyframes)
+  {
+    put(StreamSink{*m_file}, frame);
+    put(StreamSink{*m_file}, offset);
+  }
+  put(StreamSink{*m_file}, indexOffset);
+  put(StreamSink{*m_file}, IndexMagic);
+}
 
-// ReSharper disable once CppMemberFunctionMayBeConst
 void GhostDataWriter::append(const GhostFrame& frame)
 {
-  frame.write(*m_file);
+  quantizeFrame(frame, m_previous, m_current);
+
+  const bool isKeyframe = m_frameCount % KeyframeInterval == 0 || m_previous.size() != m_current.size();
+  if(isKeyframe)
+  {
+    m_keyframes.emplace_back(m_frameCount, gsl_lite::narrow<uint64_t>(static_cast<std::streamoff>(m_file->tellp())));
+    m_previous.assign(m_current.size(), 0);
+  }
+
+  m_buffer.clear();
+  writeVarint(m_buffer, frame.bones.size());
+  for(size_t i = 0; i < m_current.size(); ++i)
+    writeVarint(m_buffer, zigzagEncode(int64_t{m_current[i]} - m_previous[i]));
+
+  const StreamSink sink{*m_file};
+  put(sink, isKeyframe ? RecordType::Keyframe : RecordType::Delta);
+  put(sink, gsl_lite::narrow<uint32_t>(m_buffer.size()));
+  sink(m_buffer.data(), m_buffer.size());
+
+  std::swap(m_previous, m_current);
+  ++m_frameCount;
 }
 
 GhostDataReader::GhostDataReader(const std::filesystem::path& path)
@@ -128,46 +380,159 @@ GhostDataReader::GhostDataReader(const std::filesystem::path& path)
   uint32_t version = 0;
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
   m_file->read(reinterpret_cast<char*>(&version), sizeof(version));
-  if(version != DataStreamVersion)
+  if(!*m_file || (version != DataStreamVersion && version != LegacyDataStreamVersion))
   {
     m_file.reset();
+    return;
   }
+
+  m_version = version;
+  m_dataBegin = m_file->tellg();
+  m_file->seekg(0, std::ios::end);
+  m_dataEnd = m_file->tellg();
+  if(m_version == DataStreamVersion)
+    readIndex();
+  m_file->seekg(m_dataBegin);
 }
 
 GhostDataReader::~GhostDataReader() = default;
 
-// ReSharper disable once CppMemberFunctionMayBeConst
-GhostFrame GhostDataReader::read()
+void GhostDataReader::readIndex()
+{
+  // the index is missing if the writer didn't shut down cleanly, which only disables fast seeking
+  static constexpr auto TrailerSize = static_cast<std::streamoff>(sizeof(uint64_t) + sizeof(uint32_t));
+  if(m_dataEnd - m_dataBegin < TrailerSize)
+    return;
+
+  const StreamSource source{*m_file};
+  m_file->seekg(m_dataEnd - TrailerSize);
+  const auto indexOffset = get<uint64_t>(source);
+  if(get<uint32_t>(source) != IndexMagic || indexOffset < static_cast<uint64_t>(m_dataBegin)
+     || indexOffset >= static_cast<uint64_t>(m_dataEnd - TrailerSize))
+  {
+    m_file->clear();
+    return;
+  }
+
+  m_file->seekg(static_cast<std::streamoff>(indexOffset));
+  if(get<RecordType>(source) != RecordType::Index)
+  {
+    m_file->clear();
+    return;
+  }
+
+  m_keyframes.resize(get<uint32_t>(source));
+  for(auto& [frame, offset] : m_keyframes)
+  {
+    frame = get<uint32_t>(source);
+    offset = get<uint64_t>(source);
+  }
+
+  if(!*m_file)
+  {
+    m_file->clear();
+    m_keyframes.clear();
+    return;
+  }
+
+  m_dataEnd = static_cast<std::streamoff>(indexOffset);
+}
+
+bool GhostDataReader::readRecord()
+{
+  if(m_file->tellg() >= m_dataEnd)
+    return false;
+
+  const StreamSource source{*m_file};
+  const auto type = get<RecordType>(source);
+  m_buffer.resize(get<uint32_t>(source));
+  source(m_buffer.data(), m_buffer.size());
+  if(!*m_file || (type != RecordType::Keyframe && type != RecordType::Delta))
+    return false;
+
+  std::span<const uint8_t> data{m_buffer};
+  const auto boneCount = readVarint(data);
+  if(boneCount > std::numeric_limits<uint8_t>::max())
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid bone count in ghost data"));
+
+  const auto valueCount = FrameHeaderValues + boneCount * BoneValues;
+  if(type == RecordType::Keyframe)
+    m_state.assign(valueCount, 0);
+  else if(m_state.size() != valueCount)
+    BOOST_THROW_EXCEPTION(std::runtime_error("ghost delta frame does not match the previous frame"));
+
+  for(auto& value : m_state)
+    value = gsl_lite::narrow_cast<int32_t>(value + zigzagDecode(readVarint(data)));
+
+  dequantizeFrame(m_state, m_frame);
+  return true;
+}
+
+const GhostFrame& GhostDataReader::read()
 {
-  GhostFrame result;
   if(m_file != nullptr && !m_file->eof())
   {
-    result.read(*m_file);
+    if(m_version == LegacyDataStreamVersion)
+    {
+      m_frame.read(*m_file);
+      ++m_frameIndex;
+      return m_frame;
+    }
+
+    if(readRecord())
+    {
+      ++m_frameIndex;
+      return m_frame;
+    }
+  }
+
+  m_frame.roomId = 0;
+  m_frame.modelMatrix = glm::mat4{1.0f};
+  m_frame.bones.clear();
+  return m_frame;
+}
+
+void GhostDataReader::seek(const core::Frame frame)
+{
+  if(m_file == nullptr)
+    return;
+
+  const auto target = gsl_lite::narrow<uint32_t>(frame.get());
+  m_file->clear();
+  m_file->seekg(m_dataBegin);
+  m_frameIndex = 0;
+  m_state.clear();
+
+  const auto keyframe = std::upper_bound(m_keyframes.begin(),
+                                         m_keyframes.end(),
+                                         target,
+                                         [](const uint32_t value, const std::pair<uint32_t, uint64_t>& entry)
+                                         {
+                                           return value < entry.first;
+                                         });
+  if(keyframe != m_keyframes.begin())
+  {
+    m_frameIndex = std::prev(keyframe)->first;
+    m_file->seekg(static_cast<std::streamoff>(std::prev(keyframe)->second));
+  }
+
+  while(m_frameIndex < target)
+  {
+    const auto previousIndex = m_frameIndex;
+    (void)read();
+    if(m_frameIndex == previousIndex)
+      break;
   }
-  return result;
 }
 
 void GhostFrame::BoneData::write(std::ostream& s) const
 {
-  writeMatrix(s, matrix);
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&meshIdx), sizeof(meshIdx));
-
-  const uint8_t tmp = visible ? 1 : 0;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&tmp), sizeof(tmp));
+  writeBone(StreamSink{s}, *this);
 }
 
 void GhostFrame::BoneData::read(std::istream& s)
 {
-  matrix = readMatrix(s);
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.read(reinterpret_cast<char*>(&meshIdx), sizeof(meshIdx));
-
-  uint8_t tmp = 0;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.read(reinterpret_cast<char*>(&tmp), sizeof(tmp));
-  visible = tmp != 0;
+  readBone(StreamSource{s}, *this);
 }
 
 void GhostMeta::serialize(const serialization::Serializer<GhostMeta>& ser) const
@@ -8,9 +8,12 @@
 #include <cstdint>
 #include <filesystem>
 #include <glm/mat4x4.hpp>
+#include <ios>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace engine::ghosting
@@ -46,8 +49,25 @@ struct GhostFrame
 
   void write(std::ostream& s) const;
   void read(std::istream& s);
+
+  /**
+   * @brief Appends the same encoding as write(std::ostream&) to @a buffer.
+   */
+  void write(std::vector<uint8_t>& buffer) const;
+  /**
+   * @brief Decodes a frame from the front of @a data and advances it past the consumed bytes.
+   * @returns false if @a data ends before the frame does; the frame's contents are unspecified then.
+   */
+  [[nodiscard]] bool read(std::span<const uint8_t>& data);
 };
 
+/**
+ * @brief Writes ghost recordings.
+ *
+ * Frames are stored as quantized rotation quaternions and translations, delta encoded against the previous frame.
+ * Every few seconds a keyframe is written which doesn't depend on earlier frames; their positions are appended as an
+ * index when the writer is destroyed.
+ */
 class GhostDataWriter
 {
 public:
@@ -58,15 +78,34 @@ public:
 
 private:
   std::unique_ptr<std::ostream> m_file;
+  uint32_t m_frameCount = 0;
+  std::vector<int32_t> m_previous;
+  std::vector<int32_t> m_current;
+  std::vector<uint8_t> m_buffer;
+  //! @brief Frame number and file offset of each keyframe.
+  std::vector<std::pair<uint32_t, uint64_t>> m_keyframes;
 };
 
+/**
+ * @brief Reads ghost recordings of the current and the previous format.
+ */
 class GhostDataReader
 {
 public:
   explicit GhostDataReader(const std::filesystem::path& path);
   ~GhostDataReader();
 
-  [[nodiscard]] GhostFrame read();
+  /**
+   * @brief Decodes the next frame, or returns an empty frame at the end of the recording.
+   *
+   * The returned frame is reused by the next call, so reading doesn't allocate once the reader is warmed up.
+   */
+  [[nodiscard]] const GhostFrame& read();
+
+  /**
+   * @brief Positions the reader so that the next read() returns frame @a frame.
+   */
+  void seek(core::Frame frame);
 
   [[nodiscard]] bool isOpen() const noexcept
   {
@@ -75,5 +114,16 @@ public:
 
 private:
   std::unique_ptr<std::istream> m_file;
+  uint32_t m_version = 0;
+  std::streamoff m_dataBegin = 0;
+  std::streamoff m_dataEnd = 0;
+  uint32_t m_frameIndex = 0;
+  GhostFrame m_frame;
+  std::vector<int32_t> m_state;
+  std::vector<uint8_t> m_buffer;
+  std::vector<std::pair<uint32_t, uint64_t>> m_keyframes;
+
+  void readIndex();
+  [[nodiscard]] bool readRecord();
 };
 } // namespace engine::ghosting
\ No newline at end of file
@@ -0,0 +1,298 @@
+#define BOOST_TEST_MODULE engine_ghosting
+
+#include "engine/ghosting/ghost.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <glm/mat4x4.hpp>
+#include <ios>
+#include <span>
+#include <vector>
+
+namespace
+{
+using engine::ghosting::GhostDataReader;
+using engine::ghosting::GhostDataWriter;
+using engine::ghosting::GhostFrame;
+
+//! Spans several keyframe intervals.
+constexpr size_t FrameCount = 700;
+constexpr size_t BoneCount = 15;
+
+//! @brief A rotation around the y axis by @a angle radians, moved to @a x, @a y and @a z.
+glm::mat4 transform(const float angle, const float x, const float y, const float z)
+{
+  glm::mat4 m{1.0f};
+  m[0][0] = std::cos(angle);
+  m[0][2] = -std::sin(angle);
+  m[2][0] = std::sin(angle);
+  m[2][2] = std::cos(angle);
+  m[3][0] = x;
+  m[3][1] = y;
+  m[3][2] = z;
+  return m;
+}
+
+GhostFrame createFrame(const size_t boneCount, const float time)
+{
+  GhostFrame frame;
+  frame.roomId = 7;
+  frame.modelMatrix = transform(time, 1024.0f + time * 16, -512.0f, 2048.0f);
+  for(size_t i = 0; i < boneCount; ++i)
+  {
+    const auto offset = static_cast<float>(i);
+    frame.bones.emplace_back(GhostFrame::BoneData{
+      transform(time + offset, offset * 100, offset * -50, time), static_cast<uint16_t>(i), i % 2 == 0});
+  }
+  return frame;
+}
+std::vector<GhostFrame> createRecording()
+{
+  std::vector<GhostFrame> frames;
+  for(size_t i = 0; i < FrameCount; ++i)
+    frames.emplace_back(createFrame(BoneCount, static_cast<float>(i) / 30));
+  return frames;
+}
+
+class TempFile final
+{
+public:
+  explicit TempFile(const char* name)
+      : m_path{std::filesystem::temp_directory_path() / name}
+  {
+  }
+
+  TempFile(const TempFile&) = delete;
+  TempFile(TempFile&&) = delete;
+  TempFile& operator=(const TempFile&) = delete;
+  TempFile& operator=(TempFile&&) = delete;
+
+  ~TempFile()
+  {
+    std::error_code ec;
+    std::filesystem::remove(m_path, ec);
+  }
+
+  [[nodiscard]] const auto& getPath() const
+  {
+    return m_path;
+  }
+
+private:
+  std::filesystem::path m_path;
+};
+
+void writeRecording(const std::filesystem::path& path, const std::vector<GhostFrame>& frames)
+{
+  GhostDataWriter writer{path};
+  for(const auto& frame : frames)
+    writer.append(frame);
+}
+
+void writeLegacyRecording(const std::filesystem::path& path, const std::vector<GhostFrame>& frames)
+{
+  static constexpr uint32_t LegacyDataStreamVersion = 2;
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.write(reinterpret_cast<const char*>(&LegacyDataStreamVersion), sizeof(LegacyDataStreamVersion));
+  for(const auto& frame : frames)
+    frame.write(file);
+}
+
+std::vector<GhostFrame> readRecording(const std::filesystem::path& path)
+{
+  GhostDataReader reader{path};
+  BOOST_REQUIRE(reader.isOpen());
+  std::vector<GhostFrame> frames;
+  while(true)
+  {
+    const auto& frame = reader.read();
+    if(frame.bones.empty())
+      break;
+    frames.emplace_back(frame);
+  }
+  return frames;
+}
+
+void checkClose(const glm::mat4& actual,
+                const glm::mat4& expected,
+                const float rotationTolerance,
+                const float translationTolerance)
+{
+  for(int x = 0; x < 4; ++x)
+  {
+    const auto tolerance = x == 3 ? translationTolerance : rotationTolerance;
+    for(int y = 0; y < 4; ++y)
+      BOOST_CHECK_SMALL(actual[x][y] - expected[x][y], tolerance);
+  }
+}
+
+void checkClose(const std::vector<GhostFrame>& actual,
+                const std::vector<GhostFrame>& expected,
+                const float rotationTolerance,
+                const float translationTolerance)
+{
+  BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+  for(size_t i = 0; i < actual.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(actual[i].roomId, expected[i].roomId);
+    checkClose(actual[i].modelMatrix, expected[i].modelMatrix, rotationTolerance, translationTolerance);
+    BOOST_REQUIRE_EQUAL(actual[i].bones.size(), expected[i].bones.size());
+    for(size_t j = 0; j < actual[i].bones.size(); ++j)
+    {
+      BOOST_CHECK_EQUAL(actual[i].bones[j].meshIdx, expected[i].bones[j].meshIdx);
+      BOOST_CHECK_EQUAL(actual[i].bones[j].visible, expected[i].bones[j].visible);
+      checkClose(actual[i].bones[j].matrix, expected[i].bones[j].matrix, rotationTolerance, translationTolerance);
+    }
+  }
+}
+
+//! @brief Checks that seeking to any frame yields the same frames as reading from the start.
+void checkSeeking(const std::filesystem::path& path)
+{
+  const auto sequential = readRecording(path);
+  BOOST_REQUIRE_EQUAL(sequential.size(), FrameCount);
+
+  GhostDataReader reader{path};
+  BOOST_REQUIRE(reader.isOpen());
+  // backwards and forwards across the keyframes
+  for(const size_t frame : {650u, 0u, 299u, 300u, 301u, 1u, 599u, 600u, 699u, 150u})
+  {
+    reader.seek(core::Frame{static_cast<core::Frame::type>(frame)});
+    for(size_t i = frame; i < std::min(frame + 3, FrameCount); ++i)
+    {
+      const auto& decoded = reader.read();
+      BOOST_CHECK(decoded.roomId == sequential[i].roomId);
+      BOOST_CHECK(decoded.modelMatrix == sequential[i].modelMatrix);
+      BOOST_REQUIRE_EQUAL(decoded.bones.size(), sequential[i].bones.size());
+      for(size_t j = 0; j < decoded.bones.size(); ++j)
+        BOOST_CHECK(decoded.bones[j].matrix == sequential[i].bones[j].matrix);
+    }
+  }
+
+  reader.seek(core::Frame{static_cast<core::Frame::type>(FrameCount)});
+  BOOST_CHECK(reader.read().bones.empty());
+}
+
+//! @brief Removes the last @a size bytes of the file at @a path.
+void truncate(const std::filesystem::path& path, const std::uintmax_t size)
+{
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - size);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ghost_frame_tests)
+
+BOOST_AUTO_TEST_CASE(test_buffer_round_trip)
+{
+  const auto frame = createFrame(15, 0.5f);
+  std::vector<uint8_t> buffer;
+  frame.write(buffer);
+  // data following the frame is left alone
+  buffer.emplace_back(42);
+
+  std::span<const uint8_t> data{buffer};
+  GhostFrame decoded;
+  BOOST_REQUIRE(decoded.read(data));
+  BOOST_REQUIRE_EQUAL(data.size(), 1);
+  BOOST_CHECK_EQUAL(data[0], 42);
+  BOOST_CHECK_EQUAL(decoded.roomId, frame.roomId);
+  BOOST_REQUIRE_EQUAL(decoded.bones.size(), frame.bones.size());
+  for(size_t i = 0; i < frame.bones.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(decoded.bones[i].meshIdx, frame.bones[i].meshIdx);
+    BOOST_CHECK_EQUAL(decoded.bones[i].visible, frame.bones[i].visible);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_truncated_buffer_fails)
+{
+  const auto frame = createFrame(15, 0.5f);
+  std::vector<uint8_t> buffer;
+  frame.write(buffer);
+
+  GhostFrame decoded;
+  for(size_t size = 0; size < buffer.size(); ++size)
+  {
+    std::span<const uint8_t> data{buffer.data(), size};
+    BOOST_CHECK(!decoded.read(data));
+    BOOST_CHECK(data.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_bone_count_beyond_buffer_fails)
+{
+  // a malformed frame announcing more bones than it contains
+  const std::vector<uint8_t> buffer{255, 1, 2, 3, 4, 5, 6, 7, 8};
+  std::span<const uint8_t> data{buffer};
+  GhostFrame decoded;
+  BOOST_CHECK(!decoded.read(data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ghost_data_tests)
+
+BOOST_AUTO_TEST_CASE(test_round_trip)
+{
+  const TempFile file{"croftengine-test-ghost-round-trip.bin"};
+  const auto frames = createRecording();
+  writeRecording(file.getPath(), frames);
+
+  // quaternion components are stored with 15 bits, translations in 1/16 units
+  checkClose(readRecording(file.getPath()), frames, 1e-3f, 1.0f / 32);
+}
+
+BOOST_AUTO_TEST_CASE(test_changing_bone_count)
+{
+  const TempFile file{"croftengine-test-ghost-bone-count.bin"};
+  std::vector<GhostFrame> frames;
+  for(size_t i = 0; i < 10; ++i)
+    frames.emplace_back(createFrame(i < 5 ? BoneCount : 3, static_cast<float>(i) / 30));
+  writeRecording(file.getPath(), frames);
+
+  checkClose(readRecording(file.getPath()), frames, 1e-3f, 1.0f / 32);
+}
+
+BOOST_AUTO_TEST_CASE(test_seek)
+{
+  const TempFile file{"croftengine-test-ghost-seek.bin"};
+  writeRecording(file.getPath(), createRecording());
+  checkSeeking(file.getPath());
+}
+
+BOOST_AUTO_TEST_CASE(test_seek_without_index)
+{
+  const TempFile file{"croftengine-test-ghost-seek-without-index.bin"};
+  writeRecording(file.getPath(), createRecording());
+  // the trailer pointing to the index is an offset and a magic number
+  truncate(file.getPath(), sizeof(uint64_t) + sizeof(uint32_t));
+  checkSeeking(file.getPath());
+}
+
+BOOST_AUTO_TEST_CASE(test_seek_with_truncated_index)
+{
+  const TempFile file{"croftengine-test-ghost-seek-truncated-index.bin"};
+  writeRecording(file.getPath(), createRecording());
+  truncate(file.getPath(), 5);
+  checkSeeking(file.getPath());
+}
+
+BOOST_AUTO_TEST_CASE(test_read_legacy)
+{
+  const TempFile file{"croftengine-test-ghost-legacy.bin"};
+  const auto frames = createRecording();
+  writeLegacyRecording(file.getPath(), frames);
+
+  // rotations are stored as 16 bit fixed point, translations as floats
+  checkClose(readRecording(file.getPath()), frames, 1e-4f, 1e-6f);
+  checkSeeking(file.getPath());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,7 @@
 #include "writeonlyxzarchive.h"
 
 #include <boost/log/trivial.hpp>
+#include <exception>
 #include <filesystem>
 #include <gsl-lite/gsl-lite.hpp>
 #include <memory>
@@ -49,20 +50,46 @@ GhostManager::GhostManager(const std::filesystem::path& recordingPath, world::Wo
     if(!m_reader->isOpen())
       m_reader.reset();
   }
+
+  auto i = 0_frame;
   if(m_reader != nullptr)
   {
-    for(auto i = 0_frame; i < world.getGhostFrame(); i += 1_frame)
+    try
     {
-      m_writer->append(m_reader->read());
+      for(; i < world.getGhostFrame(); i += 1_frame)
+      {
+        m_writer->append(m_reader->read());
+      }
     }
-  }
-  else
-  {
-    for(auto i = 0_frame; i < world.getGhostFrame(); i += 1_frame)
+    catch(const std::exception& ex)
     {
-      m_writer->append({});
+      BOOST_LOG_TRIVIAL(error) << "Failed to read ghost data from " << m_readerPath << ": " << ex.what();
+      m_reader.reset();
     }
   }
+
+  for(; i < world.getGhostFrame(); i += 1_frame)
+  {
+    m_writer->append({});
+  }
+}
+
+void GhostManager::applyNextFrame(world::World& world)
+{
+  if(m_reader == nullptr)
+    return;
+
+  try
+  {
+    m_model->apply(world, m_reader->read());
+  }
+  catch(const std::exception& ex)
+  {
+    // a corrupt recording only stops the ghost, not the game
+    BOOST_LOG_TRIVIAL(error) << "Failed to replay ghost data from " << m_readerPath << ": " << ex.what();
+    m_reader.reset();
+    m_model->apply(world, {});
+  }
 }
 
 GhostManager::~GhostManager()
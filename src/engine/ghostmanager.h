@@ -57,6 +57,13 @@ public:
 
   void setChildrenVisibility(bool visible);
 
+  /**
+   * @brief Applies the next frame of the recorded ghost to the ghost model, if there is a recorded ghost.
+   *
+   * If the recording can't be read, the ghost is stopped and hidden for the rest of the level.
+   */
+  void applyNextFrame(world::World& world);
+
 private:
   std::shared_ptr<ghosting::GhostModel> m_model;
   std::map<uint64_t, std::shared_ptr<ghosting::GhostModel>> m_remoteModels;
@@ -19,12 +19,130 @@
 
 namespace engine
 {
+namespace
+{
+void applyFloorSlant(HeightInfo& hi,
+                     const core::Length::type xSlant,
+                     const core::Length::type zSlant,
+                     const core::TRVec& pos)
+{
+  const core::Length::type absX = std::abs(xSlant);
+  if(const core::Length::type absZ = std::abs(zSlant); !HeightInfo::skipSteepSlants || (absX <= 2 && absZ <= 2))
+  {
+    if(absX <= 2 && absZ <= 2)
+      hi.slantClass = SlantClass::Max512;
+    else
+      hi.slantClass = SlantClass::Steep;
+
+    const auto localX = toSectorLocal(pos.X);
+    const auto localZ = toSectorLocal(pos.Z);
+
+    if(zSlant > 0) // lower edge at -Z
+    {
+      const auto dist = 1_sectors - localZ;
+      hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+    else if(zSlant < 0) // lower edge at +Z
+    {
+      // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
+      const auto dist = localZ;
+      hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+
+    if(xSlant > 0) // lower edge at -X
+    {
+      const auto dist = 1_sectors - localX;
+      hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+    else if(xSlant < 0) // lower edge at +X
+    {
+      // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
+      const auto dist = localX;
+      hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+  }
+}
+
+void applyCeilingSlant(HeightInfo& hi,
+                       const core::Length::type xSlant,
+                       const core::Length::type zSlant,
+                       const core::TRVec& pos)
+{
+  const core::Length::type absX = std::abs(xSlant);
+  if(const core::Length::type absZ = std::abs(zSlant); !HeightInfo::skipSteepSlants || (absX <= 2 && absZ <= 2))
+  {
+    const auto localX = toSectorLocal(pos.X);
+    const auto localZ = toSectorLocal(pos.Z);
+
+    if(zSlant > 0) // lower edge at -Z
+    {
+      const auto dist = 1_sectors - localZ;
+      hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+    else if(zSlant < 0) // lower edge at +Z
+    {
+      // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
+      const auto dist = localZ;
+      hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+
+    if(xSlant > 0) // lower edge at -X
+    {
+      // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
+      const auto dist = localX;
+      hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+    else if(xSlant < 0) // lower edge at +X
+    {
+      const auto dist = 1_sectors - localX;
+      hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+    }
+  }
+}
+
+HeightInfo fromResolvedFloor(const world::ResolvedFloor& resolved,
+                             const core::TRVec& pos,
+                             const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
+{
+  HeightInfo hi;
+  hi.y = resolved.sector->floorHeight;
+  hi.lastCommandSequenceOrDeath = resolved.lastCommandSequenceOrDeath;
+  for(const auto& patch : resolved.patches)
+  {
+    if(!patch.objectId.has_value())
+      applyFloorSlant(hi, patch.xSlant, patch.zSlant, pos);
+    else if(const auto it = objects.find(*patch.objectId); it != objects.end())
+      it->second->patchFloor(pos, hi.y);
+  }
+  return hi;
+}
+
+HeightInfo fromResolvedCeiling(const world::ResolvedCeiling& resolved,
+                               const core::TRVec& pos,
+                               const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
+{
+  HeightInfo hi;
+  hi.y = resolved.sector->ceilingHeight;
+  if(resolved.slant.has_value())
+    applyCeilingSlant(hi, resolved.slant->xSlant, resolved.slant->zSlant, pos);
+  for(const auto objectId : resolved.patchingObjects)
+  {
+    if(const auto it = objects.find(objectId); it != objects.end())
+      it->second->patchCeiling(pos, hi.y);
+  }
+  return hi;
+}
+} // namespace
+
 bool HeightInfo::skipSteepSlants = false;
 
 HeightInfo HeightInfo::fromFloor(gsl_lite::not_null<const world::Sector*> roomSector,
                                  const core::TRVec& pos,
                                  const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
 {
+  if(roomSector->resolvedFloor.sector != nullptr)
+    return fromResolvedFloor(roomSector->resolvedFloor, pos, objects);
+
   HeightInfo hi;
 
   while(roomSector->roomBelow != nullptr)
@@ -48,44 +166,11 @@ HeightInfo HeightInfo::fromFloor(gsl_lite::not_null<const world::Sector*> roomSe
     {
     case floordata::FloorDataChunkType::FloorSlant:
     {
-      const core::Length::type xSlant = gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8));
-      const core::Length::type zSlant = gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8));
+      applyFloorSlant(hi,
+                      gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8)),
+                      gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8)),
+                      pos);
       ++fd;
-      const core::Length::type absX = std::abs(xSlant);
-      if(const core::Length::type absZ = std::abs(zSlant); !skipSteepSlants || (absX <= 2 && absZ <= 2))
-      {
-        if(absX <= 2 && absZ <= 2)
-          hi.slantClass = SlantClass::Max512;
-        else
-          hi.slantClass = SlantClass::Steep;
-
-        const auto localX = toSectorLocal(pos.X);
-        const auto localZ = toSectorLocal(pos.Z);
-
-        if(zSlant > 0) // lower edge at -Z
-        {
-          const auto dist = 1_sectors - localZ;
-          hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(zSlant < 0) // lower edge at +Z
-        {
-          // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
-          const auto dist = localZ;
-          hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-
-        if(xSlant > 0) // lower edge at -X
-        {
-          const auto dist = 1_sectors - localX;
-          hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(xSlant < 0) // lower edge at +X
-        {
-          // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
-          const auto dist = localX;
-          hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-      }
     }
     break;
     // NOLINTNEXTLINE(bugprone-branch-clone)
@@ -136,6 +221,9 @@ HeightInfo HeightInfo::fromCeiling(gsl_lite::not_null<const world::Sector*> room
                                    const core::TRVec& pos,
                                    const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
 {
+  if(roomSector->resolvedCeiling.sector != nullptr)
+    return fromResolvedCeiling(roomSector->resolvedCeiling, pos, objects);
+
   HeightInfo hi;
 
   while(roomSector->roomAbove != nullptr)
@@ -161,38 +249,10 @@ HeightInfo HeightInfo::fromCeiling(gsl_lite::not_null<const world::Sector*> room
 
     if(chunkHeader.type == floordata::FloorDataChunkType::CeilingSlant)
     {
-      const core::Length::type xSlant = gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8));
-      const core::Length::type absX = std::abs(xSlant);
-      const core::Length::type zSlant = gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8));
-      if(const core::Length::type absZ = std::abs(zSlant); !skipSteepSlants || (absX <= 2 && absZ <= 2))
-      {
-        const auto localX = toSectorLocal(pos.X);
-        const auto localZ = toSectorLocal(pos.Z);
-
-        if(zSlant > 0) // lower edge at -Z
-        {
-          const auto dist = 1_sectors - localZ;
-          hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(zSlant < 0) // lower edge at +Z
-        {
-          // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
-          const auto dist = localZ;
-          hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-
-        if(xSlant > 0) // lower edge at -X
-        {
-          // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
-          const auto dist = localX;
-          hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(xSlant < 0) // lower edge at +X
-        {
-          const auto dist = 1_sectors - localX;
-          hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-      }
+      applyCeilingSlant(hi,
+                        gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8)),
+                        gsl_lite::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8)),
+                        pos);
     }
   }
 
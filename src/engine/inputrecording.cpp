@@ -0,0 +1,99 @@
+#include "inputrecording.h"
+
+#include "hid/actions.h"
+#include "hid/inputstate.h"
+
+#include <boost/container/flat_map.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <ranges>
+
+namespace engine
+{
+namespace
+{
+constexpr uint32_t DataStreamVersion = 1;
+
+[[nodiscard]] uint64_t toActionMask(const hid::InputState& inputState)
+{
+  uint64_t mask = 0;
+  for(const auto& [action, button] : inputState.actions)
+  {
+    const auto bit = static_cast<uint32_t>(action);
+    gsl_Assert(bit < 64);
+    if(button.current)
+      mask |= uint64_t{1} << bit;
+  }
+  return mask;
+}
+
+[[nodiscard]] boost::container::flat_map<hid::Action, bool> fromActionMask(const uint64_t mask)
+{
+  boost::container::flat_map<hid::Action, bool> actionStates;
+  actionStates.reserve(hid::EnumUtil<hid::Action>::all().size());
+  for(const auto& action : hid::EnumUtil<hid::Action>::all() | std::views::keys)
+  {
+    const auto bit = static_cast<uint32_t>(action);
+    gsl_Assert(bit < 64);
+    actionStates.emplace(action, ((mask >> bit) & 1u) != 0);
+  }
+  return actionStates;
+}
+} // namespace
+
+InputRecordingWriter::InputRecordingWriter(const std::filesystem::path& path, const uint32_t rngSeed)
+    : m_file{std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc)}
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->write(reinterpret_cast<const char*>(&DataStreamVersion), sizeof(DataStreamVersion));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->write(reinterpret_cast<const char*>(&rngSeed), sizeof(rngSeed));
+}
+
+InputRecordingWriter::~InputRecordingWriter() = default;
+
+// ReSharper disable once CppMemberFunctionMayBeConst
+void InputRecordingWriter::append(const hid::InputState& inputState)
+{
+  const auto mask = toActionMask(inputState);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->write(reinterpret_cast<const char*>(&mask), sizeof(mask));
+}
+
+InputRecordingReader::InputRecordingReader(const std::filesystem::path& path)
+    : m_file{std::make_unique<std::ifstream>(path, std::ios::binary)}
+{
+  uint32_t version = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->read(reinterpret_cast<char*>(&version), sizeof(version));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->read(reinterpret_cast<char*>(&m_rngSeed), sizeof(m_rngSeed));
+  if(!*m_file || version != DataStreamVersion)
+  {
+    m_file.reset();
+  }
+}
+
+InputRecordingReader::~InputRecordingReader() = default;
+
+// ReSharper disable once CppMemberFunctionMayBeConst
+std::optional<boost::container::flat_map<hid::Action, bool>> InputRecordingReader::read()
+{
+  if(m_file == nullptr)
+    return std::nullopt;
+
+  uint64_t mask = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_file->read(reinterpret_cast<char*>(&mask), sizeof(mask));
+  if(m_file->gcount() != sizeof(mask))
+    return std::nullopt;
+
+  return fromActionMask(mask);
+}
+} // namespace engine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+
+namespace hid
+{
+enum class Action : int32_t;
+struct InputState;
+} // namespace hid
+
+namespace engine
+{
+/**
+ * @brief Writes the per-tick input of a level session, together with the random seed it was started with.
+ *
+ * Re-simulating a level from its start with the same seed and the recorded input reproduces the session exactly,
+ * see InputRecordingReader and Engine::simulateLevel.
+ */
+class InputRecordingWriter
+{
+public:
+  explicit InputRecordingWriter(const std::filesystem::path& path, uint32_t rngSeed);
+  ~InputRecordingWriter();
+
+  void append(const hid::InputState& inputState);
+
+private:
+  std::unique_ptr<std::ostream> m_file;
+};
+
+class InputRecordingReader
+{
+public:
+  explicit InputRecordingReader(const std::filesystem::path& path);
+  ~InputRecordingReader();
+
+  [[nodiscard]] bool isOpen() const noexcept
+  {
+    return m_file != nullptr;
+  }
+
+  [[nodiscard]] uint32_t getRngSeed() const noexcept
+  {
+    return m_rngSeed;
+  }
+
+  /**
+   * @brief Reads the action states of the next recorded tick.
+   * @return The action states, or an empty value if the end of the recording has been reached.
+   */
+  [[nodiscard]] std::optional<boost::container::flat_map<hid::Action, bool>> read();
+
+private:
+  std::unique_ptr<std::istream> m_file;
+  uint32_t m_rngSeed = 0;
+};
+} // namespace engine
@@ -13,16 +13,26 @@
 #include "player.h"
 #include "presenter.h"
 #include "render/material/materialmanager.h"
+#include "render/portaltracer.h"
 #include "render/scene/rendercontext.h"
 #include "render/scene/translucency.h"
+#include "render/scene/visitor.h"
 #include "soundeffects_tr1.h"
 #include "ui/core.h"
 #include "ui/ui.h"
 #include "util/datetime.h"
+#include "util/helpers.h"
+#include "util/profiler.h"
 #include "world/world.h"
 
+#include <algorithm>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/log/trivial.hpp>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+#include <utility>
 
 namespace engine
 {
@@ -120,6 +130,68 @@ void takeBugReport(const std::filesystem::path& userDataPath, world::World& worl
   world.save(bugReport / "save.yaml");
 }
 
+void constructProfilerOverlay(ui::Ui& ui, const ui::TRFont& trFont)
+{
+  const auto stats = util::profiler::summarizeCurrentThread(std::chrono::seconds{1});
+  const auto frameStats = std::find_if(stats.begin(),
+                                       stats.end(),
+                                       [](const util::profiler::ZoneStats& zoneStats)
+                                       {
+                                         return std::string_view{zoneStats.name} == "frame";
+                                       });
+  if(frameStats == stats.end())
+    return;
+
+  // average milliseconds per frame, the "frame" zone itself gives the total frame time
+  const auto frames = static_cast<double>(frameStats->calls);
+  auto pos = glm::ivec2{ui::FontHeight, ui::FontHeight * 4};
+  for(const auto& zoneStats : stats)
+  {
+    std::ostringstream line;
+    line << std::string(zoneStats.depth * 2, ' ') << zoneStats.name << " " << std::fixed << std::setprecision(2)
+         << std::chrono::duration<double, std::milli>(zoneStats.total).count() / frames;
+    const auto text = ui::Text{util::escape(line.str())};
+    drawBox(text, ui, pos, 2, gl::SRGBA8{0, 0, 0, 160}, 0.5f);
+    text.draw(ui, trFont, pos, 0.5f);
+    pos.y += ui::FontHeight / 2 + 2;
+  }
+
+  // counted since the previous overlay, i.e. during a single frame
+  const auto renderStatistics = std::exchange(render::scene::getRenderStatistics(), {});
+  std::ostringstream line;
+  line << "draws " << renderStatistics.drawCalls << " states " << renderStatistics.stateChanges << " programs "
+       << renderStatistics.programChanges;
+  const auto text = ui::Text{util::escape(line.str())};
+  drawBox(text, ui, pos, 2, gl::SRGBA8{0, 0, 0, 160}, 0.5f);
+  text.draw(ui, trFont, pos, 0.5f);
+  pos.y += ui::FontHeight / 2 + 2;
+
+  const auto portalStatistics = std::exchange(render::PortalTracer::getStatistics(), {});
+  std::ostringstream portalLine;
+  portalLine << "expansions " << portalStatistics.expansions << " rooms " << portalStatistics.visitedRooms
+             << " portals " << portalStatistics.visitedPortals << " untraced " << portalStatistics.fallbackRooms;
+  const auto portalText = ui::Text{util::escape(portalLine.str())};
+  drawBox(portalText, ui, pos, 2, gl::SRGBA8{0, 0, 0, 160}, 0.5f);
+  portalText.draw(ui, trFont, pos, 0.5f);
+}
+
+void writeProfilerTrace(const std::filesystem::path& userDataPath)
+{
+  if constexpr(!util::profiler::Enabled)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Profiling is not compiled in, configure with ENABLE_PROFILING=ON";
+    return;
+  }
+
+  const auto profilesDir = userDataPath / "profiles";
+  if(!std::filesystem::is_directory(profilesDir))
+    std::filesystem::create_directories(profilesDir);
+
+  const auto path = profilesDir / (util::getCurrentHumanReadableTimestamp() + ".json");
+  util::profiler::writeChromeTrace(path);
+  BOOST_LOG_TRIVIAL(info) << "Profiler trace written to " << path;
+}
+
 void makeScreenshot(const Presenter& presenter, const std::filesystem::path& userDataPath)
 {
   auto img = presenter.takeScreenshot();
@@ -153,6 +225,11 @@ void LevelLoop::genericPreTick(world::World& world)
   {
     makeScreenshot(*m_presenter, m_userDataPath);
   }
+
+  if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::ProfilerTrace))
+  {
+    writeProfilerTrace(m_userDataPath);
+  }
 }
 
 void LevelLoop::genericPostTick()
@@ -252,6 +329,8 @@ void LevelLoop::render(world::World& world,
                        const float interTickFactor,
                        const std::optional<std::chrono::steady_clock::time_point>& saveReminderNext)
 {
+  UTIL_PROFILE_ZONE("LevelLoop::render");
+
   ui::Ui ui{m_presenter->getRenderSystem().getMaterialManager().getUi(),
             world.getWorldGeometry().getPalette(),
             m_presenter->getUiViewport()};
@@ -261,6 +340,8 @@ void LevelLoop::render(world::World& world,
 
   world.getCameraController().interpolateCameraTransform(interTickFactor);
   world.getObjectManager().interpolateTransforms(objectInterTickFactor);
+  for(const auto& room : world.getRooms())
+    room.spriteParticles.setInterTickFactor(objectInterTickFactor);
 
   if(const auto lara = world.getObjectManager().getLaraPtr())
     lara->m_state.location.room->node->setVisible(true);
@@ -281,6 +362,11 @@ void LevelLoop::render(world::World& world,
     ui.drawBox({0, 0}, ui.getSize(), gl::SRGBA8{0, 0, 0, gsl_lite::narrow_cast<uint8_t>(255 * blackAlpha)});
   }
 
+  if constexpr(util::profiler::Enabled)
+  {
+    constructProfilerOverlay(ui, m_presenter->getTrFont());
+  }
+
   m_presenter->renderUiToBackbuffer(ui, 1);
   m_presenter->swapBuffers();
 }
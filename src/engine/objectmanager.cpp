@@ -1,10 +1,14 @@
 #include "objectmanager.h"
 
+#include "ai/ai.h"
+#include "ai/pathfinder.h"
+#include "cameracontroller.h"
 #include "core/id.h"
 #include "core/magic.h"
 #include "core/units.h"
 #include "items_tr1.h"
 #include "loader/file/item.h"
+#include "objects/aiagent.h"
 #include "objects/laraobject.h"
 #include "objects/object.h"
 #include "objects/objectfactory.h"
@@ -19,19 +23,23 @@
 #include "serialization/serialization.h"
 #include "serialization/vector.h"
 #include "skeletalmodelnode.h"
+#include "util/profiler.h"
+#include "util/threadpool.h"
+#include "world/potentiallyvisibleset.h"
 #include "world/room.h"
 #include "world/sprite.h"
 #include "world/world.h"
 
-#include <algorithm>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -62,7 +70,9 @@ void ObjectManager::createObjects(world::World& world, std::vector<loader::file:
     if(object == nullptr)
       continue;
 
-    m_objects.emplace(gsl_lite::narrow<ObjectId>(idItem.index()), object);
+    const auto id = gsl_lite::narrow<ObjectId>(idItem.index());
+    m_objects.emplace(id, object);
+    insertEntry(m_objects.at(id), id);
     if(object->isActive())
     {
       object->activate();
@@ -70,6 +80,95 @@ void ObjectManager::createObjects(world::World& world, std::vector<loader::file:
   }
 }
 
+void ObjectManager::insertEntry(const gslu::nn_shared<objects::Object>& object, const std::optional<ObjectId>& id)
+{
+  if(m_handles.contains(object.get().get()))
+    return;
+
+  Entry entry{object, id};
+  if(!id.has_value())
+  {
+    entry.dynamicIndex = m_dynamicObjects.size();
+    m_dynamicObjects.emplace_back(object);
+  }
+  m_handles.emplace(object.get().get(), m_entries.insert(std::move(entry)));
+}
+
+void ObjectManager::eraseEntry(const objects::Object* object)
+{
+  const auto it = m_handles.find(object);
+  if(it == m_handles.end())
+    return;
+
+  const auto handle = it->second;
+  auto& entry = m_entries.at(handle);
+  unlinkActive(handle.index);
+  if(entry.id.has_value())
+  {
+    m_objects.erase(*entry.id);
+  }
+  else
+  {
+    // swap-remove to keep the dynamic objects contiguous
+    const auto& last = m_dynamicObjects.back();
+    m_entries.at(m_handles.at(last.get().get())).dynamicIndex = entry.dynamicIndex;
+    m_dynamicObjects[entry.dynamicIndex] = last;
+    m_dynamicObjects.pop_back();
+  }
+
+  m_entries.erase(handle);
+  m_handles.erase(it);
+}
+
+void ObjectManager::linkActiveFront(const uint32_t index)
+{
+  auto& entry = m_entries.atIndex(index);
+  gsl_Assert(!entry.active);
+  entry.active = true;
+  entry.prevActive = NoSlot;
+  entry.nextActive = m_activeHead;
+  if(m_activeHead != NoSlot)
+    m_entries.atIndex(m_activeHead).prevActive = index;
+  else
+    m_activeTail = index;
+  m_activeHead = index;
+}
+
+void ObjectManager::linkActiveBack(const uint32_t index)
+{
+  auto& entry = m_entries.atIndex(index);
+  gsl_Assert(!entry.active);
+  entry.active = true;
+  entry.prevActive = m_activeTail;
+  entry.nextActive = NoSlot;
+  if(m_activeTail != NoSlot)
+    m_entries.atIndex(m_activeTail).nextActive = index;
+  else
+    m_activeHead = index;
+  m_activeTail = index;
+}
+
+void ObjectManager::unlinkActive(const uint32_t index)
+{
+  auto& entry = m_entries.atIndex(index);
+  if(!entry.active)
+    return;
+
+  if(entry.prevActive != NoSlot)
+    m_entries.atIndex(entry.prevActive).nextActive = entry.nextActive;
+  else
+    m_activeHead = entry.nextActive;
+
+  if(entry.nextActive != NoSlot)
+    m_entries.atIndex(entry.nextActive).prevActive = entry.prevActive;
+  else
+    m_activeTail = entry.prevActive;
+
+  entry.active = false;
+  entry.prevActive = NoSlot;
+  entry.nextActive = NoSlot;
+}
+
 void ObjectManager::applyScheduledDeletions()
 {
   if(m_scheduledDeletions.empty())
@@ -77,29 +176,7 @@ void ObjectManager::applyScheduledDeletions()
 
   for(const auto& del : m_scheduledDeletions)
   {
-    deactivate(del);
-
-    if(auto it = std::ranges::find_if(m_dynamicObjects,
-                                      [del](const std::shared_ptr<objects::Object>& i) noexcept
-                                      {
-                                        return i.get() == del;
-                                      });
-       it != m_dynamicObjects.end())
-    {
-      m_dynamicObjects.erase(it);
-      continue;
-    }
-
-    if(auto it = std::ranges::find_if(m_objects,
-                                      [del](const std::pair<uint16_t, gslu::nn_shared<objects::Object>>& i)
-                                      {
-                                        return i.second.get().get() == del;
-                                      });
-       it != m_objects.end())
-    {
-      m_objects.erase(it);
-      continue;
-    }
+    eraseEntry(del);
   }
 
   m_scheduledDeletions.clear();
@@ -110,7 +187,9 @@ void ObjectManager::registerObject(const gslu::nn_shared<objects::Object>& objec
   if(m_objectCounter == std::numeric_limits<ObjectId>::max())
     BOOST_THROW_EXCEPTION(std::runtime_error("Artificial object counter exceeded"));
 
-  m_objects.emplace(m_objectCounter++, object);
+  const auto id = m_objectCounter++;
+  if(m_objects.emplace(id, object).second)
+    insertEntry(object, id);
 }
 
 std::shared_ptr<objects::Object> ObjectManager::find(const objects::Object* object,
@@ -119,25 +198,39 @@ std::shared_ptr<objects::Object> ObjectManager::find(const objects::Object* obje
   if(object == nullptr)
     return nullptr;
 
-  const auto it = std::ranges::find_if(m_objects,
-                                       [object](const std::pair<uint16_t, gslu::nn_shared<objects::Object>>& x)
-                                       {
-                                         return x.second.get().get() == object;
-                                       });
+  const auto it = m_handles.find(object);
+  if(it == m_handles.end())
+    return nullptr;
 
-  if(it != m_objects.end())
-    return it->second;
+  const auto& entry = m_entries.at(it->second);
+  if(!entry.id.has_value() && !includeDynamicObjects)
+    return nullptr;
 
-  if(includeDynamicObjects)
-  {
-    const auto it2 = std::ranges::find_if(m_dynamicObjects,
-                                          [object](const auto& x)
-                                          {
-                                            return x.get().get() == object;
-                                          });
-    if(it2 != m_dynamicObjects.end())
-      return *it2;
-  }
+  return entry.object;
+}
+
+std::optional<ObjectId> ObjectManager::findId(const objects::Object* object) const
+{
+  const auto it = m_handles.find(object);
+  if(it == m_handles.end())
+    return std::nullopt;
+
+  return m_entries.at(it->second).id;
+}
+
+core::SlotHandle ObjectManager::getHandle(const objects::Object* object) const
+{
+  const auto it = m_handles.find(object);
+  if(it == m_handles.end())
+    return {};
+
+  return it->second;
+}
+
+std::shared_ptr<objects::Object> ObjectManager::get(const core::SlotHandle& handle) const
+{
+  if(const auto entry = m_entries.get(handle); entry != nullptr)
+    return entry->object;
 
   return nullptr;
 }
@@ -153,21 +246,23 @@ std::shared_ptr<objects::Object> ObjectManager::getObject(const ObjectId id) con
 
 void ObjectManager::updateLogic(world::World& world, const bool godMode)
 {
-  for(const auto& object : m_dynamicObjects)
-  {
-    object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
-    object->updateLighting();
-  }
+  UTIL_PROFILE_ZONE("ObjectManager::updateLogic");
 
-  for(const auto& object : m_objects | std::views::values)
-  {
-    object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
-    object->updateLighting();
-  }
+  updateCosmetics(world);
+  prepareAiUpdates(world);
 
-  // need to work on a copy because updateLogic() may modify the collection
-  for(const auto activeObjects = m_activeObjects; const auto& object : activeObjects)
+  // need to work on a snapshot because updateLogic() may (de-)activate objects: objects deactivated during this tick
+  // are still updated, objects activated during this tick are not
+  m_activeSnapshot.clear();
+  for(auto index = m_activeHead; index != NoSlot; index = m_entries.atIndex(index).nextActive)
+    m_activeSnapshot.emplace_back(m_entries.handleAt(index));
+
+  for(const auto& handle : m_activeSnapshot)
   {
+    const auto entry = m_entries.get(handle);
+    if(entry == nullptr)
+      continue;
+    const auto object = entry->object;
     if(object.get() == m_lara) // Lara is special and needs to be updated last
       continue;
     object->updateLogic();
@@ -178,10 +273,14 @@ void ObjectManager::updateLogic(world::World& world, const bool godMode)
     }
   }
 
-  m_particles.update(world);
-  for(auto& room : world.getRooms())
   {
-    room.particles.update(world);
+    UTIL_PROFILE_ZONE("particles");
+    m_particles.update(world);
+    for(auto& room : world.getRooms())
+    {
+      room.particles.update(world);
+      room.spriteParticles.update(world);
+    }
   }
 
   if(m_lara != nullptr)
@@ -196,6 +295,68 @@ void ObjectManager::updateLogic(world::World& world, const bool godMode)
   applyScheduledDeletions();
 }
 
+void ObjectManager::updateCosmetics(const world::World& world)
+{
+  UTIL_PROFILE_ZONE("cosmetics");
+
+  //! Number of ticks between lighting updates of objects which can't be seen.
+  static constexpr uint32_t HiddenLightingInterval = 4;
+
+  const auto& potentiallyVisibleSet = world.getPotentiallyVisibleSet();
+  const auto cameraRoom = potentiallyVisibleSet.indexOf(world.getCameraController().getCurrentRoom());
+  // when the camera changes rooms, objects may become visible which have been updated at the reduced rate
+  const bool updateAll = m_lastCameraRoom != cameraRoom;
+  m_lastCameraRoom = cameraRoom;
+  ++m_cosmeticTick;
+
+  uint32_t counter = 0;
+  auto update = [&potentiallyVisibleSet, cameraRoom, updateAll, &counter, this](objects::Object& object)
+  {
+    object.getNode()->setVisible(object.m_state.triggerState != objects::TriggerState::Invisible);
+    // spread the hidden objects' updates evenly across the ticks
+    if(updateAll || (m_cosmeticTick + counter++) % HiddenLightingInterval == 0
+       || potentiallyVisibleSet.isVisible(cameraRoom, potentiallyVisibleSet.indexOf(object.m_state.location.room)))
+    {
+      object.updateLighting();
+    }
+  };
+
+  for(const auto& object : m_dynamicObjects)
+    update(*object);
+
+  for(const auto& object : m_objects | std::views::values)
+    update(*object);
+}
+
+void ObjectManager::prepareAiUpdates(const world::World& world)
+{
+  UTIL_PROFILE_ZONE("ai-think");
+
+  if(!m_parallelAiUpdates)
+    return;
+
+  std::vector<ai::PathFinder*> pathFinders;
+  for(auto index = m_activeHead; index != NoSlot; index = m_entries.atIndex(index).nextActive)
+  {
+    const auto aiAgent = std::dynamic_pointer_cast<objects::AIAgent>(m_entries.atIndex(index).object.get());
+    if(aiAgent == nullptr || aiAgent->getCreatureInfo() == nullptr)
+      continue;
+
+    if(auto& pathFinder = aiAgent->getCreatureInfo()->pathFinder; pathFinder.hasPendingExpansions())
+      pathFinders.emplace_back(&pathFinder);
+  }
+
+  // with a single agent, the serial update does the same work without the synchronization overhead
+  if(pathFinders.size() < 2)
+    return;
+
+  util::ThreadPool::getShared().parallelFor(pathFinders.size(),
+                                            [&pathFinders, &world](const size_t i)
+                                            {
+                                              pathFinders[i]->prepareExpansion(world);
+                                            });
+}
+
 void ObjectManager::serialize(const serialization::Serializer<world::World>& ser) const
 {
   ser(S_NV("objectCounter", m_objectCounter),
@@ -203,16 +364,11 @@ void ObjectManager::serialize(const serialization::Serializer<world::World>& ser
       S_NV("lara", serialization::ObjectReference{std::cref(m_lara)}));
 
   std::vector<ObjectId> activeObjectIds;
-  for(const auto& obj : m_activeObjects)
+  for(auto index = m_activeHead; index != NoSlot; index = m_entries.atIndex(index).nextActive)
   {
-    auto it = std::ranges::find_if(m_objects,
-                                   [obj](const auto& i)
-                                   {
-                                     return i.second.get() == obj;
-                                   });
-    if(it != m_objects.end())
+    if(const auto& id = m_entries.atIndex(index).id; id.has_value())
     {
-      activeObjectIds.emplace_back(it->first);
+      activeObjectIds.emplace_back(*id);
     }
   }
   ser(S_NV("activeObjects", activeObjectIds));
@@ -224,12 +380,34 @@ void ObjectManager::deserialize(const serialization::Deserializer<world::World>&
       S_NV("objects", m_objects),
       S_NV("lara", serialization::ObjectReference{std::ref(m_lara)}));
 
+  // the deserialized objects replace all previous ones, so rebuild the slots of the non-dynamic objects
+  std::vector<const objects::Object*> replacedObjects;
+  m_entries.forEach(
+    [&replacedObjects](Entry& entry)
+    {
+      if(entry.id.has_value())
+        replacedObjects.emplace_back(entry.object.get().get());
+      entry.active = false;
+      entry.prevActive = NoSlot;
+      entry.nextActive = NoSlot;
+    });
+  m_activeHead = NoSlot;
+  m_activeTail = NoSlot;
+  for(const auto object : replacedObjects)
+  {
+    m_entries.erase(m_handles.at(object));
+    m_handles.erase(object);
+  }
+  for(const auto& [id, object] : m_objects)
+  {
+    insertEntry(object, id);
+  }
+
   std::vector<ObjectId> activeObjectIds;
   ser(S_NV("activeObjects", activeObjectIds));
-  m_activeObjects.clear();
   for(const auto id : activeObjectIds)
   {
-    m_activeObjects.emplace_back(m_objects.at(id));
+    linkActiveBack(m_handles.at(m_objects.at(id).get().get()).index);
   }
 }
 
@@ -250,27 +428,19 @@ void ObjectManager::replaceItems(const TR1ItemId& oldId, const TR1ItemId& newId,
 
 void ObjectManager::deactivate(const objects::Object* object)
 {
-  if(const auto it = std::ranges::find_if(m_activeObjects,
-                                          [object](const auto& i)
-                                          {
-                                            return i.get().get() == object;
-                                          });
-     it != m_activeObjects.end())
+  if(const auto it = m_handles.find(object); it != m_handles.end())
   {
-    m_activeObjects.erase(it);
+    unlinkActive(it->second.index);
   }
 }
+
 void ObjectManager::interpolateTransforms(const float interTickFactor)
 {
-  for(const auto& object : m_objects | std::views::values)
-  {
-    object->interpolateTransform(interTickFactor);
-  }
-
-  for(const auto& object : m_dynamicObjects)
-  {
-    object->interpolateTransform(interTickFactor);
-  }
+  m_entries.forEach(
+    [interTickFactor](const Entry& entry)
+    {
+      entry.object->interpolateTransform(interTickFactor);
+    });
 
   for(const auto& particle : m_particles)
   {
@@ -280,15 +450,9 @@ void ObjectManager::interpolateTransforms(const float interTickFactor)
 
 void ObjectManager::activate(const objects::Object* object)
 {
-  const auto ob = find(object, true);
-  if(ob == nullptr)
-  {
-    return;
-  }
-
-  if(const auto it = std::ranges::find(m_activeObjects, gsl_lite::not_null{ob}); it == m_activeObjects.end())
+  if(const auto it = m_handles.find(object); it != m_handles.end() && !m_entries.at(it->second).active)
   {
-    m_activeObjects.emplace_front(ob);
+    linkActiveFront(it->second.index);
   }
 }
-} // namespace engine
\ No newline at end of file
+} // namespace engine
@@ -1,15 +1,18 @@
 #pragma once
 
+#include "core/slotmap.h"
 #include "particlecollection.h"
 #include "serialization/serialization_fwd.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
-#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,20 +41,62 @@ using ObjectId = uint16_t;
 
 class ObjectManager
 {
+  static constexpr uint32_t NoSlot = core::SlotHandle::InvalidIndex;
+
+  struct Entry
+  {
+    gslu::nn_shared<objects::Object> object;
+    //! nullopt for dynamic objects
+    std::optional<ObjectId> id;
+    //! index into m_dynamicObjects for dynamic objects
+    size_t dynamicIndex = 0;
+    //! intrusive links of the active object list, using slot indices
+    uint32_t prevActive = NoSlot;
+    uint32_t nextActive = NoSlot;
+    bool active = false;
+  };
+
   std::set<objects::Object*> m_scheduledDeletions;
   ObjectId m_objectCounter = 0;
+  core::SlotMap<Entry> m_entries;
+  std::unordered_map<const objects::Object*, core::SlotHandle> m_handles;
+  // kept alongside the slot map for id-ordered iteration, e.g. for floor data and serialization
   std::map<ObjectId, gslu::nn_shared<objects::Object>> m_objects;
-  std::list<gslu::nn_shared<objects::Object>> m_activeObjects;
-  std::set<gslu::nn_shared<objects::Object>> m_dynamicObjects;
+  std::vector<gslu::nn_shared<objects::Object>> m_dynamicObjects;
+  uint32_t m_activeHead = NoSlot;
+  uint32_t m_activeTail = NoSlot;
+  //! the active objects at the start of updateLogic(), kept to reuse its capacity
+  std::vector<core::SlotHandle> m_activeSnapshot;
   ParticleCollection m_particles;
   std::shared_ptr<objects::LaraObject> m_lara = nullptr;
+  //! staggers the reduced-rate cosmetic updates, not serialized as it doesn't affect the game logic
+  uint32_t m_cosmeticTick = 0;
+  std::optional<uint32_t> m_lastCameraRoom;
+  bool m_parallelAiUpdates = true;
+
+  void insertEntry(const gslu::nn_shared<objects::Object>& object, const std::optional<ObjectId>& id);
+  void eraseEntry(const objects::Object* object);
+  void linkActiveFront(uint32_t index);
+  void linkActiveBack(uint32_t index);
+  void unlinkActive(uint32_t index);
+
+  /**
+   * @brief Does the read-only part of the AI updates of all active objects in parallel.
+   *
+   * The results are only used by the serial updates if they would have computed the same, so the outcome doesn't
+   * depend on the thread count.
+   */
+  void prepareAiUpdates(const world::World& world);
+
+  /**
+   * @brief Updates the visibility and lighting of all objects.
+   *
+   * Objects in rooms outside the potentially visible set of the camera's room only update their lighting every few
+   * ticks.
+   */
+  void updateCosmetics(const world::World& world);
 
 public:
-  auto& getObjects() noexcept
-  {
-    return m_objects;
-  }
-
   [[nodiscard]] const auto& getObjects() const noexcept
   {
     return m_objects;
@@ -84,9 +129,15 @@ public:
     m_scheduledDeletions.insert(object);
   }
 
+  //! @brief Only meant to verify that the parallel AI updates don't change the outcome.
+  void setParallelAiUpdates(const bool parallelAiUpdates) noexcept
+  {
+    m_parallelAiUpdates = parallelAiUpdates;
+  }
+
   void registerDynamicObject(const gslu::nn_shared<objects::Object>& object)
   {
-    m_dynamicObjects.emplace(object);
+    insertEntry(object, std::nullopt);
   }
 
   [[nodiscard]] auto getDynamicObjectCount() const noexcept
@@ -117,6 +168,9 @@ public:
   void applyScheduledDeletions();
   void registerObject(const gslu::nn_shared<objects::Object>& object);
   std::shared_ptr<objects::Object> find(const objects::Object* object, bool includeDynamicObjects = false) const;
+  [[nodiscard]] std::optional<ObjectId> findId(const objects::Object* object) const;
+  [[nodiscard]] core::SlotHandle getHandle(const objects::Object* object) const;
+  [[nodiscard]] std::shared_ptr<objects::Object> get(const core::SlotHandle& handle) const;
   void createObjects(world::World& world, std::vector<loader::file::Item>& items);
   [[nodiscard]] std::shared_ptr<objects::Object> getObject(ObjectId id) const;
 
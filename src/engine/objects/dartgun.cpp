@@ -9,7 +9,7 @@
 #include "engine/items_tr1.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlecollection.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/room.h"
@@ -17,11 +17,9 @@
 #include "modelobject.h"
 #include "objectstate.h"
 #include "qs/quantity.h"
-#include "render/scene/node.h"
 
 #include <gsl-lite/gsl-lite.hpp>
 #include <memory>
-#include <utility>
 
 void engine::objects::DartGun::updateLogic()
 {
@@ -71,9 +69,8 @@ void engine::objects::DartGun::updateLogic()
   auto& dartState = dart->m_state;
   dartState.triggerState = TriggerState::Active;
 
-  auto particle = gsl_lite::make_shared<SmokeParticle>(dartState.location, getWorld(), dartState.rotation);
-  setParent(particle, dartState.location.room->node);
-  getWorld().getObjectManager().registerParticle(std::move(particle));
+  dartState.location.room->spriteParticles.emitSmoke(
+    *dartState.location.room, dartState.location.position, dartState.rotation);
 
   playSoundEffect(TR1SoundEffect::DartgunShoot);
   advanceFrame();
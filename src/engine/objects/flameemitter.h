@@ -8,7 +8,7 @@
 
 namespace engine
 {
-class Particle;
+class FlameParticle;
 struct Location;
 } // namespace engine
 
@@ -46,7 +46,7 @@ public:
   void updateLogic() override;
 
 private:
-  std::shared_ptr<Particle> m_flame;
+  std::shared_ptr<FlameParticle> m_flame;
 
   void removeParticle();
 };
@@ -431,9 +431,7 @@ void LaraObject::updateLogic()
         surfaceLocation.position.Y = *waterSurfaceHeight;
         surfaceLocation.position.Z = m_state.location.position.Z;
 
-        const auto particle = gsl_lite::make_shared<SplashParticle>(surfaceLocation, getWorld(), false);
-        setParent(particle, surfaceLocation.room->node);
-        getWorld().getObjectManager().registerParticle(particle);
+        surfaceLocation.room->spriteParticles.emitSplash(*surfaceLocation.room, surfaceLocation.position, false);
       }
     }
   }
@@ -489,11 +487,9 @@ void LaraObject::updateLogic()
     auto bubbleCount = util::rand15(2);
     while(bubbleCount-- > 0)
     {
-      const auto particle
-        = gsl_lite::make_shared<BubbleParticle>(Location{m_state.location.room, position}, getWorld(), false, true);
-      setParent(particle, nullptr);
-      particle->scale = util::rand15(0.8f) + 0.2f;
-      m_state.location.room->particles.registerParticle(particle);
+      auto& bubbles = m_state.location.room->particles;
+      const auto bubble = bubbles.emitBubble(*m_state.location.room, position, false);
+      bubbles.setScale(bubble, util::rand15(0.8f) + 0.2f);
     }
   }
 
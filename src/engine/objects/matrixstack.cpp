@@ -1,21 +1,16 @@
 #include "matrixstack.h"
 
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace engine::objects
 {
-MatrixStack::MatrixStack()
-{
-  m_stack.emplace(1.0f);
-}
-
 void MatrixStack::push()
 {
-  const auto top = m_stack.top();
-  m_stack.emplace(top);
+  m_stack.push();
 }
 
-void MatrixStack::pop() noexcept
+void MatrixStack::pop()
 {
   m_stack.pop();
 }
@@ -47,6 +42,11 @@ void MatrixStack::rotate(const uint8_t* packed)
   m_stack.top() *= core::fromPackedAngles(packed);
 }
 
+void MatrixStack::rotate(const glm::quat& q)
+{
+  m_stack.top() *= glm::mat4_cast(q);
+}
+
 void MatrixStack::translate(const glm::vec3& x)
 {
   m_stack.top() = glm::translate(m_stack.top(), x);
@@ -2,26 +2,26 @@
 
 #include "core/angle.h"
 #include "core/vec.h"
+#include "engine/skeletalpose.h"
 #include "engine/world/skeletalmodeltype.h"
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
-#include <stack>
 #include <vector>
 
 namespace engine::objects
 {
 class MatrixStack
 {
-  std::stack<glm::mat4> m_stack;
+  PoseMatrixStack m_stack;
   std::vector<glm::mat4> m_poseMatrices;
 
 public:
-  explicit MatrixStack();
+  explicit MatrixStack() = default;
 
   void push();
 
-  void pop() noexcept;
+  void pop();
 
   [[nodiscard]] const glm::mat4& top() const noexcept;
 
@@ -37,6 +37,8 @@ public:
 
   void rotate(const uint8_t* packed);
 
+  void rotate(const glm::quat& q);
+
   void translate(const glm::vec3& x);
 
   void transform(const std::initializer_list<size_t>& indices,
@@ -1,6 +1,9 @@
 #include "segmentinterpolationmatrixstack.h"
 
-#include "util/helpers.h"
+#include "engine/skeletalpose.h"
+
+#include <glm/common.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace engine::objects
 {
@@ -12,58 +15,56 @@ SegmentInterpolationMatrixStack::SegmentInterpolationMatrixStack(const float int
 
 void SegmentInterpolationMatrixStack::push()
 {
-  m_stack1.push();
-  m_stack2.push();
+  m_stack.push();
 }
 
 void SegmentInterpolationMatrixStack::pop()
 {
-  m_stack1.pop();
-  m_stack2.pop();
+  m_stack.pop();
 }
 
 glm::mat4 SegmentInterpolationMatrixStack::itop() const
 {
-  return util::lerp(m_stack1.top(), m_stack2.top(), m_interKeyframeFactor);
+  return m_stack.top();
 }
 
 void SegmentInterpolationMatrixStack::rotate(const glm::mat4& m)
 {
-  m_stack1.top() *= m;
-  m_stack2.top() *= m;
+  m_stack.multiply(m);
 }
 
 void SegmentInterpolationMatrixStack::rotate(const core::TRRotation& r)
 {
-  rotate(r.toMatrix());
+  m_stack.rotate(r);
 }
 
 void SegmentInterpolationMatrixStack::rotate(const core::TRRotationXY& r)
 {
-  rotate(r.toMatrix());
+  m_stack.rotate(r);
 }
 
 void SegmentInterpolationMatrixStack::rotate(const uint8_t* packed1, const uint8_t* packed2)
 {
-  m_stack1.top() *= core::fromPackedAngles(packed1);
-  m_stack2.top() *= core::fromPackedAngles(packed2);
+  if(packed1 == packed2)
+    m_stack.rotate(core::quatFromPackedAngles(packed1));
+  else
+    m_stack.rotate(
+      nlerp(core::quatFromPackedAngles(packed1), core::quatFromPackedAngles(packed2), m_interKeyframeFactor));
 }
 
 void SegmentInterpolationMatrixStack::resetRotation()
 {
-  m_stack1.resetRotation();
-  m_stack2.resetRotation();
+  m_stack.resetRotation();
 }
 
 void SegmentInterpolationMatrixStack::translate(const glm::vec3& v1, const glm::vec3& v2)
 {
-  m_stack1.top() = glm::translate(m_stack1.top(), v1);
-  m_stack2.top() = glm::translate(m_stack2.top(), v2);
+  m_stack.translate(glm::mix(v1, v2, m_interKeyframeFactor));
 }
 
 void SegmentInterpolationMatrixStack::translate(const glm::vec3& v)
 {
-  translate(v, v);
+  m_stack.translate(v);
 }
 
 void SegmentInterpolationMatrixStack::transform(const std::initializer_list<size_t>& indices,
@@ -88,19 +89,11 @@ void SegmentInterpolationMatrixStack::transform(const size_t idx,
 
 void SegmentInterpolationMatrixStack::apply(const size_t idx)
 {
-  m_stack1.apply(idx);
-  m_stack2.apply(idx);
+  m_stack.apply(idx);
 }
 
-std::vector<glm::mat4> SegmentInterpolationMatrixStack::getPoseMatrices() const
+const std::vector<glm::mat4>& SegmentInterpolationMatrixStack::getPoseMatrices() const noexcept
 {
-  const auto matrices1 = m_stack1.getPoseMatrices();
-  const auto matrices2 = m_stack2.getPoseMatrices();
-  gsl_Assert(matrices1.size() == matrices2.size());
-
-  std::vector<glm::mat4> result;
-  for(size_t i = 0; i < matrices1.size(); ++i)
-    result.emplace_back(util::lerp(matrices1[i], matrices2[i], m_interKeyframeFactor));
-  return result;
+  return m_stack.getPoseMatrices();
 }
 } // namespace engine::objects
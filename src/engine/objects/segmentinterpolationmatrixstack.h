@@ -14,10 +14,12 @@ namespace engine
 
 namespace engine::objects
 {
+/**
+ * @brief A matrix stack between two keyframes, interpolating each rotation and translation as it is applied.
+ */
 class SegmentInterpolationMatrixStack
 {
-  MatrixStack m_stack1;
-  MatrixStack m_stack2;
+  MatrixStack m_stack;
   float m_interKeyframeFactor;
 
 public:
@@ -56,6 +58,6 @@ public:
   // NOLINTNEXTLINE(readability-make-member-function-const)
   void apply(size_t idx);
 
-  std::vector<glm::mat4> getPoseMatrices() const;
+  [[nodiscard]] const std::vector<glm::mat4>& getPoseMatrices() const noexcept;
 };
 } // namespace engine::objects
\ No newline at end of file
@@ -5,13 +5,12 @@
 #include "engine/floordata/floordata.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlecollection.h"
 #include "engine/world/room.h"
 #include "engine/world/world.h"
 #include "laraobject.h"
 #include "objectstate.h"
 #include "qs/quantity.h"
-#include "render/scene/node.h"
 
 #include <gsl-lite/gsl-lite.hpp>
 
@@ -26,8 +25,6 @@ void WaterfallMist::updateLogic()
      abs(d.X) > 20_sectors || abs(d.Y) > 20_sectors || abs(d.Z) > 20_sectors)
     return;
 
-  const auto particle = gsl_lite::make_shared<SplashParticle>(m_state.location, getWorld(), true);
-  setParent(particle, m_state.location.room->node);
-  getWorld().getObjectManager().registerParticle(particle);
+  m_state.location.room->spriteParticles.emitSplash(*m_state.location.room, m_state.location.position, true);
 }
 } // namespace engine::objects
\ No newline at end of file
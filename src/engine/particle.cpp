@@ -35,11 +35,10 @@
 #include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/throw_exception.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <gl/pixel.h>
-#include <gl/renderstate.h>
-#include <gl/vertexbuffer.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
@@ -47,7 +46,7 @@
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
-#include <tuple>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -74,8 +73,7 @@ void Particle::initRenderables(world::World& world, const render::material::Spri
                                 const auto& settings = world.getEngine().getEngineConfig()->renderSettings;
                                 return !settings.lightingModeActive ? 0 : settings.lightingMode;
                               },
-                              "particle"),
-                            nullptr);
+                              "particle"));
     }
   }
   else if(const auto& spriteSequence = world.getWorldGeometry().findSpriteSequenceForType(object_number))
@@ -85,14 +83,14 @@ void Particle::initRenderables(world::World& world, const render::material::Spri
       switch(mode)
       {
       case render::material::SpriteMaterialMode::YAxisBound:
-        m_meshes.emplace_back(spr.yBoundMesh, nullptr);
+        m_meshes.emplace_back(spr.yBoundMesh);
         break;
       case render::material::SpriteMaterialMode::Billboard:
-        m_meshes.emplace_back(spr.billboardMesh, nullptr);
+        m_meshes.emplace_back(spr.billboardMesh);
         break;
       case render::material::SpriteMaterialMode::InstancedBillboard:
-        m_meshes.emplace_back(spr.instancedBillboardMesh);
-        break;
+        // instanced particles are pooled per room, see InstancedParticleCollection
+        BOOST_THROW_EXCEPTION(std::domain_error("Particles cannot be instanced"));
       }
     }
   }
@@ -105,28 +103,20 @@ void Particle::initRenderables(world::World& world, const render::material::Spri
 
   if(!m_meshes.empty())
   {
-    setRenderable(std::get<0>(m_meshes.front()));
+    setRenderable(m_meshes.front());
     m_lighting.bind(*this, world);
   }
 }
 
-glm::vec3 Particle::getPosition() const
-{
-  return location.position.toRenderSystem();
-}
-
 Particle::Particle(const std::string& id,
                    const core::TypeId& objectNumber,
                    const gsl_lite::not_null<const world::Room*>& room,
                    world::World& world,
                    const render::material::SpriteMaterialMode mode,
-                   const bool withoutParent,
                    const std::shared_ptr<render::scene::Mesh>& renderable)
     : Node{id}
-    , Emitter{gsl_lite::not_null{world.getEngine().getPresenter().getSoundEngine().get().get()}}
     , location{room}
     , object_number{objectNumber}
-    , m_withoutParent{withoutParent}
 {
   if(renderable == nullptr)
   {
@@ -134,8 +124,8 @@ Particle::Particle(const std::string& id,
   }
   else
   {
-    m_meshes.emplace_back(gsl_lite::not_null{renderable}, nullptr);
-    setRenderable(std::get<0>(m_meshes.front()));
+    m_meshes.emplace_back(gsl_lite::not_null{renderable});
+    setRenderable(m_meshes.front());
     m_lighting.bind(*this, world);
   }
 }
@@ -145,13 +135,10 @@ Particle::Particle(const std::string& id,
                    Location location,
                    world::World& world,
                    const render::material::SpriteMaterialMode mode,
-                   const bool withoutParent,
                    const std::shared_ptr<render::scene::Mesh>& renderable)
     : Node{id}
-    , Emitter{gsl_lite::not_null{world.getEngine().getPresenter().getSoundEngine().get().get()}}
     , location{std::move(location)}
     , object_number{objectNumber}
-    , m_withoutParent{withoutParent}
 {
   if(renderable == nullptr)
   {
@@ -159,12 +146,27 @@ Particle::Particle(const std::string& id,
   }
   else
   {
-    m_meshes.emplace_back(renderable, nullptr);
-    setRenderable(std::get<0>(m_meshes.front()));
+    m_meshes.emplace_back(gsl_lite::not_null{renderable});
+    setRenderable(m_meshes.front());
     m_lighting.bind(*this, world);
   }
 }
 
+EmittingParticle::EmittingParticle(const std::string& id,
+                                   const core::TypeId& objectNumber,
+                                   Location location,
+                                   world::World& world,
+                                   const render::material::SpriteMaterialMode mode)
+    : Particle{id, objectNumber, std::move(location), world, mode}
+    , Emitter{gsl_lite::not_null{world.getEngine().getPresenter().getSoundEngine().get().get()}}
+{
+}
+
+glm::vec3 EmittingParticle::getPosition() const
+{
+  return location.position.toRenderSystem();
+}
+
 void Particle::applyLogicTransform()
 {
   location.updateRoom();
@@ -191,24 +193,13 @@ void Particle::interpolateTransform(const float interTickFactor)
   const auto pos = core::lerp(location.position, predictedPosition, interTickFactor);
   const auto rot = core::lerp(angle, predictedAngle, interTickFactor);
 
-  auto l = pos.toRenderSystem();
-  if(!m_withoutParent)
-    l -= location.room->position.toRenderSystem();
+  const auto l = pos.toRenderSystem() - location.room->position.toRenderSystem();
 
   auto transform = glm::scale(rot.toMatrix(), glm::vec3{scale});
   transform[3] = glm::vec4{l, 1.0f};
   setLocalMatrix(transform);
 }
 
-std::tuple<std::shared_ptr<render::scene::Mesh>, std::shared_ptr<gl::VertexBuffer<glm::mat4>>>
-  Particle::getCurrentMesh() const
-{
-  if(m_meshes.empty())
-    return {nullptr, nullptr};
-
-  return m_meshes.front();
-}
-
 void Particle::nextFrame()
 {
   --negSpriteFrameId;
@@ -216,16 +207,16 @@ void Particle::nextFrame()
   if(m_meshes.empty())
     return;
 
-  m_meshes.emplace_back(m_meshes.front());
-  m_meshes.pop_front();
-  setRenderable(std::get<0>(m_meshes.front()));
+  m_currentMesh = (m_currentMesh + 1) % m_meshes.size();
+  setRenderable(m_meshes[m_currentMesh]);
 }
 
 BloodSplatterParticle::BloodSplatterParticle(const Location& location,
                                              const core::Speed& speed_,
                                              const core::Angle& angle_,
                                              world::World& world)
-    : Particle{"blood-splat", TR1ItemId::Blood, location, world, render::material::SpriteMaterialMode::Billboard}
+    : EmittingParticle{
+        "blood-splat", TR1ItemId::Blood, location, world, render::material::SpriteMaterialMode::Billboard}
 {
   speed = speed_;
   angle.Y = angle_;
@@ -251,49 +242,8 @@ bool BloodSplatterParticle::updateLogic(world::World& world)
   return true;
 }
 
-bool SplashParticle::updateLogic(world::World& world)
-{
-  nextFrame();
-
-  if(gsl_lite::narrow<size_t>(-negSpriteFrameId)
-     >= world.getWorldGeometry().findSpriteSequenceForType(object_number)->sprites.size())
-  {
-    return false;
-  }
-
-  location.position += util::pitch(speed * 1_frame, angle.Y);
-
-  applyLogicTransform();
-  return true;
-}
-
-SplashParticle::SplashParticle(const Location& location, world::World& world, const bool waterfall)
-    : Particle{"splash", TR1ItemId::Splash, location, world, render::material::SpriteMaterialMode::YAxisBound}
-{
-  if(!waterfall)
-  {
-    speed = util::rand15(128_spd);
-    angle.Y = core::auToAngle(int16_t{2} * util::rand15s());
-  }
-  else
-  {
-    this->location.position.X += util::rand15s(1_sectors);
-    this->location.position.Z += util::rand15s(1_sectors);
-  }
-  getRenderState().setScissorTest(false);
-}
-
-BubbleParticle::BubbleParticle(const Location& location,
-                               world::World& world,
-                               const bool onlyInWater,
-                               const bool instanced)
-    : Particle{"bubble",
-               TR1ItemId::Bubbles,
-               location,
-               world,
-               instanced ? render::material::SpriteMaterialMode::InstancedBillboard
-                         : render::material::SpriteMaterialMode::Billboard,
-               instanced}
+BubbleParticle::BubbleParticle(const Location& location, world::World& world, const bool onlyInWater)
+    : Particle{"bubble", TR1ItemId::Bubbles, location, world, render::material::SpriteMaterialMode::Billboard}
     , m_onlyInWater{onlyInWater}
 {
   speed = 10_spd + util::rand15(6_spd);
@@ -325,7 +275,7 @@ bool BubbleParticle::updateLogic(world::World& world)
 }
 
 FlameParticle::FlameParticle(const Location& location, world::World& world, const bool randomize)
-    : Particle{"flame", TR1ItemId::Flame, location, world, render::material::SpriteMaterialMode::YAxisBound}
+    : EmittingParticle{"flame", TR1ItemId::Flame, location, world, render::material::SpriteMaterialMode::YAxisBound}
 {
   timePerSpriteFrame = 0;
   negSpriteFrameId = 0;
@@ -388,8 +338,7 @@ bool FlameParticle::updateLogic(world::World& world)
         {
           const auto particle = gsl_lite::make_shared<FlameParticle>(location, world);
           particle->timePerSpriteFrame = -1;
-          if(!withoutParent())
-            setParent(particle, location.room->node);
+          setParent(particle, location.room->node);
           world.getObjectManager().registerParticle(particle);
         }
       }
@@ -461,16 +410,14 @@ bool MeshShrapnelParticle::updateLogic(world::World& world)
     lara.explosionStumblingDuration = 5_frame;
   }
 
-  if(!withoutParent())
-    setParent(this, location.room->node);
+  setParent(this, location.room->node);
   applyLogicTransform();
 
   if(!explode)
     return true;
 
   const auto particle = gsl_lite::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-  if(!withoutParent())
-    setParent(particle, location.room->node);
+  setParent(particle, location.room->node);
   world.getObjectManager().registerParticle(particle);
   world.getAudioEngine().playSoundEffect(TR1SoundEffect::ShrapnelExplosion, particle.get().get());
   return false;
@@ -486,7 +433,6 @@ MeshShrapnelParticle::MeshShrapnelParticle(const Location& location,
                location,
                world,
                render::material::SpriteMaterialMode::YAxisBound,
-               false,
                renderable}
     , m_damageRadius{damageRadius}
 {
@@ -520,16 +466,14 @@ bool MutantBulletParticle::updateLogic(world::World& world)
 {
   location.position += util::yawPitch(speed * 1_frame, angle);
   const auto sector = location.updateRoom();
-  if(!withoutParent())
-    setParent(this, location.room->node);
+  setParent(this, location.room->node);
   if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
     const auto particle = gsl_lite::make_shared<RicochetParticle>(location, world);
     particle->timePerSpriteFrame = 6;
-    if(!withoutParent())
-      setParent(particle, location.room->node);
+    setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
     world.getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, particle.get().get());
     return false;
@@ -539,8 +483,7 @@ bool MutantBulletParticle::updateLogic(world::World& world)
     world.hitLara(30_hp);
     const auto& laraState = world.getObjectManager().getLara().m_state;
     const auto particle = gsl_lite::make_shared<BloodSplatterParticle>(location, speed, angle.Y, world);
-    if(!withoutParent())
-      setParent(particle, location.room->node);
+    setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
     world.getAudioEngine().playSoundEffect(TR1SoundEffect::BulletHitsLara, particle.get().get());
     angle.Y = laraState.rotation.Y;
@@ -558,15 +501,13 @@ bool MutantGrenadeParticle::updateLogic(world::World& world)
 {
   location.position += util::yawPitch(speed * 1_frame, angle);
   const auto sector = location.updateRoom();
-  if(!withoutParent())
-    setParent(this, location.room->node);
+  setParent(this, location.room->node);
   if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
     const auto particle = gsl_lite::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-    if(!withoutParent())
-      setParent(particle, location.room->node);
+    setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
     world.getAudioEngine().playSoundEffect(TR1SoundEffect::ShrapnelExplosion, particle.get().get());
 
@@ -582,8 +523,7 @@ bool MutantGrenadeParticle::updateLogic(world::World& world)
   {
     world.hitLara(100_hp);
     const auto particle = gsl_lite::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
-    if(!withoutParent())
-      setParent(particle, location.room->node);
+    setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
     world.getAudioEngine().playSoundEffect(TR1SoundEffect::ShrapnelExplosion, particle.get().get());
 
@@ -620,8 +560,7 @@ bool LavaParticle::updateLogic(world::World& world)
   location.position += util::pitch(speed * 1_frame, angle.Y, fall_speed * 1_frame);
 
   const auto sector = location.updateRoom();
-  if(!withoutParent())
-    setParent(this, location.room->node);
+  setParent(this, location.room->node);
   if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           > location.position.Y)
@@ -681,7 +620,8 @@ ExplosionParticle::ExplosionParticle(const Location& location,
                                      world::World& world,
                                      const core::Speed& fallSpeed,
                                      const core::TRRotation& angle)
-    : Particle{"explosion", TR1ItemId::Explosion, location, world, render::material::SpriteMaterialMode::Billboard}
+    : EmittingParticle{
+        "explosion", TR1ItemId::Explosion, location, world, render::material::SpriteMaterialMode::Billboard}
 {
   fall_speed = fallSpeed;
   this->angle = angle;
@@ -704,27 +644,9 @@ bool ExplosionParticle::updateLogic(world::World&)
   return true;
 }
 
-SmokeParticle::SmokeParticle(const Location& location, world::World& world, const core::TRRotation& rotation)
-    : Particle{"smoke", TR1ItemId::Smoke, location, world, render::material::SpriteMaterialMode::YAxisBound}
-{
-  angle = rotation;
-}
-
-bool SmokeParticle::updateLogic(world::World&)
-{
-  applyLogicTransform();
-
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame < 3)
-    return true;
-
-  timePerSpriteFrame = 0;
-  nextFrame();
-  return gsl_lite::narrow<size_t>(-negSpriteFrameId) < getLength();
-}
-
 RicochetParticle::RicochetParticle(const Location& location, world::World& world)
-    : Particle{"ricochet", TR1ItemId::Ricochet, location, world, render::material::SpriteMaterialMode::YAxisBound}
+    : EmittingParticle{
+        "ricochet", TR1ItemId::Ricochet, location, world, render::material::SpriteMaterialMode::YAxisBound}
 {
   timePerSpriteFrame = 4;
 
@@ -11,15 +11,13 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <deque>
-#include <gl/soglb_fwd.h>
 #include <glm/fwd.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
 #include <optional>
 #include <string>
-#include <tuple>
+#include <vector>
 
 namespace render::scene
 {
@@ -39,9 +37,7 @@ struct Room;
 
 namespace engine
 {
-class Particle
-    : public render::scene::Node
-    , public audio::Emitter
+class Particle : public render::scene::Node
 {
 public:
   Location location;
@@ -55,13 +51,11 @@ public:
   int16_t timePerSpriteFrame = 0;
   float scale = 1.0f;
 
-  std::tuple<std::shared_ptr<render::scene::Mesh>, std::shared_ptr<gl::VertexBuffer<glm::mat4>>> getCurrentMesh() const;
-
 private:
-  std::deque<std::tuple<gslu::nn_shared<render::scene::Mesh>, std::shared_ptr<gl::VertexBuffer<glm::mat4>>>> m_meshes;
+  std::vector<gslu::nn_shared<render::scene::Mesh>> m_meshes;
+  size_t m_currentMesh = 0;
   Lighting m_lighting;
   std::optional<core::Shade> m_shade{std::nullopt};
-  bool m_withoutParent;
 
   void initRenderables(world::World& world, render::material::SpriteMaterialMode mode);
 
@@ -76,6 +70,7 @@ protected:
   void clearMeshes() noexcept
   {
     m_meshes.clear();
+    m_currentMesh = 0;
   }
 
 public:
@@ -84,7 +79,6 @@ public:
                     const gsl_lite::not_null<const world::Room*>& room,
                     world::World& world,
                     render::material::SpriteMaterialMode mode,
-                    bool withoutParent = false,
                     const std::shared_ptr<render::scene::Mesh>& renderable = nullptr);
 
   explicit Particle(const std::string& id,
@@ -92,7 +86,6 @@ public:
                     Location location,
                     world::World& world,
                     render::material::SpriteMaterialMode mode,
-                    bool withoutParent = false,
                     const std::shared_ptr<render::scene::Mesh>& renderable = nullptr);
 
   void setShade(const core::Shade& shade) noexcept
@@ -102,37 +95,42 @@ public:
 
   virtual bool updateLogic(world::World& world) = 0;
 
-  glm::vec3 getPosition() const final;
-
   void applyLogicTransform();
   void interpolateTransform(float interTickFactor);
-
-  [[nodiscard]] bool withoutParent() const noexcept
-  {
-    return m_withoutParent;
-  }
 };
 
-class BloodSplatterParticle final : public Particle
+/**
+ * @brief A particle which is used as the source of sound effects.
+ *
+ * Particles which never play sounds don't derive from this, so they are not registered with the sound engine.
+ */
+class EmittingParticle
+    : public Particle
+    , public audio::Emitter
 {
 public:
-  explicit BloodSplatterParticle(const Location& location,
-                                 const core::Speed& speed_,
-                                 const core::Angle& angle_,
-                                 world::World& world);
+  glm::vec3 getPosition() const final;
 
-  bool updateLogic(world::World& world) override;
+protected:
+  explicit EmittingParticle(const std::string& id,
+                            const core::TypeId& objectNumber,
+                            Location location,
+                            world::World& world,
+                            render::material::SpriteMaterialMode mode);
 };
 
-class SplashParticle final : public Particle
+class BloodSplatterParticle final : public EmittingParticle
 {
 public:
-  explicit SplashParticle(const Location& location, world::World& world, bool waterfall);
+  explicit BloodSplatterParticle(const Location& location,
+                                 const core::Speed& speed_,
+                                 const core::Angle& angle_,
+                                 world::World& world);
 
   bool updateLogic(world::World& world) override;
 };
 
-class RicochetParticle final : public Particle
+class RicochetParticle final : public EmittingParticle
 {
 public:
   explicit RicochetParticle(const Location& location, world::World& world);
@@ -143,10 +141,7 @@ public:
 class BubbleParticle final : public Particle
 {
 public:
-  explicit BubbleParticle(const Location& location,
-                          world::World& world,
-                          bool onlyInWater = true,
-                          bool instanced = false);
+  explicit BubbleParticle(const Location& location, world::World& world, bool onlyInWater = true);
 
   bool updateLogic(world::World& world) override;
 
@@ -172,7 +167,7 @@ public:
   bool updateLogic(world::World& /*world*/) override;
 };
 
-class FlameParticle final : public Particle
+class FlameParticle final : public EmittingParticle
 {
 public:
   explicit FlameParticle(const Location& location, world::World& world, bool randomize = false);
@@ -180,7 +175,7 @@ public:
   bool updateLogic(world::World& world) override;
 };
 
-class ExplosionParticle final : public Particle
+class ExplosionParticle final : public EmittingParticle
 {
 public:
   explicit ExplosionParticle(const Location& location,
@@ -251,14 +246,6 @@ public:
   bool updateLogic(world::World& world) override;
 };
 
-class SmokeParticle final : public Particle
-{
-public:
-  explicit SmokeParticle(const Location& location, world::World& world, const core::TRRotation& rotation);
-
-  bool updateLogic(world::World& /*world*/) override;
-};
-
 extern gslu::nn_shared<Particle>
   createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle);
 
@@ -1,20 +1,35 @@
 #include "particlecollection.h"
 
+#include "core/angle.h"
+#include "core/id.h"
+#include "core/magic.h"
 #include "core/units.h"
+#include "heightinfo.h"
+#include "items_tr1.h"
 #include "lighting.h"
 #include "location.h"
+#include "objectmanager.h"
 #include "particle.h"
 #include "render/scene/mesh.h"
 #include "render/scene/node.h"
+#include "util/helpers.h"
 #include "world/room.h"
+#include "world/sprite.h"
+#include "world/world.h"
+#include "world/worldgeometry.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <gl/debuggroup.h>
+#include <gl/renderstate.h>
 #include <gl/vertexbuffer.h>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
-#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -41,12 +56,15 @@ void ParticleCollection::eraseParticle(const std::shared_ptr<Particle>& particle
 
 void ParticleCollection::update(world::World& world)
 {
-  for(const auto currentParticles = std::move(m_particles); const auto& particle : currentParticles)
+  // particles may register new particles while being updated, which are appended between the surviving ones just
+  // like before; both vectors keep their capacity across ticks
+  gsl_Assert(m_updating.empty());
+  m_updating.swap(m_particles);
+  for(const auto& particle : m_updating)
   {
     if(particle->updateLogic(world))
     {
-      if(!particle->withoutParent())
-        setParent(particle, particle->location.room->node);
+      setParent(particle, particle->location.room->node);
       m_particles.emplace_back(particle);
     }
     else
@@ -54,10 +72,109 @@ void ParticleCollection::update(world::World& world)
       setParent(particle, nullptr);
     }
   }
+  m_updating.clear();
 }
 
 ParticleCollection::~ParticleCollection() = default;
 
+InstancedParticleCollection::InstancedParticleCollection()
+    : m_lighting{std::make_unique<Lighting>()}
+    , m_node{std::make_shared<render::scene::Node>("bubble-instances")}
+{
+}
+
+InstancedParticleCollection::~InstancedParticleCollection() = default;
+InstancedParticleCollection::InstancedParticleCollection(InstancedParticleCollection&&) noexcept = default;
+InstancedParticleCollection& InstancedParticleCollection::operator=(InstancedParticleCollection&&) noexcept = default;
+
+size_t InstancedParticleCollection::emitBubble(const world::Room& room,
+                                               const core::TRVec& position,
+                                               const bool onlyInWater,
+                                               const float scale,
+                                               const core::Length& circleRadius)
+{
+  m_positions.emplace_back(position);
+  m_angles.emplace_back(0_deg, 0_deg, 0_deg);
+  m_speeds.emplace_back(10_spd + util::rand15(6_spd));
+  m_circleRadii.emplace_back(circleRadius);
+  m_scales.emplace_back(scale);
+  m_spriteFrames.emplace_back(gsl_lite::narrow_cast<uint8_t>(util::rand15(3)));
+  m_onlyInWater.emplace_back(onlyInWater ? 1 : 0);
+  m_rooms.emplace_back(&room);
+  return m_positions.size() - 1;
+}
+
+void InstancedParticleCollection::remove(const size_t i)
+{
+  const auto swapRemove = [i](auto& column)
+  {
+    column[i] = std::move(column.back());
+    column.pop_back();
+  };
+
+  swapRemove(m_positions);
+  swapRemove(m_angles);
+  swapRemove(m_speeds);
+  swapRemove(m_circleRadii);
+  swapRemove(m_scales);
+  swapRemove(m_spriteFrames);
+  swapRemove(m_onlyInWater);
+  swapRemove(m_rooms);
+}
+
+void InstancedParticleCollection::update(const world::World& world)
+{
+  const auto& objects = world.getObjectManager().getObjects();
+  for(size_t i = 0; i < m_positions.size();)
+  {
+    m_angles[i].X += 13_deg;
+    m_angles[i].Y += 9_deg;
+    m_positions[i] += util::pitch(m_circleRadii[i], m_angles[i].Y, -m_speeds[i] * 1_frame);
+
+    Location location{gsl_lite::not_null{m_rooms[i]}, m_positions[i]};
+    const auto sector = location.updateRoom();
+    m_rooms[i] = location.room.get();
+    if(m_onlyInWater[i] != 0 && !location.room->isWaterRoom)
+    {
+      remove(i);
+      continue;
+    }
+
+    if(const auto ceiling = HeightInfo::fromCeiling(sector, m_positions[i], objects).y;
+       ceiling == core::InvalidHeight || m_positions[i].Y <= ceiling)
+    {
+      remove(i);
+      continue;
+    }
+
+    ++i;
+  }
+}
+
+void InstancedParticleCollection::transferToCurrentRooms(const world::Room& room)
+{
+  for(size_t i = 0; i < m_positions.size();)
+  {
+    const auto target = m_rooms[i];
+    if(target == &room)
+    {
+      ++i;
+      continue;
+    }
+
+    auto& other = target->particles;
+    other.m_positions.emplace_back(m_positions[i]);
+    other.m_angles.emplace_back(m_angles[i]);
+    other.m_speeds.emplace_back(m_speeds[i]);
+    other.m_circleRadii.emplace_back(m_circleRadii[i]);
+    other.m_scales.emplace_back(m_scales[i]);
+    other.m_spriteFrames.emplace_back(m_spriteFrames[i]);
+    other.m_onlyInWater.emplace_back(m_onlyInWater[i]);
+    other.m_rooms.emplace_back(target);
+    remove(i);
+  }
+}
+
 void InstancedParticleCollection::render(const std::string& roomName,
                                          render::scene::RenderContext& context,
                                          const world::World& world) const
@@ -65,43 +182,269 @@ void InstancedParticleCollection::render(const std::string& roomName,
   if(empty())
     return;
 
+  const auto& spriteSequence = world.getWorldGeometry().findSpriteSequenceForType(TR1ItemId::Bubbles);
+  if(spriteSequence == nullptr || spriteSequence->sprites.empty())
+    return;
+
   SOGLB_DEBUGGROUP(roomName + ":bubble-instances");
-  std::map<std::shared_ptr<gl::VertexBuffer<glm::mat4>>, std::tuple<std::vector<glm::mat4>, gslu::nn_shared<Particle>>>
-    buffersData;
-  for(const auto& particle : *this)
+
+  if(!m_lightingBound)
+  {
+    m_lighting->bind(*m_node, world);
+    m_lightingBound = true;
+  }
+
+  const auto& sprites = spriteSequence->sprites;
+  m_instanceData.resize(sprites.size());
+  for(auto& data : m_instanceData)
+    data.clear();
+
+  for(size_t i = 0; i < m_positions.size(); ++i)
   {
-    setParent(particle, nullptr);
-    auto buffer = std::get<1>(particle->getCurrentMesh());
-    if(buffer == nullptr)
+    // the billboard faces the camera, but the shaders derive the world position and normals from the whole matrix
+    auto transform = glm::scale(m_angles[i].toMatrix(), glm::vec3{m_scales[i]});
+    transform[3] = glm::vec4{m_positions[i].toRenderSystem(), 1.0f};
+    m_instanceData[m_spriteFrames[i] % sprites.size()].emplace_back(transform);
+  }
+
+  for(size_t frame = 0; frame < sprites.size(); ++frame)
+  {
+    const auto& data = m_instanceData[frame];
+    const auto& [mesh, buffer] = sprites[frame].instancedBillboardMesh;
+    if(data.empty() || mesh == nullptr || buffer == nullptr)
       continue;
-    particle->applyLogicTransform();
-    if(const auto it = buffersData.find(gsl_lite::not_null{buffer}); it != buffersData.end())
+
+    // the instance buffers are shared between all rooms and have a fixed size
+    const auto capacity = gsl_lite::narrow<size_t>(buffer->size());
+    gsl_Assert(capacity > 0);
+    for(size_t start = 0; start < data.size(); start += capacity)
     {
-      std::get<0>(it->second).emplace_back(particle->getTransform().modelMatrix);
+      const auto count = std::min(data.size() - start, capacity);
+      buffer->setSubData(gsl_lite::span<const glm::mat4>{data.data() + start, count}, 0);
+      mesh->render(m_node.get(), context, gsl_lite::narrow<gl::api::core::SizeType>(count));
     }
-    else
+  }
+}
+
+void InstancedParticleCollection::setAmbient(const world::Room& room)
+{
+  m_lighting->ambient = toBrightness(room.ambientShade);
+  m_lighting->update(core::Shade{static_cast<core::Shade::type>(-1)}, room);
+}
+
+SpriteParticleCollection::SpriteParticleCollection()
+    : m_lighting{std::make_unique<Lighting>()}
+    , m_node{std::make_shared<render::scene::Node>("sprite-particles")}
+{
+}
+
+SpriteParticleCollection::~SpriteParticleCollection() = default;
+SpriteParticleCollection::SpriteParticleCollection(SpriteParticleCollection&&) noexcept = default;
+SpriteParticleCollection& SpriteParticleCollection::operator=(SpriteParticleCollection&&) noexcept = default;
+
+void SpriteParticleCollection::Pool::emit(const world::Room& room,
+                                          const core::TRVec& position,
+                                          const core::TRRotation& angle,
+                                          const core::Speed& speed)
+{
+  positions.emplace_back(position);
+  angles.emplace_back(angle);
+  speeds.emplace_back(speed);
+  spriteFrames.emplace_back(0);
+  ticks.emplace_back(0);
+  rooms.emplace_back(&room);
+}
+
+void SpriteParticleCollection::Pool::remove(const size_t i)
+{
+  const auto swapRemove = [i](auto& column)
+  {
+    column[i] = std::move(column.back());
+    column.pop_back();
+  };
+
+  swapRemove(positions);
+  swapRemove(angles);
+  swapRemove(speeds);
+  swapRemove(spriteFrames);
+  swapRemove(ticks);
+  swapRemove(rooms);
+}
+
+void SpriteParticleCollection::Pool::transferToCurrentRooms(const world::Room& room,
+                                                            Pool SpriteParticleCollection::* const pool)
+{
+  for(size_t i = 0; i < positions.size();)
+  {
+    const auto target = rooms[i];
+    if(target == &room)
     {
-      buffersData.emplace(gsl_lite::not_null{buffer},
-                          std::tuple{std::vector{particle->getTransform().modelMatrix}, particle});
+      ++i;
+      continue;
     }
+
+    auto& other = target->spriteParticles.*pool;
+    other.positions.emplace_back(positions[i]);
+    other.angles.emplace_back(angles[i]);
+    other.speeds.emplace_back(speeds[i]);
+    other.spriteFrames.emplace_back(spriteFrames[i]);
+    other.ticks.emplace_back(ticks[i]);
+    other.rooms.emplace_back(target);
+    remove(i);
   }
+}
 
-  for(const auto& [buffer, dataRenderable] : buffersData)
+void SpriteParticleCollection::emitSplash(const world::Room& room, const core::TRVec& position, const bool waterfall)
+{
+  if(!waterfall)
+  {
+    const auto speed = util::rand15(128_spd);
+    const auto angle = core::auToAngle(int16_t{2} * util::rand15s());
+    m_splashes.emit(room, position, core::TRRotation{0_deg, angle, 0_deg}, speed);
+  }
+  else
   {
-    auto [data, particle] = dataRenderable;
-    if(data.empty())
+    auto spread = position;
+    spread.X += util::rand15s(1_sectors);
+    spread.Z += util::rand15s(1_sectors);
+    m_splashes.emit(room, spread, core::TRRotation{0_deg, 0_deg, 0_deg}, 0_spd);
+  }
+}
+
+void SpriteParticleCollection::emitSmoke(const world::Room& room,
+                                         const core::TRVec& position,
+                                         const core::TRRotation& rotation)
+{
+  m_smoke.emit(room, position, rotation, 0_spd);
+}
+
+void SpriteParticleCollection::update(const world::World& world)
+{
+  updateSplashes(world);
+  updateSmoke(world);
+}
+
+void SpriteParticleCollection::updateSplashes(const world::World& world)
+{
+  const auto& spriteSequence = world.getWorldGeometry().findSpriteSequenceForType(TR1ItemId::Splash);
+  const size_t frameCount = spriteSequence == nullptr ? 0 : spriteSequence->sprites.size();
+
+  // each tick shows the next frame, and the splash vanishes after the last one
+  for(size_t i = 0; i < m_splashes.positions.size();)
+  {
+    ++m_splashes.spriteFrames[i];
+    if(m_splashes.spriteFrames[i] >= frameCount)
+    {
+      m_splashes.remove(i);
       continue;
+    }
 
-    m_lighting.bind(*particle, world);
-    buffer->setSubData(data, 0);
-    const auto mesh = std::get<0>(particle->getCurrentMesh());
-    mesh->render(particle.get().get(), context, gsl_lite::narrow<gl::api::core::SizeType>(data.size()));
+    m_splashes.positions[i] += util::pitch(m_splashes.speeds[i] * 1_frame, m_splashes.angles[i].Y);
+    Location location{gsl_lite::not_null{m_splashes.rooms[i]}, m_splashes.positions[i]};
+    location.updateRoom();
+    m_splashes.rooms[i] = location.room.get();
+    ++i;
   }
 }
 
-void InstancedParticleCollection::setAmbient(const world::Room& room)
+void SpriteParticleCollection::updateSmoke(const world::World& world)
+{
+  const auto& spriteSequence = world.getWorldGeometry().findSpriteSequenceForType(TR1ItemId::Smoke);
+  const size_t frameCount = spriteSequence == nullptr ? 0 : spriteSequence->sprites.size();
+
+  // smoke doesn't move, and shows each frame for three ticks
+  for(size_t i = 0; i < m_smoke.positions.size();)
+  {
+    Location location{gsl_lite::not_null{m_smoke.rooms[i]}, m_smoke.positions[i]};
+    location.updateRoom();
+    m_smoke.rooms[i] = location.room.get();
+
+    ++m_smoke.ticks[i];
+    if(m_smoke.ticks[i] < 3)
+    {
+      ++i;
+      continue;
+    }
+
+    m_smoke.ticks[i] = 0;
+    ++m_smoke.spriteFrames[i];
+    if(m_smoke.spriteFrames[i] >= frameCount)
+    {
+      m_smoke.remove(i);
+      continue;
+    }
+
+    ++i;
+  }
+}
+
+void SpriteParticleCollection::transferToCurrentRooms(const world::Room& room)
 {
-  m_lighting.ambient = toBrightness(room.ambientShade);
-  m_lighting.update(core::Shade{static_cast<core::Shade::type>(-1)}, room);
+  m_splashes.transferToCurrentRooms(room, &SpriteParticleCollection::m_splashes);
+  m_smoke.transferToCurrentRooms(room, &SpriteParticleCollection::m_smoke);
+}
+
+void SpriteParticleCollection::render(const std::string& roomName,
+                                      render::scene::RenderContext& context,
+                                      const world::World& world) const
+{
+  if(empty())
+    return;
+
+  SOGLB_DEBUGGROUP(roomName + ":sprite-particles");
+
+  if(!m_lightingBound)
+  {
+    m_lighting->bind(*m_node, world);
+    m_lightingBound = true;
+  }
+
+  // splashes of waterfalls extend beyond the portals they are seen through
+  gl::RenderState splashState;
+  splashState.setScissorTest(false);
+  context.pushState(splashState);
+  render(m_splashes, TR1ItemId::Splash, context, world);
+  context.popState();
+
+  render(m_smoke, TR1ItemId::Smoke, context, world);
+}
+
+void SpriteParticleCollection::setAmbient(const world::Room& room)
+{
+  m_lighting->ambient = toBrightness(room.ambientShade);
+  m_lighting->update(core::Shade{static_cast<core::Shade::type>(-1)}, room);
+}
+
+void SpriteParticleCollection::render(const Pool& pool,
+                                      const core::TypeId& type,
+                                      render::scene::RenderContext& context,
+                                      const world::World& world) const
+{
+  if(pool.positions.empty())
+    return;
+
+  const auto& spriteSequence = world.getWorldGeometry().findSpriteSequenceForType(type);
+  if(spriteSequence == nullptr || spriteSequence->sprites.empty())
+    return;
+
+  const auto& sprites = spriteSequence->sprites;
+  for(size_t i = 0; i < pool.positions.size(); ++i)
+  {
+    const auto& mesh = sprites[pool.spriteFrames[i] % sprites.size()].yBoundMesh;
+    if(mesh == nullptr)
+      continue;
+
+    auto position = pool.positions[i];
+    if(pool.speeds[i] != 0_spd)
+    {
+      const auto predicted = position + util::pitch(pool.speeds[i] * 1_frame, pool.angles[i].Y);
+      position = core::lerp(position, predicted, m_interTickFactor);
+    }
+
+    auto transform = pool.angles[i].toMatrix();
+    transform[3] = glm::vec4{position.toRenderSystem(), 1.0f};
+    m_node->setLocalMatrix(transform);
+    mesh->render(m_node.get(), context);
+  }
 }
-} // namespace engine
\ No newline at end of file
+} // namespace engine
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "core/angle.h"
+#include "core/id.h"
+#include "core/units.h"
+#include "core/vec.h"
 #include "lighting.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
 #include <gslu.h>
 #include <memory>
 #include <string>
@@ -16,6 +23,7 @@ class World;
 
 namespace render::scene
 {
+class Node;
 class RenderContext;
 } // namespace render::scene
 
@@ -23,10 +31,10 @@ namespace engine
 {
 class Particle;
 
-class ParticleCollection
+class ParticleCollection final
 {
 public:
-  virtual ~ParticleCollection();
+  ~ParticleCollection();
 
   void registerParticle(const gslu::nn_shared<Particle>& particle)
   {
@@ -59,15 +67,171 @@ public:
 
 private:
   std::vector<gslu::nn_shared<Particle>> m_particles;
+  //! @brief The particles being updated; only non-empty during update().
+  std::vector<gslu::nn_shared<Particle>> m_updating;
 };
 
-class InstancedParticleCollection : public ParticleCollection
+/**
+ * @brief Pooled bubbles of a room, rendered as instanced billboards.
+ *
+ * Bubbles are purely cosmetic and may exist by the thousands, so they are neither scene nodes nor sound emitters.
+ * Their state is kept as a structure of arrays, updated by a single kernel, and dead bubbles are removed by swapping
+ * in the last one. The per-sprite instance data keeps its capacity across frames.
+ */
+class InstancedParticleCollection final
 {
 public:
+  InstancedParticleCollection();
+  ~InstancedParticleCollection();
+
+  InstancedParticleCollection(const InstancedParticleCollection&) = delete;
+  InstancedParticleCollection(InstancedParticleCollection&&) noexcept;
+  InstancedParticleCollection& operator=(const InstancedParticleCollection&) = delete;
+  InstancedParticleCollection& operator=(InstancedParticleCollection&&) noexcept;
+
+  /**
+   * @param room The room containing @a position.
+   * @param onlyInWater Whether the bubble bursts when leaving water.
+   * @return The index of the new bubble, valid until the next update.
+   */
+  size_t emitBubble(const world::Room& room,
+                    const core::TRVec& position,
+                    bool onlyInWater,
+                    float scale = 1.0f,
+                    const core::Length& circleRadius = 11_len);
+
+  void setScale(const size_t i, const float scale)
+  {
+    m_scales.at(i) = scale;
+  }
+
+  void update(const world::World& world);
+
+  /**
+   * @brief Moves the bubbles which floated into other rooms to the collections of these rooms.
+   * @param room The room owning this collection.
+   */
+  void transferToCurrentRooms(const world::Room& room);
+
   void render(const std::string& roomName, render::scene::RenderContext& context, const world::World& world) const;
   void setAmbient(const world::Room& room);
 
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_positions.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_positions.empty();
+  }
+
 private:
-  Lighting m_lighting;
+  void remove(size_t i);
+
+  std::vector<core::TRVec> m_positions;
+  //! @brief Only X and Y are used; X only affects the rendering.
+  std::vector<core::TRRotation> m_angles;
+  std::vector<core::Speed> m_speeds;
+  std::vector<core::Length> m_circleRadii;
+  std::vector<float> m_scales;
+  std::vector<uint8_t> m_spriteFrames;
+  std::vector<uint8_t> m_onlyInWater;
+  std::vector<const world::Room*> m_rooms;
+
+  //! @brief Lighting and node are heap-allocated, as the lighting bindings of the node refer to them.
+  std::unique_ptr<Lighting> m_lighting;
+  std::shared_ptr<render::scene::Node> m_node;
+  mutable bool m_lightingBound = false;
+  mutable std::vector<std::vector<glm::mat4>> m_instanceData;
+};
+
+/**
+ * @brief Pooled splashes and smoke puffs of a room.
+ *
+ * Like the bubbles, they neither play sounds nor interact with anything, so they are kept as structures of arrays
+ * instead of scene nodes and sound emitters. Splashes and smoke have their own update kernels. There is no instanced
+ * variant of the Y axis bound sprite material, so they are drawn one by one with a single node whose matrix is set
+ * before each draw.
+ */
+class SpriteParticleCollection final
+{
+public:
+  SpriteParticleCollection();
+  ~SpriteParticleCollection();
+
+  SpriteParticleCollection(const SpriteParticleCollection&) = delete;
+  SpriteParticleCollection(SpriteParticleCollection&&) noexcept;
+  SpriteParticleCollection& operator=(const SpriteParticleCollection&) = delete;
+  SpriteParticleCollection& operator=(SpriteParticleCollection&&) noexcept;
+
+  /**
+   * @param room The room containing @a position.
+   * @param waterfall Whether the splash is spread around @a position instead of moving away from it.
+   */
+  void emitSplash(const world::Room& room, const core::TRVec& position, bool waterfall);
+  void emitSmoke(const world::Room& room, const core::TRVec& position, const core::TRRotation& rotation);
+
+  void update(const world::World& world);
+
+  /**
+   * @brief Moves the particles which moved into other rooms to the collections of these rooms.
+   * @param room The room owning this collection.
+   */
+  void transferToCurrentRooms(const world::Room& room);
+
+  void setInterTickFactor(const float interTickFactor) noexcept
+  {
+    m_interTickFactor = interTickFactor;
+  }
+
+  void render(const std::string& roomName, render::scene::RenderContext& context, const world::World& world) const;
+  void setAmbient(const world::Room& room);
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_splashes.positions.size() + m_smoke.positions.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_splashes.positions.empty() && m_smoke.positions.empty();
+  }
+
+private:
+  struct Pool
+  {
+    std::vector<core::TRVec> positions;
+    std::vector<core::TRRotation> angles;
+    //! @brief Horizontal speed along the Y angle.
+    std::vector<core::Speed> speeds;
+    std::vector<uint16_t> spriteFrames;
+    //! @brief Ticks since the last sprite frame change.
+    std::vector<uint8_t> ticks;
+    std::vector<const world::Room*> rooms;
+
+    void emit(const world::Room& room,
+              const core::TRVec& position,
+              const core::TRRotation& angle,
+              const core::Speed& speed);
+    void remove(size_t i);
+    void transferToCurrentRooms(const world::Room& room, Pool SpriteParticleCollection::* pool);
+  };
+
+  void updateSplashes(const world::World& world);
+  void updateSmoke(const world::World& world);
+  void render(const Pool& pool,
+              const core::TypeId& type,
+              render::scene::RenderContext& context,
+              const world::World& world) const;
+
+  Pool m_splashes;
+  Pool m_smoke;
+  float m_interTickFactor = 0;
+
+  //! @brief Lighting and node are heap-allocated, as the lighting bindings of the node refer to them.
+  std::unique_ptr<Lighting> m_lighting;
+  std::shared_ptr<render::scene::Node> m_node;
+  mutable bool m_lightingBound = false;
 };
 } // namespace engine
@@ -36,12 +36,16 @@
 #include "ui/text.h"
 #include "ui/ui.h"
 #include "util/helpers.h"
+#include "util/profiler.h"
 #include "video/videoplayer.h"
+#include "world/potentiallyvisibleset.h"
 #include "world/room.h"
+#include "world/world.h"
 
 #include <algorithm>
 #include <array>
 #include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -71,6 +75,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -189,13 +194,21 @@ void Presenter::renderWorldGeometryFramebuffers(const std::vector<world::Room>&
                                                 const std::unordered_set<const world::Portal*>& waterSurfacePortals,
                                                 const world::World& world)
 {
+  UTIL_PROFILE_ZONE("Presenter::renderWorldGeometryFramebuffers");
+
   m_renderSystem->getRenderPipeline().updateCameraData(m_renderSystem->getCamera());
 
-  renderCsmBuffers(visibleRooms);
+  // shadow casters are only rendered for rooms which may be visible from the camera room; cinematic cameras are not
+  // bound to the room they are in, so all visible rooms cast shadows then
+  std::optional<std::span<const uint32_t>> potentiallyVisibleRooms;
+  if(cameraController.getMode() != CameraMode::Cinematic)
+    potentiallyVisibleRooms = world.getPotentiallyVisibleSet().getVisibleRooms(cameraController.getCurrentRoom());
+  renderCsmBuffers(visibleRooms, potentiallyVisibleRooms);
 
   m_renderSystem->getRenderPipeline().renderGeometryFrameBuffer(
     [this, &world, &cameraController, &visibleRooms]
     {
+      UTIL_PROFILE_ZONE("geometry-pass");
       prefillDepthBuffer(cameraController, visibleRooms);
       renderGeometry(world, visibleRooms);
     },
@@ -204,6 +217,7 @@ void Presenter::renderWorldGeometryFramebuffers(const std::vector<world::Room>&
   m_renderSystem->getRenderPipeline().renderPortalFrameBuffer(
     [&cameraController, &waterSurfacePortals](const gl::RenderState& fbRenderState)
     {
+      UTIL_PROFILE_ZONE("portal-pass");
       gl::RenderState::resetWantedState();
 
       for(const auto translucencySelector :
@@ -222,13 +236,18 @@ void Presenter::renderWorldGeometryFramebuffers(const std::vector<world::Room>&
       }
     });
 
-  m_renderSystem->getRenderPipeline().renderWorldCompositionPassToBackbuffer(
-    visibleRooms, cameraController.getCurrentRoom()->isWaterRoom);
+  {
+    UTIL_PROFILE_ZONE("composition-pass");
+    m_renderSystem->getRenderPipeline().renderWorldCompositionPassToBackbuffer(
+      visibleRooms, cameraController.getCurrentRoom()->isWaterRoom);
+  }
   m_screenOverlay.reset();
 }
 
-void Presenter::renderCsmBuffers(const std::vector<world::Room>& visibleRooms)
+void Presenter::renderCsmBuffers(const std::vector<world::Room>& visibleRooms,
+                                 const std::optional<std::span<const uint32_t>>& potentiallyVisibleRooms)
 {
+  UTIL_PROFILE_ZONE("csm-pass");
   gl::RenderState::resetWantedState();
   gl::RenderState::getWantedState().setDepthClamp(true);
   m_renderSystem->getCSM().updateCamera(*m_renderSystem->getCamera());
@@ -237,7 +256,7 @@ void Presenter::renderCsmBuffers(const std::vector<world::Room>& visibleRooms)
   {
     m_renderSystem->getCSM().setActiveSplit(i);
     m_renderSystem->getCSM().renderToActiveDepthBuffer(
-      [&visibleRooms](const gl::RenderState& fbRenderState, const glm::mat4& vpMatrix)
+      [&visibleRooms, &potentiallyVisibleRooms](const gl::RenderState& fbRenderState, const glm::mat4& vpMatrix)
       {
         gl::RenderState::getWantedState() = fbRenderState;
 
@@ -247,15 +266,26 @@ void Presenter::renderCsmBuffers(const std::vector<world::Room>& visibleRooms)
           render::scene::RenderContext context{
             render::material::RenderMode::CSMDepthOnly, vpMatrix, translucencySelector};
           render::scene::Visitor visitor{gsl_lite::not_null{&context}, false};
-          for(const auto& room : visibleRooms)
+          const auto visitRoom = [&visitor](const world::Room& room)
           {
             if(!room.node->isVisible())
-              continue;
+              return;
 
             for(const auto& child : room.node->getChildren())
             {
               visitor.visit(*child);
             }
+          };
+
+          if(potentiallyVisibleRooms.has_value())
+          {
+            for(const auto roomIndex : *potentiallyVisibleRooms)
+              visitRoom(visibleRooms.at(roomIndex));
+          }
+          else
+          {
+            for(const auto& room : visibleRooms)
+              visitRoom(room);
           }
           visitor.render(glm::vec3{0.0f, 0.0f, std::numeric_limits<float>::lowest()});
         }
@@ -430,9 +460,10 @@ Presenter::Presenter(const std::filesystem::path& engineDataPath,
                      const glm::ivec2& resolution,
                      const render::RenderSettings& renderSettings,
                      const bool borderlessFullscreen,
+                     const bool headless,
                      std::function<float()> interTickFactorProvider)
     : m_window{gsl_lite::make_shared<gl::Window>(
-        getIconPaths(engineDataPath, {24, 32, 64, 128, 256, 512}), resolution, borderlessFullscreen)}
+        getIconPaths(engineDataPath, {24, 32, 64, 128, 256, 512}), resolution, borderlessFullscreen, headless)}
     , m_soundEngine{gsl_lite::make_shared<audio::SoundEngine>()}
     , m_sceneGraph{gsl_lite::make_shared<render::scene::SceneGraph>(gsl_lite::make_shared<render::scene::Camera>(
         core::DefaultFov, getRenderViewport(), core::DefaultNearPlane, core::DefaultFarPlane))}
@@ -486,6 +517,12 @@ void Presenter::scaleSplashImage()
 
 void Presenter::drawLoadingScreen(const std::string& state)
 {
+  if(isHeadless())
+  {
+    BOOST_LOG_TRIVIAL(info) << state;
+    return;
+  }
+
   if(!beginFrame())
     return;
 
@@ -573,6 +610,7 @@ void Presenter::setTrFont(std::unique_ptr<ui::TRFont>&& font) noexcept
 
 void Presenter::swapBuffers()
 {
+  UTIL_PROFILE_ZONE("Presenter::swapBuffers");
   m_renderSystem->getRenderPipeline().renderBackbufferEffects();
   m_window->swapBuffers();
 }
@@ -700,6 +738,7 @@ void Presenter::renderGeometry(const world::World& world, const std::vector<worl
 
       context.pushState(room.node->getRenderState());
       room.particles.render(room.node->getName(), context, world);
+      room.spriteParticles.render(room.node->getName(), context, world);
       context.popState();
     }
   }
@@ -19,6 +19,8 @@
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -70,6 +72,7 @@ public:
                      const glm::ivec2& resolution,
                      const render::RenderSettings& renderSettings,
                      bool borderlessFullscreen,
+                     bool headless,
                      std::function<float()> interTickFactorProvider);
   ~Presenter();
 
@@ -179,6 +182,11 @@ public:
     return *m_ghostNameFont;
   }
 
+  [[nodiscard]] bool isHeadless() const noexcept
+  {
+    return m_window->isHidden();
+  }
+
 private:
   gslu::nn_shared<gl::Window> m_window;
   uint8_t m_renderResolutionDivisor = 1;
@@ -214,6 +222,7 @@ private:
 
   void renderGeometry(const world::World& world, const std::vector<world::Room>& rooms);
 
-  void renderCsmBuffers(const std::vector<world::Room>& visibleRooms);
+  void renderCsmBuffers(const std::vector<world::Room>& visibleRooms,
+                        const std::optional<std::span<const uint32_t>>& potentiallyVisibleRooms);
 };
 } // namespace engine
\ No newline at end of file
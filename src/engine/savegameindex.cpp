@@ -0,0 +1,386 @@
+#include "savegameindex.h"
+
+#include "core/magic.h"
+#include "engine.h"
+#include "savegamewriter.h"
+#include "serialization/binarydocument.h"
+#include "serialization/yamldocument.h"
+#include "util/fsutil.h"
+
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+const auto IndexFilename = "savegames.idx";
+const auto IndexHeader = "croftengine-savegame-index 1";
+const auto QuicksaveKey = "q";
+
+struct FileStatus
+{
+  std::filesystem::file_time_type time;
+  uintmax_t size;
+};
+
+std::optional<FileStatus> getFileStatus(const std::filesystem::path& path)
+{
+  std::error_code ec;
+  if(!std::filesystem::is_regular_file(path, ec))
+    return std::nullopt;
+
+  const auto time = std::filesystem::last_write_time(path, ec);
+  if(ec)
+    return std::nullopt;
+  const auto size = std::filesystem::file_size(path, ec);
+  if(ec)
+    return std::nullopt;
+
+  return FileStatus{time, size};
+}
+
+SavegameMeta readMeta(const std::filesystem::path& path, const std::filesystem::file_time_type& saveTime)
+{
+  // the meta cache is written after the savegame, so an older one belongs to a previous savegame
+  const auto metaPath = makeMetaFilepath(path);
+  if(const auto metaStatus = getFileStatus(metaPath); metaStatus.has_value() && metaStatus->time >= saveTime)
+  {
+    serialization::YAMLDocument<true> metaCacheDoc{metaPath};
+    SavegameMeta meta{};
+    metaCacheDoc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
+    return meta;
+  }
+
+  SavegameMeta meta{};
+  serialization::withLoadingDocument(path,
+                                     [&meta](auto& doc)
+                                     {
+                                       doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
+                                     });
+  serialization::YAMLDocument<false> newMetaCacheDoc{metaPath};
+  newMetaCacheDoc.serialize("meta", gsl_lite::not_null{&meta}, meta);
+  newMetaCacheDoc.write();
+  return meta;
+}
+} // namespace
+
+SavegameIndex::SavegameIndex(Engine& engine)
+    : m_engine{engine}
+{
+}
+
+std::filesystem::path SavegameIndex::getIndexPath() const
+{
+  return m_engine.getSavegameRootPath() / IndexFilename;
+}
+
+std::tuple<std::optional<SavegameInfo>, std::map<size_t, SavegameInfo>> SavegameIndex::getSavegames()
+{
+  std::unique_lock lock{m_mutex};
+  ensureLoaded();
+
+  bool changed = false;
+  for(auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto& [slot, entry] = *it;
+    if(!entry.stale)
+    {
+      ++it;
+      continue;
+    }
+
+    changed = true;
+    const auto path = m_engine.getSavegamePath(slot);
+    const auto status = getFileStatus(path);
+    if(!status.has_value())
+    {
+      it = m_entries.erase(it);
+      continue;
+    }
+
+    BOOST_LOG_TRIVIAL(debug) << "Re-reading changed savegame " << path;
+    entry.info = SavegameInfo{readMeta(path, status->time), status->time};
+    entry.size = status->size;
+    entry.stale = false;
+    ++it;
+  }
+  if(changed)
+    postPersist();
+
+  std::optional<SavegameInfo> quicksave;
+  std::map<size_t, SavegameInfo> result;
+  for(const auto& [slot, entry] : m_entries)
+  {
+    if(slot.has_value())
+      result.emplace(*slot, entry.info);
+    else
+      quicksave = entry.info;
+  }
+  return {std::move(quicksave), std::move(result)};
+}
+
+bool SavegameIndex::empty()
+{
+  std::unique_lock lock{m_mutex};
+  ensureLoaded();
+  return m_entries.empty();
+}
+
+void SavegameIndex::onSaving(const std::optional<size_t>& slot, const SavegameMeta& meta)
+{
+  std::unique_lock lock{m_mutex};
+  // an index which was not loaded yet is validated against the disk when it is loaded
+  if(!m_loaded)
+    return;
+
+  auto& entry = m_entries[slot];
+  entry.info = SavegameInfo{meta, std::filesystem::file_time_type::clock::now()};
+  entry.stale = false;
+  entry.pending = true;
+}
+
+void SavegameIndex::onWritten(const std::optional<size_t>& slot)
+{
+  const auto status = getFileStatus(m_engine.getSavegamePath(slot));
+
+  {
+    std::unique_lock lock{m_mutex};
+    if(!m_loaded)
+      return;
+
+    if(!status.has_value())
+    {
+      m_entries.erase(slot);
+    }
+    else
+    {
+      // the meta data is only known if the savegame was registered while the index was loaded
+      auto& entry = m_entries[slot];
+      entry.info.saveTime = status->time;
+      entry.size = status->size;
+      entry.stale = !entry.pending;
+      entry.pending = false;
+    }
+  }
+
+  persist();
+}
+
+void SavegameIndex::onDeleted(const size_t slot)
+{
+  std::unique_lock lock{m_mutex};
+  if(!m_loaded)
+    return;
+
+  m_entries.erase(slot);
+  postPersist();
+}
+
+void SavegameIndex::onMoved(const std::map<size_t, size_t>& srcToDst)
+{
+  std::unique_lock lock{m_mutex};
+  if(!m_loaded)
+    return;
+
+  std::map<size_t, Entry> moved;
+  for(const auto& [src, dst] : srcToDst)
+  {
+    if(const auto it = m_entries.find(src); it != m_entries.end())
+    {
+      moved.emplace(dst, std::move(it->second));
+      m_entries.erase(it);
+    }
+  }
+  for(auto& [dst, entry] : moved)
+    m_entries.insert_or_assign(dst, std::move(entry));
+  postPersist();
+}
+
+void SavegameIndex::ensureLoaded()
+{
+  if(m_loaded)
+    return;
+
+  m_loaded = true;
+  if(auto entries = readIndex(); entries.has_value())
+  {
+    m_entries = std::move(*entries);
+    // savegames may have been changed outside of the engine since the index was written
+    m_engine.getSavegameWriter().post(
+      [this]()
+      {
+        refresh();
+      });
+    return;
+  }
+
+  BOOST_LOG_TRIVIAL(info) << "Savegame index missing or invalid, scanning all savegames";
+  m_entries = scan();
+  postPersist();
+}
+
+std::optional<SavegameIndex::Entries> SavegameIndex::readIndex() const
+{
+  const auto path = getIndexPath();
+  std::ifstream file{path, std::ios::in};
+  if(!file.is_open())
+    return std::nullopt;
+
+  std::string line;
+  if(!std::getline(file, line) || line != IndexHeader)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Unsupported savegame index " << path;
+    return std::nullopt;
+  }
+
+  Entries entries;
+  while(std::getline(file, line))
+  {
+    std::istringstream lineStream{line};
+    std::string slotStr;
+    int64_t ticks = 0;
+    uintmax_t size = 0;
+    if(!(lineStream >> slotStr >> ticks >> size) || lineStream.get() != '\t')
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Invalid savegame index entry in " << path << ": " << line;
+      return std::nullopt;
+    }
+
+    std::optional<size_t> slot;
+    if(slotStr != QuicksaveKey)
+    {
+      try
+      {
+        slot = std::stoul(slotStr);
+      }
+      catch(const std::exception&)
+      {
+        BOOST_LOG_TRIVIAL(warning) << "Invalid savegame index entry in " << path << ": " << line;
+        return std::nullopt;
+      }
+      if(*slot >= core::SavegameSlots)
+        continue;
+    }
+
+    Entry entry{};
+    std::getline(lineStream, entry.info.meta.filename);
+    entry.info.saveTime = std::filesystem::file_time_type{std::filesystem::file_time_type::duration{ticks}};
+    entry.size = size;
+    entries.insert_or_assign(slot, std::move(entry));
+  }
+
+  return entries;
+}
+
+SavegameIndex::Entries SavegameIndex::scan() const
+{
+  Entries entries;
+  auto scanSlot = [this, &entries](const std::optional<size_t>& slot)
+  {
+    const auto path = m_engine.getSavegamePath(slot);
+    const auto status = getFileStatus(path);
+    if(!status.has_value())
+      return;
+
+    entries.emplace(slot, Entry{SavegameInfo{readMeta(path, status->time), status->time}, status->size});
+  };
+
+  scanSlot(std::nullopt);
+  for(size_t i = 0; i < core::SavegameSlots; ++i)
+    scanSlot(i);
+  return entries;
+}
+
+void SavegameIndex::refresh()
+{
+  std::map<std::optional<size_t>, std::optional<FileStatus>> statuses;
+  statuses.emplace(std::nullopt, getFileStatus(m_engine.getSavegamePath(std::nullopt)));
+  for(size_t i = 0; i < core::SavegameSlots; ++i)
+    statuses.emplace(i, getFileStatus(m_engine.getSavegamePath(i)));
+
+  bool changed = false;
+  {
+    std::unique_lock lock{m_mutex};
+    for(const auto& [slot, status] : statuses)
+    {
+      const auto it = m_entries.find(slot);
+      if(it != m_entries.end() && it->second.pending)
+        continue;
+
+      if(!status.has_value())
+      {
+        if(it != m_entries.end())
+        {
+          m_entries.erase(it);
+          changed = true;
+        }
+        continue;
+      }
+
+      if(it != m_entries.end() && it->second.info.saveTime == status->time && it->second.size == status->size)
+        continue;
+
+      auto& entry = m_entries[slot];
+      entry.info.saveTime = status->time;
+      entry.size = status->size;
+      entry.stale = true;
+      changed = true;
+    }
+  }
+
+  if(changed)
+  {
+    BOOST_LOG_TRIVIAL(info) << "Savegames changed since the savegame index was written";
+    persist();
+  }
+}
+
+void SavegameIndex::persist()
+{
+  std::ostringstream data;
+  data << IndexHeader << '\n';
+  {
+    std::unique_lock lock{m_mutex};
+    for(const auto& [slot, entry] : m_entries)
+    {
+      // stale entries are left out, so they are detected as changed again in the next session
+      if(entry.stale)
+        continue;
+
+      if(slot.has_value())
+        data << *slot;
+      else
+        data << QuicksaveKey;
+      data << '\t' << static_cast<int64_t>(entry.info.saveTime.time_since_epoch().count()) << '\t' << entry.size
+           << '\t' << entry.info.meta.filename << '\n';
+    }
+  }
+
+  util::writeFileAtomically(getIndexPath(), data.str());
+}
+
+void SavegameIndex::postPersist()
+{
+  // the index is only written by the savegame writer thread, so it is never written concurrently
+  m_engine.getSavegameWriter().post(
+    [this]()
+    {
+      persist();
+    });
+}
+} // namespace engine
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "engine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+namespace engine
+{
+/**
+ * @brief Keeps the meta data of all savegames in memory, backed by an index file next to the savegames.
+ *
+ * The index is read once per session, and kept up to date by the operations writing, deleting or moving savegames.
+ * Savegames changed outside of the engine are detected by comparing their modification time and size on the
+ * savegame writer thread; only those are re-read when the savegames are requested the next time.
+ */
+class SavegameIndex final
+{
+public:
+  explicit SavegameIndex(Engine& engine);
+
+  SavegameIndex(const SavegameIndex&) = delete;
+  SavegameIndex(SavegameIndex&&) = delete;
+  SavegameIndex& operator=(const SavegameIndex&) = delete;
+  SavegameIndex& operator=(SavegameIndex&&) = delete;
+
+  [[nodiscard]] std::tuple<std::optional<SavegameInfo>, std::map<size_t, SavegameInfo>> getSavegames();
+  [[nodiscard]] bool empty();
+
+  /**
+   * @brief Registers a savegame which is queued for writing, so that it is listed before it is on the disk.
+   */
+  void onSaving(const std::optional<size_t>& slot, const SavegameMeta& meta);
+  /**
+   * @brief Must be called on the savegame writer thread after the savegame was written.
+   */
+  void onWritten(const std::optional<size_t>& slot);
+  void onDeleted(size_t slot);
+  /**
+   * @brief Registers renamed savegames; all sources are moved before any destination is assigned.
+   */
+  void onMoved(const std::map<size_t, size_t>& srcToDst);
+
+private:
+  struct Entry
+  {
+    SavegameInfo info{};
+    uintmax_t size = 0;
+    //! the savegame changed on the disk, and the meta data must be re-read
+    bool stale = false;
+    //! the savegame is still queued for writing
+    bool pending = false;
+  };
+
+  using Entries = std::map<std::optional<size_t>, Entry>;
+
+  [[nodiscard]] std::filesystem::path getIndexPath() const;
+  //! must be called with the mutex held
+  void ensureLoaded();
+  [[nodiscard]] std::optional<Entries> readIndex() const;
+  [[nodiscard]] Entries scan() const;
+  void refresh();
+  void persist();
+  void postPersist();
+
+  Engine& m_engine;
+  std::mutex m_mutex;
+  Entries m_entries;
+  bool m_loaded = false;
+  bool m_refreshPosted = false;
+};
+} // namespace engine
@@ -0,0 +1,128 @@
+#include "savegamewriter.h"
+
+#include "util/fsutil.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace engine
+{
+SavegameWriter::SavegameWriter()
+    : m_worker{&SavegameWriter::workerMain, this}
+{
+}
+
+SavegameWriter::~SavegameWriter()
+{
+  {
+    std::unique_lock lock{m_mutex};
+    m_stop = true;
+  }
+  m_jobCondition.notify_all();
+  m_worker.join();
+}
+
+void SavegameWriter::enqueue(const std::filesystem::path& path,
+                             std::function<std::string()> encodeSavegame,
+                             const std::filesystem::path& metaPath,
+                             std::string meta,
+                             const std::chrono::nanoseconds stall,
+                             std::function<void()> onWritten)
+{
+  BOOST_LOG_TRIVIAL(debug) << "Savegame snapshot of " << path << " took "
+                           << std::chrono::duration<double, std::milli>(stall).count() << "ms";
+  {
+    std::unique_lock lock{m_mutex};
+    m_stats.lastStall = stall;
+    m_stats.maxStall = std::max(m_stats.maxStall, stall);
+    m_stats.totalStall += stall;
+    ++m_stats.saves;
+  }
+
+  post(
+    [path, encodeSavegame = std::move(encodeSavegame), metaPath, meta = std::move(meta), onWritten = std::move(onWritten)]
+    {
+      const auto start = std::chrono::steady_clock::now();
+      const auto data = encodeSavegame();
+      // the meta cache would otherwise refer to the previous savegame until it is replaced
+      std::error_code ec;
+      std::filesystem::remove(metaPath, ec);
+      util::writeFileAtomically(path, data);
+      util::writeFileAtomically(metaPath, meta);
+      BOOST_LOG_TRIVIAL(info) << "Wrote " << data.size() << " bytes to " << path << " in "
+                              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                                   .count()
+                              << "ms";
+      if(onWritten != nullptr)
+        onWritten();
+    });
+}
+
+void SavegameWriter::post(std::function<void()> task)
+{
+  {
+    std::unique_lock lock{m_mutex};
+    m_jobs.emplace_back(std::move(task));
+  }
+  m_jobCondition.notify_one();
+}
+
+void SavegameWriter::wait() const
+{
+  std::unique_lock lock{m_mutex};
+  m_idleCondition.wait(lock,
+                       [this]
+                       {
+                         return m_jobs.empty() && !m_busy;
+                       });
+}
+
+SavegameWriter::Stats SavegameWriter::getStats() const
+{
+  std::unique_lock lock{m_mutex};
+  return m_stats;
+}
+
+void SavegameWriter::workerMain()
+{
+  while(true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock lock{m_mutex};
+      m_busy = false;
+      if(m_jobs.empty())
+        m_idleCondition.notify_all();
+      m_jobCondition.wait(lock,
+                          [this]
+                          {
+                            return m_stop || !m_jobs.empty();
+                          });
+      // pending savegames are still written when stopping
+      if(m_jobs.empty())
+        return;
+
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+      m_busy = true;
+    }
+
+    try
+    {
+      job();
+    }
+    catch(const std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(error) << "Savegame writer task failed: " << ex.what();
+    }
+  }
+}
+} // namespace engine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace engine
+{
+/**
+ * @brief Encodes and writes savegames on a background thread.
+ *
+ * The game thread only takes a snapshot of the world in memory and hands over the encoders. Savegames are written
+ * in the order they were queued, and every file is replaced atomically.
+ */
+class SavegameWriter final
+{
+public:
+  struct Stats
+  {
+    size_t saves = 0;
+    std::chrono::nanoseconds lastStall{0};
+    std::chrono::nanoseconds maxStall{0};
+    std::chrono::nanoseconds totalStall{0};
+  };
+
+  explicit SavegameWriter();
+  ~SavegameWriter();
+
+  SavegameWriter(const SavegameWriter&) = delete;
+  SavegameWriter(SavegameWriter&&) = delete;
+  SavegameWriter& operator=(const SavegameWriter&) = delete;
+  SavegameWriter& operator=(SavegameWriter&&) = delete;
+
+  /**
+   * @param stall Time the game thread spent on taking the snapshot.
+   * @param onWritten Called on the writer thread after the savegame was written successfully.
+   */
+  void enqueue(const std::filesystem::path& path,
+               std::function<std::string()> encodeSavegame,
+               const std::filesystem::path& metaPath,
+               std::string meta,
+               std::chrono::nanoseconds stall,
+               std::function<void()> onWritten);
+
+  /**
+   * @brief Runs @a task on the writer thread, ordered with the queued savegames.
+   */
+  void post(std::function<void()> task);
+
+  /**
+   * @brief Blocks until all queued savegames are on the disk.
+   */
+  void wait() const;
+
+  [[nodiscard]] Stats getStats() const;
+
+private:
+  void workerMain();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_jobCondition;
+  mutable std::condition_variable m_idleCondition;
+  std::deque<std::function<void()>> m_jobs;
+  bool m_busy = false;
+  bool m_stop = false;
+  Stats m_stats{};
+  std::thread m_worker;
+};
+} // namespace engine
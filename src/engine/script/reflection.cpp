@@ -335,6 +335,26 @@ std::pair<LevelLoopResult, std::optional<size_t>> Level::runFromSave(const gsl_l
   return result;
 }
 
+SimulationStats Level::simulate(const gsl_lite::not_null<Engine*>& engine,
+                               const std::shared_ptr<Player>& player,
+                               const core::Frame maxFrames,
+                               InputRecordingReader* inputReplay)
+{
+  const auto world = loadForSimulation(engine, player);
+  return engine->simulateLevel(*world, maxFrames, inputReplay);
+}
+
+std::unique_ptr<world::World> Level::loadForSimulation(const gsl_lite::not_null<Engine*>& engine,
+                                                       const std::shared_ptr<Player>& player)
+{
+  engine->getPresenter().getSoundEngine()->reset();
+  player->requestedWeaponType = m_defaultWeapon;
+  player->selectedWeaponType = m_defaultWeapon;
+
+  const auto levelStartPlayer = std::make_shared<Player>(*player);
+  return loadWorld(engine, player, levelStartPlayer, false);
+}
+
 std::vector<std::filesystem::path> Level::getFilepathsIfInvalid(const std::filesystem::path& dataRoot) const
 {
   if(std::filesystem::is_regular_file(findCaseInsensitivePath(dataRoot, m_name)))
@@ -35,6 +35,8 @@ enum class LevelLoopResult : uint8_t;
 enum class WeaponType : uint8_t;
 class Engine;
 class Player;
+class InputRecordingReader;
+struct SimulationStats;
 } // namespace engine
 
 namespace engine::world
@@ -179,6 +181,13 @@ public:
                 const std::optional<size_t>& slot,
                 const std::shared_ptr<Player>& player,
                 const std::shared_ptr<Player>& levelStartPlayer) override;
+  SimulationStats simulate(const gsl_lite::not_null<Engine*>& engine,
+                           const std::shared_ptr<Player>& player,
+                           core::Frame maxFrames,
+                           InputRecordingReader* inputReplay);
+  //! @brief Loads the world like simulate(), but leaves ticking it to the caller.
+  [[nodiscard]] std::unique_ptr<world::World> loadForSimulation(const gsl_lite::not_null<Engine*>& engine,
+                                                                const std::shared_ptr<Player>& player);
 
   [[nodiscard]] bool isLevel(const std::filesystem::path& path) const override;
 
@@ -20,6 +20,7 @@
 #include "serialization/skeletalmodeltype_ptr.h"
 #include "serialization/vector.h"
 #include "serialization/vector_element.h"
+#include "skeletalpose.h"
 #include "util/helpers.h"
 #include "world/animation.h"
 #include "world/rendermeshdata.h"
@@ -36,13 +37,13 @@
 #include <gl/pixel.h>
 #include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <iterator>
 #include <memory>
 #include <optional>
-#include <stack>
 #include <string>
 #include <utility>
 #include <vector>
@@ -74,6 +75,21 @@ std::optional<const world::TransitionCase>
 
   return std::nullopt;
 }
+
+PoseRotations decodeBoneRotations(const loader::file::AnimFrame& frame, const size_t firstBone)
+{
+  const auto angleData = frame.getAngleData();
+  PoseRotations result;
+  for(size_t lane = 0; lane < PoseLanes; ++lane)
+  {
+    // bones without animation data, and the padding of the last block, are not rotated
+    if(const auto bone = firstBone + lane; bone < frame.numValues)
+      result[lane] = core::quatFromPackedAngles(&angleData[sizeof(uint32_t) * bone]);
+    else
+      result[lane] = glm::quat{1.0f, 0.0f, 0.0f, 0.0f};
+  }
+  return result;
+}
 } // namespace
 
 SkeletalModelNode::SkeletalModelNode(const std::string& id,
@@ -142,62 +158,65 @@ void SkeletalModelNode::calculatePoseMatrices(const bool predictive)
   if(m_meshParts.empty())
     return;
 
-  BOOST_ASSERT(m_meshParts.size() >= m_model->bones.size());
-
-  calculatePoseMatrices(getInterpolationInfo(), &MeshPart::poseMatrix);
-  calculatePoseMatrices(predictive ? getNextInterpolationInfo() : getInterpolationInfo(), &MeshPart::nextPoseMatrix);
-}
-
-void SkeletalModelNode::calculatePoseMatrices(const AnimSegmentInterpolationInfo& framePair,
-                                              glm::mat4 MeshPart::* targetMatrix)
-{
-  BOOST_ASSERT(!m_model->bones.empty());
-  BOOST_ASSERT(framePair.firstFrame->numValues > 0);
-  BOOST_ASSERT(framePair.secondFrame->numValues > 0);
-
-  const auto angleDataFirst = framePair.firstFrame->getAngleData();
-  std::stack<glm::mat4> transformsFirst;
-  transformsFirst.push(glm::translate(glm::mat4{1.0f}, framePair.firstFrame->pos.toGl())
-                       * core::fromPackedAngles(angleDataFirst.data()) * m_meshParts[0].patch);
-
-  const auto angleDataSecond = framePair.secondFrame->getAngleData();
-  std::stack<glm::mat4> transformsSecond;
-  transformsSecond.push(translate(glm::mat4{1.0f}, framePair.secondFrame->pos.toGl())
-                        * core::fromPackedAngles(angleDataSecond.data()) * m_meshParts[0].patch);
-
-  m_meshParts[0].*targetMatrix
-    = util::lerp(transformsFirst.top(), transformsSecond.top(), framePair.interKeyframeFactor);
-
-  if(m_model->bones.size() <= 1)
-    return;
-
-  for(size_t i = 1; i < m_model->bones.size(); ++i)
+  const auto& bones = m_model->bones;
+  BOOST_ASSERT(!bones.empty());
+  BOOST_ASSERT(m_meshParts.size() >= bones.size());
+
+  const auto current = getInterpolationInfo();
+  const auto next = predictive ? getNextInterpolationInfo() : current;
+  BOOST_ASSERT(current.firstFrame->numValues > 0 && current.secondFrame->numValues > 0);
+  BOOST_ASSERT(next.firstFrame->numValues > 0 && next.secondFrame->numValues > 0);
+
+  // the bone rotations are interpolated instead of the composed matrices of both keyframes, so each pose only needs
+  // a single pass over the bone tree
+  PoseMatrixStack currentStack;
+  PoseMatrixStack nextStack;
+  currentStack.top() = glm::translate(
+    glm::mat4{1.0f},
+    glm::mix(current.firstFrame->pos.toGl(), current.secondFrame->pos.toGl(), current.interKeyframeFactor));
+  nextStack.top() = glm::translate(
+    glm::mat4{1.0f}, glm::mix(next.firstFrame->pos.toGl(), next.secondFrame->pos.toGl(), next.interKeyframeFactor));
+
+  PoseRotations currentRotations;
+  PoseRotations nextRotations;
+  for(size_t block = 0; block < bones.size(); block += PoseLanes)
   {
-    if(m_model->bones[i].popMatrix)
+    const auto blockSize = std::min(PoseLanes, bones.size() - block);
+    nlerp(decodeBoneRotations(*current.firstFrame, block),
+          decodeBoneRotations(*current.secondFrame, block),
+          current.interKeyframeFactor,
+          currentRotations);
+    nlerp(decodeBoneRotations(*next.firstFrame, block),
+          decodeBoneRotations(*next.secondFrame, block),
+          next.interKeyframeFactor,
+          nextRotations);
+
+    for(size_t lane = 0; lane < blockSize; ++lane)
     {
-      transformsFirst.pop();
-      transformsSecond.pop();
-    }
-    if(m_model->bones[i].pushMatrix)
-    {
-      transformsFirst.push({transformsFirst.top()});
-      transformsSecond.push({transformsSecond.top()});
-    }
-
-    if(framePair.firstFrame->numValues < i)
-      transformsFirst.top() *= translate(glm::mat4{1.0f}, m_model->bones[i].position) * m_meshParts[i].patch;
-    else
-      transformsFirst.top() *= translate(glm::mat4{1.0f}, m_model->bones[i].position)
-                               * core::fromPackedAngles(&angleDataFirst[sizeof(uint32_t) * i]) * m_meshParts[i].patch;
-
-    if(framePair.firstFrame->numValues < i)
-      transformsSecond.top() *= translate(glm::mat4{1.0f}, m_model->bones[i].position) * m_meshParts[i].patch;
-    else
-      transformsSecond.top() *= translate(glm::mat4{1.0f}, m_model->bones[i].position)
-                                * core::fromPackedAngles(&angleDataSecond[sizeof(uint32_t) * i]) * m_meshParts[i].patch;
+      const auto i = block + lane;
+      auto& part = m_meshParts[i];
+      if(i > 0)
+      {
+        if(bones[i].popMatrix)
+        {
+          currentStack.pop();
+          nextStack.pop();
+        }
+        if(bones[i].pushMatrix)
+        {
+          currentStack.push();
+          nextStack.push();
+        }
+
+        currentStack.top() = glm::translate(currentStack.top(), bones[i].position);
+        nextStack.top() = glm::translate(nextStack.top(), bones[i].position);
+      }
 
-    m_meshParts[i].*targetMatrix
-      = util::lerp(transformsFirst.top(), transformsSecond.top(), framePair.interKeyframeFactor);
+      currentStack.top() *= glm::mat4_cast(currentRotations[lane]) * part.patch;
+      nextStack.top() *= glm::mat4_cast(nextRotations[lane]) * part.patch;
+      part.poseMatrix = currentStack.top();
+      part.nextPoseMatrix = nextStack.top();
+    }
   }
 }
 
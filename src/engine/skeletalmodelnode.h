@@ -280,7 +280,6 @@ private:
   const world::Animation* m_anim = nullptr;
   core::Frame m_frame = 0_frame;
 
-  void calculatePoseMatrices(const AnimSegmentInterpolationInfo& framePair, glm::mat4 MeshPart::* targetMatrix);
   AnimSegmentInterpolationInfo getInterpolationInfo(const world::Animation& anim, core::Frame frame) const;
 
   bool m_shadowCaster;
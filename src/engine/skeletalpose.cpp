@@ -0,0 +1,63 @@
+#include "skeletalpose.h"
+
+#include <cstddef>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define SKELETALPOSE_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace engine
+{
+// the blending is component-wise apart from the dot products, so the component order of glm::quat does not matter
+static_assert(sizeof(glm::quat) == 4 * sizeof(float));
+
+void nlerp(const PoseRotations& a, const PoseRotations& b, const float alpha, PoseRotations& result)
+{
+#ifdef SKELETALPOSE_SSE2
+  static_assert(PoseLanes == 4);
+
+  // transpose to one register per component, holding that component of all four rotations
+  auto a0 = _mm_loadu_ps(&a[0][0]);
+  auto a1 = _mm_loadu_ps(&a[1][0]);
+  auto a2 = _mm_loadu_ps(&a[2][0]);
+  auto a3 = _mm_loadu_ps(&a[3][0]);
+  _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+  auto b0 = _mm_loadu_ps(&b[0][0]);
+  auto b1 = _mm_loadu_ps(&b[1][0]);
+  auto b2 = _mm_loadu_ps(&b[2][0]);
+  auto b3 = _mm_loadu_ps(&b[3][0]);
+  _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+  const auto dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)),
+                              _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3)));
+  // flip the sign of the second weight where the rotations are in opposite hemispheres
+  const auto signMask = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+  const auto wa = _mm_set1_ps(1 - alpha);
+  const auto wb = _mm_xor_ps(_mm_set1_ps(alpha), signMask);
+
+  auto r0 = _mm_add_ps(_mm_mul_ps(a0, wa), _mm_mul_ps(b0, wb));
+  auto r1 = _mm_add_ps(_mm_mul_ps(a1, wa), _mm_mul_ps(b1, wb));
+  auto r2 = _mm_add_ps(_mm_mul_ps(a2, wa), _mm_mul_ps(b2, wb));
+  auto r3 = _mm_add_ps(_mm_mul_ps(a3, wa), _mm_mul_ps(b3, wb));
+
+  const auto lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)),
+                                   _mm_add_ps(_mm_mul_ps(r2, r2), _mm_mul_ps(r3, r3)));
+  const auto invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+  r0 = _mm_mul_ps(r0, invLength);
+  r1 = _mm_mul_ps(r1, invLength);
+  r2 = _mm_mul_ps(r2, invLength);
+  r3 = _mm_mul_ps(r3, invLength);
+
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(&result[0][0], r0);
+  _mm_storeu_ps(&result[1][0], r1);
+  _mm_storeu_ps(&result[2][0], r2);
+  _mm_storeu_ps(&result[3][0], r3);
+#else
+  for(size_t i = 0; i < PoseLanes; ++i)
+    result[i] = nlerp(a[i], b[i], alpha);
+#endif
+}
+} // namespace engine
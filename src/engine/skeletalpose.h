@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+
+namespace engine
+{
+//! @brief Number of bone rotations blended at once, matching the 128 bit registers of SSE2.
+constexpr size_t PoseLanes = 4;
+
+using PoseRotations = std::array<glm::quat, PoseLanes>;
+
+/**
+ * @brief Normalized linear interpolation along the shorter arc between two rotations.
+ */
+[[nodiscard]] inline glm::quat nlerp(const glm::quat& a, const glm::quat& b, const float alpha)
+{
+  const auto bias = glm::dot(a, b) < 0 ? -alpha : alpha;
+  return glm::normalize(a * (1 - alpha) + b * bias);
+}
+
+/**
+ * @brief Applies nlerp() to a whole block of rotations.
+ */
+extern void nlerp(const PoseRotations& a, const PoseRotations& b, float alpha, PoseRotations& result);
+
+/**
+ * @brief A matrix stack for walking bone hierarchies, which never allocates.
+ *
+ * The stack starts with a single identity matrix.
+ */
+class PoseMatrixStack final
+{
+public:
+  //! @brief The bone trees of all supported games are much shallower than this.
+  static constexpr size_t Capacity = 32;
+
+  PoseMatrixStack()
+  {
+    m_matrices[0] = glm::mat4{1.0f};
+  }
+
+  void push()
+  {
+    gsl_Assert(m_size < Capacity);
+    m_matrices[m_size] = m_matrices[m_size - 1];
+    ++m_size;
+  }
+
+  void pop()
+  {
+    gsl_Expects(m_size > 1);
+    --m_size;
+  }
+
+  [[nodiscard]] glm::mat4& top() noexcept
+  {
+    return m_matrices[m_size - 1];
+  }
+
+  [[nodiscard]] const glm::mat4& top() const noexcept
+  {
+    return m_matrices[m_size - 1];
+  }
+
+private:
+  // only the used part is ever initialized
+  std::array<glm::mat4, Capacity> m_matrices;
+  size_t m_size = 1;
+};
+} // namespace engine
@@ -0,0 +1,293 @@
+#include "core/magic.h"
+#include "core/units.h"
+#include "engine/ai/searchstate.h"
+#include "engine/world/box.h"
+#include "engine/world/boxgraph.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <gsl-lite/gsl-lite.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::tests
+{
+BOOST_AUTO_TEST_SUITE(searchstate_tests)
+
+namespace
+{
+using BoxPtr = gsl_lite::not_null<const world::Box*>;
+
+/**
+ * The search as it was implemented before it was moved to world::BoxGraph indices: box pointers, maps for the
+ * per-box state, and a deque for the expansions. Presence of a box in #reachable marks it as visited.
+ */
+struct ReferenceSearch
+{
+  std::deque<BoxPtr> expansions;
+  std::unordered_map<BoxPtr, BoxPtr> edges;
+  std::unordered_map<BoxPtr, uint32_t> distances;
+  std::unordered_map<BoxPtr, bool> reachable;
+
+  explicit ReferenceSearch(const BoxPtr& target)
+      : expansions{target}
+  {
+    distances.emplace(target, 0);
+    reachable.emplace(target, true);
+  }
+
+  void setReachable(const BoxPtr& box, const bool isReachable)
+  {
+    reachable[box] |= isReachable;
+    if(isReachable && std::ranges::find(expansions, box) == expansions.end())
+      expansions.emplace_back(box);
+  }
+
+  void updateDistance(const BoxPtr& current, const BoxPtr& neighbor)
+  {
+    auto& neighborDistance = distances.at(neighbor);
+    const auto newDistance = distances.at(current) + 1;
+    if(neighborDistance <= newDistance)
+      return;
+
+    neighborDistance = newDistance;
+    edges.erase(current);
+    edges.emplace(current, neighbor);
+    expansions.emplace_back(neighbor);
+  }
+
+  bool updateEdge(const BoxPtr& current, const BoxPtr& neighbor)
+  {
+    if(!reachable.at(current))
+    {
+      setReachable(neighbor, false);
+      return true;
+    }
+
+    if(const auto it = reachable.find(neighbor); it != reachable.end() && it->second)
+    {
+      updateDistance(current, neighbor);
+      return true;
+    }
+
+    return false;
+  }
+
+  template<typename TCanVisit>
+  void expand(const world::ZoneId world::Box::*zoneRef,
+              const core::Length& step,
+              const core::Length& drop,
+              const TCanVisit& canVisit,
+              const size_t maxExpansions)
+  {
+    for(size_t i = 0; i < maxExpansions && !expansions.empty(); ++i)
+    {
+      const auto current = expansions.front();
+      expansions.pop_front();
+      const auto searchZone = current.get()->*zoneRef;
+
+      for(const auto& neighbor : current->overlaps)
+      {
+        if(neighbor == current)
+          continue;
+
+        if(searchZone != neighbor.get()->*zoneRef)
+        {
+          setReachable(neighbor, false);
+          continue;
+        }
+
+        if(const auto dy = current->floor - neighbor->floor; dy < -step || dy > -drop)
+        {
+          setReachable(neighbor, false);
+          continue;
+        }
+
+        if(updateEdge(current, neighbor))
+          continue;
+
+        const bool isReachable = canVisit(*neighbor);
+        if(isReachable)
+        {
+          edges.emplace(neighbor, current);
+          distances[neighbor] = distances[current] + 1;
+        }
+
+        setReachable(neighbor, isReachable);
+      }
+    }
+  }
+};
+
+std::vector<world::Box> createBoxes(std::mt19937& rng)
+{
+  std::uniform_int_distribution<size_t> sizeDistribution{1, 60};
+  std::vector<world::Box> boxes(sizeDistribution(rng));
+
+  std::uniform_int_distribution<int> floorDistribution{-4, 4};
+  std::uniform_int_distribution<world::ZoneId> zoneDistribution{0, 1};
+  std::bernoulli_distribution blockedDistribution{0.2};
+  for(auto& box : boxes)
+  {
+    box.floor = floorDistribution(rng) * core::QuarterSectorSize;
+    box.blocked = blockedDistribution(rng);
+    box.zoneGround1 = zoneDistribution(rng);
+    box.zoneGround1Swapped = zoneDistribution(rng);
+  }
+
+  // self-overlaps and duplicate overlaps are intentional, the search must cope with both
+  std::uniform_int_distribution<size_t> boxDistribution{0, boxes.size() - 1};
+  std::uniform_int_distribution<size_t> overlapCountDistribution{0, 6};
+  for(auto& box : boxes)
+  {
+    for(size_t n = overlapCountDistribution(rng); n > 0; --n)
+      box.overlaps.emplace_back(&boxes[boxDistribution(rng)]);
+  }
+
+  return boxes;
+}
+
+void checkEqual(const world::BoxGraph& graph, const ai::SearchState& search, const ReferenceSearch& reference)
+{
+  BOOST_REQUIRE_EQUAL(search.expansions.size(), reference.expansions.size());
+  for(size_t i = 0; i < reference.expansions.size(); ++i)
+    BOOST_CHECK_EQUAL(search.expansions.at(i), graph.indexOf(reference.expansions[i]));
+
+  for(uint32_t i = 0; i < graph.size(); ++i)
+  {
+    const BoxPtr box{&graph.getBox(i)};
+    BOOST_CHECK_EQUAL(search.queued[i], gsl_lite::narrow<uint32_t>(std::ranges::count(reference.expansions, box)));
+
+    const auto reachable = reference.reachable.find(box);
+    BOOST_CHECK_EQUAL(search.visited[i], reachable != reference.reachable.end());
+    if(reachable == reference.reachable.end())
+      continue;
+
+    BOOST_CHECK_EQUAL(search.reachable[i], reachable->second);
+    if(const auto distance = reference.distances.find(box); distance != reference.distances.end())
+      BOOST_CHECK_EQUAL(search.distances[i], distance->second);
+
+    if(const auto edge = reference.edges.find(box); edge != reference.edges.end())
+      BOOST_CHECK_EQUAL(search.edges[i], graph.indexOf(edge->second));
+    else
+      BOOST_CHECK_EQUAL(search.edges[i], world::BoxGraph::NoBox);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_matches_reference_search)
+{
+  // fixed seed, so that failures are reproducible
+  std::mt19937 rng{0};
+  for(int i = 0; i < 500; ++i)
+  {
+    const auto boxes = createBoxes(rng);
+    const world::BoxGraph graph{boxes};
+    const bool swapped = i % 2 != 0;
+    const auto step = core::QuarterSectorSize * (1 + i % 3);
+    const auto drop = -core::QuarterSectorSize * (1 + i % 4);
+    const auto target = std::uniform_int_distribution<uint32_t>{0, gsl_lite::narrow<uint32_t>(boxes.size() - 1)}(rng);
+
+    ai::SearchState search;
+    search.reset(graph.size(), target);
+    ReferenceSearch reference{BoxPtr{&boxes[target]}};
+
+    // continue some searches from a state like a deserialized one, with reachable boxes whose distances are too
+    // large, so that shorter paths are found and boxes are enqueued multiple times
+    if(i % 4 == 3)
+    {
+      std::uniform_int_distribution<uint32_t> boxDistribution{0, gsl_lite::narrow<uint32_t>(boxes.size() - 1)};
+      std::uniform_int_distribution<uint32_t> distanceDistribution{1, 20};
+      for(int j = 0; j < 3; ++j)
+      {
+        const auto box = boxDistribution(rng);
+        if(search.visited[box])
+          continue;
+
+        const auto distance = distanceDistribution(rng);
+        search.enqueue(box);
+        search.visited[box] = true;
+        search.reachable[box] = true;
+        search.distances[box] = distance;
+        reference.expansions.emplace_back(&boxes[box]);
+        reference.reachable.emplace(&boxes[box], true);
+        reference.distances.emplace(&boxes[box], distance);
+      }
+    }
+
+    BOOST_TEST_CONTEXT("graph " << i << " with " << boxes.size() << " boxes, target " << target)
+    {
+      checkEqual(graph, search, reference);
+
+      // single expansions, so that the state can be compared after each of them; a box might be enqueued more often
+      // than there are boxes, so this is bounded to catch non-terminating searches
+      for(size_t expansion = 0; !reference.expansions.empty(); ++expansion)
+      {
+        BOOST_REQUIRE_LT(expansion, 100 * boxes.size());
+        search.expand(
+          graph,
+          graph.getZones(swapped, false, core::QuarterSectorSize),
+          step,
+          drop,
+          [&graph](const uint32_t box)
+          {
+            return !graph.getBox(box).blocked;
+          },
+          1);
+        reference.expand(
+          world::Box::getZoneRef(swapped, false, core::QuarterSectorSize),
+          step,
+          drop,
+          [](const world::Box& box)
+          {
+            return !box.blocked;
+          },
+          1);
+        checkEqual(graph, search, reference);
+      }
+      BOOST_CHECK(search.expansions.empty());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_expansion_queue_grows)
+{
+  ai::SearchState::ExpansionQueue queue;
+  queue.reset(4);
+  std::deque<uint32_t> reference;
+
+  // interleave pushes and pops so that the ring wraps around before it needs to grow
+  uint32_t next = 0;
+  for(int round = 0; round < 20; ++round)
+  {
+    for(int i = 0; i < 3 + round % 5; ++i)
+    {
+      queue.push(next);
+      reference.emplace_back(next);
+      ++next;
+    }
+    for(int i = 0; i < 2; ++i)
+    {
+      BOOST_CHECK_EQUAL(queue.pop(), reference.front());
+      reference.pop_front();
+    }
+
+    BOOST_REQUIRE_EQUAL(queue.size(), reference.size());
+    for(size_t i = 0; i < reference.size(); ++i)
+      BOOST_CHECK_EQUAL(queue.at(i), reference[i]);
+  }
+
+  while(!reference.empty())
+  {
+    BOOST_CHECK_EQUAL(queue.pop(), reference.front());
+    reference.pop_front();
+  }
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace engine::tests
@@ -0,0 +1,111 @@
+#include "engine/skeletalpose.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <glm/gtc/quaternion.hpp>
+#include <random>
+
+namespace engine::tests
+{
+BOOST_AUTO_TEST_SUITE(skeletalpose_tests)
+
+namespace
+{
+glm::quat randomRotation(std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> distribution{-1, 1};
+  return glm::normalize(glm::quat{distribution(rng), distribution(rng), distribution(rng), distribution(rng)});
+}
+
+void checkBlock(const PoseRotations& a, const PoseRotations& b, const float alpha)
+{
+  PoseRotations result;
+  nlerp(a, b, alpha, result);
+  for(size_t lane = 0; lane < PoseLanes; ++lane)
+  {
+    const auto expected = nlerp(a[lane], b[lane], alpha);
+    for(int i = 0; i < 4; ++i)
+      BOOST_CHECK_SMALL(result[lane][i] - expected[i], 1e-6f);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_block_nlerp_matches_scalar)
+{
+  // fixed seed, so that failures are reproducible
+  std::mt19937 rng{0};
+  std::uniform_real_distribution<float> alphaDistribution{0, 1};
+  for(int i = 0; i < 1000; ++i)
+  {
+    PoseRotations a;
+    PoseRotations b;
+    for(size_t lane = 0; lane < PoseLanes; ++lane)
+    {
+      a[lane] = randomRotation(rng);
+      b[lane] = randomRotation(rng);
+    }
+    checkBlock(a, b, alphaDistribution(rng));
+    checkBlock(a, b, 0);
+    checkBlock(a, b, 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_block_nlerp_opposite_hemispheres)
+{
+  // q and -q are the same rotation, so the blend must take the shorter arc in each lane independently
+  std::mt19937 rng{0};
+  for(int i = 0; i < 100; ++i)
+  {
+    PoseRotations a;
+    PoseRotations b;
+    for(size_t lane = 0; lane < PoseLanes; ++lane)
+    {
+      a[lane] = randomRotation(rng);
+      b[lane] = randomRotation(rng);
+      const bool opposite = glm::dot(a[lane], b[lane]) < 0;
+      if(opposite != (lane % 2 == 0))
+        b[lane] = -b[lane];
+    }
+    checkBlock(a, b, 0.25f);
+
+    PoseRotations result;
+    nlerp(a, b, 1, result);
+    for(size_t lane = 0; lane < PoseLanes; ++lane)
+    {
+      // at the end of the blend, the rotation equals b up to its sign
+      const auto sign = lane % 2 == 0 ? -1.0f : 1.0f;
+      for(int c = 0; c < 4; ++c)
+        BOOST_CHECK_SMALL(result[lane][c] - sign * b[lane][c], 1e-6f);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_block_nlerp_partial_blocks)
+{
+  // the last block of a bone tree is padded with identity rotations, which must neither change nor affect the others
+  std::mt19937 rng{0};
+  for(size_t used = 1; used < PoseLanes; ++used)
+  {
+    PoseRotations a;
+    PoseRotations b;
+    for(size_t lane = 0; lane < PoseLanes; ++lane)
+    {
+      a[lane] = lane < used ? randomRotation(rng) : glm::quat{1.0f, 0.0f, 0.0f, 0.0f};
+      b[lane] = lane < used ? randomRotation(rng) : glm::quat{1.0f, 0.0f, 0.0f, 0.0f};
+    }
+    checkBlock(a, b, 0.5f);
+
+    PoseRotations result;
+    nlerp(a, b, 0.5f, result);
+    for(size_t lane = used; lane < PoseLanes; ++lane)
+    {
+      BOOST_CHECK_SMALL(result[lane].w - 1.0f, 1e-6f);
+      BOOST_CHECK_SMALL(result[lane].x, 1e-6f);
+      BOOST_CHECK_SMALL(result[lane].y, 1e-6f);
+      BOOST_CHECK_SMALL(result[lane].z, 1e-6f);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace engine::tests
@@ -0,0 +1,60 @@
+#include "boxgraph.h"
+
+#include "box.h"
+#include "core/units.h"
+
+#include <array>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace engine::world
+{
+namespace
+{
+constexpr std::array<const ZoneId Box::*, 6> ZoneRefs{
+  &Box::zoneFly,
+  &Box::zoneFlySwapped,
+  &Box::zoneGround1,
+  &Box::zoneGround1Swapped,
+  &Box::zoneGround2,
+  &Box::zoneGround2Swapped,
+};
+} // namespace
+
+BoxGraph::BoxGraph(const std::vector<Box>& boxes)
+    : m_boxes{boxes.data()}
+    , m_boxCount{boxes.size()}
+{
+  m_overlapOffsets.reserve(boxes.size() + 1);
+  m_floors.reserve(boxes.size());
+  for(auto& zones : m_zones)
+    zones.reserve(boxes.size());
+
+  for(const auto& box : boxes)
+  {
+    m_overlapOffsets.emplace_back(gsl_lite::narrow<uint32_t>(m_overlaps.size()));
+    for(const auto& overlap : box.overlaps)
+      m_overlaps.emplace_back(indexOf(overlap));
+
+    m_floors.emplace_back(box.floor);
+    for(size_t i = 0; i < ZoneRefs.size(); ++i)
+      m_zones[i].emplace_back(box.*ZoneRefs[i]);
+  }
+  m_overlapOffsets.emplace_back(gsl_lite::narrow<uint32_t>(m_overlaps.size()));
+}
+
+const std::vector<ZoneId>& BoxGraph::getZones(const bool swapped, const bool isFlying, const core::Length& step) const
+{
+  const auto zoneRef = Box::getZoneRef(swapped, isFlying, step);
+  for(size_t i = 0; i < ZoneRefs.size(); ++i)
+  {
+    if(ZoneRefs[i] == zoneRef)
+      return m_zones[i];
+  }
+  BOOST_THROW_EXCEPTION(std::logic_error("unknown zone reference"));
+}
+} // namespace engine::world
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "box.h"
+#include "core/units.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace engine::world
+{
+/**
+ * @brief Read-only, index-based copy of the box overlap graph, built once after loading a level.
+ *
+ * Boxes are identified by their index within World::getBoxes(). Overlaps are stored in compressed sparse row format,
+ * in the same order as in Box::overlaps, and floors and zones are stored in arrays indexed by box.
+ */
+class BoxGraph final
+{
+public:
+  static constexpr uint32_t NoBox = std::numeric_limits<uint32_t>::max();
+
+  BoxGraph() = default;
+  explicit BoxGraph(const std::vector<Box>& boxes);
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_boxCount;
+  }
+
+  [[nodiscard]] uint32_t indexOf(const gsl_lite::not_null<const Box*>& box) const
+  {
+    gsl_Expects(box.get() >= m_boxes && box.get() < m_boxes + size());
+    return gsl_lite::narrow_cast<uint32_t>(box.get() - m_boxes);
+  }
+
+  [[nodiscard]] const Box& getBox(const uint32_t index) const
+  {
+    gsl_Expects(index < size());
+    return m_boxes[index];
+  }
+
+  [[nodiscard]] std::span<const uint32_t> getOverlaps(const uint32_t index) const
+  {
+    gsl_Expects(index < size());
+    return {m_overlaps.data() + m_overlapOffsets[index], m_overlaps.data() + m_overlapOffsets[index + 1]};
+  }
+
+  [[nodiscard]] const std::vector<core::Length>& getFloors() const noexcept
+  {
+    return m_floors;
+  }
+
+  /**
+   * @brief The zones of all boxes, for the same zone that Box::getZoneRef() selects.
+   */
+  [[nodiscard]] const std::vector<ZoneId>& getZones(bool swapped, bool isFlying, const core::Length& step) const;
+
+private:
+  const Box* m_boxes = nullptr;
+  size_t m_boxCount = 0;
+  std::vector<uint32_t> m_overlapOffsets;
+  std::vector<uint32_t> m_overlaps;
+  std::vector<core::Length> m_floors;
+  std::array<std::vector<ZoneId>, 6> m_zones;
+};
+} // namespace engine::world
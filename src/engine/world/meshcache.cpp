@@ -0,0 +1,234 @@
+#include "meshcache.h"
+
+#include "atlastile.h"
+#include "mesh.h"
+#include "rendermeshdata.h"
+#include "util/md5.h"
+
+#include <array>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <gl/pixel.h>
+#include <gsl-lite/gsl-lite.hpp>
+#include <gslu.h>
+#include <ios>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace engine::world
+{
+namespace
+{
+constexpr std::array<char, 4> Magic{'C', 'E', 'M', 'C'};
+constexpr uint32_t Version = 1;
+
+static_assert(std::is_trivially_copyable_v<RenderMeshData::RenderVertex>);
+static_assert(std::is_trivially_copyable_v<RenderMeshData::IndexType>);
+
+template<typename T>
+void put(std::vector<char>& buffer, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+template<typename T>
+void putAll(std::vector<char>& buffer, const std::vector<T>& values)
+{
+  const auto offset = buffer.size();
+  buffer.resize(offset + values.size() * sizeof(T));
+  if(!values.empty())
+    std::memcpy(&buffer[offset], values.data(), values.size() * sizeof(T));
+}
+
+class CacheSource final
+{
+public:
+  explicit CacheSource(const std::span<const char>& data)
+      : m_data{data}
+  {
+  }
+
+  template<typename T>
+  [[nodiscard]] bool get(T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if(m_data.size() < sizeof(T))
+      return false;
+
+    std::memcpy(&value, m_data.data(), sizeof(T));
+    m_data = m_data.subspan(sizeof(T));
+    return true;
+  }
+
+  template<typename T>
+  [[nodiscard]] bool getAll(std::vector<T>& values, const size_t count)
+  {
+    if(m_data.size() / sizeof(T) < count)
+      return false;
+
+    values.resize(count);
+    if(count != 0)
+      std::memcpy(values.data(), m_data.data(), count * sizeof(T));
+    m_data = m_data.subspan(count * sizeof(T));
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_data.empty();
+  }
+
+private:
+  std::span<const char> m_data;
+};
+
+std::string hashFile(const std::filesystem::path& path)
+{
+  const boost::iostreams::mapped_file_source mapping{path.string()};
+  return util::md5(mapping.data(), mapping.size());
+}
+
+std::optional<std::vector<gslu::nn_shared<RenderMeshData>>>
+  readMeshes(const std::span<const char>& data, const std::string& key, const size_t meshCount)
+{
+  CacheSource source{data};
+
+  std::array<char, 4> magic{};
+  uint32_t version = 0;
+  uint32_t vertexSize = 0;
+  uint32_t keySize = 0;
+  if(!source.get(magic) || magic != Magic || !source.get(version) || version != Version || !source.get(vertexSize)
+     || vertexSize != sizeof(RenderMeshData::RenderVertex) || !source.get(keySize) || keySize != key.size())
+    return std::nullopt;
+
+  std::vector<char> storedKey;
+  if(!source.getAll(storedKey, keySize) || std::string{storedKey.begin(), storedKey.end()} != key)
+    return std::nullopt;
+
+  uint64_t storedMeshCount = 0;
+  if(!source.get(storedMeshCount) || storedMeshCount != meshCount)
+    return std::nullopt;
+
+  std::vector<gslu::nn_shared<RenderMeshData>> meshes;
+  meshes.reserve(meshCount);
+  for(size_t i = 0; i < meshCount; ++i)
+  {
+    std::array<uint32_t, 3> sizes{};
+    std::vector<RenderMeshData::RenderVertex> vertices;
+    std::vector<RenderMeshData::IndexType> opaqueIndices;
+    std::vector<RenderMeshData::IndexType> nonOpaqueIndices;
+    if(!source.get(sizes) || !source.getAll(vertices, sizes[0]) || !source.getAll(opaqueIndices, sizes[1])
+       || !source.getAll(nonOpaqueIndices, sizes[2]))
+      return std::nullopt;
+
+    meshes.emplace_back(gsl_lite::make_shared<RenderMeshData>(
+      std::move(vertices), std::move(opaqueIndices), std::move(nonOpaqueIndices)));
+  }
+
+  if(!source.empty())
+    return std::nullopt;
+
+  return meshes;
+}
+} // namespace
+
+std::string getMeshCacheKey(const std::filesystem::path& levelFilename,
+                            const std::vector<AtlasTile>& atlasTiles,
+                            const std::array<gl::SRGBA8, 256>& palette)
+{
+  std::vector<char> layout;
+  for(const auto& tile : atlasTiles)
+  {
+    put(layout, static_cast<uint16_t>(tile.textureKey.blendingMode));
+    put(layout, tile.textureKey.atlasIdAndFlag);
+    for(const auto& uv : tile.uvCoordinates)
+    {
+      put(layout, uv.x);
+      put(layout, uv.y);
+    }
+  }
+  for(const auto& color : palette)
+  {
+    for(int i = 0; i < 4; ++i)
+      put(layout, color.channels[i]);
+  }
+
+  return hashFile(levelFilename) + util::md5(layout.data(), layout.size());
+}
+
+std::optional<std::vector<gslu::nn_shared<RenderMeshData>>>
+  loadMeshCache(const std::filesystem::path& path, const std::string& key, const size_t meshCount)
+{
+  if(!std::filesystem::is_regular_file(path))
+    return std::nullopt;
+
+  std::optional<std::vector<gslu::nn_shared<RenderMeshData>>> meshes;
+  try
+  {
+    const boost::iostreams::mapped_file_source mapping{path.string()};
+    meshes = readMeshes(std::span{mapping.data(), mapping.size()}, key, meshCount);
+  }
+  catch(const std::exception& ex)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Failed to read mesh cache " << path << ": " << ex.what();
+    return std::nullopt;
+  }
+
+  if(!meshes.has_value())
+    BOOST_LOG_TRIVIAL(debug) << "Mesh cache " << path << " is outdated";
+  return meshes;
+}
+
+void writeMeshCache(const std::filesystem::path& path, const std::string& key, const std::vector<Mesh>& meshes)
+{
+  std::vector<char> buffer;
+  put(buffer, Magic);
+  put(buffer, Version);
+  put(buffer, gsl_lite::narrow<uint32_t>(sizeof(RenderMeshData::RenderVertex)));
+  put(buffer, gsl_lite::narrow<uint32_t>(key.size()));
+  buffer.insert(buffer.end(), key.begin(), key.end());
+  put(buffer, static_cast<uint64_t>(meshes.size()));
+  for(const auto& mesh : meshes)
+  {
+    const auto& data = *mesh.meshData;
+    put(buffer,
+        std::array{gsl_lite::narrow<uint32_t>(data.getVertices().size()),
+                   gsl_lite::narrow<uint32_t>(data.getOpaqueIndices().size()),
+                   gsl_lite::narrow<uint32_t>(data.getNonOpaqueIndices().size())});
+    putAll(buffer, data.getVertices());
+    putAll(buffer, data.getOpaqueIndices());
+    putAll(buffer, data.getNonOpaqueIndices());
+  }
+
+  // write to a temporary file first so that an interrupted write never leaves a truncated cache behind
+  auto tmpPath = path;
+  tmpPath += ".tmp";
+  {
+    std::ofstream file{tmpPath, std::ios::binary | std::ios::trunc};
+    file.write(buffer.data(), gsl_lite::narrow<std::streamsize>(buffer.size()));
+    if(!file)
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to write mesh cache " << tmpPath;
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if(ec)
+    BOOST_LOG_TRIVIAL(warning) << "Failed to write mesh cache " << path << ": " << ec.message();
+}
+} // namespace engine::world
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <gl/pixel.h>
+#include <gslu.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine::world
+{
+struct AtlasTile;
+struct Mesh;
+class RenderMeshData;
+
+inline std::filesystem::path getMeshCachePath(const std::filesystem::path& cacheDir)
+{
+  return cacheDir / "_meshes.bin";
+}
+
+/**
+ * @brief Hashes everything the converted meshes depend on: the level file contents, the atlas layout and the palette.
+ */
+[[nodiscard]] extern std::string getMeshCacheKey(const std::filesystem::path& levelFilename,
+                                                 const std::vector<AtlasTile>& atlasTiles,
+                                                 const std::array<gl::SRGBA8, 256>& palette);
+
+/**
+ * @brief Loads the converted render data of all level meshes.
+ * @return Nothing if the cache does not exist, is outdated, or does not match @a key.
+ */
+[[nodiscard]] extern std::optional<std::vector<gslu::nn_shared<RenderMeshData>>>
+  loadMeshCache(const std::filesystem::path& path, const std::string& key, size_t meshCount);
+
+extern void writeMeshCache(const std::filesystem::path& path, const std::string& key, const std::vector<Mesh>& meshes);
+} // namespace engine::world
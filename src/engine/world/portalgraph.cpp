@@ -0,0 +1,150 @@
+#include "portalgraph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace engine::world
+{
+namespace
+{
+//! Portals touching a plane within this distance are considered to reach beyond it, to stay conservative.
+constexpr float PlaneEpsilon = 1.0f;
+} // namespace
+
+bool PortalGeometry::isReachedBy(const PortalGeometry& other) const
+{
+  return std::ranges::any_of(other.vertices,
+                             [this](const glm::vec3& vertex)
+                             {
+                               // written as a negation so that degenerate normals count as reached
+                               return !(glm::dot(normal, vertex - origin) >= PlaneEpsilon);
+                             });
+}
+
+PortalGraph buildPortalGraph(const std::vector<std::vector<PortalGeometry>>& roomPortals,
+                             const std::vector<std::optional<uint32_t>>& alternateRooms)
+{
+  gsl_Expects(roomPortals.size() == alternateRooms.size());
+
+  PortalGraph graph;
+  std::vector<std::vector<uint32_t>> ownPortals(roomPortals.size());
+  for(size_t i = 0; i < roomPortals.size(); ++i)
+  {
+    for(const auto& portal : roomPortals[i])
+    {
+      gsl_Expects(portal.target < roomPortals.size());
+      ownPortals[i].emplace_back(gsl_lite::narrow<uint32_t>(graph.portals.size()));
+      graph.portals.emplace_back(portal);
+    }
+  }
+
+  // a room may be swapped with its alternate room at any time, so both must be traced through the portals of both
+  auto sharedPortals = ownPortals;
+  for(size_t i = 0; i < alternateRooms.size(); ++i)
+  {
+    if(!alternateRooms[i].has_value())
+      continue;
+
+    const auto alternate = *alternateRooms[i];
+    gsl_Expects(alternate < roomPortals.size());
+    sharedPortals[i].insert(sharedPortals[i].end(), ownPortals[alternate].begin(), ownPortals[alternate].end());
+    sharedPortals[alternate].insert(sharedPortals[alternate].end(), ownPortals[i].begin(), ownPortals[i].end());
+  }
+
+  graph.roomPortalOffsets.reserve(roomPortals.size() + 1);
+  for(auto& portals : sharedPortals)
+  {
+    std::ranges::sort(portals);
+    const auto duplicates = std::ranges::unique(portals);
+    portals.erase(duplicates.begin(), duplicates.end());
+
+    graph.roomPortalOffsets.emplace_back(gsl_lite::narrow<uint32_t>(graph.roomPortals.size()));
+    graph.roomPortals.insert(graph.roomPortals.end(), portals.begin(), portals.end());
+  }
+  graph.roomPortalOffsets.emplace_back(gsl_lite::narrow<uint32_t>(graph.roomPortals.size()));
+
+  return graph;
+}
+
+std::vector<uint32_t> traceVisibleRooms(const PortalGraph& graph, const uint32_t source)
+{
+  gsl_Expects(source < graph.size());
+
+  // the portals every line of sight into a room must have passed; if a room is reached through multiple portal
+  // chains, only the portals common to all of them are kept, and the room is expanded again
+  std::vector<std::optional<std::vector<uint32_t>>> roomPlanes(graph.size());
+  std::vector<bool> queued(graph.size(), false);
+  std::deque<uint32_t> queue;
+
+  auto reach = [&roomPlanes, &queued, &queue](const uint32_t room, std::vector<uint32_t>&& planes)
+  {
+    auto& current = roomPlanes[room];
+    if(!current.has_value())
+    {
+      current = std::move(planes);
+    }
+    else
+    {
+      std::vector<uint32_t> common;
+      std::ranges::set_intersection(*current, planes, std::back_inserter(common));
+      if(common.size() == current->size())
+        return;
+      *current = std::move(common);
+    }
+
+    if(!queued[room])
+    {
+      queued[room] = true;
+      queue.emplace_back(room);
+    }
+  };
+
+  reach(source, {});
+  while(!queue.empty())
+  {
+    const auto room = queue.front();
+    queue.pop_front();
+    queued[room] = false;
+
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    const auto planes = *roomPlanes[room];
+    for(const auto portalIndex : graph.getPortals(room))
+    {
+      const auto& portal = graph.portals[portalIndex];
+      if(!std::ranges::all_of(planes,
+                              [&graph, &portal](const uint32_t plane)
+                              {
+                                return graph.portals[plane].isReachedBy(portal);
+                              }))
+      {
+        continue;
+      }
+
+      auto chainPlanes = planes;
+      if(const auto it = std::ranges::lower_bound(chainPlanes, portalIndex);
+         it == chainPlanes.end() || *it != portalIndex)
+      {
+        chainPlanes.insert(it, portalIndex);
+      }
+      reach(portal.target, std::move(chainPlanes));
+    }
+  }
+
+  std::vector<uint32_t> visible;
+  for(uint32_t i = 0; i < roomPlanes.size(); ++i)
+  {
+    if(roomPlanes[i].has_value())
+      visible.emplace_back(i);
+  }
+  return visible;
+}
+} // namespace engine::world
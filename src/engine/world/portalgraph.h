@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace engine::world
+{
+struct PortalGeometry
+{
+  //! @brief The index of the room this portal leads to.
+  uint32_t target;
+  glm::vec3 normal;
+  glm::vec3 origin;
+  std::array<glm::vec3, 4> vertices;
+
+  //! @brief Whether any part of @a other is beyond this portal, as seen from the room containing this portal.
+  [[nodiscard]] bool isReachedBy(const PortalGeometry& other) const;
+};
+
+struct PortalGraph
+{
+  std::vector<PortalGeometry> portals;
+  //! the portals of all rooms, including those of their alternate rooms, in compressed sparse row format
+  std::vector<uint32_t> roomPortalOffsets;
+  std::vector<uint32_t> roomPortals;
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return roomPortalOffsets.size() - 1;
+  }
+
+  [[nodiscard]] std::span<const uint32_t> getPortals(const uint32_t room) const
+  {
+    return {roomPortals.data() + roomPortalOffsets[room], roomPortals.data() + roomPortalOffsets[room + 1]};
+  }
+};
+
+/**
+ * @param roomPortals The portals of each room.
+ * @param alternateRooms The alternate room of each room, if any; a room and its alternate room share their portals.
+ */
+[[nodiscard]] extern PortalGraph buildPortalGraph(const std::vector<std::vector<PortalGeometry>>& roomPortals,
+                                                  const std::vector<std::optional<uint32_t>>& alternateRooms);
+
+/**
+ * @brief Finds all rooms a straight line starting in @a source may reach through chains of portals.
+ * @return The visible rooms, including @a source, in ascending order.
+ */
+[[nodiscard]] extern std::vector<uint32_t> traceVisibleRooms(const PortalGraph& graph, uint32_t source);
+} // namespace engine::world
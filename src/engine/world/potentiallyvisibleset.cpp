@@ -0,0 +1,246 @@
+#include "potentiallyvisibleset.h"
+
+#include "portalgraph.h"
+#include "room.h"
+#include "util/fsutil.h"
+#include "util/md5.h"
+#include "util/threadpool.h"
+
+#include <array>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <glm/geometric.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::world
+{
+namespace
+{
+constexpr std::array<char, 4> Magic{'C', 'E', 'P', 'V'};
+constexpr uint32_t Version = 1;
+
+template<typename T>
+void put(std::vector<char>& buffer, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] bool get(std::span<const char>& data, T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  if(data.size() < sizeof(T))
+    return false;
+
+  std::memcpy(&value, data.data(), sizeof(T));
+  data = data.subspan(sizeof(T));
+  return true;
+}
+
+uint32_t slotOf(const std::vector<Room>& rooms, const Room* room)
+{
+  gsl_Expects(room >= rooms.data() && room < rooms.data() + rooms.size());
+  return gsl_lite::narrow_cast<uint32_t>(room - rooms.data());
+}
+
+PortalGraph buildRoomPortalGraph(const std::vector<Room>& rooms)
+{
+  std::vector<std::vector<PortalGeometry>> roomPortals(rooms.size());
+  std::vector<std::optional<uint32_t>> alternateRooms(rooms.size());
+  for(size_t i = 0; i < rooms.size(); ++i)
+  {
+    for(const auto& portal : rooms[i].portals)
+    {
+      roomPortals[i].emplace_back(PortalGeometry{slotOf(rooms, portal.adjoiningRoom.get()),
+                                                 glm::normalize(portal.normal),
+                                                 portal.vertices[0],
+                                                 portal.vertices});
+    }
+
+    if(rooms[i].alternateRoom != nullptr)
+      alternateRooms[i] = slotOf(rooms, rooms[i].alternateRoom);
+  }
+
+  return buildPortalGraph(roomPortals, alternateRooms);
+}
+
+std::optional<std::pair<std::vector<uint32_t>, std::vector<uint32_t>>>
+  readVisibleRooms(std::span<const char> data, const std::string& key, const size_t roomCount)
+{
+  std::array<char, 4> magic{};
+  uint32_t version = 0;
+  uint32_t keySize = 0;
+  if(!get(data, magic) || magic != Magic || !get(data, version) || version != Version || !get(data, keySize)
+     || keySize != key.size() || data.size() < keySize || std::string_view{data.data(), keySize} != key)
+    return std::nullopt;
+  data = data.subspan(keySize);
+
+  uint32_t storedRoomCount = 0;
+  if(!get(data, storedRoomCount) || storedRoomCount != roomCount)
+    return std::nullopt;
+
+  std::vector<uint32_t> offsets(roomCount + 1);
+  for(size_t i = 0; i < offsets.size(); ++i)
+  {
+    if(!get(data, offsets[i]) || offsets[i] < (i == 0 ? 0 : offsets[i - 1]))
+      return std::nullopt;
+  }
+  if(offsets.front() != 0)
+    return std::nullopt;
+
+  std::vector<uint32_t> visible(offsets.back());
+  for(auto& room : visible)
+  {
+    if(!get(data, room) || room >= roomCount)
+      return std::nullopt;
+  }
+
+  if(!data.empty())
+    return std::nullopt;
+
+  return std::pair{std::move(offsets), std::move(visible)};
+}
+} // namespace
+
+PotentiallyVisibleSet::PotentiallyVisibleSet(const std::vector<Room>& rooms)
+    : m_rooms{rooms.data()}
+    , m_roomCount{rooms.size()}
+{
+  const auto graph = buildRoomPortalGraph(rooms);
+  std::vector<std::vector<uint32_t>> visible(rooms.size());
+  util::ThreadPool::getShared().parallelFor(rooms.size(),
+                                            [&graph, &visible](const size_t i)
+                                            {
+                                              visible[i] = traceVisibleRooms(graph, gsl_lite::narrow<uint32_t>(i));
+                                            });
+
+  m_visibleOffsets.reserve(rooms.size() + 1);
+  for(const auto& roomVisible : visible)
+  {
+    m_visibleOffsets.emplace_back(gsl_lite::narrow<uint32_t>(m_visible.size()));
+    m_visible.insert(m_visible.end(), roomVisible.begin(), roomVisible.end());
+  }
+  m_visibleOffsets.emplace_back(gsl_lite::narrow<uint32_t>(m_visible.size()));
+
+  BOOST_LOG_TRIVIAL(debug) << "Potentially visible set of " << rooms.size() << " rooms has " << m_visible.size()
+                           << " entries";
+  buildMatrix();
+}
+
+PotentiallyVisibleSet::PotentiallyVisibleSet(const std::vector<Room>& rooms,
+                                             std::vector<uint32_t>&& visibleOffsets,
+                                             std::vector<uint32_t>&& visible)
+    : m_rooms{rooms.data()}
+    , m_roomCount{rooms.size()}
+    , m_visibleOffsets{std::move(visibleOffsets)}
+    , m_visible{std::move(visible)}
+{
+  gsl_Expects(m_visibleOffsets.size() == m_roomCount + 1);
+  buildMatrix();
+}
+
+uint32_t PotentiallyVisibleSet::indexOf(const gsl_lite::not_null<const Room*>& room) const
+{
+  gsl_Expects(room.get() >= m_rooms && room.get() < m_rooms + size());
+  return gsl_lite::narrow_cast<uint32_t>(room.get() - m_rooms);
+}
+
+void PotentiallyVisibleSet::buildMatrix()
+{
+  m_matrix.assign((m_roomCount * m_roomCount + 63) / 64, 0);
+  for(uint32_t from = 0; from < m_roomCount; ++from)
+  {
+    for(const auto to : getVisibleRooms(from))
+    {
+      const auto bit = size_t{from} * m_roomCount + to;
+      m_matrix[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+  }
+}
+
+std::string PotentiallyVisibleSet::getCacheKey(const std::vector<Room>& rooms)
+{
+  std::vector<char> data;
+  put(data, gsl_lite::narrow<uint32_t>(rooms.size()));
+  for(const auto& room : rooms)
+  {
+    put(data, room.alternateRoom == nullptr ? std::numeric_limits<uint32_t>::max() : slotOf(rooms, room.alternateRoom));
+    put(data, gsl_lite::narrow<uint32_t>(room.portals.size()));
+    for(const auto& portal : room.portals)
+    {
+      put(data, slotOf(rooms, portal.adjoiningRoom.get()));
+      put(data, portal.normal);
+      put(data, portal.vertices);
+    }
+  }
+
+  return util::md5(data.data(), data.size());
+}
+
+std::optional<PotentiallyVisibleSet> PotentiallyVisibleSet::load(const std::filesystem::path& path,
+                                                                 const std::string& key,
+                                                                 const std::vector<Room>& rooms)
+{
+  if(!std::filesystem::is_regular_file(path))
+    return std::nullopt;
+
+  std::optional<std::pair<std::vector<uint32_t>, std::vector<uint32_t>>> visible;
+  try
+  {
+    const boost::iostreams::mapped_file_source mapping{path.string()};
+    visible = readVisibleRooms(std::span{mapping.data(), mapping.size()}, key, rooms.size());
+  }
+  catch(const std::exception& ex)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Failed to read potentially visible set " << path << ": " << ex.what();
+    return std::nullopt;
+  }
+
+  if(!visible.has_value())
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Potentially visible set " << path << " is outdated";
+    return std::nullopt;
+  }
+
+  return PotentiallyVisibleSet{rooms, std::move(visible->first), std::move(visible->second)};
+}
+
+void PotentiallyVisibleSet::write(const std::filesystem::path& path, const std::string& key) const
+{
+  std::vector<char> data;
+  put(data, Magic);
+  put(data, Version);
+  put(data, gsl_lite::narrow<uint32_t>(key.size()));
+  data.insert(data.end(), key.begin(), key.end());
+  put(data, gsl_lite::narrow<uint32_t>(m_roomCount));
+  for(const auto offset : m_visibleOffsets)
+    put(data, offset);
+  for(const auto room : m_visible)
+    put(data, room);
+
+  try
+  {
+    util::writeFileAtomically(path, std::string_view{data.data(), data.size()});
+  }
+  catch(const std::exception& ex)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Failed to write potentially visible set " << path << ": " << ex.what();
+  }
+}
+} // namespace engine::world
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gsl-lite/gsl-lite.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace engine::world
+{
+struct Room;
+
+inline std::filesystem::path getPotentiallyVisibleSetCachePath(const std::filesystem::path& cacheDir)
+{
+  return cacheDir / "_pvs.bin";
+}
+
+/**
+ * @brief Conservative room-to-room visibility, built once after loading a level.
+ *
+ * A room is potentially visible from another one if a straight line could pass through a chain of portals between
+ * them. Because a line crosses a plane at most once, every portal of such a chain must reach beyond the planes of all
+ * portals before it; chains violating that are pruned. Rooms and their alternate rooms share their portals, so the set
+ * stays valid regardless of flipped rooms.
+ *
+ * Rooms are identified by their index within World::getRooms(), i.e. by their slot, not by their physical id.
+ */
+class PotentiallyVisibleSet final
+{
+public:
+  PotentiallyVisibleSet() = default;
+  explicit PotentiallyVisibleSet(const std::vector<Room>& rooms);
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_roomCount;
+  }
+
+  [[nodiscard]] uint32_t indexOf(const gsl_lite::not_null<const Room*>& room) const;
+
+  //! @brief The rooms potentially visible from @a from, including itself, in ascending order.
+  [[nodiscard]] std::span<const uint32_t> getVisibleRooms(const uint32_t from) const
+  {
+    gsl_Expects(from < size());
+    return {m_visible.data() + m_visibleOffsets[from], m_visible.data() + m_visibleOffsets[from + 1]};
+  }
+
+  [[nodiscard]] std::span<const uint32_t> getVisibleRooms(const gsl_lite::not_null<const Room*>& from) const
+  {
+    return getVisibleRooms(indexOf(from));
+  }
+
+  [[nodiscard]] bool isVisible(const uint32_t from, const uint32_t to) const
+  {
+    gsl_Expects(from < size() && to < size());
+    const auto bit = size_t{from} * size() + to;
+    return (m_matrix[bit / 64] >> (bit % 64)) & 1u;
+  }
+
+  [[nodiscard]] bool isVisible(const gsl_lite::not_null<const Room*>& from,
+                               const gsl_lite::not_null<const Room*>& to) const
+  {
+    return isVisible(indexOf(from), indexOf(to));
+  }
+
+  /**
+   * @brief Hashes everything the set depends on: the portals of all rooms and the alternate room relations.
+   */
+  [[nodiscard]] static std::string getCacheKey(const std::vector<Room>& rooms);
+
+  /**
+   * @brief Loads the set for @a rooms.
+   * @return Nothing if the cache does not exist, is outdated, or does not match @a key.
+   */
+  [[nodiscard]] static std::optional<PotentiallyVisibleSet>
+    load(const std::filesystem::path& path, const std::string& key, const std::vector<Room>& rooms);
+
+  void write(const std::filesystem::path& path, const std::string& key) const;
+
+private:
+  PotentiallyVisibleSet(const std::vector<Room>& rooms,
+                        std::vector<uint32_t>&& visibleOffsets,
+                        std::vector<uint32_t>&& visible);
+
+  void buildMatrix();
+
+  const Room* m_rooms = nullptr;
+  size_t m_roomCount = 0;
+  std::vector<uint32_t> m_visibleOffsets;
+  std::vector<uint32_t> m_visible;
+  std::vector<uint64_t> m_matrix;
+};
+} // namespace engine::world
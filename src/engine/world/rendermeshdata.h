@@ -14,6 +14,7 @@
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace render::material
@@ -82,6 +83,15 @@ public:
                           const std::vector<AtlasTile>& atlasTiles,
                           const std::array<gl::SRGBA8, 256>& palette);
 
+  explicit RenderMeshData(std::vector<RenderVertex> vertices,
+                          std::vector<IndexType> opaqueIndices,
+                          std::vector<IndexType> nonOpaqueIndices) noexcept
+      : m_vertices{std::move(vertices)}
+      , m_opaqueIndices{std::move(opaqueIndices)}
+      , m_nonOpaqueIndices{std::move(nonOpaqueIndices)}
+  {
+  }
+
   [[nodiscard]] const auto& getVertices() const noexcept
   {
     return m_vertices;
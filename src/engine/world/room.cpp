@@ -222,7 +222,6 @@ void Portal::buildMesh(const loader::file::Portal& srcPortal,
 
 void Room::createSceneNode(const loader::file::Room& srcRoom,
                            World& world,
-                           const std::vector<uint16_t>& textureAnimData,
                            render::material::MaterialManager& materialManager)
 {
   node = std::make_shared<render::scene::Node>("Room:" + std::to_string(physicalId));
@@ -233,12 +232,10 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
   }
   else
   {
-    auto textureAnimator = gsl_lite::make_shared<render::TextureAnimator>(textureAnimData);
-
-    const auto [mesh, uvBuffer] = buildMesh(srcRoom, world.getEngine(), world.getWorldGeometry(), *textureAnimator);
+    const auto mesh = buildMesh(srcRoom, world.getEngine(), world.getWorldGeometry());
     node->setRenderable(mesh);
 
-    roomGeometry = std::make_shared<RoomGeometry>(mesh, textureAnimator, uvBuffer);
+    roomGeometry = std::make_shared<RoomGeometry>(mesh);
 
     world.getWorldGeometry().setRoomGeometry(physicalId, gsl_lite::not_null{roomGeometry});
   }
@@ -413,6 +410,7 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
   resetScenery();
 
   particles.setAmbient(*this);
+  spriteParticles.setAmbient(*this);
 }
 
 void patchHeightsForBlock(const objects::Object& object, const core::Length& height)
@@ -491,6 +489,19 @@ void Room::deserialize(const serialization::Deserializer<World>& ser)
       S_NV_VECTOR_ELEMENT("alternateRoom", std::cref(ser.context->getRooms()), std::ref(alternateRoom)));
 }
 
+void Room::resolveSectorHeights()
+{
+  for(int dx = 0; dx < sectorCountX; ++dx)
+  {
+    for(int dz = 0; dz < sectorCountZ; ++dz)
+    {
+      const auto center
+        = position + core::TRVec{1_sectors * dx + 1_sectors / 2, 0_len, 1_sectors * dz + 1_sectors / 2};
+      sectors[sectorCountZ * dx + dz].resolveHeights(center);
+    }
+  }
+}
+
 const Sector* Room::getSectorByIndex(const int dx, const int dz) const
 {
   if(dx < 0 || dx >= sectorCountX)
@@ -646,7 +657,7 @@ void Room::buildMeshData(WorldGeometry& worldGeometry,
                          std::vector<RoomRenderVertex>& vbufData,
                          std::vector<render::AnimatedUV>& uvCoordsData,
                          RoomRenderMesh& renderMesh,
-                         render::TextureAnimator& textureAnimator) const
+                         const render::TextureAnimator& textureAnimator) const
 {
   for(const loader::file::QuadFace& quad : srcRoom.rectangles)
   {
@@ -688,10 +699,13 @@ void Room::buildMeshData(WorldGeometry& worldGeometry,
       iv.position = quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
       iv.color = quad.vertices[i].from(srcRoom.vertices).color;
 
-      uvCoordsData.emplace_back(tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
+      if(const auto animatedUv = textureAnimator.tryGetAnimatedUV(quad.tileId, i); animatedUv.has_value())
+        uvCoordsData.emplace_back(*animatedUv);
+      else
+        uvCoordsData.emplace_back(tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask,
+                                  tile.uvCoordinates[i],
+                                  glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
+                                  glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
       if(useQuadHandling)
       {
         iv.isQuad = 1;
@@ -727,10 +741,6 @@ void Room::buildMeshData(WorldGeometry& worldGeometry,
       else
         renderMesh.m_nonOpaqueIndices.emplace_back(idx);
     }
-    for(const int i : {0, 1, 2, 3})
-    {
-      textureAnimator.registerVertex(quad.tileId, i, firstVertex + i);
-    }
   }
 
   for(const loader::file::Triangle& tri : srcRoom.triangles)
@@ -759,10 +769,13 @@ void Room::buildMeshData(WorldGeometry& worldGeometry,
       RoomRenderVertex iv;
       iv.position = tri.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
       iv.color = tri.vertices[i].from(srcRoom.vertices).color;
-      uvCoordsData.emplace_back(tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
+      if(const auto animatedUv = textureAnimator.tryGetAnimatedUV(tri.tileId, i); animatedUv.has_value())
+        uvCoordsData.emplace_back(*animatedUv);
+      else
+        uvCoordsData.emplace_back(tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask,
+                                  tile.uvCoordinates[i],
+                                  glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
+                                  glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
 
       static constexpr std::array indices{0, 1, 2};
       iv.normal = generateNormal(tri.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
@@ -780,18 +793,11 @@ void Room::buildMeshData(WorldGeometry& worldGeometry,
       else
         renderMesh.m_nonOpaqueIndices.emplace_back(idx);
     }
-    for(const int i : {0, 1, 2})
-    {
-      textureAnimator.registerVertex(tri.tileId, i, firstVertex + i);
-    }
   }
 }
 
-std::pair<gslu::nn_shared<render::scene::Mesh>, gslu::nn_shared<gl::VertexBuffer<render::AnimatedUV>>>
-  Room::buildMesh(const loader::file::Room& srcRoom,
-                  Engine& engine,
-                  WorldGeometry& worldGeometry,
-                  render::TextureAnimator& textureAnimator)
+gslu::nn_shared<render::scene::Mesh>
+  Room::buildMesh(const loader::file::Room& srcRoom, Engine& engine, WorldGeometry& worldGeometry)
 {
   RoomRenderMesh renderMesh;
   renderMesh.m_materialDepthOnly
@@ -833,7 +839,8 @@ std::pair<gslu::nn_shared<render::scene::Mesh>, gslu::nn_shared<gl::VertexBuffer
   std::vector<RoomRenderVertex> vbufData;
   std::vector<render::AnimatedUV> uvCoordsData;
 
-  buildMeshData(worldGeometry, srcRoom, vbufData, uvCoordsData, renderMesh, textureAnimator);
+  const auto textureAnimator = worldGeometry.getTextureAnimator();
+  buildMeshData(worldGeometry, srcRoom, vbufData, uvCoordsData, renderMesh, *textureAnimator);
   if(!renderMesh.m_nonOpaqueIndices.empty())
     BOOST_LOG_TRIVIAL(debug) << "room " << physicalId << " is non-opaque";
 
@@ -847,12 +854,26 @@ std::pair<gslu::nn_shared<render::scene::Mesh>, gslu::nn_shared<gl::VertexBuffer
     {VERTEX_ATTRIBUTE_QUAD_UV34, &render::AnimatedUV::quadUv34},
   };
   auto uvCoordsBuffer = gsl_lite::make_shared<gl::VertexBuffer<render::AnimatedUV>>(
-    uvAttribs, label + "-uv" + gl::VboSuffix, gl::api::BufferUsage::DynamicDraw, uvCoordsData);
+    uvAttribs, label + "-uv" + gl::VboSuffix, gl::api::BufferUsage::StaticDraw, uvCoordsData);
 
   auto resMesh = renderMesh.toMesh(vbuf, uvCoordsBuffer, label);
   resMesh->getRenderState().setCullFace(true);
   resMesh->getRenderState().setCullFaceSide(gl::api::TriangleFace::Back);
-
-  return {resMesh, uvCoordsBuffer};
+  resMesh->bind("b_animatedTiles",
+                [textureAnimator](const render::scene::Node* /*node*/,
+                                  const render::scene::Mesh& /*mesh*/,
+                                  gl::ShaderStorageBlock& shaderStorageBlock)
+                {
+                  shaderStorageBlock.bind(textureAnimator->getTilesBuffer());
+                });
+  resMesh->bind("b_textureSequences",
+                [textureAnimator](const render::scene::Node* /*node*/,
+                                  const render::scene::Mesh& /*mesh*/,
+                                  gl::ShaderStorageBlock& shaderStorageBlock)
+                {
+                  shaderStorageBlock.bind(textureAnimator->getSequencesBuffer());
+                });
+
+  return resMesh;
 }
 } // namespace engine::world
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "engine/particlecollection.h"
 #include "sector.h"
 #include "serialization/serialization_fwd.h"
+#include "staticmeshcollision.h"
 
 #include <algorithm>
 #include <array>
@@ -112,6 +113,7 @@ struct Room
   std::vector<Portal> portals{};
   std::vector<Sector> sectors{};
   std::vector<RoomStaticMesh> staticMeshes{};
+  StaticMeshCollisionBoxes staticMeshCollisionBoxes{};
 
   Room* alternateRoom{nullptr};
 
@@ -122,11 +124,11 @@ struct Room
   glm::vec3 verticesBBoxMax{std::numeric_limits<float>::lowest()};
   std::shared_ptr<render::scene::Node> dust{};
   mutable InstancedParticleCollection particles{};
+  mutable SpriteParticleCollection spriteParticles{};
   std::shared_ptr<RoomGeometry> roomGeometry{};
 
   void createSceneNode(const loader::file::Room& srcRoom,
                        World& world,
-                       const std::vector<uint16_t>& textureAnimData,
                        render::material::MaterialManager& materialManager);
 
   [[nodiscard]] const Sector* getSectorByAbsolutePosition(const core::TRVec& worldPos) const
@@ -177,6 +179,10 @@ struct Room
   std::shared_ptr<gl::ShaderStorageBuffer<ShaderLight>> lightsBuffer{};
 
   void collectShaderLights(size_t depth);
+
+  //! @see Sector::resolveHeights
+  void resolveSectorHeights();
+
   void regenerateDust(Presenter& presenter,
                       const gslu::nn_shared<render::material::Material>& dustMaterial,
                       bool isDustEnabled,
@@ -188,13 +194,10 @@ private:
                      std::vector<RoomRenderVertex>& vbufData,
                      std::vector<render::AnimatedUV>& uvCoordsData,
                      RoomRenderMesh& renderMesh,
-                     render::TextureAnimator& textureAnimator) const;
+                     const render::TextureAnimator& textureAnimator) const;
 
-  [[nodiscard]] std::pair<gslu::nn_shared<render::scene::Mesh>, gslu::nn_shared<gl::VertexBuffer<render::AnimatedUV>>>
-    buildMesh(const loader::file::Room& srcRoom,
-              Engine& engine,
-              WorldGeometry& worldGeometry,
-              render::TextureAnimator& textureAnimator);
+  [[nodiscard]] gslu::nn_shared<render::scene::Mesh>
+    buildMesh(const loader::file::Room& srcRoom, Engine& engine, WorldGeometry& worldGeometry);
 };
 
 extern void patchHeightsForBlock(const objects::Object& object, const core::Length& height);
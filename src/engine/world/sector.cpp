@@ -5,19 +5,182 @@
 #include "engine/floordata/floordata.h"
 #include "engine/floordata/types.h"
 #include "loader/file/datatypes.h"
+#include "room.h"
 #include "serialization/optional.h"
 #include "serialization/quantity.h"
 #include "serialization/serialization.h"
 #include "serialization/vector_element.h"
+#include "util/helpers.h"
 #include "world.h"
 
+#include <cstdint>
 #include <exception>
 #include <functional>
+#include <gsl-lite/gsl-lite.hpp>
 #include <optional>
 #include <vector>
 
 namespace engine::world
 {
+namespace
+{
+const Sector* findSector(const Room& room, const core::TRVec& position)
+{
+  // unlike Room::getSectorByAbsolutePosition, this doesn't complain about sectors that may never be queried
+  const auto localPos = position - room.position;
+  const auto dx = sectorOf(localPos.X);
+  const auto dz = sectorOf(localPos.Z);
+  if(localPos.X < 0_len || dx >= room.sectorCountX || localPos.Z < 0_len || dz >= room.sectorCountZ)
+    return nullptr;
+  return room.getSectorByIndex(dx, dz);
+}
+
+const Sector* findBottomSector(const Sector* sector, const core::TRVec& position)
+{
+  while(sector != nullptr && sector->roomBelow != nullptr)
+    sector = findSector(*sector->roomBelow, position);
+  return sector;
+}
+
+const Sector* findTopSector(const Sector* sector, const core::TRVec& position)
+{
+  while(sector != nullptr && sector->roomAbove != nullptr)
+    sector = findSector(*sector->roomAbove, position);
+  return sector;
+}
+
+FloorPatch decodeSlant(const floordata::FloorDataValue& value)
+{
+  return FloorPatch{std::nullopt,
+                    gsl_lite::narrow_cast<int8_t>(util::bits(value.get(), 0, 8)),
+                    gsl_lite::narrow_cast<int8_t>(util::bits(value.get(), 8, 8))};
+}
+
+/**
+ * @brief Calls @p onActivate for all objects activated by the command sequence at @p fd, and advances @p fd past it.
+ */
+void collectActivatedObjects(const floordata::FloorDataValue*& fd, const std::function<void(uint16_t)>& onActivate)
+{
+  ++fd;
+  while(true)
+  {
+    const floordata::Command command{*fd++};
+
+    if(command.opcode == floordata::CommandOpcode::Activate)
+      onActivate(command.parameter);
+    else if(command.opcode == floordata::CommandOpcode::SwitchCamera)
+      command.isLast = floordata::CameraParameters{*fd++}.isLast;
+
+    if(command.isLast)
+      break;
+  }
+}
+
+ResolvedFloor resolveFloor(const Sector& sector, const core::TRVec& position)
+{
+  ResolvedFloor result;
+  result.sector = findBottomSector(&sector, position);
+  if(result.sector == nullptr || result.sector->floorData == nullptr)
+    return result;
+
+  // mirrors HeightInfo::fromFloor
+  const floordata::FloorDataValue* fd = result.sector->floorData;
+  while(true)
+  {
+    const floordata::FloorDataChunk chunkHeader{*fd++};
+    switch(chunkHeader.type)
+    {
+    case floordata::FloorDataChunkType::FloorSlant:
+      result.patches.emplace_back(decodeSlant(*fd++));
+      break;
+    // NOLINTNEXTLINE(bugprone-branch-clone)
+    case floordata::FloorDataChunkType::CeilingSlant:
+      ++fd;
+      break;
+    case floordata::FloorDataChunkType::BoundaryRoom:
+      ++fd;
+      break;
+    case floordata::FloorDataChunkType::Death:
+      result.lastCommandSequenceOrDeath = fd - 1;
+      break;
+    case floordata::FloorDataChunkType::CommandSequence:
+      if(result.lastCommandSequenceOrDeath == nullptr)
+        result.lastCommandSequenceOrDeath = fd - 1;
+      collectActivatedObjects(fd,
+                              [&result](const uint16_t objectId)
+                              {
+                                result.patches.emplace_back(FloorPatch{objectId});
+                              });
+      break;
+    default:
+      break;
+    }
+    if(chunkHeader.isLast)
+      break;
+  }
+
+  return result;
+}
+
+ResolvedCeiling resolveCeiling(const Sector& sector, const core::TRVec& position)
+{
+  // mirrors HeightInfo::fromCeiling
+  const auto topSector = findTopSector(&sector, position);
+  const auto bottomSector = findBottomSector(topSector, position);
+  if(topSector == nullptr || bottomSector == nullptr)
+    return {};
+
+  ResolvedCeiling result;
+  result.sector = topSector;
+
+  if(topSector->floorData != nullptr)
+  {
+    const floordata::FloorDataValue* fd = topSector->floorData;
+    floordata::FloorDataChunk chunkHeader{*fd++};
+    if(chunkHeader.type == floordata::FloorDataChunkType::FloorSlant)
+    {
+      ++fd;
+      chunkHeader = floordata::FloorDataChunk{*fd++};
+    }
+
+    if(chunkHeader.type == floordata::FloorDataChunkType::CeilingSlant)
+      result.slant = decodeSlant(*fd);
+  }
+
+  if(bottomSector->floorData == nullptr)
+    return result;
+
+  const floordata::FloorDataValue* fd = bottomSector->floorData;
+  while(true)
+  {
+    const floordata::FloorDataChunk chunkHeader{*fd++};
+    switch(chunkHeader.type)
+    {
+    case floordata::FloorDataChunkType::CeilingSlant:
+    case floordata::FloorDataChunkType::FloorSlant:
+    case floordata::FloorDataChunkType::BoundaryRoom:
+      ++fd;
+      break;
+    case floordata::FloorDataChunkType::Death:
+      break;
+    case floordata::FloorDataChunkType::CommandSequence:
+      collectActivatedObjects(fd,
+                              [&result](const uint16_t objectId)
+                              {
+                                result.patchingObjects.emplace_back(objectId);
+                              });
+      break;
+    default:
+      break;
+    }
+    if(chunkHeader.isLast)
+      break;
+  }
+
+  return result;
+}
+} // namespace
+
 Sector::Sector(const loader::file::Sector& src,
                std::vector<Room>& rooms,
                const std::vector<Box>& boxes,
@@ -62,6 +225,12 @@ void Sector::connect(std::vector<Room>& rooms)
   }
 }
 
+void Sector::resolveHeights(const core::TRVec& position)
+{
+  resolvedFloor = resolveFloor(*this, position);
+  resolvedCeiling = resolveCeiling(*this, position);
+}
+
 void Sector::serialize(const serialization::Serializer<World>& ser) const
 {
   ser(S_NV_VECTOR_ELEMENT("box", std::cref(ser.context->getBoxes()), std::cref(box)),
@@ -2,10 +2,12 @@
 
 #include "core/magic.h"
 #include "core/units.h"
+#include "core/vec.h"
 #include "engine/floordata/types.h"
 #include "serialization/serialization_fwd.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -20,6 +22,34 @@ class World;
 struct Box;
 struct Room;
 
+struct FloorPatch
+{
+  //! @brief The object whose floor patch to apply; if not set, this is a slant.
+  std::optional<uint16_t> objectId;
+  int8_t xSlant = 0;
+  int8_t zSlant = 0;
+};
+
+//! @brief The floor of a sector after following the rooms below, with its floordata pre-decoded.
+struct ResolvedFloor
+{
+  //! @brief The bottom-most sector, or @c nullptr if it could not be resolved.
+  const Sector* sector = nullptr;
+  //! @brief Slants and object patches, in floordata order.
+  std::vector<FloorPatch> patches;
+  const floordata::FloorDataValue* lastCommandSequenceOrDeath = nullptr;
+};
+
+//! @brief The ceiling of a sector after following the rooms above, with its floordata pre-decoded.
+struct ResolvedCeiling
+{
+  //! @brief The top-most sector, or @c nullptr if it could not be resolved.
+  const Sector* sector = nullptr;
+  std::optional<FloorPatch> slant;
+  //! @brief Objects patching the ceiling, taken from the bottom-most sector below the top-most sector.
+  std::vector<uint16_t> patchingObjects;
+};
+
 struct Sector
 {
   const floordata::FloorDataValue* floorData = nullptr;
@@ -31,6 +61,12 @@ struct Sector
   Room* roomAbove = nullptr;
   core::Length ceilingHeight = core::InvalidHeight; // value is sometimes considered exclusive, sometimes not
 
+  //! @brief Only valid after all sectors were connected, see World::connectSectors().
+  //! @{
+  ResolvedFloor resolvedFloor;
+  ResolvedCeiling resolvedCeiling;
+  //! @}
+
   Sector() = default;
   Sector(const loader::file::Sector& src,
          std::vector<Room>& rooms,
@@ -39,6 +75,12 @@ struct Sector
 
   void connect(std::vector<Room>& rooms);
 
+  /**
+   * @brief Updates #resolvedFloor and #resolvedCeiling; @p position is any position within this sector.
+   * @pre All sectors are connected.
+   */
+  void resolveHeights(const core::TRVec& position);
+
   void serialize(const serialization::Serializer<World>& ser) const;
   void deserialize(const serialization::Deserializer<World>& ser);
 
@@ -0,0 +1,135 @@
+#include "staticmeshcollision.h"
+
+#include "core/angle.h"
+#include "core/boundingbox.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "room.h"
+#include "staticmesh.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <gsl-lite/gsl-lite.hpp>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define STATICMESHCOLLISION_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace engine::world
+{
+namespace
+{
+[[nodiscard]] core::BoundingBox
+  rotateTranslate(const core::BoundingBox& bbox, const core::TRVec& pos, const core::Angle& angle)
+{
+  auto result = bbox;
+
+  switch(axisFromAngle(angle))
+  {
+  case core::Axis::Deg0:
+    // nothing to do
+    break;
+  case core::Axis::Right90:
+    result.x = {bbox.z.min, bbox.z.max};
+    result.z = {-bbox.x.max, -bbox.x.min};
+    break;
+  case core::Axis::Deg180:
+    result.x = {-bbox.x.max, -bbox.x.min};
+    result.z = {-bbox.z.max, -bbox.z.min};
+    break;
+  case core::Axis::Left90:
+    result.x = {-bbox.z.max, -bbox.z.min};
+    result.z = {bbox.x.min, bbox.x.max};
+    break;
+  }
+
+  result.x += pos.X;
+  result.y += pos.Y;
+  result.z += pos.Z;
+  return result;
+}
+} // namespace
+
+StaticMeshCollisionBoxes::StaticMeshCollisionBoxes(const std::vector<RoomStaticMesh>& staticMeshes)
+{
+  for(const auto& rsm : staticMeshes)
+  {
+    if(rsm.staticMesh->doNotCollide)
+      continue;
+
+    const auto box = rotateTranslate(rsm.staticMesh->collisionBox, rsm.position, rsm.rotation);
+    m_minX.emplace_back(box.x.min.get());
+    m_maxX.emplace_back(box.x.max.get());
+    m_minY.emplace_back(box.y.min.get());
+    m_maxY.emplace_back(box.y.max.get());
+    m_minZ.emplace_back(box.z.min.get());
+    m_maxZ.emplace_back(box.z.max.get());
+  }
+
+  m_size = m_minX.size();
+
+  // inverted boxes fail every intersection test
+  const auto padded = (m_size + Lanes - 1) / Lanes * Lanes;
+  for(auto* mins : {&m_minX, &m_minY, &m_minZ})
+    mins->resize(padded, std::numeric_limits<int32_t>::max());
+  for(auto* maxs : {&m_maxX, &m_maxY, &m_maxZ})
+    maxs->resize(padded, std::numeric_limits<int32_t>::min());
+}
+
+std::optional<size_t> StaticMeshCollisionBoxes::findFirstIntersection(const core::BoundingBox& box) const
+{
+  // same as core::BoundingBox::intersectsExclusive, for #Lanes boxes at once
+#ifdef STATICMESHCOLLISION_SSE2
+  const auto minX = _mm_set1_epi32(box.x.min.get());
+  const auto maxX = _mm_set1_epi32(box.x.max.get());
+  const auto minY = _mm_set1_epi32(box.y.min.get());
+  const auto maxY = _mm_set1_epi32(box.y.max.get());
+  const auto minZ = _mm_set1_epi32(box.z.min.get());
+  const auto maxZ = _mm_set1_epi32(box.z.max.get());
+
+  const auto load = [](const std::vector<int32_t>& data, const size_t base)
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[base]));
+  };
+
+  for(size_t base = 0; base < m_minX.size(); base += Lanes)
+  {
+    const auto hitX
+      = _mm_and_si128(_mm_cmplt_epi32(load(m_minX, base), maxX), _mm_cmplt_epi32(minX, load(m_maxX, base)));
+    const auto hitY
+      = _mm_and_si128(_mm_cmplt_epi32(load(m_minY, base), maxY), _mm_cmplt_epi32(minY, load(m_maxY, base)));
+    const auto hitZ
+      = _mm_and_si128(_mm_cmplt_epi32(load(m_minZ, base), maxZ), _mm_cmplt_epi32(minZ, load(m_maxZ, base)));
+    const auto hits = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(_mm_and_si128(hitX, hitY), hitZ)));
+    if(hits != 0)
+      return base + static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(hits)));
+  }
+#else
+  for(size_t i = 0; i < m_size; ++i)
+  {
+    if(m_minX[i] < box.x.max.get() && box.x.min.get() < m_maxX[i] && m_minY[i] < box.y.max.get()
+       && box.y.min.get() < m_maxY[i] && m_minZ[i] < box.z.max.get() && box.z.min.get() < m_maxZ[i])
+      return i;
+  }
+#endif
+
+  return std::nullopt;
+}
+
+core::BoundingBox StaticMeshCollisionBoxes::getBox(const size_t index) const
+{
+  gsl_Expects(index < m_size);
+  return core::BoundingBox{core::Length{m_minX[index]},
+                           core::Length{m_maxX[index]},
+                           core::Length{m_minY[index]},
+                           core::Length{m_maxY[index]},
+                           core::Length{m_minZ[index]},
+                           core::Length{m_maxZ[index]}};
+}
+} // namespace engine::world
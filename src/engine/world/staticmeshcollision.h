@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/boundingbox.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace engine::world
+{
+struct RoomStaticMesh;
+
+/**
+ * @brief World-space collision boxes of the collidable static meshes of a room, stored as a structure of arrays.
+ *
+ * The arrays are padded to a multiple of #Lanes with boxes that never intersect anything, so that the intersection
+ * test can process whole blocks with SIMD instructions.
+ */
+class StaticMeshCollisionBoxes final
+{
+public:
+  //! @brief Number of boxes tested at once, matching the 128 bit registers of SSE2.
+  static constexpr size_t Lanes = 4;
+
+  StaticMeshCollisionBoxes() = default;
+  explicit StaticMeshCollisionBoxes(const std::vector<RoomStaticMesh>& staticMeshes);
+
+  /**
+   * @brief Finds the first box, in the order of the room's static meshes, which intersects exclusively with @p box.
+   * @return The index of the matching box.
+   */
+  [[nodiscard]] std::optional<size_t> findFirstIntersection(const core::BoundingBox& box) const;
+
+  [[nodiscard]] core::BoundingBox getBox(size_t index) const;
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_size;
+  }
+
+private:
+  size_t m_size = 0;
+  std::vector<int32_t> m_minX;
+  std::vector<int32_t> m_maxX;
+  std::vector<int32_t> m_minY;
+  std::vector<int32_t> m_maxY;
+  std::vector<int32_t> m_minZ;
+  std::vector<int32_t> m_maxZ;
+};
+} // namespace engine::world
@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE engine_world
+
+#include "engine/world/portalgraph.h"
+
+#include <algorithm>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <vector>
+
+namespace
+{
+using engine::world::PortalGeometry;
+
+//! @brief A portal spanning the x/y-rectangle at @a z, leading to @a target in the +z direction.
+PortalGeometry portalZ(const uint32_t target, const float z, const float x0, const float x1)
+{
+  return PortalGeometry{target,
+                        glm::vec3{0, 0, -1},
+                        glm::vec3{x0, 0, z},
+                        {glm::vec3{x0, 0, z}, glm::vec3{x1, 0, z}, glm::vec3{x1, 1024, z}, glm::vec3{x0, 1024, z}}};
+}
+
+//! @brief A portal spanning the z/y-rectangle at @a x, leading to @a target in the +x direction.
+PortalGeometry portalX(const uint32_t target, const float x, const float z0, const float z1)
+{
+  return PortalGeometry{target,
+                        glm::vec3{-1, 0, 0},
+                        glm::vec3{x, 0, z0},
+                        {glm::vec3{x, 0, z0}, glm::vec3{x, 0, z1}, glm::vec3{x, 1024, z1}, glm::vec3{x, 1024, z0}}};
+}
+
+//! @brief Like portalX, but leading in the -x direction.
+PortalGeometry portalNegX(const uint32_t target, const float x, const float z0, const float z1)
+{
+  auto portal = portalX(target, x, z0, z1);
+  portal.normal = -portal.normal;
+  return portal;
+}
+
+std::vector<uint32_t> trace(const std::vector<std::vector<PortalGeometry>>& roomPortals, const uint32_t source)
+{
+  return engine::world::traceVisibleRooms(
+    engine::world::buildPortalGraph(roomPortals, std::vector<std::optional<uint32_t>>(roomPortals.size())), source);
+}
+
+bool contains(const std::vector<uint32_t>& rooms, const uint32_t room)
+{
+  return std::ranges::find(rooms, room) != rooms.end();
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(portalgraph_tests)
+
+BOOST_AUTO_TEST_CASE(test_portal_reached)
+{
+  const auto portal = portalX(1, 1024, 0, 1024);
+  BOOST_CHECK(portal.isReachedBy(portalX(2, 2048, 0, 1024)));
+  BOOST_CHECK(!portal.isReachedBy(portalX(2, 512, 0, 1024)));
+  // portals touching the plane count as reached
+  BOOST_CHECK(portal.isReachedBy(portalZ(2, 1024, 0, 1024)));
+  BOOST_CHECK(portal.isReachedBy(portalX(2, 1024, 1024, 2048)));
+  // only a single vertex needs to be beyond the plane
+  BOOST_CHECK(portal.isReachedBy(portalZ(2, 1024, 0, 2048)));
+}
+
+BOOST_AUTO_TEST_CASE(test_straight_chain)
+{
+  // rooms 0..3 along the x axis, with portals in both directions
+  const std::vector<std::vector<PortalGeometry>> roomPortals{
+    {portalX(1, 1024, 0, 1024)},
+    {portalNegX(0, 1024, 0, 1024), portalX(2, 2048, 0, 1024)},
+    {portalNegX(1, 2048, 0, 1024), portalX(3, 3072, 0, 1024)},
+    {portalNegX(2, 3072, 0, 1024)},
+  };
+
+  for(uint32_t source = 0; source < roomPortals.size(); ++source)
+    BOOST_CHECK((trace(roomPortals, source) == std::vector<uint32_t>{0, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_u_turn_is_pruned)
+{
+  // room 0 leads to room 1 in +x, room 1 to room 2 in +z, and room 2 back in -x to room 3, which is behind the
+  // portal leaving room 0
+  const std::vector<std::vector<PortalGeometry>> roomPortals{
+    {portalX(1, 1024, 0, 1024)},
+    {portalZ(2, 1024, 1024, 2048)},
+    {portalNegX(3, 512, 1024, 2048)},
+    {},
+  };
+
+  BOOST_CHECK((trace(roomPortals, 0) == std::vector<uint32_t>{0, 1, 2}));
+  BOOST_CHECK((trace(roomPortals, 1) == std::vector<uint32_t>{1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_chains_are_intersected)
+{
+  // room 3 is reached from room 0 both through room 1 (+x, then +z) and through room 2 (+z, then +z); room 4 is
+  // behind the +x portal of room 0, so it is only visible along the chain through room 2
+  const auto toRoom4 = portalZ(4, 3072, 0, 512);
+  std::vector<std::vector<PortalGeometry>> roomPortals{
+    {portalX(1, 1024, 0, 1024), portalZ(2, 1024, 0, 1024)},
+    {portalZ(3, 2048, 1024, 2048)},
+    {portalZ(3, 2048, 0, 1024)},
+    {toRoom4},
+    {},
+  };
+
+  BOOST_CHECK((trace(roomPortals, 0) == std::vector<uint32_t>{0, 1, 2, 3, 4}));
+
+  // without the chain through room 2, the planes of the chain through room 1 prune room 4
+  roomPortals[0].pop_back();
+  BOOST_CHECK((trace(roomPortals, 0) == std::vector<uint32_t>{0, 1, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_alternate_rooms_share_portals)
+{
+  // room 2 is the alternate room of room 1, and only room 2 has a portal to room 3
+  const std::vector<std::vector<PortalGeometry>> roomPortals{
+    {portalX(1, 1024, 0, 1024)},
+    {},
+    {portalX(3, 2048, 0, 1024)},
+    {},
+  };
+
+  BOOST_CHECK(!contains(trace(roomPortals, 0), 3));
+
+  const auto graph = engine::world::buildPortalGraph(roomPortals, {std::nullopt, 2, 1, std::nullopt});
+  BOOST_REQUIRE_EQUAL(graph.getPortals(1).size(), 1);
+  BOOST_REQUIRE_EQUAL(graph.getPortals(2).size(), 1);
+  BOOST_CHECK_EQUAL(graph.getPortals(1)[0], graph.getPortals(2)[0]);
+  BOOST_CHECK((engine::world::traceVisibleRooms(graph, 0) == std::vector<uint32_t>{0, 1, 3}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
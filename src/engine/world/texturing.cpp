@@ -16,6 +16,7 @@
 #include "serialization/serialization.h"
 #include "serialization/yamldocument.h"
 #include "sprite.h"
+#include "util/threadpool.h"
 
 #include <algorithm>
 #include <array>
@@ -29,6 +30,7 @@
 #include <functional>
 #include <future>
 #include <gl/cimgwrapper.h>
+#include <gl/glad_init.h>
 #include <gl/image.h>
 #include <gl/pixel.h>
 #include <gl/texture2darray.h>
@@ -242,68 +244,64 @@ std::vector<std::vector<Tile>> getMaximizedAtlasesTiles(const loader::file::leve
   return atlasesTiles;
 }
 
-bool tryRemapTile(Tile& maximizedTile,
-                  const loader::trx::Rectangle& glidosTile,
-                  render::MultiTextureAtlas& atlases,
-                  std::map<std::filesystem::path, glm::ivec2>& textureSizes,
-                  const std::filesystem::path& path,
-                  const std::shared_ptr<gl::Image<gl::SRGBA8>>& textureImage)
+struct TileReplacement
+{
+  gsl_lite::not_null<Tile*> tile;
+  gsl_lite::not_null<const loader::file::DWordTexture*> atlas;
+  //! empty if the tile is not replaced by an external texture
+  std::filesystem::path path;
+  std::optional<gl::CImgWrapper> image{};
+};
+
+void loadReplacementImage(TileReplacement& replacement)
 {
-  if(glidosTile.getXY0() != maximizedTile.position || glidosTile.getXY1() != maximizedTile.getXY1())
+  const auto& tile = *replacement.tile;
+  if(replacement.path.empty())
   {
-    return false;
+    gl::CImgWrapper replacementImg(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<const uint8_t*>(replacement.atlas->image->getRawData()),
+      256,
+      256,
+      true);
+    replacementImg.crop(tile.position.x, tile.position.y, tile.getXY1().x - 1, tile.getXY1().y - 1);
+    replacement.image = std::move(replacementImg);
   }
-
-  if(maximizedTile.remapped.has_value())
+  else
   {
-    return true;
+    replacement.image.emplace(replacement.path);
   }
 
-  const bool hasExternalTexture = !path.empty() && std::filesystem::is_regular_file(path);
+  if(!tile.opaque)
+    replacement.image->premultiplyPixels();
+}
 
+void placeReplacement(TileReplacement& replacement,
+                      render::MultiTextureAtlas& atlases,
+                      std::map<std::filesystem::path, glm::ivec2>& textureSizes)
+{
+  auto& tile = *replacement.tile;
   if(atlases.isOnlyLayout())
   {
-    if(!hasExternalTexture)
-    {
-      const auto remapped = atlases.put(maximizedTile.size);
-      maximizedTile.remapped = {remapped.first, remapped.second, maximizedTile.size};
-    }
-    else
-    {
-      const auto& size = textureSizes.at(path);
-      const auto remapped = atlases.put(size);
-      maximizedTile.remapped = {remapped.first, remapped.second, size};
-    }
+    const auto size = replacement.path.empty() ? tile.size : textureSizes.at(replacement.path);
+    const auto remapped = atlases.put(size);
+    tile.remapped = {remapped.first, remapped.second, size};
+    return;
+  }
+
+  gsl_Assert(replacement.image.has_value());
+  const glm::ivec2 size{replacement.image->width(), replacement.image->height()};
+  const auto remapped = atlases.put(std::move(*replacement.image));
+  replacement.image.reset();
+  if(replacement.path.empty())
+  {
+    tile.remapped = {remapped.first, remapped.second, tile.size};
   }
   else
   {
-    if(!hasExternalTexture)
-    {
-      gl::CImgWrapper replacementImg(
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        reinterpret_cast<const uint8_t*>(textureImage->getRawData()),
-        256,
-        256,
-        true);
-      replacementImg.crop(
-        maximizedTile.position.x, maximizedTile.position.y, maximizedTile.getXY1().x - 1, maximizedTile.getXY1().y - 1);
-      if(!maximizedTile.opaque)
-        replacementImg.premultiplyPixels();
-      const auto remapped = atlases.put(replacementImg);
-      maximizedTile.remapped = {remapped.first, remapped.second, maximizedTile.size};
-    }
-    else
-    {
-      gl::CImgWrapper tmp{path};
-      if(!maximizedTile.opaque)
-        tmp.premultiplyPixels();
-      const auto remapped = atlases.put(tmp);
-      maximizedTile.remapped = {remapped.first, remapped.second, {tmp.width(), tmp.height()}};
-      textureSizes.emplace(path, glm::ivec2{tmp.width(), tmp.height()});
-    }
+    tile.remapped = {remapped.first, remapped.second, size};
+    textureSizes.emplace(replacement.path, size);
   }
-
-  return true;
 }
 
 // draws 0..5% progress
@@ -321,34 +319,57 @@ void layoutAtlases(const loader::file::level::Level& level,
   gsl_Assert(maximizedAtlasesTiles.size() == level.m_atlases.size());
 
   BOOST_LOG_TRIVIAL(debug) << "Layouting texture atlases";
+  std::vector<TileReplacement> replacements;
   for(size_t atlasId = 0; atlasId < level.m_atlases.size(); ++atlasId)
   {
-    drawLoadingScreen(_("Building atlases (%1%%%)", atlasId * 5 / level.m_atlases.size()));
-
     const auto& atlas = level.m_atlases[atlasId];
-    BOOST_LOG_TRIVIAL(debug) << "Layouting atlas " << atlas.md5;
     auto& maximizedAtlasTiles = maximizedAtlasesTiles[atlasId];
     auto mappings = glidos.getMappingsForTexture(atlas.md5);
     BOOST_LOG_TRIVIAL(debug) << "Layouting atlas " << atlas.md5 << ", " << mappings.size() << " possible mappings";
     for(auto& maximizedTile : maximizedAtlasTiles)
     {
-      bool found = false;
-      for(const auto& [tile, path] : mappings)
+      const auto it = std::ranges::find_if(mappings,
+                                           [&maximizedTile](const auto& mapping)
+                                           {
+                                             return mapping.first.getXY0() == maximizedTile.position
+                                                    && mapping.first.getXY1() == maximizedTile.getXY1();
+                                           });
+
+      std::filesystem::path path;
+      if(it != mappings.end())
       {
-        if(tryRemapTile(maximizedTile, tile, atlases, textureSizes, path, atlas.image))
-        {
-          found = true;
-          break;
-        }
+        if(std::filesystem::is_regular_file(it->second))
+          path = it->second;
+      }
+      else
+      {
+        glidos.insertInternalMapping(atlas.md5, loader::trx::Rectangle{maximizedTile.position, maximizedTile.getXY1()});
       }
 
-      if(found)
-        continue;
+      replacements.emplace_back(TileReplacement{&maximizedTile, &atlas, std::move(path)});
+    }
+  }
 
-      const auto mappedRect = loader::trx::Rectangle{maximizedTile.position, maximizedTile.getXY1()};
-      glidos.insertInternalMapping(atlas.md5, mappedRect);
-      gsl_Assert(tryRemapTile(maximizedTile, mappedRect, atlases, textureSizes, {}, atlas.image));
+  // images are decoded in parallel batches, but placed in their original order to keep the layout deterministic,
+  // which is required to match the cached atlases
+  auto& threadPool = util::ThreadPool::getShared();
+  const auto batchSize = 4 * (threadPool.getWorkerCount() + 1);
+  for(size_t first = 0; first < replacements.size(); first += batchSize)
+  {
+    drawLoadingScreen(_("Building atlases (%1%%%)", first * 5 / replacements.size()));
+
+    const auto count = std::min(batchSize, replacements.size() - first);
+    if(!atlases.isOnlyLayout())
+    {
+      threadPool.parallelFor(count,
+                             [&replacements, first](const size_t i)
+                             {
+                               loadReplacementImage(replacements[first + i]);
+                             });
     }
+
+    for(size_t i = first; i < first + count; ++i)
+      placeReplacement(replacements[i], atlases, textureSizes);
   }
 
   for(size_t atlasId = 0; atlasId < level.m_atlases.size(); ++atlasId)
@@ -522,7 +543,7 @@ void materializeAtlases(const loader::file::level::Level& level,
         replacementImg.crop(srcMinPx.x, srcMinPx.y, srcMaxPx.x, srcMaxPx.y);
         if(!tile->isOpaque())
           replacementImg.premultiplyPixels();
-        replacementPos = atlases.put(replacementImg);
+        replacementPos = atlases.put(std::move(replacementImg));
       }
       else
       {
@@ -582,7 +603,7 @@ void materializeAtlases(const loader::file::level::Level& level,
           true);
         replacementImg->crop(minMaxPx.first.x, minMaxPx.first.y, minMaxPx.second.x, minMaxPx.second.y);
         replacementImg->premultiplyPixels();
-        replacementPos = atlases.put(*replacementImg);
+        replacementPos = atlases.put(std::move(*replacementImg));
       }
       replaced.emplace(srcTile, replacementPos);
     }
@@ -614,11 +635,8 @@ struct DataPart
 class DataProvider
 {
 public:
-  explicit DataProvider(gl::CImgWrapper& img)
-      : m_bmp{std::make_shared<Bitmap>(
-          glm::ivec2{img.width(), img.height()},
-          gsl_lite::span{reinterpret_cast<const uint32_t*>(img.pixels().data()), img.pixels().size()})}
-      , m_current{m_bmp[0]}
+  explicit DataProvider(const std::shared_ptr<Bitmap>& bmp)
+      : m_bmp{bmp}
   {
   }
 
@@ -626,75 +644,165 @@ public:
 
   [[nodiscard]] uint32_t numberOfParts() const noexcept
   {
-    return ((m_bmp[0]->size().y / 4) + m_linesPerPart - 1) / m_linesPerPart;
+    return ((m_bmp->size().y / 4) + m_linesPerPart - 1) / m_linesPerPart;
   }
 
   [[nodiscard]] DataPart nextPart()
   {
     assert(!m_done);
 
-    const auto [ptr, lines, done] = m_current->nextBlock(m_linesPerPart);
-    const DataPart ret{ptr, std::max<uint32_t>(4, m_current->size().x), lines, m_offset};
+    const auto [ptr, lines, done] = m_bmp->nextBlock(m_linesPerPart);
+    const DataPart ret{ptr, std::max<uint32_t>(4, m_bmp->size().x), lines, m_offset};
 
-    m_offset += m_current->size().x / 4 * lines;
+    m_offset += m_bmp->size().x / 4 * lines;
 
     m_done |= done;
 
     return ret;
   }
 
-  [[nodiscard]] const glm::ivec2& size() const noexcept
-  {
-    return m_bmp[0]->size();
-  }
-
 private:
-  std::vector<std::shared_ptr<Bitmap>> m_bmp;
-  std::shared_ptr<Bitmap> m_current;
+  std::shared_ptr<Bitmap> m_bmp;
   uint32_t m_offset = 0;
   uint32_t m_linesPerPart = 32;
   bool m_done = false;
 };
 
-void compressEtc2(gl::CImgWrapper& wrapper, const std::filesystem::path& output)
+/**
+ * @brief The number of mip levels stored in the texture cache; the ETC2 encoder needs sizes which are a multiple of 4.
+ */
+int getEtc2Levels(int size)
 {
-  wrapper.interleave();
+  int levels = 1;
+  while(size % 8 == 0)
+  {
+    size /= 2;
+    ++levels;
+  }
+  return levels;
+}
+
+/**
+ * @brief Halves the size of an image, averaging the color channels in linear space, like the mipmap generation of
+ * sRGB textures does.
+ */
+std::shared_ptr<Bitmap> downsample(const Bitmap& src)
+{
+  static const auto srgbToLinear = []()
+  {
+    std::array<float, 256> result{};
+    for(size_t i = 0; i < result.size(); ++i)
+    {
+      const auto c = static_cast<float>(i) / 255.0f;
+      result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+    return result;
+  }();
+
+  static const auto linearToSrgb = [](const float c)
+  {
+    const auto srgb = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1 / 2.4f) - 0.055f;
+    return gsl_lite::narrow_cast<uint32_t>(std::lround(std::clamp(srgb, 0.0f, 1.0f) * 255.0f));
+  };
+
+  gsl_Expects(src.size().x % 2 == 0 && src.size().y % 2 == 0);
+
+  const auto size = src.size() / 2;
+  auto dst = std::make_shared<Bitmap>(size);
+  const auto srcWidth = gsl_lite::narrow_cast<size_t>(src.size().x);
+  for(int y = 0; y < size.y; ++y)
+  {
+    const auto* row0 = src.data() + gsl_lite::narrow_cast<size_t>(2 * y) * srcWidth;
+    const auto* row1 = row0 + srcWidth;
+    auto* dstRow = dst->data() + gsl_lite::narrow_cast<size_t>(y) * gsl_lite::narrow_cast<size_t>(size.x);
+    for(int x = 0; x < size.x; ++x)
+    {
+      const std::array<uint32_t, 4> quad{row0[2 * x], row0[2 * x + 1], row1[2 * x], row1[2 * x + 1]};
+
+      uint32_t result = 0;
+      // the channel order doesn't matter, as long as the alpha channel is the last one
+      for(uint32_t channel = 0; channel < 3; ++channel)
+      {
+        float sum = 0;
+        for(const auto px : quad)
+          sum += srgbToLinear[(px >> (channel * 8u)) & 0xffu];
+        result |= linearToSrgb(sum / 4) << (channel * 8u);
+      }
+
+      uint32_t alphaSum = 0;
+      for(const auto px : quad)
+        alphaSum += px >> 24u;
+      result |= ((alphaSum + 2) / 4) << 24u;
+
+      dstRow[x] = result;
+    }
+  }
+
+  return dst;
+}
 
-  BOOST_LOG_TRIVIAL(debug) << "init data provider";
-  DataProvider dp{wrapper};
-  const auto num = dp.numberOfParts();
+std::shared_ptr<BlockData> compressEtc2(gl::CImgWrapper& wrapper, const std::filesystem::path& output)
+{
+  wrapper.interleave();
 
-  BOOST_LOG_TRIVIAL(debug) << "parts: " << num;
+  const glm::ivec2 size{wrapper.width(), wrapper.height()};
+  const auto levels = getEtc2Levels(std::min(size.x, size.y));
+  BOOST_LOG_TRIVIAL(debug) << "create block data with " << levels << " levels";
+  auto bd = std::make_shared<BlockData>(output.string().c_str(), size, levels);
 
-  BOOST_LOG_TRIVIAL(debug) << "create block data";
-  BlockData bd{output.string().c_str(), dp.size()};
+  auto bmp = std::make_shared<Bitmap>(
+    size,
+    gsl_lite::span{reinterpret_cast<const uint32_t*>(wrapper.pixels().data()), wrapper.pixels().size()});
 
   std::vector<std::future<void>> futures;
-  futures.reserve(num);
-  for(uint32_t i = 0; i < num; i++)
+  for(int level = 0; level < levels; ++level)
   {
-    futures.emplace_back(std::async(std::launch::async,
-                                    [part = dp.nextPart(), &bd]
-                                    {
-                                      bd.processRgba(
-                                        part.src, part.width / 4 * part.lines, part.offset, part.width, true);
-                                    }));
+    DataProvider dp{bmp};
+    const auto num = dp.numberOfParts();
+    BOOST_LOG_TRIVIAL(debug) << "level " << level << " parts: " << num;
+
+    for(uint32_t i = 0; i < num; i++)
+    {
+      futures.emplace_back(std::async(std::launch::async,
+                                      [part = dp.nextPart(), bmp, &blockData = *bd, level]
+                                      {
+                                        blockData.processRgba(part.src,
+                                                              part.width / 4 * part.lines,
+                                                              part.offset,
+                                                              part.width,
+                                                              true,
+                                                              level);
+                                      }));
+    }
+
+    // the compression only reads the current level, so the next one can be built in the meantime
+    if(level + 1 < levels)
+      bmp = downsample(*bmp);
   }
   for(const auto& f : futures)
   {
     f.wait();
   }
+
+  return bd;
+}
+
+void uploadCompressed(gl::Texture2DArray<gl::PremultipliedSRGBA8>& texture, const BlockData& data, const int z)
+{
+  for(int level = 0; level < data.getLevels(); ++level)
+  {
+    texture.assignCompressed(data.getLevelData(level), gl::api::InternalFormat::CompressedSrgb8Alpha8Etc2Eac, z, level);
+  }
 }
 } // namespace
 
-std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
-  buildTextures(const loader::file::level::Level& level,
-                const std::unique_ptr<loader::trx::Glidos>& glidos,
-                render::MultiTextureAtlas& atlases,
-                std::vector<AtlasTile>& atlasTiles,
-                std::vector<Sprite>& sprites,
-                const std::function<void(const std::string&)>& drawLoadingScreen,
-                const std::filesystem::path& cacheDir)
+void buildAtlases(const loader::file::level::Level& level,
+                  const std::unique_ptr<loader::trx::Glidos>& glidos,
+                  render::MultiTextureAtlas& atlases,
+                  std::vector<AtlasTile>& atlasTiles,
+                  std::vector<Sprite>& sprites,
+                  const std::function<void(const std::string&)>& drawLoadingScreen,
+                  const std::filesystem::path& cacheDir)
 {
   drawLoadingScreen(_("Building atlases"));
 
@@ -727,43 +835,65 @@ std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
   }
 
   materializeAtlases(level, atlases, atlasTiles, sprites, doneTiles, doneSprites, drawLoadingScreen);
+}
 
-  const int textureLevels = static_cast<int>(std::log2(atlases.getSize())) + 1;
-  auto allTextures = std::make_unique<gl::Texture2DArray<gl::PremultipliedSRGBA8>>(
-    glm::ivec3{atlases.getSize(), atlases.getSize(), gsl_lite::narrow<int>(atlases.numAtlases())},
-    "all-textures",
-    textureLevels);
+std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
+  buildTextures(const loader::file::level::Level& level,
+                const std::unique_ptr<loader::trx::Glidos>& glidos,
+                render::MultiTextureAtlas& atlases,
+                std::vector<AtlasTile>& atlasTiles,
+                std::vector<Sprite>& sprites,
+                const std::function<void(const std::string&)>& drawLoadingScreen,
+                const std::filesystem::path& cacheDir)
+{
+  buildAtlases(level, glidos, atlases, atlasTiles, sprites, drawLoadingScreen, cacheDir);
+
+  const glm::ivec3 textureSize{atlases.getSize(), atlases.getSize(), gsl_lite::narrow<int>(atlases.numAtlases())};
+  const auto etc2Levels = getEtc2Levels(atlases.getSize());
+  // the cached mip chain is uploaded as-is if the driver keeps it compressed, saving the decoding and 3/4 of the
+  // video memory
+  const bool compressed = gl::hasNativeEtc2Support();
+  auto allTextures = compressed ? std::make_unique<gl::Texture2DArray<gl::PremultipliedSRGBA8>>(
+                                    textureSize,
+                                    "all-textures",
+                                    etc2Levels,
+                                    gl::api::SizedInternalFormat::CompressedSrgb8Alpha8Etc2Eac)
+                                : std::make_unique<gl::Texture2DArray<gl::PremultipliedSRGBA8>>(
+                                    textureSize, "all-textures", static_cast<int>(std::log2(atlases.getSize())) + 1);
 
   if(atlases.isOnlyLayout())
   {
-    std::vector<std::future<std::shared_ptr<Bitmap>>> loaders;
+    std::vector<std::future<std::shared_ptr<BlockData>>> loaders;
 
     for(size_t i = 0; i < atlases.numAtlases(); ++i)
     {
       loaders.emplace_back(std::async(std::launch::async,
-                                      [i, &cacheDir, &atlases]
+                                      [i, &cacheDir, &atlases, etc2Levels]
                                       {
                                         const auto cacheFile = cacheDir / (std::to_string(i) + ".pvr");
                                         BOOST_LOG_TRIVIAL(info) << "Loading cache texture " << cacheFile;
-                                        const auto data = std::make_shared<BlockData>(cacheFile.string().c_str());
-                                        auto bmp = data->decode();
+                                        auto data = std::make_shared<BlockData>(cacheFile.string().c_str());
 
-                                        gsl_Assert(bmp->size().x == atlases.getSize());
-                                        gsl_Assert(bmp->size().y == atlases.getSize());
+                                        gsl_Assert(data->getLevelSize(0).x == atlases.getSize());
+                                        gsl_Assert(data->getLevelSize(0).y == atlases.getSize());
+                                        gsl_Assert(data->getLevels() == etc2Levels);
 
-                                        return bmp;
+                                        return data;
                                       }));
     }
 
-    std::vector<std::shared_ptr<gl::CImgWrapper>> images;
     for(size_t i = 0; i < atlases.numAtlases(); ++i)
     {
       drawLoadingScreen(_("Building atlases (%1%%%)", 75 + i * 25 / atlases.numAtlases()));
 
-      const auto bmp = loaders[i].get();
-      images.emplace_back(std::make_shared<gl::CImgWrapper>(
-        reinterpret_cast<uint8_t*>(bmp->data()), bmp->size().x, bmp->size().y, false));
+      const auto data = loaders[i].get();
+      if(compressed)
+      {
+        uploadCompressed(*allTextures, *data, gsl_lite::narrow_cast<int>(i));
+        continue;
+      }
 
+      const auto bmp = data->decode();
       allTextures->assign(
         gsl_lite::span{reinterpret_cast<gl::PremultipliedSRGBA8*>(bmp->data()),
                        gsl_lite::narrow_cast<size_t>(bmp->size().x) * gsl_lite::narrow_cast<size_t>(bmp->size().y)},
@@ -780,13 +910,18 @@ std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
 
       const auto cacheFile = cacheDir / (std::to_string(i) + ".pvr");
       BOOST_LOG_TRIVIAL(info) << "Saving cache texture " << cacheFile;
-      compressEtc2(*images[i], cacheFile);
+      const auto data = compressEtc2(*images[i], cacheFile);
 
-      allTextures->assign(images[i]->asPremultipliedPixels(), gsl_lite::narrow_cast<int>(i));
+      // upload the same data as when loading from the cache, so the results don't depend on whether it existed
+      if(compressed)
+        uploadCompressed(*allTextures, *data, gsl_lite::narrow_cast<int>(i));
+      else
+        allTextures->assign(images[i]->asPremultipliedPixels(), gsl_lite::narrow_cast<int>(i));
     }
   }
 
-  allTextures->generateMipmaps();
+  if(!compressed)
+    allTextures->generateMipmaps();
 
   return allTextures;
 }
@@ -28,6 +28,18 @@ namespace engine::world
 struct AtlasTile;
 struct Sprite;
 
+/**
+ * @brief Places all tiles and sprites of @a level, or their replacements from @a glidos, in @a atlases, and remaps
+ * @a atlasTiles and @a sprites to their new positions; this is the part of buildTextures() drawing 0..75% progress.
+ */
+extern void buildAtlases(const loader::file::level::Level& level,
+                         const std::unique_ptr<loader::trx::Glidos>& glidos,
+                         render::MultiTextureAtlas& atlases,
+                         std::vector<AtlasTile>& atlasTiles,
+                         std::vector<Sprite>& sprites,
+                         const std::function<void(const std::string&)>& drawLoadingScreen,
+                         const std::filesystem::path& cacheDir);
+
 extern std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
   buildTextures(const loader::file::level::Level& level,
                 const std::unique_ptr<loader::trx::Glidos>& glidos,
@@ -44,6 +56,6 @@ inline std::filesystem::path getTextureSizesYamlPath(const std::filesystem::path
 
 inline std::filesystem::path getTextureCacheVersionFilePath(const std::filesystem::path& cacheDir)
 {
-  return cacheDir / "_cache_v3.txt";
+  return cacheDir / "_cache_v4.txt";
 }
 } // namespace engine::world
@@ -38,6 +38,8 @@
 #include "engine/particlecollection.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
+#include "engine/savegameindex.h"
+#include "engine/savegamewriter.h"
 #include "engine/script/scriptengine.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
@@ -48,6 +50,7 @@
 #include "loader/file/larastateid.h"
 #include "loader/file/level/level.h"
 #include "loader/file/meshes.h"
+#include "potentiallyvisibleset.h"
 #include "qs/qs.h"
 #include "render/material/materialmanager.h"
 #include "render/rendersettings.h"
@@ -57,6 +60,7 @@
 #include "room.h"
 #include "sector.h"
 #include "serialization/array.h"
+#include "serialization/binarydocument.h"
 #include "serialization/bitset.h"
 #include "serialization/objectreference.h"
 #include "serialization/optional.h"
@@ -72,6 +76,7 @@
 #include "ui/ui.h"
 #include "util/fsutil.h"
 #include "util/helpers.h"
+#include "util/profiler.h"
 #include "worldgeometry.h"
 
 #include <algorithm>
@@ -95,6 +100,7 @@
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -248,11 +254,7 @@ void emitGroundBubbles(const gsl_lite::not_null<Room*>& room, World& world)
         const auto pz = room->position.Z + z * core::SectorSize + util::rand15(core::SectorSize);
         const auto py = s->floorHeight;
 
-        auto particle
-          = gsl_lite::make_shared<BubbleParticle>(Location{room, core::TRVec{px, py, pz}}, world, true, true);
-        particle->scale = 0.5f;
-        particle->circleRadius = 1_len;
-        room->particles.registerParticle(std::move(particle));
+        room->particles.emitBubble(*room, core::TRVec{px, py, pz}, true, 0.5f, 1_len);
       }
     }
   }
@@ -290,6 +292,11 @@ const std::vector<Box>& World::getBoxes() const noexcept
   return m_boxes;
 }
 
+const BoxGraph& World::getBoxGraph() const noexcept
+{
+  return m_boxGraph;
+}
+
 void World::useAlternativeLaraAppearance(const bool withHead)
 {
   const auto& base = *m_worldGeometry->findAnimatedModelForType(TR1ItemId::Lara);
@@ -659,10 +666,7 @@ void World::updateLogicWorldState(const bool godMode)
   m_uvAnimTime += 1_frame;
   if(m_uvAnimTime >= UVAnimTime)
   {
-    for(const auto& room : m_rooms)
-    {
-      room.roomGeometry->animateUv(m_worldGeometry->getAtlasTiles());
-    }
+    m_worldGeometry->getTextureAnimator()->step();
     m_uvAnimTime -= UVAnimTime;
   }
 
@@ -966,22 +970,14 @@ void World::deserialize(const serialization::Deserializer<World>& ser)
 
 void World::updateGameLogic(const bool godMode)
 {
+  UTIL_PROFILE_ZONE("World::updateGameLogic");
   updateLogicWorldState(godMode);
   m_player->laraHealth = m_objectManager.getLara().m_state.health;
 
   for(const auto& room : m_rooms)
   {
-    std::vector<std::shared_ptr<Particle>> particlesToErase;
-    for(const auto& particle : room.particles)
-    {
-      if(const auto parent = particle->location.room; parent != &room)
-      {
-        particlesToErase.emplace_back(particle);
-        particle->location.room->particles.registerParticle(particle);
-      }
-    }
-    for(const auto& particle : particlesToErase)
-      room.particles.eraseParticle(particle);
+    room.particles.transferToCurrentRooms(room);
+    room.spriteParticles.transferToCurrentRooms(room);
   }
 
   doGlobalEffect();
@@ -1027,24 +1023,31 @@ void World::renderCinematic() const
 void World::load(const std::optional<size_t>& slot)
 {
   m_engine->getPresenter().drawLoadingScreen(_("Loading..."));
+  m_engine->getSavegameWriter().wait();
   const auto filename = m_engine->getSavegamePath(slot);
   BOOST_LOG_TRIVIAL(info) << "Load " << filename;
-  serialization::YAMLDocument<true> doc{filename};
-  SavegameMeta meta{};
-  doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
-  if(!util::preferredEqual(meta.filename, std::filesystem::relative(m_levelFilename, m_engine->getAssetDataPath())))
-  {
-    BOOST_LOG_TRIVIAL(error) << "Savegame mismatch. File is for " << meta.filename << ", but current level is "
-                             << m_levelFilename;
-    return;
-  }
-  doc.deserialize("data", gsl_lite::not_null{this}, *this);
+  const bool loaded = serialization::withLoadingDocument(
+    filename,
+    [this](auto& doc)
+    {
+      SavegameMeta meta{};
+      doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
+      if(!util::preferredEqual(meta.filename,
+                               std::filesystem::relative(m_levelFilename, m_engine->getAssetDataPath())))
+      {
+        BOOST_LOG_TRIVIAL(error) << "Savegame mismatch. File is for " << meta.filename << ", but current level is "
+                                 << m_levelFilename;
+        return false;
+      }
+      doc.deserialize("data", gsl_lite::not_null{this}, *this);
 
-  {
-    GameplayRules rules{};
-    doc.deserialize("gameplayRules", gsl_lite::not_null{this}, rules);
-    m_engine->setGameplayRules(rules);
-  }
+      GameplayRules rules{};
+      doc.deserialize("gameplayRules", gsl_lite::not_null{this}, rules);
+      m_engine->setGameplayRules(rules);
+      return true;
+    });
+  if(!loaded)
+    return;
 
   m_objectManager.getLara().m_state.health = m_player->laraHealth;
   m_objectManager.getLara().initWeaponAnimData();
@@ -1073,59 +1076,67 @@ void World::save(const std::filesystem::path& filename)
 
 void World::save(const std::optional<size_t>& slot)
 {
-  const auto filename = m_engine->getSavegamePath(slot);
-  save(filename);
-  m_engine->getPresenter().disableScreenOverlay();
-}
+  UTIL_PROFILE_ZONE("savegame snapshot");
+  const auto snapshotStart = std::chrono::steady_clock::now();
 
-std::tuple<std::optional<SavegameInfo>, std::map<size_t, SavegameInfo>> World::getSavedGames() const
-{
-  auto getSavegameInfo = [](const std::filesystem::path& path) -> std::optional<SavegameInfo>
+  const auto filename = m_engine->getSavegamePath(slot);
+  BOOST_LOG_TRIVIAL(info) << "Save " << filename;
+  SavegameMeta meta{std::filesystem::relative(m_levelFilename, m_engine->getAssetDataPath()).string()};
+  const auto snapshot = [this, &meta](auto& doc)
   {
-    if(!std::filesystem::is_regular_file(path))
-      return std::nullopt;
-
-    auto metaPath = makeMetaFilepath(path);
-    if(std::filesystem::is_regular_file(metaPath))
-    {
-      serialization::YAMLDocument<true> metaCacheDoc{metaPath};
-      SavegameMeta meta{};
-      metaCacheDoc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
-      return SavegameInfo{std::move(meta), std::filesystem::last_write_time(path)};
-    }
-
-    serialization::YAMLDocument<true> doc{path};
-    SavegameMeta meta{};
-    doc.deserialize("meta", gsl_lite::not_null{&meta}, meta);
-    serialization::YAMLDocument<false> newMetaCacheDoc{metaPath};
-    newMetaCacheDoc.serialize("meta", gsl_lite::not_null{&meta}, meta);
-    newMetaCacheDoc.write();
-    return SavegameInfo{std::move(meta), std::filesystem::last_write_time(path)};
+    doc.serialize("meta", gsl_lite::not_null{&meta}, meta);
+    doc.serialize("data", gsl_lite::not_null{this}, *this);
+    doc.serialize("gameplayRules", gsl_lite::not_null{this}, m_engine->getGameplayRules());
   };
 
-  std::map<size_t, SavegameInfo> result;
-  for(size_t i = 0; i < core::SavegameSlots; ++i)
+  // only building the document touches the world; encoding and writing it is left to the savegame writer
+  std::function<std::string()> encodeSavegame;
+  if(m_engine->getEngineConfig()->yamlSavegames)
   {
-    const auto path = m_engine->getSavegamePath(i);
-    if(auto info = getSavegameInfo(path); info.has_value())
-      result.emplace(i, *info);
+    auto doc = std::make_shared<serialization::YAMLDocument<false>>();
+    snapshot(*doc);
+    encodeSavegame = [doc]()
+    {
+      return doc->encode();
+    };
+  }
+  else
+  {
+    auto doc = std::make_shared<serialization::BinaryDocument<false>>();
+    snapshot(*doc);
+    encodeSavegame = [doc]()
+    {
+      return doc->encode();
+    };
   }
-  return {getSavegameInfo(m_engine->getSavegamePath(std::nullopt)), result};
+
+  serialization::YAMLDocument<false> metaCacheDoc{};
+  metaCacheDoc.serialize("meta", gsl_lite::not_null{&meta}, meta);
+
+  auto& savegameIndex = m_engine->getSavegameIndex();
+  savegameIndex.onSaving(slot, meta);
+  m_engine->getSavegameWriter().enqueue(filename,
+                                        std::move(encodeSavegame),
+                                        makeMetaFilepath(filename),
+                                        metaCacheDoc.encode(),
+                                        std::chrono::steady_clock::now() - snapshotStart,
+                                        [&savegameIndex, slot]()
+                                        {
+                                          savegameIndex.onWritten(slot);
+                                        });
+
+  m_engine->onGameSavedOrLoaded();
+  m_engine->getPresenter().disableScreenOverlay();
 }
 
-bool World::hasSavedGames() const
+std::tuple<std::optional<SavegameInfo>, std::map<size_t, SavegameInfo>> World::getSavedGames() const
 {
-  if(std::filesystem::is_regular_file(m_engine->getSavegamePath(std::nullopt)))
-    return true;
-
-  for(size_t i = 0; i < core::SavegameSlots; ++i)
-  {
-    if(const auto path = m_engine->getSavegamePath(i); !std::filesystem::is_regular_file(path))
-      continue;
+  return m_engine->getSavegameIndex().getSavegames();
+}
 
-    return true;
-  }
-  return false;
+bool World::hasSavedGames() const
+{
+  return !m_engine->getSavegameIndex().empty();
 }
 
 World::World(const gsl_lite::not_null<Engine*>& engine,
@@ -1279,6 +1290,7 @@ void World::initFromLevel(loader::file::level::Level& level, const bool fromSave
 
   initBoxes(level);
   initRooms(level);
+  initPotentiallyVisibleSet();
   initCinematicFrames(level);
   initCameras(level);
 
@@ -1411,17 +1423,31 @@ void World::initRooms(const loader::file::level::Level& level)
         BOOST_LOG_TRIVIAL(warning) << "No static mesh found for id " << rsm.meshId.get();
       }
     }
+    m_rooms[i].staticMeshCollisionBoxes = StaticMeshCollisionBoxes{m_rooms[i].staticMeshes};
     m_rooms[i].alternateRoom = srcRoom.alternateRoom.get() >= 0 ? &m_rooms.at(srcRoom.alternateRoom.get()) : nullptr;
 
     m_rooms[i].createSceneNode(level.m_rooms.at(i),
                                *this,
-                               level.m_animatedTextures,
                                m_engine->getPresenter().getRenderSystem().getMaterialManager());
     setParent(gsl_lite::not_null{m_rooms[i].node},
               m_engine->getPresenter().getRenderSystem().getSceneGraph().getRootNode());
   }
 }
 
+void World::initPotentiallyVisibleSet()
+{
+  const auto cachePath = getPotentiallyVisibleSetCachePath(m_worldGeometry->getCacheDir());
+  const auto cacheKey = PotentiallyVisibleSet::getCacheKey(m_rooms);
+  if(auto cached = PotentiallyVisibleSet::load(cachePath, cacheKey, m_rooms); cached.has_value())
+  {
+    m_potentiallyVisibleSet = std::move(*cached);
+    return;
+  }
+
+  m_potentiallyVisibleSet = PotentiallyVisibleSet{m_rooms};
+  m_potentiallyVisibleSet.write(cachePath, cacheKey);
+}
+
 void World::initBoxes(const loader::file::level::Level& level)
 {
   m_boxes.resize(level.m_boxes.size());
@@ -1473,6 +1499,8 @@ void World::initBoxes(const loader::file::level::Level& level)
     m_boxes[i].zoneGround1Swapped = level.m_alternateZones.groundZone1[i];
     m_boxes[i].zoneGround2Swapped = level.m_alternateZones.groundZone2[i];
   }
+
+  m_boxGraph = BoxGraph{m_boxes};
 }
 
 void World::connectSectors()
@@ -1483,6 +1511,10 @@ void World::connectSectors()
     for(auto& sector : room.sectors)
       sector.connect(m_rooms);
   }
+
+  // resolving follows the connections between the rooms, so all of them must be connected first
+  for(auto& room : m_rooms)
+    room.resolveSectorHeights();
 }
 
 void World::updateStaticSoundEffects()
@@ -2,6 +2,7 @@
 
 #include "audio/emitter.h"
 #include "box.h"
+#include "boxgraph.h"
 #include "camerasink.h"
 #include "cinematicframe.h"
 #include "core/id.h"
@@ -13,6 +14,7 @@
 #include "engine/objectmanager.h"
 #include "engine/objects/object.h"
 #include "loader/file/item.h"
+#include "potentiallyvisibleset.h"
 #include "qs/qs.h"
 #include "room.h"
 #include "serialization/serialization_fwd.h"
@@ -188,6 +190,13 @@ public:
   void swapAllRooms();
   void swapWithAlternate(Room& orig, Room& alternate);
   [[nodiscard]] const std::vector<Box>& getBoxes() const noexcept;
+  [[nodiscard]] const BoxGraph& getBoxGraph() const noexcept;
+
+  [[nodiscard]] const PotentiallyVisibleSet& getPotentiallyVisibleSet() const noexcept
+  {
+    return m_potentiallyVisibleSet;
+  }
+
   [[nodiscard]] const std::vector<Room>& getRooms() const noexcept;
   std::vector<Room>& getRooms() noexcept;
   [[nodiscard]] const std::vector<CinematicFrame>& getCinematicFrames() const noexcept;
@@ -401,7 +410,9 @@ private:
   gslu::nn_shared<WorldGeometry> m_worldGeometry;
 
   std::vector<Box> m_boxes;
+  BoxGraph m_boxGraph;
   std::vector<Room> m_rooms;
+  PotentiallyVisibleSet m_potentiallyVisibleSet;
   std::vector<CinematicFrame> m_cinematicFrames;
   std::vector<CameraSink> m_cameraSinks;
   std::vector<StaticSoundEffect> m_staticSoundEffects;
@@ -418,6 +429,7 @@ private:
 
   void initBoxes(const loader::file::level::Level& level);
   void initRooms(const loader::file::level::Level& level);
+  void initPotentiallyVisibleSet();
   void initCinematicFrames(const loader::file::level::Level& level);
   void initCameras(const loader::file::level::Level& level);
   void countSecrets();
@@ -19,6 +19,7 @@
 #include "loader/file/texture.h"
 #include "loader/trx/trx.h"
 #include "mesh.h"
+#include "meshcache.h"
 #include "paths.h"
 #include "qs/quantity.h"
 #include "render/material/materialmanager.h"
@@ -27,6 +28,7 @@
 #include "render/rendersettings.h"
 #include "render/scene/mesh.h"
 #include "render/scene/sprite.h"
+#include "render/textureanimator.h"
 #include "render/textureatlas.h"
 #include "rendermeshdata.h"
 #include "skeletalmodeltype.h"
@@ -123,8 +125,21 @@ core::TypeId WorldGeometry::find(const Sprite* sprite) const
   BOOST_THROW_EXCEPTION(std::runtime_error("Cannot find sprite"));
 }
 
-void WorldGeometry::initMeshes(const loader::file::level::Level& level)
+void WorldGeometry::initMeshes(const loader::file::level::Level& level, const std::filesystem::path& cacheDir)
 {
+  const auto cachePath = getMeshCachePath(cacheDir);
+  const auto cacheKey = getMeshCacheKey(level.getFilename(), m_atlasTiles, m_palette);
+  if(auto cached = loadMeshCache(cachePath, cacheKey, level.m_meshes.size()); cached.has_value())
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Using cached mesh data from " << cachePath;
+    for(size_t i = 0; i < level.m_meshes.size(); ++i)
+    {
+      const auto& mesh = level.m_meshes[i];
+      m_meshes.emplace_back(Mesh{mesh.collision_center, mesh.collision_radius, std::move(cached->at(i))});
+    }
+    return;
+  }
+
   std::ranges::transform(level.m_meshes,
                          std::back_inserter(m_meshes),
                          [this](const loader::file::Mesh& mesh)
@@ -133,6 +148,7 @@ void WorldGeometry::initMeshes(const loader::file::level::Level& level)
                                        mesh.collision_radius,
                                        gsl_lite::make_shared<RenderMeshData>(mesh, m_atlasTiles, m_palette)};
                          });
+  writeMeshCache(cachePath, cacheKey, m_meshes);
 }
 
 void WorldGeometry::initTextureDependentDataFromLevel(const loader::file::level::Level& level)
@@ -362,7 +378,7 @@ void WorldGeometry::initAnimationData(const loader::file::level::Level& level)
   gsl_Ensures(m_transitions.size() == level.m_transitions.size());
 }
 
-void WorldGeometry::initTextures(Engine& engine, const loader::file::level::Level& level)
+std::filesystem::path WorldGeometry::initTextures(Engine& engine, const loader::file::level::Level& level)
 {
   const auto userDataDir = findUserDataDir().value();
   std::string texturePackId;
@@ -436,6 +452,8 @@ void WorldGeometry::initTextures(Engine& engine, const loader::file::level::Leve
 
   // NOLINTNEXTLINE(bugprone-unused-raii)
   std::ofstream{getTextureCacheVersionFilePath(cacheDir), std::ios::trunc};
+
+  return cacheDir;
 }
 
 void WorldGeometry::initSpriteMeshes(Engine& engine)
@@ -500,8 +518,9 @@ WorldGeometry::WorldGeometry(Engine& engine, const loader::file::level::Level& l
     , m_animCommands{level.m_animCommands}
 {
   initTextureDependentDataFromLevel(level);
-  initTextures(engine, level);
+  m_cacheDir = initTextures(engine, level);
   initSpriteMeshes(engine);
+  m_textureAnimator = std::make_shared<render::TextureAnimator>(level.m_animatedTextures, m_atlasTiles);
 
   std::ranges::transform(level.m_palette->colors,
                          m_palette.begin(),
@@ -511,7 +530,7 @@ WorldGeometry::WorldGeometry(Engine& engine, const loader::file::level::Level& l
                          });
 
   initAnimationData(level);
-  initMeshes(level);
+  initMeshes(level, m_cacheDir);
   const auto meshesDirect = initAnimatedModels(level);
   initStaticMeshes(level, meshesDirect, engine);
 }
@@ -14,6 +14,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h>
 #include <gsl-lite/gsl-lite.hpp>
@@ -47,12 +48,8 @@ class RenderMeshData;
 class RoomGeometry final
 {
 public:
-  explicit RoomGeometry(const gslu::nn_shared<render::scene::Mesh>& geometry,
-                        const gslu::nn_shared<render::TextureAnimator>& textureAnimator,
-                        const gslu::nn_shared<gl::VertexBuffer<render::AnimatedUV>>& uvBuffer)
+  explicit RoomGeometry(const gslu::nn_shared<render::scene::Mesh>& geometry)
       : m_geometry{geometry}
-      , m_textureAnimator{textureAnimator}
-      , m_uvBuffer{uvBuffer}
   {
   }
 
@@ -74,15 +71,8 @@ public:
     gsl_Assert(m_dustCache.try_emplace(i, mesh).second);
   }
 
-  void animateUv(const std::vector<AtlasTile>& atlasTiles)
-  {
-    m_textureAnimator->updateCoordinates(*m_uvBuffer, atlasTiles);
-  }
-
 private:
   gslu::nn_shared<render::scene::Mesh> m_geometry;
-  gslu::nn_shared<render::TextureAnimator> m_textureAnimator;
-  gslu::nn_shared<gl::VertexBuffer<render::AnimatedUV>> m_uvBuffer;
   std::map<uint8_t, gslu::nn_shared<render::scene::Mesh>> m_dustCache;
 };
 
@@ -146,6 +136,17 @@ public:
     return m_palette;
   }
 
+  //! @brief The directory holding the cached data derived from the level.
+  [[nodiscard]] const auto& getCacheDir() const noexcept
+  {
+    return m_cacheDir;
+  }
+
+  [[nodiscard]] gslu::nn_shared<render::TextureAnimator> getTextureAnimator() const
+  {
+    return gsl_lite::not_null{m_textureAnimator};
+  }
+
   [[nodiscard]] std::shared_ptr<RoomGeometry> tryGetRoomGeometry(const size_t roomId) const
   {
     if(const auto it = m_roomGeometries.find(roomId); it != m_roomGeometries.end())
@@ -161,15 +162,16 @@ public:
 
 private:
   void initAnimationData(const loader::file::level::Level& level);
-  void initMeshes(const loader::file::level::Level& level);
+  void initMeshes(const loader::file::level::Level& level, const std::filesystem::path& cacheDir);
   std::vector<gsl_lite::not_null<const Mesh*>> initAnimatedModels(const loader::file::level::Level& level);
   void initStaticMeshes(const loader::file::level::Level& level,
                         const std::vector<gsl_lite::not_null<const Mesh*>>& meshesDirect,
                         Engine& engine);
   void initTextureDependentDataFromLevel(const loader::file::level::Level& level);
-  void initTextures(Engine& engine, const loader::file::level::Level& level);
+  [[nodiscard]] std::filesystem::path initTextures(Engine& engine, const loader::file::level::Level& level);
   void initSpriteMeshes(Engine& engine);
 
+  std::filesystem::path m_cacheDir;
   std::array<gl::SRGBA8, 256> m_palette;
 
   std::unordered_map<core::StaticMeshId, StaticMesh> m_staticMeshes;
@@ -188,6 +190,7 @@ private:
 
   ControllerLayouts m_controllerLayouts;
   std::shared_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>> m_allTextures;
+  std::shared_ptr<render::TextureAnimator> m_textureAnimator;
 
   std::map<size_t, gslu::nn_shared<RoomGeometry>> m_roomGeometries;
 };
@@ -8,6 +8,7 @@
 
 #include <array>
 #include <boost/iostreams/device/mapped_file.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
@@ -35,7 +36,30 @@ namespace
 {
 constexpr std::array<uint8_t, 8> table59T58H{{3, 6, 11, 16, 23, 32, 41, 64}};
 
-boost::iostreams::mapped_file_sink openForWriting(const char* fn, const size_t len, const glm::ivec2& size)
+constexpr size_t HeaderSize = 52;
+// ETC2 RGBA encodes each block of 4x4 pixels in 16 bytes
+constexpr size_t BlockSize = 2 * sizeof(uint64_t);
+
+size_t getBlocksSize(const glm::ivec2& size)
+{
+  return gsl_lite::narrow_cast<size_t>((size.x / 4) * (size.y / 4)) * BlockSize;
+}
+
+size_t getMipChainSize(const glm::ivec2& size, const int levels)
+{
+  size_t result = 0;
+  for(int level = 0; level < levels; ++level)
+  {
+    const auto levelSize = size >> level;
+    gsl_Expects(levelSize.x > 0 && levelSize.y > 0);
+    gsl_Expects(levelSize.x % 4 == 0 && levelSize.y % 4 == 0);
+    result += getBlocksSize(levelSize);
+  }
+  return result;
+}
+
+boost::iostreams::mapped_file_sink
+  openForWriting(const char* fn, const size_t len, const glm::ivec2& size, const int levels)
 {
   {
     std::ofstream tmp{fn, std::ios::binary | std::ios::trunc};
@@ -60,7 +84,7 @@ boost::iostreams::mapped_file_sink openForWriting(const char* fn, const size_t l
   *dst++ = 1;          // depth
   *dst++ = 1;          // num surfs
   *dst++ = 1;          // num faces
-  *dst++ = 1;          // mipmap count
+  *dst++ = levels;     // mipmap count
   *dst++ = 0;          // metadata size
 
   return sink;
@@ -84,26 +108,30 @@ BlockData::BlockData(const char* fn)
   m_size.y = gsl_lite::narrow_cast<int32_t>(*(data32 + 6));
   m_size.x = gsl_lite::narrow_cast<int32_t>(*(data32 + 7));
   gsl_Assert(m_size.x > 0 && m_size.y > 0);
-  m_dataOffset = 52u + *(data32 + 12);
+  m_levels = gsl_lite::narrow_cast<int>(*(data32 + 11));
+  gsl_Assert(m_levels > 0);
+  m_dataOffset = HeaderSize + *(data32 + 12);
+  gsl_Assert(m_dataOffset + getMipChainSize(m_size, m_levels) <= m_maplen);
 }
 
-BlockData::BlockData(const char* fn, const glm::ivec2& size)
+BlockData::BlockData(const char* fn, const glm::ivec2& size, const int levels)
     : m_size(size)
-    , m_dataOffset(52)
-    , m_maplen(gsl_lite::narrow_cast<size_t>((m_size.x / 4) * (m_size.y / 4)) * sizeof(uint64_t) * 2u)
+    , m_levels{levels}
+    , m_dataOffset(HeaderSize)
+    , m_maplen(getMipChainSize(size, levels))
 {
-  gsl_Expects(m_size.x % 4 == 0 && m_size.y % 4 == 0);
+  gsl_Expects(levels > 0);
 
   m_maplen += m_dataOffset;
-  m_file = std::make_unique<boost::iostreams::mapped_file_sink>(openForWriting(fn, m_maplen, m_size));
+  m_file = std::make_unique<boost::iostreams::mapped_file_sink>(openForWriting(fn, m_maplen, m_size, m_levels));
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
   m_data = reinterpret_cast<uint8_t*>(m_file->data());
 }
 
 BlockData::BlockData(const glm::ivec2& size)
     : m_size(size)
-    , m_dataOffset(52)
-    , m_maplen{gsl_lite::narrow_cast<size_t>((m_size.x / 4) * (m_size.y / 4)) * sizeof(uint64_t) * 2u}
+    , m_dataOffset(HeaderSize)
+    , m_maplen{getBlocksSize(size)}
 {
   gsl_Assert(m_size.x > 0 && m_size.y > 0);
   gsl_Assert(m_size.x % 4 == 0 && m_size.y % 4 == 0);
@@ -118,12 +146,33 @@ BlockData::~BlockData()
     delete[] m_data;
 }
 
+glm::ivec2 BlockData::getLevelSize(const int level) const
+{
+  gsl_Expects(level >= 0 && level < m_levels);
+  return m_size >> level;
+}
+
+size_t BlockData::getLevelOffset(const int level) const
+{
+  gsl_Expects(level >= 0 && level < m_levels);
+  return m_dataOffset + getMipChainSize(m_size, level);
+}
+
+gsl_lite::span<const uint8_t> BlockData::getLevelData(const int level) const
+{
+  return gsl_lite::span<const uint8_t>{m_data + getLevelOffset(level), getBlocksSize(getLevelSize(level))};
+}
+
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-void BlockData::processRgba(
-  const uint32_t* src, const uint32_t blocks, const size_t offset, const size_t width, const bool useHeuristics)
+void BlockData::processRgba(const uint32_t* src,
+                            const uint32_t blocks,
+                            const size_t offset,
+                            const size_t width,
+                            const bool useHeuristics,
+                            const int level)
 {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  const auto dst = reinterpret_cast<uint64_t*>(m_data + m_dataOffset) + offset * 2u;
+  const auto dst = reinterpret_cast<uint64_t*>(m_data + getLevelOffset(level)) + offset * 2u;
 
   compressEtc2Bgra(src, dst, blocks, width, useHeuristics);
 }
@@ -502,26 +551,27 @@ void decodeRgbaPart(uint64_t d, uint64_t alpha, uint32_t* dst, const uint32_t w)
 }
 } // namespace
 
-std::shared_ptr<Bitmap> BlockData::decode()
+std::shared_ptr<Bitmap> BlockData::decode(const int level)
 {
   gsl_Assert(m_dataOffset < m_maplen);
 
-  auto ret = std::make_shared<Bitmap>(m_size);
+  const auto size = getLevelSize(level);
+  auto ret = std::make_shared<Bitmap>(size);
 
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  const auto* src = reinterpret_cast<const uint64_t*>(m_data + m_dataOffset);
+  const auto* src = reinterpret_cast<const uint64_t*>(m_data + getLevelOffset(level));
   uint32_t* dst = ret->data();
 
-  for(int y = 0; y < m_size.y / 4; y++)
+  for(int y = 0; y < size.y / 4; y++)
   {
-    for(int x = 0; x < m_size.x / 4; x++)
+    for(int x = 0; x < size.x / 4; x++)
     {
       const auto a = *src++;
       const auto d = *src++;
-      decodeRgbaPart(d, a, dst, m_size.x);
+      decodeRgbaPart(d, a, dst, size.x);
       dst += 4;
     }
-    dst += m_size.x * 3;
+    dst += size.x * 3;
   }
 
   return ret;
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <glm/vec2.hpp>
+#include <gsl-lite/gsl-lite.hpp>
 #include <memory>
 
 class Bitmap;
@@ -17,17 +18,30 @@ public:
   void operator=(BlockData&&) = delete;
 
   explicit BlockData(const char* fn);
-  BlockData(const char* fn, const glm::ivec2& size);
+  //! Creates a file holding @a levels mip levels; every level's size must be a multiple of 4.
+  BlockData(const char* fn, const glm::ivec2& size, int levels = 1);
   explicit BlockData(const glm::ivec2& size);
   ~BlockData();
 
-  std::shared_ptr<Bitmap> decode();
+  std::shared_ptr<Bitmap> decode(int level = 0);
 
-  void processRgba(const uint32_t* src, uint32_t blocks, size_t offset, size_t width, bool useHeuristics);
+  void processRgba(
+    const uint32_t* src, uint32_t blocks, size_t offset, size_t width, bool useHeuristics, int level = 0);
+
+  [[nodiscard]] int getLevels() const noexcept
+  {
+    return m_levels;
+  }
+
+  [[nodiscard]] glm::ivec2 getLevelSize(int level) const;
+  [[nodiscard]] gsl_lite::span<const uint8_t> getLevelData(int level) const;
 
 private:
+  [[nodiscard]] size_t getLevelOffset(int level) const;
+
   uint8_t* m_data;
   glm::ivec2 m_size{};
+  int m_levels = 1;
   size_t m_dataOffset = 0;
   size_t m_maplen;
   std::unique_ptr<boost::iostreams::mapped_file_sink> m_file{nullptr};
@@ -0,0 +1,320 @@
+#include "benchmark/benchmark.h"
+#include "core/units.h"
+#include "engine/engine.h"
+#include "engine/inputrecording.h"
+#include "engine/objectmanager.h"
+#include "engine/player.h"
+#include "engine/script/reflection.h"
+#include "engine/script/scriptengine.h"
+#include "engine/world/world.h"
+#include "paths.h"
+#include "serialization/binarydocument.h"
+#include "util/md5.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <boost/log/utility/setup/common_attributes.hpp>
+#include <boost/log/utility/setup/console.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <glm/vec2.hpp>
+#include <gsl-lite/gsl-lite.hpp>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+const auto logFormat = "[%TimeStamp% %Severity% %ThreadID%] %Message%";
+
+void useNullAudioBackend()
+{
+  // only OpenAL Soft's null backend is guaranteed to work on boxes without any audio hardware
+  if(getenv("ALSOFT_DRIVERS") != nullptr)
+    return;
+
+#ifdef WIN32
+  gsl_Assert(_putenv_s("ALSOFT_DRIVERS", "null") == 0);
+#else
+  gsl_Assert(setenv("ALSOFT_DRIVERS", "null", true) == 0);
+#endif
+}
+
+int usage(const char* self)
+{
+  std::cerr << "Usage: " << self << " <gameflow-id> <level-sequence-index> <frames> [<input-recording>]\n"
+            << "       " << self << " --verify <gameflow-id> <level-sequence-index> <input-recording>\n"
+            << "       " << self << " --benchmark <name> <gameflow-id> [<level-sequence-index>]\n"
+            << "\n"
+            << "Benchmarks, run on all levels of the level sequence unless an index is given:\n";
+  for(const auto& item : benchmark::getBenchmarks())
+    std::cerr << "  " << item.name << ": " << item.description << "\n";
+  std::cerr.flush();
+  return EXIT_FAILURE;
+}
+
+std::unique_ptr<engine::Engine> createEngine(const std::string& gameflowId)
+{
+  const auto userDataDir = findUserDataDir();
+  const auto engineDataDir = findEngineDataDir();
+  if(!userDataDir.has_value() || !engineDataDir.has_value())
+  {
+    BOOST_LOG_TRIVIAL(fatal) << "Could not determine the user or engine data dir";
+    return nullptr;
+  }
+
+  useNullAudioBackend();
+
+  return std::make_unique<engine::Engine>(
+    *userDataDir, *engineDataDir, std::nullopt, gameflowId, glm::ivec2{320, 200}, false, true);
+}
+
+std::shared_ptr<engine::script::Level> getLevel(const engine::Engine& engine, const size_t levelSequenceIndex)
+{
+  const auto& levelSequence = engine.getScriptEngine().getGameflow().getLevelSequence();
+  if(levelSequenceIndex >= levelSequence.size())
+  {
+    BOOST_LOG_TRIVIAL(fatal) << "Level sequence index " << levelSequenceIndex << " out of range, sequence has "
+                             << levelSequence.size() << " items";
+    return nullptr;
+  }
+
+  auto level = std::dynamic_pointer_cast<engine::script::Level>(levelSequence.at(levelSequenceIndex));
+  if(level == nullptr)
+    BOOST_LOG_TRIVIAL(fatal) << "Level sequence item " << levelSequenceIndex << " is not a level";
+  return level;
+}
+
+//! @brief Creates the player the same way as selecting the level from the title menu.
+std::shared_ptr<engine::Player> createPlayer(const engine::Engine& engine, const size_t levelSequenceIndex)
+{
+  const auto& levelSequence = engine.getScriptEngine().getGameflow().getLevelSequence();
+  auto player = std::make_shared<engine::Player>();
+  for(size_t i = 0; i < levelSequenceIndex; ++i)
+  {
+    if(const auto modInv = std::dynamic_pointer_cast<engine::script::ModifyInventory>(levelSequence.at(i));
+       modInv != nullptr)
+      modInv->apply(player);
+  }
+  return player;
+}
+
+std::unique_ptr<engine::InputRecordingReader> openInputRecording(const std::filesystem::path& path)
+{
+  auto inputReplay = std::make_unique<engine::InputRecordingReader>(path);
+  if(!inputReplay->isOpen())
+  {
+    BOOST_LOG_TRIVIAL(fatal) << "Could not open input recording " << path;
+    return nullptr;
+  }
+  return inputReplay;
+}
+
+//! @brief Replays @a inputRecording from the level start and returns the digest of the world state after each frame.
+std::vector<std::string> replayDigests(engine::Engine& engine,
+                                       const size_t levelSequenceIndex,
+                                       engine::script::Level& level,
+                                       const std::filesystem::path& inputRecording,
+                                       const bool parallelAiUpdates)
+{
+  const auto inputReplay = openInputRecording(inputRecording);
+  gsl_Assert(inputReplay != nullptr);
+
+  const auto world = level.loadForSimulation(gsl_lite::not_null{&engine}, createPlayer(engine, levelSequenceIndex));
+  world->getObjectManager().setParallelAiUpdates(parallelAiUpdates);
+
+  std::vector<std::string> digests;
+  const auto stats = engine.simulateLevel(*world,
+                                          core::Frame{std::numeric_limits<core::Frame::type>::max()},
+                                          inputReplay.get(),
+                                          [&world, &digests]()
+                                          {
+                                            serialization::BinaryDocument<false> doc;
+                                            doc.serialize("data", gsl_lite::not_null{world.get()}, *world);
+                                            const auto data = doc.encode();
+                                            digests.emplace_back(util::md5(data.data(), data.size()));
+                                          });
+  BOOST_LOG_TRIVIAL(info) << "Replayed " << stats.frames.get() << " frames with "
+                          << (parallelAiUpdates ? "parallel" : "serial") << " AI updates, level finished: "
+                          << stats.levelFinished << ", Lara dead: " << stats.laraDead;
+  return digests;
+}
+
+/**
+ * @brief Replays a recording with and without the parallel AI updates, and compares the world state after each frame.
+ *
+ * Besides verifying that the parallel AI updates don't change the outcome, this also verifies that replaying a
+ * recording is deterministic.
+ */
+int verifyReplay(engine::Engine& engine,
+                 const size_t levelSequenceIndex,
+                 engine::script::Level& level,
+                 const std::filesystem::path& inputRecording)
+{
+  const auto parallelDigests = replayDigests(engine, levelSequenceIndex, level, inputRecording, true);
+  const auto serialDigests = replayDigests(engine, levelSequenceIndex, level, inputRecording, false);
+
+  for(size_t i = 0; i < parallelDigests.size() && i < serialDigests.size(); ++i)
+  {
+    if(parallelDigests[i] != serialDigests[i])
+    {
+      BOOST_LOG_TRIVIAL(error) << "World states differ after frame " << i + 1;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if(parallelDigests.size() != serialDigests.size())
+  {
+    BOOST_LOG_TRIVIAL(error) << "Replays differ in length, " << parallelDigests.size() << " vs. "
+                             << serialDigests.size() << " frames";
+    return EXIT_FAILURE;
+  }
+
+  BOOST_LOG_TRIVIAL(info) << "World states of all " << parallelDigests.size() << " frames are equal";
+  return EXIT_SUCCESS;
+}
+
+int simulate(const char* self, const std::vector<std::string>& args)
+{
+  if(args.size() != 3 && args.size() != 4)
+    return usage(self);
+
+  size_t levelSequenceIndex;
+  core::Frame::type maxFrames;
+  try
+  {
+    levelSequenceIndex = std::stoul(args[1]);
+    maxFrames = gsl_lite::narrow<core::Frame::type>(std::stol(args[2]));
+  }
+  catch(const std::exception&)
+  {
+    return usage(self);
+  }
+
+  const auto engine = createEngine(args[0]);
+  if(engine == nullptr)
+    return EXIT_FAILURE;
+
+  const auto level = getLevel(*engine, levelSequenceIndex);
+  if(level == nullptr)
+    return EXIT_FAILURE;
+
+  std::unique_ptr<engine::InputRecordingReader> inputReplay;
+  if(args.size() == 4)
+  {
+    inputReplay = openInputRecording(args[3]);
+    if(inputReplay == nullptr)
+      return EXIT_FAILURE;
+  }
+
+  const auto stats = level->simulate(gsl_lite::not_null{engine.get()},
+                                     createPlayer(*engine, levelSequenceIndex),
+                                     core::Frame{maxFrames},
+                                     inputReplay.get());
+
+  const auto seconds = std::chrono::duration<double>(stats.duration).count();
+  BOOST_LOG_TRIVIAL(info) << "Simulated " << stats.frames.get() << " frames of " << level->getFilepath() << " in "
+                          << seconds << "s ("
+                          << (seconds > 0 ? static_cast<double>(stats.frames.get()) / seconds : 0.0)
+                          << " frames/s), level finished: " << stats.levelFinished
+                          << ", Lara dead: " << stats.laraDead;
+  return EXIT_SUCCESS;
+}
+
+int verify(const char* self, const std::vector<std::string>& args)
+{
+  if(args.size() != 3)
+    return usage(self);
+
+  size_t levelSequenceIndex;
+  try
+  {
+    levelSequenceIndex = std::stoul(args[1]);
+  }
+  catch(const std::exception&)
+  {
+    return usage(self);
+  }
+
+  const auto engine = createEngine(args[0]);
+  if(engine == nullptr)
+    return EXIT_FAILURE;
+
+  const auto level = getLevel(*engine, levelSequenceIndex);
+  if(level == nullptr || openInputRecording(args[2]) == nullptr)
+    return EXIT_FAILURE;
+
+  return verifyReplay(*engine, levelSequenceIndex, *level, args[2]);
+}
+
+int runBenchmark(const char* self, const std::vector<std::string>& args)
+{
+  if(args.size() != 2 && args.size() != 3)
+    return usage(self);
+
+  const auto benchmarks = benchmark::getBenchmarks();
+  const auto selected = std::ranges::find_if(benchmarks,
+                                             [&args](const benchmark::Benchmark& candidate)
+                                             {
+                                               return args[0] == candidate.name;
+                                             });
+  if(selected == benchmarks.end())
+    return usage(self);
+
+  std::optional<size_t> levelSequenceIndex;
+  try
+  {
+    if(args.size() == 3)
+      levelSequenceIndex = std::stoul(args[2]);
+  }
+  catch(const std::exception&)
+  {
+    return usage(self);
+  }
+
+  const auto engine = createEngine(args[1]);
+  if(engine == nullptr)
+    return EXIT_FAILURE;
+
+  if(levelSequenceIndex.has_value() && getLevel(*engine, *levelSequenceIndex) == nullptr)
+    return EXIT_FAILURE;
+
+  const auto& levelSequence = engine->getScriptEngine().getGameflow().getLevelSequence();
+  for(size_t i = 0; i < levelSequence.size(); ++i)
+  {
+    if(levelSequenceIndex.has_value() && i != *levelSequenceIndex)
+      continue;
+
+    const auto level = std::dynamic_pointer_cast<engine::script::Level>(levelSequence.at(i));
+    if(level == nullptr)
+      continue;
+
+    const auto world = level->loadForSimulation(gsl_lite::not_null{engine.get()}, createPlayer(*engine, i));
+    BOOST_LOG_TRIVIAL(info) << "Benchmark " << selected->name << " on " << level->getFilepath();
+    selected->run(*world);
+  }
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+// NOLINTNEXTLINE(bugprone-exception-escape)
+int main(const int argc, char** argv)
+{
+  boost::log::add_common_attributes();
+  boost::log::add_console_log(std::cout, boost::log::keywords::format = logFormat)
+    ->set_filter(boost::log::trivial::severity >= boost::log::trivial::info);
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  if(!args.empty() && args.front() == "--verify")
+    return verify(argv[0], {args.begin() + 1, args.end()});
+  if(!args.empty() && args.front() == "--benchmark")
+    return runBenchmark(argv[0], {args.begin() + 1, args.end()});
+  return simulate(argv[0], args);
+}
@@ -281,7 +281,17 @@ void InputHandler::update()
     }
   }
 
-  for(const auto& [action, state] : newActionStates)
+  applyActionStates(newActionStates);
+}
+
+void InputHandler::replay(const boost::container::flat_map<Action, bool>& actionStates)
+{
+  applyActionStates(actionStates);
+}
+
+void InputHandler::applyActionStates(const boost::container::flat_map<Action, bool>& actionStates)
+{
+  for(const auto& [action, state] : actionStates)
   {
     m_inputState.actions[action] = state;
   }
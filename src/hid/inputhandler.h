@@ -28,6 +28,10 @@ public:
   void setMappings(const std::vector<engine::NamedInputMappingConfig>& inputMappings);
 
   void update();
+  /**
+   * @brief Replaces the polled input with the given action states, e.g. when replaying a recorded session.
+   */
+  void replay(const boost::container::flat_map<Action, bool>& actionStates);
 
   [[nodiscard]] const InputState& getInputState() const
   {
@@ -75,5 +79,7 @@ private:
   std::vector<engine::NamedInputMappingConfig> m_inputMappings;
   engine::InputMappingConfig m_mergedGameInputMappings;
   engine::InputMappingConfig m_mergedMenuInputMappings;
+
+  void applyActionStates(const boost::container::flat_map<Action, bool>& actionStates);
 };
 } // namespace hid
@@ -355,6 +355,8 @@ std::string getName(const Action action)
     return /* translators: TR charmap encoding */ pgettext("Action", "Screenshot");
   case Action::BugReport:
     return /* translators: TR charmap encoding */ pgettext("Action", "Bug Report");
+  case Action::ProfilerTrace:
+    return /* translators: TR charmap encoding */ pgettext("Action", "Profiler Trace");
   case Action::MenuLeft:
     return /* translators: TR charmap encoding */ pgettext("MenuAction", "Left");
   case Action::MenuRight:
@@ -7,8 +7,7 @@
 #  pragma warning(disable : 4702)
 #endif
 
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 
 #ifdef _MSC_VER
@@ -19,11 +18,18 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
 #include <iosfwd>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <zconf.h>
@@ -39,6 +45,12 @@ namespace loader::file::io
 {
 using DataStreamBuf = boost::iostreams::filtering_istreambuf;
 
+/**
+ * @brief Reads little-endian level data.
+ *
+ * Files are memory-mapped and, like in-memory data, read directly from memory; only readers constructed from a
+ * stream buffer go through the stream.
+ */
 class SDLReader
 {
 public:
@@ -56,26 +68,49 @@ public:
 
   SDLReader(SDLReader&& rhs) noexcept
       : m_memory{std::move(rhs.m_memory)}
-      , m_file{std::move(rhs.m_file)}
-      , m_array{std::move(rhs.m_array)}
+      , m_mapping{std::move(rhs.m_mapping)}
+      , m_data{rhs.m_data}
+      , m_position{rhs.m_position}
+      , m_isOpen{rhs.m_isOpen}
       , m_streamBuf{std::move(rhs.m_streamBuf)}
       , m_stream{m_streamBuf.get()}
   {
   }
 
   explicit SDLReader(const std::filesystem::path& filename)
-      : m_file{std::make_unique<boost::iostreams::file>(
-          filename.string(), std::ios::in | std::ios::binary, std::ios::in | std::ios::binary)}
-      , m_streamBuf{std::make_shared<DataStreamBuf>(*m_file)}
-      , m_stream{m_streamBuf.get()}
+      : m_stream{nullptr}
   {
+    if(!std::filesystem::is_regular_file(filename))
+      return;
+
+    if(std::filesystem::file_size(filename) == 0)
+    {
+      m_isOpen = true;
+      return;
+    }
+
+    try
+    {
+      m_mapping = std::make_unique<boost::iostreams::mapped_file_source>(filename);
+      m_data = std::span{m_mapping->data(), m_mapping->size()};
+      m_isOpen = true;
+    }
+    catch(const std::ios_base::failure&)
+    {
+      // some file systems can't be mapped, fall back to reading the whole file
+      m_mapping.reset();
+      std::ifstream file{filename, std::ios::in | std::ios::binary};
+      m_memory.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+      m_data = std::span{m_memory};
+      m_isOpen = !file.bad();
+    }
   }
 
   explicit SDLReader(std::vector<char> data)
       : m_memory{std::move(data)}
-      , m_array{std::make_unique<boost::iostreams::array>(m_memory.data(), m_memory.size())}
-      , m_streamBuf{std::make_shared<DataStreamBuf>(*m_array)}
-      , m_stream{m_streamBuf.get()}
+      , m_data{m_memory}
+      , m_isOpen{true}
+      , m_stream{nullptr}
   {
   }
 
@@ -106,16 +141,25 @@ public:
 
   [[nodiscard]] bool isOpen() const
   {
+    if(!isStream())
+      return m_isOpen;
+
     return !m_stream.bad();
   }
 
   [[nodiscard]] std::streampos tell() const
   {
+    if(!isStream())
+      return static_cast<std::streamoff>(m_position);
+
     return m_stream.tellg();
   }
 
   [[nodiscard]] std::streamsize size() const
   {
+    if(!isStream())
+      return gsl_lite::narrow<std::streamsize>(m_data.size());
+
     const auto pos = m_stream.tellg();
     m_stream.seekg(0, std::ios::end);
     const auto size = m_stream.tellg();
@@ -126,25 +170,54 @@ public:
   // ReSharper disable once CppMemberFunctionMayBeConst
   void skip(const std::streamoff delta)
   {
+    if(!isStream())
+    {
+      gsl_Expects(delta >= 0 || static_cast<size_t>(-delta) <= m_position);
+      m_position = static_cast<size_t>(static_cast<std::streamoff>(m_position) + delta);
+      return;
+    }
+
     m_stream.seekg(delta, std::ios::cur);
   }
 
   // ReSharper disable once CppMemberFunctionMayBeConst
   void seek(const std::streampos& position)
   {
+    if(!isStream())
+    {
+      gsl_Expects(position >= 0);
+      m_position = static_cast<size_t>(static_cast<std::streamoff>(position));
+      return;
+    }
+
     m_stream.seekg(position, std::ios::beg);
   }
 
+  /**
+   * @brief Whether view() is available, i.e. the data is read from memory instead of a stream.
+   */
+  [[nodiscard]] bool canView() const noexcept
+  {
+    return !isStream();
+  }
+
+  /**
+   * @brief An independent reader over the same data, starting at the current position.
+   *
+   * Views can be used concurrently with each other and with this reader. They don't own the data, so they must not
+   * outlive this reader.
+   */
+  [[nodiscard]] SDLReader view() const
+  {
+    gsl_Expects(canView());
+    return SDLReader{m_data, m_position, m_isOpen};
+  }
+
   template<std::integral T>
   void readBytes(T* dest, const size_t n)
   {
     static_assert(sizeof(T) == 1, "readBytes() only allowed for byte-compatible data");
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    m_stream.read(reinterpret_cast<char*>(dest), gsl_lite::narrow<std::streamsize>(n));
-    if(static_cast<size_t>(m_stream.gcount()) != n)
-    {
-      BOOST_THROW_EXCEPTION(std::runtime_error("EOF unexpectedly reached"));
-    }
+    readRaw(dest, n);
   }
 
   template<typename T, typename... Args>
@@ -192,10 +265,21 @@ public:
   void readVector(std::vector<T>& elements, size_t count)
   {
     elements.clear();
-    elements.reserve(count);
-    for(size_t i = 0; i < count; ++i)
+    if constexpr(BulkTraits<T>::value)
     {
-      elements.emplace_back(read<T>());
+      // plain numbers don't need to be read one by one
+      elements.resize(count, T{typename BulkTraits<T>::value_type{0}});
+      readRaw(elements.data(), count * sizeof(T));
+      for(auto& element : elements)
+        SwapTraits<T, sizeof(T), std::is_arithmetic_v<T>>::doSwap(element);
+    }
+    else
+    {
+      elements.reserve(count);
+      for(size_t i = 0; i < count; ++i)
+      {
+        elements.emplace_back(read<T>());
+      }
     }
   }
 
@@ -216,7 +300,7 @@ public:
   template<typename T>
   [[nodiscard]] T read()
   {
-    return ReadTraits<T>::read(m_stream);
+    return ReadTraits<T>::read(*this);
   }
 
   [[nodiscard]] uint8_t readU8()
@@ -258,14 +342,65 @@ private:
   // Do not change the order of these member variables.
   std::vector<char> m_memory;
 
-  std::unique_ptr<boost::iostreams::file> m_file;
+  std::unique_ptr<boost::iostreams::mapped_file_source> m_mapping;
 
-  std::unique_ptr<boost::iostreams::array> m_array;
+  //! @brief The mapped file or the in-memory data, if not reading from a stream.
+  std::span<const char> m_data;
+
+  size_t m_position = 0;
+
+  bool m_isOpen = false;
 
   std::shared_ptr<DataStreamBuf> m_streamBuf;
 
   mutable std::istream m_stream;
 
+  SDLReader(const std::span<const char>& data, const size_t position, const bool isOpen)
+      : m_data{data}
+      , m_position{position}
+      , m_isOpen{isOpen}
+      , m_stream{nullptr}
+  {
+  }
+
+  [[nodiscard]] bool isStream() const noexcept
+  {
+    return m_streamBuf != nullptr;
+  }
+
+  void readRaw(void* dest, const size_t n)
+  {
+    if(!isStream())
+    {
+      if(m_position > m_data.size() || m_data.size() - m_position < n)
+      {
+        BOOST_THROW_EXCEPTION(std::runtime_error("EOF unexpectedly reached"));
+      }
+
+      std::memcpy(dest, m_data.data() + m_position, n);
+      m_position += n;
+      return;
+    }
+
+    m_stream.read(static_cast<char*>(dest), gsl_lite::narrow<std::streamsize>(n));
+    if(static_cast<size_t>(m_stream.gcount()) != n)
+    {
+      BOOST_THROW_EXCEPTION(std::runtime_error("EOF unexpectedly reached"));
+    }
+  }
+
+  template<typename T>
+  struct BulkTraits : std::bool_constant<std::is_arithmetic_v<T>>
+  {
+    using value_type = T;
+  };
+
+  template<typename T>
+  struct BulkTraits<type_safe::integer<T>> : std::bool_constant<sizeof(type_safe::integer<T>) == sizeof(T)>
+  {
+    using value_type = T;
+  };
+
   template<typename, int, bool>
   struct SwapTraits
   {
@@ -305,15 +440,10 @@ private:
   template<typename T>
   struct ReadTraits
   {
-    [[nodiscard]] static T read(std::istream& stream)
+    [[nodiscard]] static T read(SDLReader& reader)
     {
       T result;
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      stream.read(reinterpret_cast<char*>(&result), sizeof(T));
-      if(stream.gcount() != sizeof(T))
-      {
-        BOOST_THROW_EXCEPTION(std::runtime_error("EOF unexpectedly reached"));
-      }
+      reader.readRaw(&result, sizeof(T));
 
       SwapTraits<T, sizeof(T), std::is_integral_v<T> || std::is_floating_point_v<T>>::doSwap(result);
 
@@ -324,9 +454,9 @@ private:
   template<typename T>
   struct ReadTraits<type_safe::integer<T>>
   {
-    [[nodiscard]] static type_safe::integer<T> read(std::istream& stream)
+    [[nodiscard]] static type_safe::integer<T> read(SDLReader& reader)
     {
-      return type_safe::integer<T>{ReadTraits<T>::read(stream)};
+      return type_safe::integer<T>{ReadTraits<T>::read(reader)};
     }
   };
 };
@@ -11,6 +11,7 @@
 #include "tr5level.h"
 #include "util/helpers.h"
 #include "util/md5.h"
+#include "util/threadpool.h"
 
 #include <algorithm>
 #include <array>
@@ -33,6 +34,25 @@ namespace loader::file::level
 {
 Level::~Level() = default;
 
+Level::CompressedChunk Level::readCompressedChunk(io::SDLReader& reader, const std::string& name, const bool load)
+{
+  CompressedChunk chunk;
+  chunk.uncompressedSize = reader.readU32();
+  if(chunk.uncompressedSize == 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error(name + " is empty"));
+
+  const auto compressedSize = reader.readU32();
+  if(!load)
+  {
+    reader.skip(compressedSize);
+    return chunk;
+  }
+
+  chunk.data.resize(compressedSize);
+  reader.readBytes(chunk.data.data(), compressedSize);
+  return chunk;
+}
+
 /// \brief reads the mesh data.
 void Level::readMeshData(io::SDLReader& reader)
 {
@@ -47,15 +67,32 @@ void Level::readMeshData(io::SDLReader& reader)
   std::set<uint32_t> uniqueOffsets{offsets.begin(), offsets.end()};
   const auto endPos = reader.tell();
 
-  m_meshes.clear();
-  for(const auto offset : uniqueOffsets)
+  const std::vector<uint32_t> sortedOffsets{uniqueOffsets.begin(), uniqueOffsets.end()};
+  const auto readMesh = [this, basePos, &sortedOffsets](io::SDLReader& meshReader, const size_t i)
   {
-    reader.seek(basePos + static_cast<std::streamoff>(offset));
+    meshReader.seek(basePos + static_cast<std::streamoff>(sortedOffsets[i]));
 
     if(gameToEngine(m_gameVersion) >= Engine::TR4)
-      m_meshes.emplace_back(Mesh::readTr4(reader));
-    else
-      m_meshes.emplace_back(Mesh::readTr1(reader));
+      return Mesh::readTr4(meshReader);
+    return Mesh::readTr1(meshReader);
+  };
+
+  m_meshes.clear();
+  if(reader.canView())
+  {
+    // meshes are independent of each other, decode them concurrently
+    m_meshes.resize(sortedOffsets.size());
+    util::ThreadPool::getShared().parallelFor(sortedOffsets.size(),
+                                              [this, &reader, &readMesh](const size_t i)
+                                              {
+                                                auto meshReader = reader.view();
+                                                m_meshes[i] = readMesh(meshReader, i);
+                                              });
+  }
+  else
+  {
+    for(size_t i = 0; i < sortedOffsets.size(); ++i)
+      m_meshes.emplace_back(readMesh(reader, i));
   }
   gsl_Ensures(m_meshes.size() == uniqueOffsets.size());
 
@@ -76,10 +113,15 @@ std::unique_ptr<Level> Level::createLoader(const std::filesystem::path& filename
 {
   util::ensureFileExists(filename);
 
+  return createLoader(io::SDLReader{filename}, filename, gameVersion);
+}
+
+std::unique_ptr<Level>
+  Level::createLoader(io::SDLReader&& reader, const std::filesystem::path& filename, Game gameVersion)
+{
   std::filesystem::path sfxPath = filename;
   sfxPath.replace_filename("MAIN.SFX");
 
-  io::SDLReader reader{filename};
   if(!reader.isOpen())
     return nullptr;
 
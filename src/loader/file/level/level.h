@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -101,6 +102,9 @@ public:
   uint16_t m_weatherType = 0;
 
   static std::unique_ptr<Level> createLoader(const std::filesystem::path& filename, Game gameVersion);
+  //! @brief Like the overload taking only a filename, but reads the data from @a reader.
+  static std::unique_ptr<Level>
+    createLoader(io::SDLReader&& reader, const std::filesystem::path& filename, Game gameVersion);
 
   virtual void loadFileData() = 0;
 
@@ -114,6 +118,25 @@ protected:
 
   bool m_demoOrUb = false;
 
+  //! @brief A zlib-compressed TR4/TR5 chunk, read ahead so that chunks can be decompressed concurrently.
+  struct CompressedChunk
+  {
+    uint32_t uncompressedSize = 0;
+    //! @brief Empty if the chunk is empty or was skipped.
+    std::vector<uint8_t> data;
+
+    [[nodiscard]] io::SDLReader decompress() const
+    {
+      return io::SDLReader::decompress(data, uncompressedSize);
+    }
+  };
+
+  /**
+   * @brief Reads a compressed chunk, or skips its data if @a load is not set.
+   * @throws std::runtime_error if the chunk has no uncompressed size.
+   */
+  [[nodiscard]] static CompressedChunk readCompressedChunk(io::SDLReader& reader, const std::string& name, bool load);
+
   void readMeshData(io::SDLReader& reader);
 
   static void convertTexture(const ByteTexture& tex, Palette& pal, DWordTexture& dst);
@@ -6,13 +6,19 @@
 #include "loader/file/item.h"
 #include "loader/file/meshes.h"
 #include "loader/file/texture.h"
+#include "util/threadpool.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -28,92 +34,61 @@ void TR4Level::loadFileData()
      file_version != 0x00345254 /*&& file_version != 0x63345254*/) // +TRLE
     BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: Wrong level version"));
 
+  const auto numRoomTextiles = m_reader.readU16();
+  const auto numObjTextiles = m_reader.readU16();
+  const auto numBumpTextiles = m_reader.readU16();
+  constexpr auto numMiscTextiles = 2;
+  const auto numTextiles = numRoomTextiles + numObjTextiles + numBumpTextiles + numMiscTextiles;
+
+  // 16 bit and misc textiles are only used if there are no 32 bit textiles
+  const auto textiles32 = readCompressedChunk(m_reader, "TR4 Level: textiles32", true);
+  const bool hasTextiles32 = !textiles32.data.empty() && numTextiles > numMiscTextiles;
+  const auto textiles16 = readCompressedChunk(m_reader, "TR4 Level: textiles16", !hasTextiles32);
+  const auto textiles32Misc = readCompressedChunk(m_reader, "TR4 Level: textiles32d", !hasTextiles32);
+  if(!textiles32Misc.data.empty() && textiles32Misc.uncompressedSize / (256 * 256 * 4) > 2)
+    BOOST_LOG_TRIVIAL(warning) << "TR4 Level: number of misc textiles > 2";
+
+  const auto geometry = readCompressedChunk(m_reader, "TR4 Level: packed geometry (decompressed)", true);
+  if(geometry.data.empty())
+    BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: packed geometry (compressed) is empty"));
+
   std::vector<WordTexture> texture16;
-  {
-    const auto numRoomTextiles = m_reader.readU16();
-    const auto numObjTextiles = m_reader.readU16();
-    const auto numBumpTextiles = m_reader.readU16();
-    constexpr auto numMiscTextiles = 2;
-    const auto numTextiles = numRoomTextiles + numObjTextiles + numBumpTextiles + numMiscTextiles;
-
-    uint32_t uncomp_size = m_reader.readU32();
-    if(uncomp_size == 0)
-      BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: textiles32 is empty"));
-
-    uint32_t comp_size = m_reader.readU32();
-    if(comp_size > 0)
+  std::vector<DWordTexture> miscAtlases;
+  std::optional<io::SDLReader> geometryReader;
+  const std::array<std::function<void()>, 4> decoders{
+    [this, &textiles32, numTextiles]()
     {
-      std::vector<uint8_t> comp_buffer(comp_size);
-      m_reader.readBytes(comp_buffer.data(), comp_size);
-
-      auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-      newsrc.readVector(m_atlases, numTextiles - numMiscTextiles, &DWordTexture::read);
-    }
-
-    uncomp_size = m_reader.readU32();
-    if(uncomp_size == 0)
-      BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: textiles16 is empty"));
-
-    comp_size = m_reader.readU32();
-    if(comp_size > 0)
+      if(!textiles32.data.empty())
+        textiles32.decompress().readVector(m_atlases, numTextiles - numMiscTextiles, &DWordTexture::read);
+    },
+    [&textiles16, &texture16, numTextiles]()
     {
-      if(m_atlases.empty())
-      {
-        std::vector<uint8_t> comp_buffer(comp_size);
-        m_reader.readBytes(comp_buffer.data(), comp_size);
-
-        auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-        newsrc.readVector(texture16, numTextiles - numMiscTextiles, &WordTexture::read);
-      }
-      else
-      {
-        m_reader.skip(comp_size);
-      }
-    }
-
-    uncomp_size = m_reader.readU32();
-    if(uncomp_size == 0)
-      BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: textiles32d is empty"));
-
-    comp_size = m_reader.readU32();
-    if(comp_size > 0)
+      if(!textiles16.data.empty())
+        textiles16.decompress().readVector(texture16, numTextiles - numMiscTextiles, &WordTexture::read);
+    },
+    [&textiles32Misc, &miscAtlases]()
     {
-      if(!m_atlases.empty())
-      {
-        m_reader.skip(comp_size);
-      }
-      else
-      {
-        if(uncomp_size / (256 * 256 * 4) > 2)
-          BOOST_LOG_TRIVIAL(warning) << "TR4 Level: number of misc textiles > 2";
-
-        if(m_atlases.empty())
-        {
-          m_atlases.resize(numTextiles);
-        }
-        std::vector<uint8_t> comp_buffer(comp_size);
-
-        m_reader.readBytes(comp_buffer.data(), comp_size);
-
-        auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-        newsrc.appendVector(m_atlases, numMiscTextiles, &DWordTexture::read);
-      }
-    }
+      if(!textiles32Misc.data.empty())
+        textiles32Misc.decompress().readVector(miscAtlases, numMiscTextiles, &DWordTexture::read);
+    },
+    [&geometry, &geometryReader]()
+    {
+      geometryReader.emplace(geometry.decompress());
+    },
+  };
+  util::ThreadPool::getShared().parallelFor(decoders.size(),
+                                            [&decoders](const size_t i)
+                                            {
+                                              decoders[i]();
+                                            });
+
+  if(!textiles32Misc.data.empty())
+  {
+    m_atlases.resize(numTextiles);
+    std::move(miscAtlases.begin(), miscAtlases.end(), std::back_inserter(m_atlases));
   }
 
-  const auto uncomp_size = m_reader.readU32();
-  if(uncomp_size == 0)
-    BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: packed geometry (decompressed) is empty"));
-
-  const auto comp_size = m_reader.readU32();
-
-  if(comp_size == 0)
-    BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: packed geometry (compressed) is empty"));
-
-  std::vector<uint8_t> comp_buffer(comp_size);
-  m_reader.readBytes(comp_buffer.data(), comp_size);
-
-  auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
+  auto& newsrc = *geometryReader;
   if(!newsrc.isOpen())
     BOOST_THROW_EXCEPTION(std::runtime_error("TR4 Level: packed geometry could not be decompressed"));
 
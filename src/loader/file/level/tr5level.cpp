@@ -6,11 +6,17 @@
 #include "loader/file/item.h"
 #include "loader/file/meshes.h"
 #include "loader/file/texture.h"
+#include "util/threadpool.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <ios>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -34,58 +40,13 @@ void TR5Level::loadFileData()
   constexpr auto numMiscTextiles = 3;
   const auto numTextiles = numRoomTextiles + numObjTextiles + numBumpTextiles + numMiscTextiles;
 
-  auto uncomp_size = m_reader.readU32();
-  if(uncomp_size == 0)
-    BOOST_THROW_EXCEPTION(std::runtime_error("TR5 Level: textiles32 is empty"));
-
-  auto comp_size = m_reader.readU32();
-  if(comp_size > 0)
-  {
-    std::vector<uint8_t> comp_buffer(comp_size);
-    m_reader.readBytes(comp_buffer.data(), comp_size);
-
-    auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-    newsrc.readVector(m_atlases, numTextiles - numMiscTextiles, &DWordTexture::read);
-  }
-
-  uncomp_size = m_reader.readU32();
-  if(uncomp_size == 0)
-    BOOST_THROW_EXCEPTION(std::runtime_error("TR5 Level: textiles16 is empty"));
-
-  comp_size = m_reader.readU32();
-  std::vector<WordTexture> texture16;
-  if(comp_size > 0)
-  {
-    if(m_atlases.empty())
-    {
-      std::vector<uint8_t> comp_buffer(comp_size);
-      m_reader.readBytes(comp_buffer.data(), comp_size);
-
-      auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-      newsrc.readVector(texture16, numTextiles - numMiscTextiles, &WordTexture::read);
-    }
-    else
-    {
-      m_reader.skip(comp_size);
-    }
-  }
-
-  uncomp_size = m_reader.readU32();
-  if(uncomp_size == 0)
-    BOOST_THROW_EXCEPTION(std::runtime_error("TR5 Level: textiles32d is empty"));
-
-  comp_size = m_reader.readU32();
-  if(comp_size > 0)
-  {
-    if(uncomp_size / (256 * 256 * 4) > 3)
-      BOOST_LOG_TRIVIAL(warning) << "TR5 Level: number of misc textiles > 3";
-
-    std::vector<uint8_t> comp_buffer(comp_size);
-    m_reader.readBytes(comp_buffer.data(), comp_size);
-
-    auto newsrc = io::SDLReader::decompress(comp_buffer, uncomp_size);
-    newsrc.appendVector(m_atlases, numMiscTextiles, &DWordTexture::read);
-  }
+  // 16 bit textiles are only used if there are no 32 bit textiles
+  const auto textiles32 = readCompressedChunk(m_reader, "TR5 Level: textiles32", true);
+  const bool hasTextiles32 = !textiles32.data.empty() && numTextiles > numMiscTextiles;
+  const auto textiles16 = readCompressedChunk(m_reader, "TR5 Level: textiles16", !hasTextiles32);
+  const auto textiles32Misc = readCompressedChunk(m_reader, "TR5 Level: textiles32d", true);
+  if(!textiles32Misc.data.empty() && textiles32Misc.uncompressedSize / (256 * 256 * 4) > 3)
+    BOOST_LOG_TRIVIAL(warning) << "TR5 Level: number of misc textiles > 3";
 
   m_laraType = m_reader.readU16();
   m_weatherType = m_reader.readU16();
@@ -120,7 +81,67 @@ void TR5Level::loadFileData()
   if(m_reader.readU32() != 0)
     BOOST_LOG_TRIVIAL(warning) << "TR5 Level: Bad value for 'unused'";
 
-  m_reader.readVector(m_rooms, m_reader.readU32(), &Room::readTr5);
+  // rooms are prefixed with their size, so they can be located up front and decoded concurrently
+  std::vector<std::streampos> roomPositions;
+  const auto roomCount = m_reader.readU32();
+  if(m_reader.canView())
+  {
+    roomPositions.reserve(roomCount);
+    for(uint32_t i = 0; i < roomCount; ++i)
+    {
+      roomPositions.emplace_back(m_reader.tell());
+      m_reader.skip(sizeof(uint32_t));
+      m_reader.skip(m_reader.readU32());
+    }
+  }
+  else
+  {
+    m_reader.readVector(m_rooms, roomCount, &Room::readTr5);
+  }
+
+  std::vector<WordTexture> texture16;
+  std::vector<DWordTexture> miscAtlases;
+  std::vector<std::unique_ptr<Room>> rooms(roomPositions.size());
+  const std::array<std::function<void()>, 3> decoders{
+    [this, &textiles32, numTextiles]()
+    {
+      if(!textiles32.data.empty())
+        textiles32.decompress().readVector(m_atlases, numTextiles - numMiscTextiles, &DWordTexture::read);
+    },
+    [&textiles16, &texture16, numTextiles]()
+    {
+      if(!textiles16.data.empty())
+        textiles16.decompress().readVector(texture16, numTextiles - numMiscTextiles, &WordTexture::read);
+    },
+    [&textiles32Misc, &miscAtlases]()
+    {
+      if(!textiles32Misc.data.empty())
+        textiles32Misc.decompress().readVector(miscAtlases, numMiscTextiles, &DWordTexture::read);
+    },
+  };
+  util::ThreadPool::getShared().parallelFor(decoders.size() + rooms.size(),
+                                            [this, &decoders, &rooms, &roomPositions](const size_t i)
+                                            {
+                                              if(i < decoders.size())
+                                              {
+                                                decoders[i]();
+                                                return;
+                                              }
+
+                                              const auto roomIndex = i - decoders.size();
+                                              auto roomReader = m_reader.view();
+                                              roomReader.seek(roomPositions[roomIndex]);
+                                              rooms[roomIndex] = Room::readTr5(roomReader);
+                                            });
+
+  std::move(miscAtlases.begin(), miscAtlases.end(), std::back_inserter(m_atlases));
+  if(!rooms.empty())
+  {
+    m_rooms.clear();
+    m_rooms.reserve(rooms.size());
+    for(auto& room : rooms)
+      m_rooms.emplace_back(std::move(*room));
+  }
 
   m_reader.readVector(m_floorData, m_reader.readU32());
 
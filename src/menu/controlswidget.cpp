@@ -8,6 +8,7 @@
 #include "ui/widgets/gridbox.h"
 #include "ui/widgets/groupbox.h"
 #include "ui/widgets/label.h"
+#include "util/profiler.h"
 
 #include <algorithm>
 #include <array>
@@ -64,7 +65,7 @@ constexpr std::array<std::array<std::optional<hid::Action>, 4>, Columns> shortcu
   {
     hid::Action::ConsumeSmallMedipack,
     hid::Action::ConsumeLargeMedipack,
-    std::nullopt,
+    util::profiler::Enabled ? std::optional{hid::Action::ProfilerTrace} : std::nullopt,
     std::nullopt,
   },
   {
@@ -1,6 +1,7 @@
 #include "savegamecleanup.h"
 
 #include "engine/engine.h"
+#include "engine/savegameindex.h"
 #include "util/fsutil.h"
 
 #include <algorithm>
@@ -69,13 +70,16 @@ void orderBy(const engine::Engine& engine,
                            });
 
   // now rename the temporary saves to the ordinary saves while getting re-ordered
+  std::map<size_t, size_t> moves;
   for(size_t i = 0; i < currentSlots.size(); ++i)
   {
     util::rename(makeTempFilepath(engine.getSavegamePath(currentSlots.at(i))),
                  engine.getSavegamePath(orderedSlots.at(i)));
     util::rename(makeTempFilepath(engine::makeMetaFilepath(engine.getSavegamePath(currentSlots.at(i)))),
                  engine::makeMetaFilepath(engine.getSavegamePath(orderedSlots.at(i))));
+    moves.emplace(currentSlots.at(i), orderedSlots.at(i));
   }
+  engine.getSavegameIndex().onMoved(moves);
 }
 } // namespace
 
@@ -89,6 +93,7 @@ void deleteSave(const engine::Engine& engine, size_t slot)
   BOOST_LOG_TRIVIAL(info) << "Deleting " << savegamePath << " and " << metaPath;
   std::filesystem::remove(savegamePath, ec);
   std::filesystem::remove(metaPath, ec);
+  engine.getSavegameIndex().onDeleted(slot);
 }
 
 void deleteSavesExcept(const engine::Engine& engine,
@@ -123,12 +128,14 @@ size_t compactSaves(const engine::Engine& engine,
 {
   size_t dstSlot = 0;
   size_t newSelectedSlot = 0;
+  std::map<size_t, size_t> moves;
   for(const auto& srcSlot : savegameInfos | std::views::keys)
   {
     const auto srcPath = engine.getSavegamePath(srcSlot);
     const auto srcMetaPath = engine::makeMetaFilepath(srcPath);
     const auto dstPath = engine.getSavegamePath(dstSlot);
     const auto dstMetaPath = engine::makeMetaFilepath(dstPath);
+    moves.emplace(srcSlot, dstSlot);
     ++dstSlot;
 
     util::rename(srcPath, dstPath);
@@ -138,6 +145,7 @@ size_t compactSaves(const engine::Engine& engine,
       newSelectedSlot = dstSlot;
     }
   }
+  engine.getSavegameIndex().onMoved(moves);
 
   return newSelectedSlot;
 }
@@ -174,6 +182,7 @@ void deleteSavesPerLevelExceptNewest(const engine::Engine& engine,
       BOOST_LOG_TRIVIAL(info) << "Deleting slot " << slot;
       std::filesystem::remove(savegamePath, ec);
       std::filesystem::remove(engine::makeMetaFilepath(savegamePath), ec);
+      engine.getSavegameIndex().onDeleted(slot);
     }
   }
 }
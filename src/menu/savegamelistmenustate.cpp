@@ -803,6 +803,8 @@ void SavegameListMenuState::initCleanupConfirmation()
 
 void SavegameListMenuState::cleanupSaves(const engine::world::World& world)
 {
+  // the slot files must not be renamed or deleted while queued savegames are still being written to them
+  world.getEngine().getSavegameWriter().wait();
   const auto slot = m_entries.at(getListBox()->getSelected())->getSlot();
   switch(m_cleanupWidget->getSelectedAction())
   {
@@ -1,11 +1,11 @@
 #include "hauntedcoopclient.h"
+#include "util/lockfree.h"
 
 // FIXME: this is a bad include path
 #include "../launcher/networkconfig.h"
 
 #include <boost/system/error_code.hpp>
 #include <ios>
-#include <map>
 
 #ifdef WIN32
 // workaround to populate the correct windows version to boost asio
@@ -13,6 +13,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/asio/buffer.hpp>
@@ -21,6 +22,7 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/assert.hpp>
@@ -33,7 +35,6 @@
 #include <istream>
 #include <iterator>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -67,16 +68,13 @@ void writeLogin(std::vector<uint8_t>& msg,
   network::io::writePascal(msg, sessionId);
 }
 
-void writeUpdateState(std::vector<uint8_t>& msg, const std::vector<uint8_t>& data)
+void writeUpdateStateHeader(std::vector<uint8_t>& msg, const size_t dataSize)
 {
   msg.emplace_back(static_cast<uint8_t>(ClientMessageId::UpdateState));
-  network::io::writePascal(msg, data);
+  network::io::writeLE<uint16_t>(msg, gsl_lite::narrow<uint16_t>(dataSize));
 }
 
-void write_query_state(std::vector<uint8_t>& msg)
-{
-  msg.emplace_back(static_cast<uint8_t>(ClientMessageId::StateQuery));
-}
+constexpr auto QueryStateMessage = static_cast<uint8_t>(ClientMessageId::StateQuery);
 } // namespace
 
 namespace network
@@ -104,6 +102,10 @@ struct HauntedCoopClient::ClientImpl
     }
 
     gsl_Expects(m_networkConfig.color.size() == 3);
+    m_stateSuffix.emplace_back(m_networkConfig.color.at(0));
+    m_stateSuffix.emplace_back(m_networkConfig.color.at(1));
+    m_stateSuffix.emplace_back(m_networkConfig.color.at(2));
+    io::writePascal(m_stateSuffix, m_networkConfig.username);
 
     std::vector<std::string> socketParts;
     boost::algorithm::split(socketParts,
@@ -154,37 +156,33 @@ struct HauntedCoopClient::ClientImpl
     }
   }
 
-  [[nodiscard]] auto getStates()
+  [[nodiscard]] const PeerStates& getStates()
   {
-    const std::lock_guard guard{m_peerDatasMutex};
-    return m_peerDatas;
+    return m_publishedPeerDatas.acquire();
   }
 
-  void sendState(PeerData data)
+  [[nodiscard]] PeerData* beginState()
   {
-    if(!m_loggedIn || !m_socket.is_open())
-      return;
-
-    const std::lock_guard guard{m_sendMutex};
-    m_sendBuffer.clear();
-
-    data.emplace_back(m_networkConfig.color.at(0));
-    data.emplace_back(m_networkConfig.color.at(1));
-    data.emplace_back(m_networkConfig.color.at(2));
-    io::writePascal(data, m_networkConfig.username);
-    writeUpdateState(m_sendBuffer, data);
+    if(!m_loggedIn)
+      return nullptr;
 
-    ++m_fullSyncCounter;
-    if(m_fullSyncCounter >= 30 * 5)
-    {
-      m_fullSyncCounter = 0;
-      write_query_state(m_sendBuffer);
-    }
+    auto* data = m_outgoingStates.beginPush();
+    if(data != nullptr)
+      data->clear();
+    return data;
+  }
 
-    if(!send())
+  void commitState()
+  {
+    m_outgoingStates.commitPush();
+    // only wake up the network thread if it isn't already about to drain the queue
+    if(!m_drainScheduled.exchange(true, std::memory_order_acq_rel))
     {
-      BOOST_LOG_TRIVIAL(error) << "send state failed";
-      m_loggedIn = false;
+      boost::asio::post(m_ioContext,
+                        [this]()
+                        {
+                          drainOutgoingStates();
+                        });
     }
   }
 
@@ -209,20 +207,17 @@ private:
       throw;
     }
 
+    BOOST_LOG_TRIVIAL(info) << "Logging in to Haunted Coop Server";
+    m_sendBuffer.clear();
+    writeLogin(m_sendBuffer,
+               m_networkConfig.username,
+               m_networkConfig.authToken,
+               m_networkConfig.sessionId + "/" + m_gameflowId + "/" + m_levelId);
+    if(!send(boost::asio::buffer(m_sendBuffer)))
     {
-      BOOST_LOG_TRIVIAL(info) << "Logging in to Haunted Coop Server";
-      const std::lock_guard guard{m_sendMutex};
-      m_sendBuffer.clear();
-      writeLogin(m_sendBuffer,
-                 m_networkConfig.username,
-                 m_networkConfig.authToken,
-                 m_networkConfig.sessionId + "/" + m_gameflowId + "/" + m_levelId);
-      if(!send())
-      {
-        BOOST_LOG_TRIVIAL(error) << "failed to send login credentials";
-        m_loggedIn = false;
-        return;
-      }
+      BOOST_LOG_TRIVIAL(error) << "failed to send login credentials";
+      m_loggedIn = false;
+      return;
     }
 
     BOOST_LOG_TRIVIAL(info) << "awaiting login response";
@@ -271,10 +266,8 @@ private:
 
   void readPeerData()
   {
-    {
-      const std::lock_guard guard{m_peerDatasMutex};
-      m_peerDatas.insert_or_assign(m_peerId, m_recvBuffer);
-    }
+    m_peerDatas.insert_or_assign(m_peerId, m_recvBuffer);
+    publishPeerDatas();
     processMessages();
   }
 
@@ -299,8 +292,8 @@ private:
       continueWithRead(sizeof(PeerId) + sizeof(uint16_t), &ClientImpl::readFullSyncPeerIdAndDataSize);
     else
     {
-      const std::lock_guard guard{m_peerDatasMutex};
       m_peerDatas.clear();
+      publishPeerDatas();
       processMessages();
     }
   }
@@ -320,8 +313,8 @@ private:
       continueWithRead(sizeof(PeerId) + sizeof(uint16_t), &ClientImpl::readFullSyncPeerIdAndDataSize);
     else
     {
-      const std::lock_guard guard{m_peerDatasMutex};
-      m_peerDatas = std::move(m_fullSyncPeerDatas);
+      std::swap(m_peerDatas, m_fullSyncPeerDatas);
+      publishPeerDatas();
       processMessages();
     }
   }
@@ -357,11 +350,52 @@ private:
     continueWithRead(1, &ClientImpl::dispatchMessage);
   }
 
-  bool send()
+  void publishPeerDatas()
+  {
+    // element-wise assignment, so the back buffer keeps the capacity of its data buffers
+    m_publishedPeerDatas.getBack() = m_peerDatas;
+    m_publishedPeerDatas.publish();
+  }
+
+  void drainOutgoingStates()
+  {
+    // reset before draining, so that states committed from now on schedule another drain
+    m_drainScheduled.exchange(false, std::memory_order_acq_rel);
+    while(const auto* data = m_outgoingStates.front())
+    {
+      if(m_loggedIn)
+        sendState(*data);
+      m_outgoingStates.pop();
+    }
+  }
+
+  void sendState(const PeerData& data)
+  {
+    m_sendBuffer.clear();
+    writeUpdateStateHeader(m_sendBuffer, data.size() + m_stateSuffix.size());
+
+    ++m_fullSyncCounter;
+    const bool queryState = m_fullSyncCounter >= 30 * 5;
+    if(queryState)
+      m_fullSyncCounter = 0;
+
+    const std::array<boost::asio::const_buffer, 4> buffers{boost::asio::buffer(m_sendBuffer),
+                                                           boost::asio::buffer(data),
+                                                           boost::asio::buffer(m_stateSuffix),
+                                                           boost::asio::buffer(&QueryStateMessage, queryState ? 1 : 0)};
+    if(!send(buffers))
+    {
+      BOOST_LOG_TRIVIAL(error) << "send state failed";
+      m_loggedIn = false;
+    }
+  }
+
+  template<typename ConstBufferSequence>
+  bool send(const ConstBufferSequence& buffers)
   {
     try
     {
-      m_socket.send(boost::asio::buffer(m_sendBuffer));
+      m_socket.send(buffers);
     }
     catch(std::exception& ex)
     {
@@ -380,17 +414,22 @@ private:
 
   std::atomic_bool m_loggedIn{false};
 
-  std::mutex m_sendMutex;
   std::vector<uint8_t> m_sendBuffer;
   std::vector<uint8_t> m_recvBuffer;
+  //! @brief Color and user name, appended to every state sent.
+  std::vector<uint8_t> m_stateSuffix;
+
+  util::SpscRing<PeerData, 4> m_outgoingStates;
+  std::atomic_bool m_drainScheduled{false};
 
   PeerId m_peerId = 0;
 
   uint16_t m_fullSyncStatesCount = 0;
-  std::map<PeerId, PeerData> m_fullSyncPeerDatas;
+  PeerStates m_fullSyncPeerDatas;
 
-  std::mutex m_peerDatasMutex;
-  std::map<PeerId, PeerData> m_peerDatas;
+  //! @brief Only accessed by the network thread.
+  PeerStates m_peerDatas;
+  util::TripleBuffer<PeerStates> m_publishedPeerDatas;
 
   uint16_t m_fullSyncCounter = 0;
 
@@ -433,9 +472,14 @@ HauntedCoopClient::HauntedCoopClient(const std::string& gameflowId, const std::s
 {
 }
 
-void HauntedCoopClient::sendState(const PeerData& data) const
+PeerData* HauntedCoopClient::beginState()
+{
+  return impl->beginState();
+}
+
+void HauntedCoopClient::commitState()
 {
-  impl->sendState(data);
+  impl->commitState();
 }
 
 void HauntedCoopClient::updateThread()
@@ -443,9 +487,8 @@ void HauntedCoopClient::updateThread()
   impl->run();
 }
 
-std::map<PeerId, PeerData> HauntedCoopClient::getStates() const
+const PeerStates& HauntedCoopClient::getStates()
 {
-  const std::lock_guard guard{m_statesMutex};
   return impl->getStates();
 }
 
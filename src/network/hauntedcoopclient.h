@@ -1,10 +1,9 @@
 #pragma once
 
+#include <boost/container/flat_map.hpp>
 #include <cstdint>
 #include <iosfwd>
-#include <map>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -13,6 +12,7 @@ namespace network
 {
 using PeerId = uint64_t;
 using PeerData = std::vector<uint8_t>;
+using PeerStates = boost::container::flat_map<PeerId, PeerData>;
 
 class HauntedCoopClient
 {
@@ -20,9 +20,22 @@ public:
   explicit HauntedCoopClient(const std::string& gameflowId, const std::string& levelId);
   ~HauntedCoopClient();
 
-  void sendState(const PeerData& data) const;
+  /**
+   * @brief Returns an empty buffer to encode the local state into, or @c nullptr if the state can't be sent.
+   *
+   * The buffer is handed to the network thread by commitState(). Buffers are recycled, so encoding into them doesn't
+   * allocate once they have grown large enough. If the network thread falls behind, states are dropped instead of
+   * blocking the caller.
+   */
+  [[nodiscard]] PeerData* beginState();
+  void commitState();
 
-  [[nodiscard]] std::map<PeerId, PeerData> getStates() const;
+  /**
+   * @brief The most recent states received from the other peers.
+   *
+   * Never blocks on the network thread. The returned states stay valid and unchanged until the next call.
+   */
+  [[nodiscard]] const PeerStates& getStates();
 
   void start();
 
@@ -31,7 +44,6 @@ public:
 private:
   struct ClientImpl;
 
-  mutable std::mutex m_statesMutex;
   std::unique_ptr<ClientImpl> impl;
   std::thread m_thread;
 
@@ -4,7 +4,6 @@
 #include "engine/skeletalmodelnode.h"
 #include "render/scene/mesh.h"
 #include "render/scene/node.h"
-#include "shaderprogram.h"
 
 #include <boost/log/trivial.hpp>
 #include <functional>
@@ -12,17 +11,19 @@
 
 namespace render::material
 {
-bool BufferParameter::bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram)
+bool BufferParameter::bind(const scene::Node* node,
+                           const scene::Mesh& mesh,
+                           gl::ShaderStorageBlock* shaderStorageBlock) const
 {
   const auto* binder = m_bufferBinder ? &m_bufferBinder : nullptr;
   if(binder == nullptr)
   {
-    binder = mesh.findShaderStorageBlockBinder(getName());
+    binder = mesh.findShaderStorageBlockBinder(getId());
   }
 
   if(binder == nullptr && node != nullptr)
   {
-    binder = node->findShaderStorageBlockBinder(getName());
+    binder = node->findShaderStorageBlockBinder(getId());
   }
 
   if(binder == nullptr)
@@ -31,11 +32,13 @@ bool BufferParameter::bind(const scene::Node* node, const scene::Mesh& mesh, Sha
     return true;
   }
 
-  const auto block = findShaderStorageBlock(shaderProgram);
-  if(block == nullptr)
+  if(shaderStorageBlock == nullptr)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Shader storage block '" << getName() << "' not found in program";
     return false;
+  }
 
-  (*binder)(node, mesh, *block);
+  (*binder)(node, mesh, *shaderStorageBlock);
 
   return true;
 }
@@ -61,15 +64,4 @@ void BufferParameter::bindNextBoneTransformBuffer(const std::function<bool()>& s
       ssb.bind(go->getMeshMatricesBuffer());
   };
 }
-
-gl::ShaderStorageBlock* BufferParameter::findShaderStorageBlock(ShaderProgram& shaderProgram) const
-{
-  if(const auto block = shaderProgram.findShaderStorageBlock(getName()))
-    return block;
-
-  BOOST_LOG_TRIVIAL(warning) << "Shader storage block '" << getName() << "' not found in program '"
-                             << shaderProgram.getId() << "'";
-
-  return nullptr;
-}
 } // namespace render::material
@@ -17,8 +17,6 @@ class Node;
 
 namespace render::material
 {
-class ShaderProgram;
-
 class BufferParameter : public MaterialParameter
 {
 public:
@@ -60,13 +58,12 @@ public:
     m_bufferBinder = std::move(setter);
   }
 
-  bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
+  //! @see UniformParameter::bind
+  bool bind(const scene::Node* node, const scene::Mesh& mesh, gl::ShaderStorageBlock* shaderStorageBlock) const;
   void bindBoneTransformBuffer(const std::function<bool()>& smooth);
   void bindNextBoneTransformBuffer(const std::function<bool()>& smooth);
 
 private:
-  [[nodiscard]] gl::ShaderStorageBlock* findShaderStorageBlock(ShaderProgram& shaderProgram) const;
-
   std::function<BufferBinder> m_bufferBinder;
 };
 } // namespace render::material
@@ -1,6 +1,7 @@
 #include "material.h"
 
 #include "bufferparameter.h"
+#include "parameterid.h"
 #include "shaderprogram.h"
 #include "uniformparameter.h"
 
@@ -10,61 +11,98 @@
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace render::material
 {
+namespace
+{
+template<typename TBinding, typename TParameter, typename TFind>
+std::shared_ptr<TParameter> tryGet(std::vector<TBinding>& bindings, const std::string& name, const TFind& find)
+{
+  if(const auto id = ParameterNames::find(name); id.has_value())
+  {
+    const auto it = std::ranges::find_if(bindings,
+                                         [&id](const auto& binding)
+                                         {
+                                           return binding.parameter->getId() == *id;
+                                         });
+    if(it != bindings.end())
+      return it->parameter;
+  }
+
+  const auto target = find(name);
+  if(target == nullptr)
+    return nullptr;
+
+  auto param = std::make_shared<TParameter>(name);
+  bindings.emplace_back(TBinding{gsl_lite::not_null{param}, target});
+  return param;
+}
+} // namespace
+
 Material::Material(gslu::nn_shared<ShaderProgram> shaderProgram)
     : m_shaderProgram{std::move(shaderProgram)}
 {
+  // the program's interface never changes, so the parameters are resolved once instead of on every bind
   for(const auto& uniform : m_shaderProgram->getHandle().getUniforms())
   {
     // skip all uniforms that are part of a uniform block
     if(uniform.getName().find('.') != std::string::npos)
       continue;
-    m_uniforms.emplace_back(std::make_shared<UniformParameter>(uniform.getName()));
+    m_uniforms.emplace_back(Binding<UniformParameter, gl::Uniform>{
+      gsl_lite::make_shared<UniformParameter>(uniform.getName()), m_shaderProgram->findUniform(uniform.getName())});
   }
   for(const auto& block : m_shaderProgram->getHandle().getUniformBlocks())
     // cppcheck-suppress useStlAlgorithm
-    m_uniformBlocks.emplace_back(std::make_shared<UniformBlockParameter>(block.getName()));
+    m_uniformBlocks.emplace_back(
+      Binding<UniformBlockParameter, gl::UniformBlock>{gsl_lite::make_shared<UniformBlockParameter>(block.getName()),
+                                                       m_shaderProgram->findUniformBlock(block.getName())});
   for(const auto& block : m_shaderProgram->getHandle().getShaderStorageBlocks())
     // cppcheck-suppress useStlAlgorithm
-    m_buffers.emplace_back(std::make_shared<BufferParameter>(block.getName()));
+    m_buffers.emplace_back(
+      Binding<BufferParameter, gl::ShaderStorageBlock>{gsl_lite::make_shared<BufferParameter>(block.getName()),
+                                                       m_shaderProgram->findShaderStorageBlock(block.getName())});
 }
 
 Material::~Material() = default;
 
 void Material::bind(const scene::Node* node, const scene::Mesh& mesh) const
 {
-  for(const auto& param : m_uniforms)
+  for(const auto& [param, uniform] : m_uniforms)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, *m_shaderProgram);
+    [[maybe_unused]] const auto success = param->bind(node, mesh, uniform);
 #ifndef NDEBUG
     if(!success)
     {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform " << param->getName();
+      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform " << param->getName() << " of program '"
+                                 << m_shaderProgram->getId() << "'";
     }
 #endif
   }
 
-  for(const auto& param : m_uniformBlocks)
+  for(const auto& [param, block] : m_uniformBlocks)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, *m_shaderProgram);
+    [[maybe_unused]] const auto success = param->bind(node, mesh, block);
 #ifndef NDEBUG
     if(!success)
     {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform block " << param->getName();
+      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform block " << param->getName() << " of program '"
+                                 << m_shaderProgram->getId() << "'";
     }
 #endif
   }
 
-  for(const auto& param : m_buffers)
+  for(const auto& [param, block] : m_buffers)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, *m_shaderProgram);
+    [[maybe_unused]] const auto success = param->bind(node, mesh, block);
 #ifndef NDEBUG
     if(!success)
     {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material buffer " << param->getName();
+      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material buffer " << param->getName() << " of program '"
+                                 << m_shaderProgram->getId() << "'";
     }
 #endif
   }
@@ -74,53 +112,34 @@ void Material::bind(const scene::Node* node, const scene::Mesh& mesh) const
 
 std::shared_ptr<UniformParameter> Material::tryGetUniform(const std::string& name) const
 {
-  const auto it = std::ranges::find_if(m_uniforms,
-                                       [&name](const auto& param)
-                                       {
-                                         return param->getName() == name;
-                                       });
-  if(it != m_uniforms.end())
-    return *it;
-
-  if(m_shaderProgram->findUniform(name) == nullptr)
-    return nullptr;
-
-  auto param = std::make_shared<UniformParameter>(name);
-  m_uniforms.emplace_back(param);
-  return param;
+  return tryGet<Binding<UniformParameter, gl::Uniform>, UniformParameter>(
+    m_uniforms,
+    name,
+    [this](const std::string& needle)
+    {
+      return m_shaderProgram->findUniform(needle);
+    });
 }
 
 std::shared_ptr<UniformBlockParameter> Material::tryGetUniformBlock(const std::string& name) const
 {
-  const auto it = std::ranges::find_if(m_uniformBlocks,
-                                       [&name](const auto& param)
-                                       {
-                                         return param->getName() == name;
-                                       });
-  if(it != m_uniformBlocks.end())
-    return *it;
-
-  if(m_shaderProgram->findUniformBlock(name) == nullptr)
-    return nullptr;
-  auto param = std::make_shared<UniformBlockParameter>(name);
-  m_uniformBlocks.emplace_back(param);
-  return param;
+  return tryGet<Binding<UniformBlockParameter, gl::UniformBlock>, UniformBlockParameter>(
+    m_uniformBlocks,
+    name,
+    [this](const std::string& needle)
+    {
+      return m_shaderProgram->findUniformBlock(needle);
+    });
 }
 
 std::shared_ptr<BufferParameter> Material::tryGetBuffer(const std::string& name) const
 {
-  const auto it = std::ranges::find_if(m_buffers,
-                                       [&name](const auto& param)
-                                       {
-                                         return param->getName() == name;
-                                       });
-  if(it != m_buffers.end())
-    return *it;
-
-  if(m_shaderProgram->findShaderStorageBlock(name) == nullptr)
-    return nullptr;
-  auto param = std::make_shared<BufferParameter>(name);
-  m_buffers.emplace_back(param);
-  return param;
+  return tryGet<Binding<BufferParameter, gl::ShaderStorageBlock>, BufferParameter>(
+    m_buffers,
+    name,
+    [this](const std::string& needle)
+    {
+      return m_shaderProgram->findShaderStorageBlock(needle);
+    });
 }
-} // namespace render::material
\ No newline at end of file
+} // namespace render::material
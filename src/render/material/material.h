@@ -1,5 +1,6 @@
 #pragma once
 
+#include <gl/program.h>
 #include <gl/renderstate.h>
 #include <gsl-lite/gsl-lite.hpp>
 #include <gslu.h>
@@ -68,9 +69,17 @@ public:
 private:
   gslu::nn_shared<ShaderProgram> m_shaderProgram;
 
-  mutable std::vector<gslu::nn_shared<UniformParameter>> m_uniforms;
-  mutable std::vector<gslu::nn_shared<UniformBlockParameter>> m_uniformBlocks;
-  mutable std::vector<gslu::nn_shared<BufferParameter>> m_buffers;
+  //! @brief A parameter and the shader program's resolved counterpart, or nullptr if the program doesn't have it.
+  template<typename TParameter, typename TTarget>
+  struct Binding
+  {
+    gslu::nn_shared<TParameter> parameter;
+    TTarget* target;
+  };
+
+  mutable std::vector<Binding<UniformParameter, gl::Uniform>> m_uniforms;
+  mutable std::vector<Binding<UniformBlockParameter, gl::UniformBlock>> m_uniformBlocks;
+  mutable std::vector<Binding<BufferParameter, gl::ShaderStorageBlock>> m_buffers;
 
   gl::RenderState m_renderState;
 };
@@ -1,36 +1,35 @@
 #pragma once
 
+#include "parameterid.h"
+
 #include <string>
 #include <utility>
 
-namespace render::scene
-{
-class Mesh;
-class Node;
-} // namespace render::scene
-
 namespace render::material
 {
-class ShaderProgram;
-
 class MaterialParameter
 {
 public:
   explicit MaterialParameter(std::string name)
       : m_name{std::move(name)}
+      , m_id{ParameterNames::intern(m_name)}
   {
   }
 
   virtual ~MaterialParameter() = default;
 
-  virtual bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) = 0;
-
   [[nodiscard]] const std::string& getName() const
   {
     return m_name;
   }
 
+  [[nodiscard]] const ParameterId& getId() const
+  {
+    return m_id;
+  }
+
 private:
   std::string m_name;
+  ParameterId m_id;
 };
 } // namespace render::material
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "bufferparameter.h"
+#include "parameterid.h"
 #include "uniformparameter.h"
 
 #include <boost/container/flat_map.hpp>
 #include <functional>
 #include <string>
+#include <utility>
 
 namespace render::material
 {
@@ -13,9 +15,9 @@ template<typename T>
 class SingleMaterialParameterOverrider final
 {
 public:
-  [[nodiscard]] const std::function<T>* find(const std::string& name) const
+  [[nodiscard]] const std::function<T>* find(const ParameterId& id) const
   {
-    const auto it = m_setters.find(name);
+    const auto it = m_setters.find(id);
     if(it != m_setters.end())
       return &it->second;
 
@@ -24,16 +26,17 @@ public:
 
   void bind(const std::string& name, const std::function<T>& setter)
   {
-    m_setters[name] = setter;
+    m_setters[ParameterNames::intern(name)] = setter;
   }
 
   void bind(const std::string& name, std::function<T>&& setter)
   {
-    m_setters[name] = std::move(setter);
+    m_setters[ParameterNames::intern(name)] = std::move(setter);
   }
 
 private:
-  boost::container::flat_map<std::string, std::function<T>> m_setters;
+  // only a few setters are bound per mesh or node, so they are kept sorted by id instead of in an array indexed by id
+  boost::container::flat_map<ParameterId, std::function<T>> m_setters;
 };
 
 class MaterialParameterOverrider
@@ -42,21 +45,21 @@ public:
   virtual ~MaterialParameterOverrider() = default;
 
   [[nodiscard]] const std::function<UniformParameter::UniformValueSetter>*
-    findUniformSetter(const std::string& name) const
+    findUniformSetter(const ParameterId& id) const
   {
-    return m_uniformSetters.find(name);
+    return m_uniformSetters.find(id);
   }
 
   [[nodiscard]] const std::function<UniformBlockParameter::BufferBinder>*
-    findUniformBlockBinder(const std::string& name) const
+    findUniformBlockBinder(const ParameterId& id) const
   {
-    return m_uniformBlockBinders.find(name);
+    return m_uniformBlockBinders.find(id);
   }
 
   [[nodiscard]] const std::function<BufferParameter::BufferBinder>*
-    findShaderStorageBlockBinder(const std::string& name) const
+    findShaderStorageBlockBinder(const ParameterId& id) const
   {
-    return m_bufferBinders.find(name);
+    return m_bufferBinders.find(id);
   }
 
   void bind(const std::string& name, const std::function<UniformParameter::UniformValueSetter>& setter)
@@ -0,0 +1,44 @@
+#include "parameterid.h"
+
+#include <gsl-lite/gsl-lite.hpp>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace render::material
+{
+namespace
+{
+struct Registry
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, ParameterId> ids;
+
+  static Registry& get()
+  {
+    static Registry registry;
+    return registry;
+  }
+};
+} // namespace
+
+ParameterId ParameterNames::intern(const std::string_view& name)
+{
+  auto& registry = Registry::get();
+  std::unique_lock lock{registry.mutex};
+  const auto it
+    = registry.ids.try_emplace(std::string{name}, gsl_lite::narrow<ParameterId::type>(registry.ids.size())).first;
+  return it->second;
+}
+
+std::optional<ParameterId> ParameterNames::find(const std::string_view& name)
+{
+  auto& registry = Registry::get();
+  std::unique_lock lock{registry.mutex};
+  if(const auto it = registry.ids.find(std::string{name}); it != registry.ids.end())
+    return it->second;
+  return std::nullopt;
+}
+} // namespace render::material
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "core/id.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace render::material
+{
+DECLARE_ID(ParameterId, uint32_t);
+
+/**
+ * @brief Interns the names of uniforms, uniform blocks and shader storage blocks.
+ *
+ * Material parameters and the setters of meshes and nodes are matched by their ids, so binding a material doesn't
+ * hash or compare any strings. Ids are process-wide and never released.
+ */
+class ParameterNames final
+{
+public:
+  ParameterNames() = delete;
+
+  [[nodiscard]] static ParameterId intern(const std::string_view& name);
+  [[nodiscard]] static std::optional<ParameterId> find(const std::string_view& name);
+};
+} // namespace render::material
@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE render_material
+
+#include "render/material/bufferparameter.h"
+#include "render/material/materialparameteroverrider.h"
+#include "render/material/parameterid.h"
+#include "render/material/uniformparameter.h"
+
+#include <boost/test/unit_test.hpp>
+#include <functional>
+#include <optional>
+
+namespace render::scene
+{
+class Mesh;
+class Node;
+} // namespace render::scene
+
+// Materials can't be bound here: a ShaderProgram links its shaders, and the uniforms and blocks it resolves to are
+// queried from the linked program, so all of them need a GL context. The setter tables the materials look up by id
+// don't.
+
+namespace
+{
+using render::material::ParameterNames;
+
+//! @brief A setter which can be identified through std::function::target(), so it never needs to be called.
+template<typename TTarget>
+struct TaggedSetter
+{
+  int tag;
+
+  void operator()(const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, TTarget& /*target*/) const
+  {
+  }
+};
+
+template<typename TTarget>
+int tagOf(const std::function<void(const render::scene::Node*, const render::scene::Mesh&, TTarget&)>* setter)
+{
+  BOOST_REQUIRE(setter != nullptr);
+  const auto* tagged = setter->template target<TaggedSetter<TTarget>>();
+  BOOST_REQUIRE(tagged != nullptr);
+  return tagged->tag;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(parameter_names_tests)
+
+BOOST_AUTO_TEST_CASE(test_intern_is_stable)
+{
+  BOOST_CHECK(!ParameterNames::find("u_neverInterned").has_value());
+
+  const auto a = ParameterNames::intern("u_internA");
+  const auto b = ParameterNames::intern("u_internB");
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(ParameterNames::intern("u_internA") == a);
+  BOOST_CHECK(ParameterNames::find("u_internA") == std::optional{a});
+  BOOST_CHECK(ParameterNames::find("u_internB") == std::optional{b});
+}
+
+BOOST_AUTO_TEST_CASE(test_parameters_intern_their_names)
+{
+  const render::material::UniformParameter uniform{"u_parameterName"};
+  BOOST_CHECK(ParameterNames::find("u_parameterName") == std::optional{uniform.getId()});
+
+  // uniforms, uniform blocks and shader storage blocks share the ids
+  const render::material::BufferParameter buffer{"u_parameterName"};
+  BOOST_CHECK(buffer.getId() == uniform.getId());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(overrider_tests)
+
+BOOST_AUTO_TEST_CASE(test_find_bound_setters)
+{
+  render::material::MaterialParameterOverrider overrider;
+  overrider.bind("u_overriderA", TaggedSetter<gl::Uniform>{1});
+  overrider.bind("u_overriderB", TaggedSetter<gl::Uniform>{2});
+
+  BOOST_CHECK_EQUAL(tagOf(overrider.findUniformSetter(ParameterNames::intern("u_overriderA"))), 1);
+  BOOST_CHECK_EQUAL(tagOf(overrider.findUniformSetter(ParameterNames::intern("u_overriderB"))), 2);
+  BOOST_CHECK(overrider.findUniformSetter(ParameterNames::intern("u_overriderUnbound")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_rebinding_replaces_setter)
+{
+  render::material::MaterialParameterOverrider overrider;
+  overrider.bind("u_rebound", TaggedSetter<gl::Uniform>{1});
+  overrider.bind("u_rebound", TaggedSetter<gl::Uniform>{2});
+
+  BOOST_CHECK_EQUAL(tagOf(overrider.findUniformSetter(ParameterNames::intern("u_rebound"))), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_kinds_are_separate)
+{
+  render::material::MaterialParameterOverrider overrider;
+  overrider.bind("u_uniformOnly", TaggedSetter<gl::Uniform>{1});
+  overrider.bind("b_blockOnly", TaggedSetter<gl::UniformBlock>{2});
+  overrider.bind("b_storageOnly", TaggedSetter<gl::ShaderStorageBlock>{3});
+
+  const auto uniformId = ParameterNames::intern("u_uniformOnly");
+  const auto blockId = ParameterNames::intern("b_blockOnly");
+  const auto storageId = ParameterNames::intern("b_storageOnly");
+
+  BOOST_CHECK_EQUAL(tagOf(overrider.findUniformSetter(uniformId)), 1);
+  BOOST_CHECK(overrider.findUniformBlockBinder(uniformId) == nullptr);
+  BOOST_CHECK(overrider.findShaderStorageBlockBinder(uniformId) == nullptr);
+
+  BOOST_CHECK(overrider.findUniformSetter(blockId) == nullptr);
+  BOOST_CHECK_EQUAL(tagOf(overrider.findUniformBlockBinder(blockId)), 2);
+  BOOST_CHECK(overrider.findShaderStorageBlockBinder(blockId) == nullptr);
+
+  BOOST_CHECK(overrider.findUniformSetter(storageId) == nullptr);
+  BOOST_CHECK(overrider.findUniformBlockBinder(storageId) == nullptr);
+  BOOST_CHECK_EQUAL(tagOf(overrider.findShaderStorageBlockBinder(storageId)), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
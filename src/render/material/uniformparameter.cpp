@@ -3,7 +3,6 @@
 #include "render/scene/camera.h"
 #include "render/scene/mesh.h"
 #include "render/scene/node.h"
-#include "shaderprogram.h"
 
 #include <boost/log/trivial.hpp>
 #include <gl/program.h>
@@ -12,17 +11,17 @@
 
 namespace render::material
 {
-bool UniformParameter::bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram)
+bool UniformParameter::bind(const scene::Node* node, const scene::Mesh& mesh, gl::Uniform* uniform) const
 {
   const auto* setter = m_valueSetter ? &m_valueSetter : nullptr;
   if(setter == nullptr)
   {
-    setter = mesh.findUniformSetter(getName());
+    setter = mesh.findUniformSetter(getId());
   }
 
   if(setter == nullptr && node != nullptr)
   {
-    setter = node->findUniformSetter(getName());
+    setter = node->findUniformSetter(getId());
   }
 
   if(setter == nullptr)
@@ -31,36 +30,30 @@ bool UniformParameter::bind(const scene::Node* node, const scene::Mesh& mesh, Sh
     return true;
   }
 
-  const auto uniform = findUniform(shaderProgram);
   if(uniform == nullptr)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Uniform '" << getName() << "' not found in program";
     return false;
+  }
 
   (*setter)(node, mesh, *uniform);
 
   return true;
 }
 
-gl::Uniform* UniformParameter::findUniform(ShaderProgram& shaderProgram) const
-{
-  if(const auto uniform = shaderProgram.findUniform(getName()))
-    return uniform;
-
-  BOOST_LOG_TRIVIAL(warning) << "Uniform '" << getName() << "' not found in program '" << shaderProgram.getId() << "'";
-
-  return nullptr;
-}
-
-bool UniformBlockParameter::bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram)
+bool UniformBlockParameter::bind(const scene::Node* node,
+                                 const scene::Mesh& mesh,
+                                 gl::UniformBlock* uniformBlock) const
 {
   const auto* binder = m_bufferBinder ? &m_bufferBinder : nullptr;
   if(binder == nullptr)
   {
-    binder = mesh.findUniformBlockBinder(getName());
+    binder = mesh.findUniformBlockBinder(getId());
   }
 
   if(binder == nullptr && node != nullptr)
   {
-    binder = node->findUniformBlockBinder(getName());
+    binder = node->findUniformBlockBinder(getId());
   }
 
   if(binder == nullptr)
@@ -69,11 +62,13 @@ bool UniformBlockParameter::bind(const scene::Node* node, const scene::Mesh& mes
     return true;
   }
 
-  const auto block = findUniformBlock(shaderProgram);
-  if(block == nullptr)
+  if(uniformBlock == nullptr)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Uniform block '" << getName() << "' not found in program";
     return false;
+  }
 
-  (*binder)(node, mesh, *block);
+  (*binder)(node, mesh, *uniformBlock);
 
   return true;
 }
@@ -94,15 +89,4 @@ void UniformBlockParameter::bindCameraBuffer(const gslu::nn_shared<scene::Camera
     ub.bind(camera->getMatricesBuffer());
   };
 }
-
-gl::UniformBlock* UniformBlockParameter::findUniformBlock(ShaderProgram& shaderProgram) const
-{
-  if(const auto block = shaderProgram.findUniformBlock(getName()))
-    return block;
-
-  BOOST_LOG_TRIVIAL(warning) << "Uniform block '" << getName() << "' not found in program '" << shaderProgram.getId()
-                             << "'";
-
-  return nullptr;
-}
 } // namespace render::material
\ No newline at end of file
@@ -20,8 +20,6 @@ class Node;
 
 namespace render::material
 {
-class ShaderProgram;
-
 class UniformParameter final : public MaterialParameter
 {
 public:
@@ -71,11 +69,14 @@ public:
     };
   }
 
-  bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
+  /**
+   * @brief Applies the setter of the material, the mesh or the node, in that order.
+   * @param uniform The uniform as resolved by the material, or nullptr if its program doesn't have one.
+   * @return false if a setter is present, but @a uniform is nullptr.
+   */
+  bool bind(const scene::Node* node, const scene::Mesh& mesh, gl::Uniform* uniform) const;
 
 private:
-  [[nodiscard]] gl::Uniform* findUniform(ShaderProgram& shaderProgram) const;
-
   std::function<UniformValueSetter> m_valueSetter;
 };
 
@@ -117,14 +118,13 @@ public:
     m_bufferBinder = std::move(setter);
   }
 
-  bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
+  //! @see UniformParameter::bind
+  bool bind(const scene::Node* node, const scene::Mesh& mesh, gl::UniformBlock* uniformBlock) const;
 
   void bindTransformBuffer();
   void bindCameraBuffer(const gslu::nn_shared<scene::Camera>& camera);
 
 private:
-  [[nodiscard]] gl::UniformBlock* findUniformBlock(ShaderProgram& shaderProgram) const;
-
   std::function<BufferBinder> m_bufferBinder;
 };
 } // namespace render::material
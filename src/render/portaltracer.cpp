@@ -5,12 +5,14 @@
 #include "engine/world/world.h"
 #include "scene/camera.h"
 #include "scene/node.h"
+#include "util/profiler.h"
 
 #include <algorithm>
 #include <array>
 #include <boost/assert.hpp>
 #include <cmath>
 #include <cstddef>
+#include <deque>
 #include <glm/fwd.hpp>
 #include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
@@ -20,8 +22,9 @@
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <unordered_map>
 #include <unordered_set>
-#include <vector>
+#include <utility>
 
 namespace render
 {
@@ -156,62 +159,142 @@ std::optional<PortalTracer::CullBox> PortalTracer::narrowCullBox(const CullBox&
   return portalCullBox;
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
-bool PortalTracer::traceRoom(const engine::world::Room& room,
-                             const CullBox& roomCullBox,
-                             const engine::world::World& world,
-                             std::vector<const engine::world::Room*>& seenRooms,
-                             const bool inWater,
-                             std::unordered_set<const engine::world::Portal*>& waterSurfacePortals,
-                             const bool startFromWater,
-                             const int depth)
+PortalTracer::Statistics& PortalTracer::getStatistics()
 {
-  if(std::find(seenRooms.rbegin(), seenRooms.rend(), &room) != seenRooms.rend())
-    return false;
-  seenRooms.emplace_back(&room);
+  static Statistics statistics;
+  return statistics;
+}
 
-  room.node->setVisible(true);
-  room.node->setRenderOrder(-depth);
-  for(const auto& portal : room.portals)
+std::unordered_set<const engine::world::Portal*> PortalTracer::trace(const engine::world::Room& startRoom,
+                                                                     const engine::world::World& world)
+{
+  UTIL_PROFILE_ZONE("PortalTracer::trace");
+
+  //! Even the largest hubs settle within a few expansions per room.
+  static constexpr size_t MaxExpansionsPerRoom = 4;
+
+  // the path to a room is only relevant for detecting water surfaces, so rooms are traced separately for paths which
+  // have or have not passed through water yet
+  struct RoomState
+  {
+    std::array<std::optional<CullBox>, 2> cullBoxes{};
+    std::array<bool, 2> queued{false, false};
+    int depth = std::numeric_limits<int>::max();
+  };
+
+  const bool startFromWater = startRoom.isWaterRoom;
+  std::unordered_map<const engine::world::Room*, RoomState> states;
+  std::deque<std::pair<const engine::world::Room*, bool>> queue;
+
+  auto& startState = states[&startRoom];
+  startState.cullBoxes[startFromWater] = CullBox{{-1, 1}, {-1, 1}};
+  startState.queued[startFromWater] = true;
+  startState.depth = 1;
+  queue.emplace_back(&startRoom, startFromWater);
+
+  // rooms outside of the potentially visible set of the start room can't be seen through any portal chain
+  const auto& potentiallyVisibleSet = world.getPotentiallyVisibleSet();
+  const auto startIndex = potentiallyVisibleSet.indexOf(gsl_lite::not_null{&startRoom});
+
+  std::unordered_set<const engine::world::Portal*> waterSurfacePortals;
+  auto& statistics = getStatistics();
+  const auto maxExpansions = MaxExpansionsPerRoom * potentiallyVisibleSet.getVisibleRooms(startIndex).size();
+  size_t expansions = 0;
+  for(; !queue.empty() && expansions < maxExpansions; ++expansions)
   {
-    if(const auto narrowedCullBox = narrowCullBox(roomCullBox, portal, world.getCameraController()))
+    const auto [room, inWater] = queue.front();
+    queue.pop_front();
+
+    auto& state = states.at(room);
+    state.queued[inWater] = false;
+    gsl_Assert(state.cullBoxes[inWater].has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    const auto roomCullBox = *state.cullBoxes[inWater];
+    const auto childDepth = state.depth + 1;
+
+    statistics.visitedPortals += room->portals.size();
+    for(const auto& portal : room->portals)
     {
+      if(!potentiallyVisibleSet.isVisible(startIndex, potentiallyVisibleSet.indexOf(portal.adjoiningRoom)))
+        continue;
+
+      const auto narrowedCullBox = narrowCullBox(roomCullBox, portal, world.getCameraController());
+      if(!narrowedCullBox.has_value())
+        continue;
+
       const auto& childRoom = portal.adjoiningRoom;
-      const bool waterChanged = inWater == startFromWater && childRoom->isWaterRoom != startFromWater;
-      childRoom->node->addScissor(narrowedCullBox->x, narrowedCullBox->y);
-      if(traceRoom(*childRoom,
-                   *narrowedCullBox,
-                   world,
-                   seenRooms,
-                   inWater || childRoom->isWaterRoom,
-                   waterSurfacePortals,
-                   startFromWater,
-                   depth + 1)
-         && waterChanged)
-      {
+      if(inWater == startFromWater && childRoom->isWaterRoom != startFromWater)
         waterSurfacePortals.emplace(&portal);
+
+      const bool childInWater = inWater || childRoom->isWaterRoom;
+      auto& childState = states[childRoom.get()];
+      childState.depth = std::min(childState.depth, childDepth);
+      auto& childCullBox = childState.cullBoxes[childInWater];
+      if(!childCullBox.has_value())
+      {
+        childCullBox = narrowedCullBox;
+      }
+      else
+      {
+        const CullBox merged{childCullBox->x.union_(narrowedCullBox->x), childCullBox->y.union_(narrowedCullBox->y)};
+        if(merged.x == childCullBox->x && merged.y == childCullBox->y)
+          continue;
+        childCullBox = merged;
+      }
+
+      if(!childState.queued[childInWater])
+      {
+        childState.queued[childInWater] = true;
+        queue.emplace_back(childRoom.get(), childInWater);
       }
     }
   }
-  seenRooms.pop_back();
-  return true;
-}
 
-std::unordered_set<const engine::world::Portal*> PortalTracer::trace(const engine::world::Room& startRoom,
-                                                                     const engine::world::World& world)
-{
-  std::vector<const engine::world::Room*> seenRooms;
-  seenRooms.reserve(32);
-  std::unordered_set<const engine::world::Portal*> waterSurfacePortals;
-  traceRoom(startRoom,
-            {{-1, 1}, {-1, 1}},
-            world,
-            seenRooms,
-            startRoom.isWaterRoom,
-            waterSurfacePortals,
-            startRoom.isWaterRoom,
-            1);
-  gsl_Assert(seenRooms.empty());
+  // the cull boxes may still grow, so everything the queued rooms could lead to is assumed to be seen through the whole
+  // screen; water surfaces beyond them are not detected anymore
+  for(const auto& [room, inWater] : queue)
+  {
+    const auto childDepth = states.at(room).depth + 1;
+    const auto roomIndex = potentiallyVisibleSet.indexOf(gsl_lite::not_null{room});
+    for(const auto index : potentiallyVisibleSet.getVisibleRooms(roomIndex))
+    {
+      if(!potentiallyVisibleSet.isVisible(startIndex, index))
+        continue;
+
+      const auto& childRoom = world.getRooms().at(index);
+      const auto [it, inserted] = states.try_emplace(&childRoom);
+      if(inserted)
+        ++statistics.fallbackRooms;
+      auto& childState = it->second;
+      childState.depth = std::min(childState.depth, childDepth);
+      childState.cullBoxes[inWater || childRoom.isWaterRoom] = CullBox{{-1, 1}, {-1, 1}};
+    }
+  }
+
+  statistics.expansions += expansions;
+  statistics.visitedRooms += states.size();
+
+  for(const auto& [room, state] : states)
+  {
+    room->node->setVisible(true);
+    room->node->setRenderOrder(-state.depth);
+    // the start room is always seen through the whole screen
+    if(room == &startRoom)
+      continue;
+
+    std::optional<CullBox> cullBox;
+    for(const auto& box : state.cullBoxes)
+    {
+      if(!box.has_value())
+        continue;
+
+      cullBox = !cullBox.has_value() ? *box : CullBox{cullBox->x.union_(box->x), cullBox->y.union_(box->y)};
+    }
+    gsl_Assert(cullBox.has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    room->node->addScissor(cullBox->x, cullBox->y);
+  }
+
   return waterSurfacePortals;
 }
 } // namespace render
\ No newline at end of file
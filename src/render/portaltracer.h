@@ -2,9 +2,9 @@
 
 #include "core/interval.h"
 
+#include <cstddef>
 #include <optional>
 #include <unordered_set>
-#include <vector>
 
 namespace engine
 {
@@ -35,18 +35,33 @@ struct PortalTracer
     }
   };
 
+  //! @brief What the tracer did since the last reset.
+  struct Statistics
+  {
+    //! Rooms taken from the queue, including repeated expansions of the same room.
+    size_t expansions = 0;
+    size_t visitedRooms = 0;
+    size_t visitedPortals = 0;
+    //! Rooms made visible without tracing them because the expansion budget was exhausted.
+    size_t fallbackRooms = 0;
+  };
+
+  [[nodiscard]] static Statistics& getStatistics();
+
+  /**
+   * @brief Marks all rooms visible from @a startRoom, and sets their render order and scissors.
+   *
+   * The rooms are expanded breadth-first. Every room accumulates the union of the cull boxes it is seen through, and
+   * is only expanded again if that union grows, so the cost doesn't depend on the number of portal paths to a room.
+   * The expansions per trace are limited to a multiple of the rooms potentially visible from @a startRoom; when that
+   * budget is exhausted, all rooms potentially visible from the rooms still queued are made visible through the whole
+   * screen.
+   *
+   * @returns the portals between dry and water rooms the camera is looking through
+   */
   static std::unordered_set<const engine::world::Portal*> trace(const engine::world::Room& startRoom,
                                                                 const engine::world::World& world);
 
-  static bool traceRoom(const engine::world::Room& room,
-                        const CullBox& roomCullBox,
-                        const engine::world::World& world,
-                        std::vector<const engine::world::Room*>& seenRooms,
-                        bool inWater,
-                        std::unordered_set<const engine::world::Portal*>& waterSurfacePortals,
-                        bool startFromWater,
-                        int depth);
-
   static std::optional<CullBox> narrowCullBox(const CullBox& parentCullBox,
                                               const engine::world::Portal& portal,
                                               const engine::CameraController& camera);
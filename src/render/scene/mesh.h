@@ -54,6 +54,11 @@ public:
   void render(const Node* node, RenderContext& context) final;
   void render(const Node* node, RenderContext& context, gl::api::core::SizeType instanceCount) final;
 
+  [[nodiscard]] const material::Material* getMaterial(const material::RenderMode mode) const final
+  {
+    return m_materialGroup.get(mode).get();
+  }
+
   [[nodiscard]] auto getPrimitiveType() const
   {
     return m_primitiveType;
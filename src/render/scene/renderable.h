@@ -2,9 +2,16 @@
 
 #include "translucency.h"
 
+#include <cstdint>
 #include <gl/api/soglb_core.hpp>
 #include <gl/renderstate.h>
 
+namespace render::material
+{
+class Material;
+enum class RenderMode : uint8_t;
+} // namespace render::material
+
 namespace render::scene
 {
 class RenderContext;
@@ -25,6 +32,14 @@ public:
   virtual void render(const Node* node, RenderContext& context, gl::api::core::SizeType instanceCount) = 0;
   [[nodiscard]] virtual bool empty(Translucency translucencySelector) const = 0;
 
+  /**
+   * @brief The material used when rendering in @a mode, if known up front; used to group draws by shader program.
+   */
+  [[nodiscard]] virtual const material::Material* getMaterial(material::RenderMode /*mode*/) const
+  {
+    return nullptr;
+  }
+
   gl::RenderState& getRenderState()
   {
     return m_renderState;
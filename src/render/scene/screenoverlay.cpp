@@ -85,4 +85,9 @@ bool ScreenOverlay::empty(Translucency /*translucencySelector*/) const
 {
   return false;
 }
+
+const material::Material* ScreenOverlay::getMaterial(const material::RenderMode mode) const
+{
+  return m_mesh == nullptr ? nullptr : m_mesh->getMaterial(mode);
+}
 } // namespace render::scene
\ No newline at end of file
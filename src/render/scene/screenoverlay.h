@@ -3,6 +3,7 @@
 #include "renderable.h"
 #include "translucency.h"
 
+#include <cstdint>
 #include <gl/image.h>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h>
@@ -12,8 +13,10 @@
 
 namespace render::material
 {
+class Material;
 class MaterialManager;
-}
+enum class RenderMode : uint8_t;
+} // namespace render::material
 
 namespace render::scene
 {
@@ -38,6 +41,7 @@ public:
   void render(const Node* node, RenderContext& context) override;
   void render(const Node* node, RenderContext& context, gl::api::core::SizeType instanceCount) override;
   [[nodiscard]] bool empty(Translucency translucencySelector) const override;
+  [[nodiscard]] const material::Material* getMaterial(material::RenderMode mode) const override;
 
   [[nodiscard]] const auto& getImage() const
   {
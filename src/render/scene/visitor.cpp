@@ -1,20 +1,34 @@
 #include "visitor.h"
 
 #include "node.h"
+#include "render/material/material.h"
 #include "renderable.h"
 #include "rendercontext.h"
+#include "translucency.h"
+#include "util/profiler.h"
+#include "util/radixsort.h"
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <gl/debuggroup.h>
 #include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
 #include <gsl-lite/gsl-lite.hpp>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <utility>
 
 namespace render::scene
 {
+RenderStatistics& getRenderStatistics()
+{
+  static RenderStatistics statistics;
+  return statistics;
+}
+
 void Visitor::visit(const Node& node)
 {
   if(!node.isVisible())
@@ -34,39 +48,104 @@ void Visitor::visit(const Node& node)
 
 void Visitor::add(const gsl_lite::not_null<const Node*>& node)
 {
-  if(node->getRenderable() != nullptr)
-    m_nodes.emplace_back(node, m_context->getCurrentState());
+  const auto& renderable = node->getRenderable();
+  if(renderable == nullptr || renderable->empty(m_context->getTranslucencySelector()))
+    return;
+
+  if(m_states.empty() || m_states.back() != m_context->getCurrentState())
+    m_states.emplace_back(m_context->getCurrentState());
+
+  uint16_t program = NoProgram;
+  if(const auto material = renderable->getMaterial(m_context->getRenderMode()); material != nullptr)
+  {
+    const auto it = std::ranges::find(m_programs, material->getShaderProgram().get());
+    if(it != m_programs.end())
+      program = gsl_lite::narrow_cast<uint16_t>(std::distance(m_programs.begin(), it));
+    else if(m_programs.size() < NoProgram)
+    {
+      program = gsl_lite::narrow_cast<uint16_t>(m_programs.size());
+      m_programs.emplace_back(material->getShaderProgram().get());
+    }
+  }
+
+  m_nodes.emplace_back(RenderableInfo{0, node, gsl_lite::narrow_cast<uint32_t>(m_states.size() - 1), program});
+}
+
+uint64_t Visitor::getSortKey(const RenderableInfo& info, const glm::vec3& camera) const
+{
+  // key layout, from the most significant bits: 16 bits render order, then 24 bits depth bucket and 16 bits program
+  // index, with the program taking precedence over the depth in the opaque pass
+  static constexpr uint64_t DepthBits = 24;
+  static constexpr uint64_t ProgramBits = 16;
+  static constexpr uint64_t DepthMask = (uint64_t{1} << DepthBits) - 1;
+
+  const auto order = static_cast<uint64_t>(
+    std::clamp(info.node->getRenderOrder() - std::numeric_limits<int16_t>::min(), 0, int{UINT16_MAX}));
+
+  // the bits of a non-negative float are ordered like its value; dropping the lowest mantissa bits makes buckets with
+  // a relative size of 2^-16
+  const auto distance = glm::distance(info.node->getTranslationWorld(), camera);
+  uint64_t depth = std::bit_cast<uint32_t>(std::max(distance, 0.0f)) >> (32 - 1 - DepthBits);
+  if(!m_backToFront)
+    depth = DepthMask - depth;
+
+  if(m_context->getTranslucencySelector() == Translucency::Opaque)
+    return (order << (ProgramBits + DepthBits)) | (uint64_t{info.program} << DepthBits) | depth;
+  else
+    return (order << (ProgramBits + DepthBits)) | (depth << ProgramBits) | info.program;
 }
 
 void Visitor::render(const std::optional<glm::vec3>& camera) const
 {
   if(camera.has_value())
   {
-    // logic: first order by render order, then order by distance to camera back-to-front
-    std::ranges::sort(m_nodes,
-                      [this, camera](const RenderableInfo& a, const RenderableInfo& b)
-                      {
-                        if(auto aOrder = std::get<0>(a)->getRenderOrder(), bOrder = std::get<0>(b)->getRenderOrder();
-                           aOrder != bOrder)
-                        {
-                          return aOrder < bOrder;
-                        }
-
-                        const auto da = glm::distance(std::get<0>(a)->getTranslationWorld(), *camera);
-                        const auto db = glm::distance(std::get<0>(b)->getTranslationWorld(), *camera);
-                        return m_backToFront ? db > da : da > db;
-                      });
+    for(auto& info : m_nodes)
+      info.key = getSortKey(info, *camera);
+    util::radixSort(m_nodes,
+                    m_sortScratch,
+                    [](const RenderableInfo& info)
+                    {
+                      return info.key;
+                    });
   }
 
-  for(const auto& [node, state] : m_nodes)
+  RenderStatistics statistics{};
+  std::optional<uint32_t> boundState;
+  uint16_t boundProgram = NoProgram;
+  for(const auto& info : m_nodes)
   {
-    if(node->getRenderable()->empty(m_context->getTranslucencySelector()))
-      continue;
+    SOGLB_DEBUGGROUP(info.node->getName());
+
+    // only re-merge the captured state if it differs from the previous one; the render state itself only touches what
+    // changed when being applied
+    if(!boundState.has_value() || (*boundState != info.state && m_states[*boundState] != m_states[info.state]))
+    {
+      if(boundState.has_value())
+        m_context->popState();
+      m_context->pushState(m_states[info.state]);
+      boundState = info.state;
+      ++statistics.stateChanges;
+    }
 
-    SOGLB_DEBUGGROUP(node->getName());
-    m_context->pushState(state);
-    node->getRenderable()->render(node.get(), *m_context);
+    if(info.program != NoProgram && info.program != boundProgram)
+    {
+      boundProgram = info.program;
+      ++statistics.programChanges;
+    }
+
+    info.node->getRenderable()->render(info.node.get(), *m_context);
+    ++statistics.drawCalls;
+  }
+
+  if(boundState.has_value())
     m_context->popState();
+
+  if constexpr(util::profiler::Enabled)
+  {
+    auto& total = getRenderStatistics();
+    total.drawCalls += statistics.drawCalls;
+    total.stateChanges += statistics.stateChanges;
+    total.programChanges += statistics.programChanges;
   }
 }
 
@@ -1,17 +1,34 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <gl/renderstate.h>
 #include <glm/vec3.hpp>
 #include <gsl-lite/gsl-lite.hpp>
 #include <optional>
-#include <tuple>
 #include <vector>
 
+namespace render::material
+{
+class ShaderProgram;
+}
+
 namespace render::scene
 {
 class RenderContext;
 class Node;
 
+//! @brief What the visitors submitted since the last reset; only counted if profiling is enabled.
+struct RenderStatistics
+{
+  size_t drawCalls = 0;
+  size_t stateChanges = 0;
+  //! How often consecutive draws use different shader programs; the materials still bind their program on each draw.
+  size_t programChanges = 0;
+};
+
+[[nodiscard]] extern RenderStatistics& getRenderStatistics();
+
 class Visitor final
 {
 public:
@@ -46,13 +63,37 @@ public:
 
   void add(const gsl_lite::not_null<const Node*>& node);
 
+  /**
+   * @brief Draws everything added so far.
+   *
+   * If a @a camera is given, the draws are ordered by their render order first, then by their distance to the camera,
+   * and within the opaque pass by their shader program before the distance. Without a camera, the draws are issued in
+   * the order they were added.
+   */
   void render(const std::optional<glm::vec3>& camera) const;
 
 private:
+  struct RenderableInfo
+  {
+    uint64_t key;
+    gsl_lite::not_null<const Node*> node;
+    //! @brief Index into m_states.
+    uint32_t state;
+    //! @brief Index into m_programs, or NoProgram.
+    uint16_t program;
+  };
+
+  static constexpr uint16_t NoProgram = UINT16_MAX;
+
+  [[nodiscard]] uint64_t getSortKey(const RenderableInfo& info, const glm::vec3& camera) const;
+
   gsl_lite::not_null<RenderContext*> m_context;
   bool m_withScissors;
   bool m_backToFront;
-  using RenderableInfo = std::tuple<gsl_lite::not_null<const Node*>, gl::RenderState>;
   mutable std::vector<RenderableInfo> m_nodes;
+  mutable std::vector<RenderableInfo> m_sortScratch;
+  //! @brief The states captured when adding the nodes; siblings share their state.
+  std::vector<gl::RenderState> m_states;
+  std::vector<const material::ShaderProgram*> m_programs;
 };
-} // namespace render::scene
\ No newline at end of file
+} // namespace render::scene
@@ -4,62 +4,80 @@
 #include "loader/file/datatypes.h"
 #include "loader/file/texture.h"
 
-#include <array>
 #include <boost/assert.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <gl/buffer.h>
-#include <gl/vertexbuffer.h>
+#include <glm/vec4.hpp>
 #include <gsl-lite/gsl-lite.hpp>
-#include <utility>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace render
 {
-TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
+TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data, const std::vector<engine::world::AtlasTile>& tiles)
 {
   gsl_Expects(!data.empty());
 
+  std::vector<AnimatedTile> animatedTiles;
   const uint16_t* ptr = data.data();
   const auto sequenceCount = *ptr++;
+  m_sequences.reserve(sequenceCount);
   for(size_t i = 0; i < sequenceCount; ++i)
   {
-    Sequence sequence;
     const auto n = *ptr++;
-    sequence.tileIds.reserve(n + 1);
+    m_sequences.emplace_back(gsl_lite::narrow<glm::int32>(animatedTiles.size()), n + 1, 0, 0);
     for(size_t j = 0; j <= n; ++j)
     {
       gsl_Assert(ptr <= &data.back());
-      const auto tileId = *ptr++;
-      sequence.tileIds.emplace_back(tileId);
-      m_sequenceByTileId.emplace(tileId, m_sequences.size());
+      const core::TextureTileId tileId{*ptr++};
+      // tiles used by multiple sequences or multiple times in a sequence are animated by their first occurrence
+      m_tileReferences.emplace(tileId, TileReference{i, j});
+
+      const auto& tile = tiles.at(tileId.get());
+      animatedTiles.emplace_back(AnimatedTile{
+        glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
+        glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]},
+        glm::vec4{static_cast<float>(tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask), 0, 0, 0},
+      });
     }
-    m_sequences.emplace_back(std::move(sequence));
   }
 
   BOOST_ASSERT(ptr <= &data.back() + 1);
+
+  m_tilesBuffer = std::make_unique<gl::ShaderStorageBuffer<AnimatedTile>>(
+    "animated-tiles-ssb", gl::api::BufferUsage::StaticDraw, animatedTiles);
+  m_sequencesBuffer = std::make_unique<gl::ShaderStorageBuffer<glm::ivec4>>(
+    "texture-sequences-ssb", gl::api::BufferUsage::DynamicDraw, m_sequences);
 }
 
-void TextureAnimator::Sequence::updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer,
-                                                  const std::vector<engine::world::AtlasTile>& tiles)
+TextureAnimator::~TextureAnimator() = default;
+
+std::optional<AnimatedUV> TextureAnimator::tryGetAnimatedUV(const core::TextureTileId& tileId, const int corner) const
 {
-  BOOST_ASSERT(!tileIds.empty());
+  gsl_Expects(corner >= 0 && corner < 4);
 
-  auto uvArray
-    = buffer.map(gl::api::MapBufferAccessMask::MapWriteBit | gl::api::MapBufferAccessMask::MapFlushExplicitBit);
+  const auto it = m_tileReferences.find(tileId);
+  if(it == m_tileReferences.end())
+    return std::nullopt;
 
-  for(const VertexReference& vref : affectedVertices)
-  {
-    BOOST_ASSERT(buffer.size() > 0 && vref.getBufferIndex() < static_cast<size_t>(buffer.size()));
-    BOOST_ASSERT(vref.queueOffset < tileIds.size());
-    const engine::world::AtlasTile& tile = tiles[tileIds[vref.queueOffset].get()];
+  AnimatedUV result{};
+  result.uv = glm::vec3{corner, it->second.offset, -2 - gsl_lite::narrow<glm::int32>(it->second.sequence)};
+  return result;
+}
+
+void TextureAnimator::step()
+{
+  if(m_sequences.empty())
+    return;
 
-    uvArray[vref.getBufferIndex()].uv = glm::vec3{tile.uvCoordinates[vref.getSourceIndex()],
-                                                  tile.textureKey.atlasIdAndFlag & loader::file::AtlasIdMask};
-    uvArray[vref.getBufferIndex()].quadUv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
-    uvArray[vref.getBufferIndex()].quadUv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+  for(auto& sequence : m_sequences)
+  {
+    if(++sequence.z >= sequence.y)
+      sequence.z = 0;
   }
 
-  uvArray.flush();
+  m_sequencesBuffer->setSubData(m_sequences, 0);
 }
-} // namespace render
\ No newline at end of file
+} // namespace render
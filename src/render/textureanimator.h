@@ -2,8 +2,6 @@
 
 #include "core/id.h"
 
-#include <algorithm>
-#include <boost/assert.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <gl/soglb_fwd.h>
@@ -11,10 +9,9 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
-#include <gsl-lite/gsl-lite.hpp>
-#include <iterator>
 #include <map>
-#include <set>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace engine::world
@@ -40,91 +37,57 @@ struct AnimatedUV
   }
 };
 
+//! @see texture_animation.glsl
+struct AnimatedTile
+{
+  glm::vec4 uv12;
+  glm::vec4 uv34;
+  //! only x is used, holding the atlas layer
+  glm::vec4 layer;
+};
+
+/**
+ * @brief Animates texture tiles through an indirection table on the GPU.
+ *
+ * Vertices using a tile of an animation sequence don't hold the tile's coordinates, but a reference to their
+ * sequence and their offset within it. The tiles of all sequences are uploaded once, and an animation step only
+ * uploads the rotation of each sequence, so its cost doesn't depend on the amount of animated geometry.
+ */
 class TextureAnimator
 {
 public:
-  explicit TextureAnimator(const std::vector<uint16_t>& data);
+  explicit TextureAnimator(const std::vector<uint16_t>& data, const std::vector<engine::world::AtlasTile>& tiles);
+  ~TextureAnimator();
 
-  void registerVertex(const core::TextureTileId& tileId, const int sourceIndex, const size_t bufferIndex)
-  {
-    const auto it = m_sequenceByTileId.find(tileId);
-    if(it == m_sequenceByTileId.end())
-      return;
+  /**
+   * @brief Returns the texture coordinates of the given tile corner which reference the tile's sequence, or
+   * std::nullopt if the tile isn't animated.
+   */
+  [[nodiscard]] std::optional<AnimatedUV> tryGetAnimatedUV(const core::TextureTileId& tileId, int corner) const;
 
-    m_sequences.at(it->second).registerVertex(Sequence::VertexReference(bufferIndex, sourceIndex), tileId);
+  void step();
+
+  [[nodiscard]] const auto& getTilesBuffer() const noexcept
+  {
+    return *m_tilesBuffer;
   }
 
-  void updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer, const std::vector<engine::world::AtlasTile>& tiles)
+  [[nodiscard]] const auto& getSequencesBuffer() const noexcept
   {
-    for(Sequence& sequence : m_sequences)
-    {
-      sequence.rotate();
-      sequence.updateCoordinates(buffer, tiles);
-    }
+    return *m_sequencesBuffer;
   }
 
 private:
-  struct Sequence
+  struct TileReference
   {
-    class VertexReference
-    {
-    public:
-      size_t queueOffset = 0;
-
-      VertexReference(const size_t bufferIdx, const int sourceIdx)
-          : m_bufferIndex{bufferIdx}
-          , m_sourceIndex{sourceIdx}
-      {
-        gsl_Expects(sourceIdx >= 0 && sourceIdx < 4);
-      }
-
-      bool operator<(const VertexReference& rhs) const noexcept
-      {
-        return m_bufferIndex < rhs.m_bufferIndex;
-      }
-
-      bool operator==(const VertexReference& rhs) const noexcept
-      {
-        return m_bufferIndex == rhs.m_bufferIndex;
-      }
-
-      [[nodiscard]] auto getBufferIndex() const
-      {
-        return m_bufferIndex;
-      }
-
-      [[nodiscard]] auto getSourceIndex() const
-      {
-        return m_sourceIndex;
-      }
-
-    private:
-      //! Vertex buffer index
-      size_t m_bufferIndex;
-      int m_sourceIndex;
-    };
-
-    std::vector<core::TextureTileId> tileIds;
-    std::set<VertexReference> affectedVertices;
-
-    void rotate()
-    {
-      BOOST_ASSERT(!tileIds.empty());
-      std::ranges::rotate(tileIds, std::next(tileIds.begin()));
-    }
-
-    void registerVertex(VertexReference vertex, const core::TextureTileId& tileId)
-    {
-      const auto it = std::ranges::find(tileIds, tileId);
-      gsl_Assert(it != tileIds.end());
-      vertex.queueOffset = std::distance(tileIds.begin(), it);
-      affectedVertices.insert(vertex);
-    }
-
-    void updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer, const std::vector<engine::world::AtlasTile>& tiles);
+    size_t sequence;
+    size_t offset;
   };
 
-  std::vector<Sequence> m_sequences;
-  std::map<core::TextureTileId, size_t> m_sequenceByTileId;
+  //! x: index of the first tile, y: tile count, z: rotation
+  std::vector<glm::ivec4> m_sequences;
+  std::map<core::TextureTileId, TileReference> m_tileReferences;
+  std::unique_ptr<gl::ShaderStorageBuffer<AnimatedTile>> m_tilesBuffer;
+  std::unique_ptr<gl::ShaderStorageBuffer<glm::ivec4>> m_sequencesBuffer;
 };
-} // namespace render
\ No newline at end of file
+} // namespace render
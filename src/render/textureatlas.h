@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/threadpool.h"
+
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
@@ -180,6 +182,8 @@ public:
       : m_layout{0, 0, pageSize, pageSize}
       , m_image{onlyLayout ? nullptr : std::make_shared<gl::CImgWrapper>(pageSize)}
   {
+    if(m_image != nullptr)
+      m_image->interleave();
   }
 
   ~TextureAtlas() = default;
@@ -190,27 +194,20 @@ public:
   {
   }
 
-  std::optional<glm::ivec2> put(gl::CImgWrapper& img)
+  std::optional<glm::ivec2> put(const glm::ivec2& size)
   {
-    gsl_Assert(m_image != nullptr);
-    const auto dstArea = m_layout.tryInsert(img.width(), img.height());
-    if(!dstArea.has_value())
-      return std::nullopt;
-
-    for(int y = 0; y < img.height(); ++y)
-    {
-      for(int x = 0; x < img.width(); ++x)
-      {
-        (*m_image)(x + dstArea->x, y + dstArea->y) = img(x, y);
-      }
-    }
-    return dstArea;
+    return m_layout.tryInsert(size.x, size.y);
   }
 
-  std::optional<glm::ivec2> put(const glm::ivec2& size)
+  /**
+   * @brief Copies an interleaved image into the atlas.
+   *
+   * Copies into areas returned by put() don't overlap, so they may be done concurrently.
+   */
+  void blit(const glm::ivec2& position, const gl::CImgWrapper& img) const
   {
-    gsl_Assert(m_image == nullptr);
-    return m_layout.tryInsert(size.x, size.y);
+    gsl_Assert(m_image != nullptr);
+    m_image->replace(position.x, position.y, img);
   }
 
   [[nodiscard]] std::shared_ptr<gl::CImgWrapper> takeImage()
@@ -220,12 +217,39 @@ public:
   }
 };
 
+/**
+ * @brief Packs images into as many atlas pages as needed.
+ *
+ * The packing is done immediately, so that the resulting positions only depend on the order of the put() calls.
+ * Copying the images into the pages is deferred until the pages are taken, where it is done in parallel.
+ */
 class MultiTextureAtlas final
 {
+  struct PendingBlit
+  {
+    size_t page;
+    glm::ivec2 position;
+    gl::CImgWrapper image;
+  };
+
   std::vector<TextureAtlas> m_atlases;
+  std::vector<PendingBlit> m_pendingBlits;
   int32_t m_pageSize;
   bool m_onlyLayout;
 
+  std::pair<size_t, glm::ivec2> layout(const glm::ivec2& size)
+  {
+    for(size_t i = 0; i < m_atlases.size(); ++i)
+      if(const auto position = m_atlases[i].put(size + 2 * glm::ivec2{BoundaryMargin, BoundaryMargin}))
+        return {i, *position};
+
+    m_atlases.emplace_back(m_pageSize, m_onlyLayout);
+    const auto position = m_atlases.back().put(size + 2 * glm::ivec2{BoundaryMargin, BoundaryMargin});
+    gsl_Assert(position.has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    return {m_atlases.size() - 1, *position};
+  }
+
 public:
   static constexpr int BoundaryMargin = 16;
 
@@ -242,42 +266,35 @@ public:
     return m_pageSize;
   }
 
-  std::pair<size_t, glm::ivec2> put(const gl::CImgWrapper& img)
+  std::pair<size_t, glm::ivec2> put(gl::CImgWrapper img)
   {
     gsl_Assert(!m_onlyLayout);
-    auto extended = img;
-    extended.extendBorder(BoundaryMargin);
-
-    for(size_t i = 0; i < m_atlases.size(); ++i)
-      if(const auto position = m_atlases[i].put(extended))
-        return {i, *position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
-
-    m_atlases.emplace_back(m_pageSize, m_onlyLayout);
-    const auto position = m_atlases.back().put(extended);
-    gsl_Assert(position.has_value());
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    return {m_atlases.size() - 1, *position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
+    const auto [page, position] = layout({img.width(), img.height()});
+    m_pendingBlits.emplace_back(PendingBlit{page, position, std::move(img)});
+    return {page, position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
   }
 
   std::pair<size_t, glm::ivec2> put(const glm::ivec2& size)
   {
     gsl_Assert(m_onlyLayout);
-
-    for(size_t i = 0; i < m_atlases.size(); ++i)
-      if(const auto position = m_atlases[i].put(size + 2 * glm::ivec2{BoundaryMargin, BoundaryMargin}))
-        return {i, *position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
-
-    m_atlases.emplace_back(m_pageSize, m_onlyLayout);
-    const auto position = m_atlases.back().put(size + 2 * glm::ivec2{BoundaryMargin, BoundaryMargin});
-    gsl_Assert(position.has_value());
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    return {m_atlases.size() - 1, *position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
+    const auto [page, position] = layout(size);
+    return {page, position + glm::ivec2{BoundaryMargin, BoundaryMargin}};
   }
 
   std::vector<std::shared_ptr<gl::CImgWrapper>> takeImages()
   {
     gsl_Assert(!m_onlyLayout);
 
+    util::ThreadPool::getShared().parallelFor(m_pendingBlits.size(),
+                                              [this](const size_t i)
+                                              {
+                                                auto& blit = m_pendingBlits[i];
+                                                blit.image.extendBorder(BoundaryMargin);
+                                                blit.image.interleave();
+                                                m_atlases[blit.page].blit(blit.position, blit.image);
+                                              });
+    m_pendingBlits.clear();
+
     std::vector<std::shared_ptr<gl::CImgWrapper>> result;
     result.reserve(m_atlases.size());
     std::ranges::transform(m_atlases,
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "access.h" // IWYU pragma: keep
+#include "serialization.h"
+#include "yamldocument.h"
+
+#include <algorithm>
+#include <array>
+#include <boost/log/trivial.hpp>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
+#include <ryml.hpp>
+#include <string>
+#include <utility>
+
+namespace serialization
+{
+namespace detail
+{
+constexpr std::array<char, 4> BinaryDocumentMagic{'C', 'E', 'S', 'B'};
+constexpr uint32_t BinaryDocumentVersion = 1;
+//! Nodes are decoded recursively, so corrupt files must not be able to nest them arbitrarily deep.
+constexpr size_t BinaryDocumentMaxDepth = 256;
+} // namespace detail
+
+/**
+ * @brief Stores the same node tree as a YAMLDocument in a compact binary encoding.
+ *
+ * All serializers work on the rapidyaml tree, so they behave exactly as with YAML. Only the conversion between the
+ * tree and the file differs: the tree is written as varint-length-prefixed strings, and on loading, the nodes reference
+ * the file buffer directly instead of being parsed.
+ */
+template<bool Loading>
+class BinaryDocument
+{
+  enum NodeFlags : uint8_t
+  {
+    IsMap = 1u << 0u,
+    IsSeq = 1u << 1u,
+    HasKey = 1u << 2u,
+    HasVal = 1u << 3u,
+    HasKeyTag = 1u << 4u,
+    HasValTag = 1u << 5u,
+    NullKey = 1u << 6u,
+    NullVal = 1u << 7u,
+  };
+
+  std::filesystem::path m_filename;
+  std::string m_buffer;
+  size_t m_position = 0;
+  ryml::Tree m_tree;
+
+  template<typename T>
+  static void put(std::string& buffer, const T& value)
+  {
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(&buffer[offset], &value, sizeof(T));
+  }
+
+  static void putVarint(std::string& buffer, size_t value)
+  {
+    while(value >= 0x80u)
+    {
+      buffer.push_back(static_cast<char>((value & 0x7fu) | 0x80u));
+      value >>= 7u;
+    }
+    buffer.push_back(static_cast<char>(value));
+  }
+
+  static void putString(std::string& buffer, const c4::csubstr& str)
+  {
+    putVarint(buffer, str.size());
+    buffer.append(str.data(), str.size());
+  }
+
+  static void encodeNode(std::string& buffer, const ryml::ConstNodeRef& node)
+  {
+    uint8_t flags = 0;
+    if(node.is_map())
+      flags |= IsMap;
+    else if(node.is_seq())
+      flags |= IsSeq;
+    if(node.has_key())
+    {
+      flags |= HasKey;
+      if(node.key().str == nullptr)
+        flags |= NullKey;
+    }
+    if(node.has_val())
+    {
+      flags |= HasVal;
+      if(node.val().str == nullptr)
+        flags |= NullVal;
+    }
+    if(node.has_key_tag())
+      flags |= HasKeyTag;
+    if(node.has_val_tag())
+      flags |= HasValTag;
+    put(buffer, flags);
+
+    if(node.has_key())
+      putString(buffer, node.key());
+    if(node.has_key_tag())
+      putString(buffer, node.key_tag());
+    if(node.has_val())
+      putString(buffer, node.val());
+    if(node.has_val_tag())
+      putString(buffer, node.val_tag());
+
+    if((flags & (IsMap | IsSeq)) == 0)
+      return;
+
+    putVarint(buffer, node.num_children());
+    for(const auto child : node.children())
+      encodeNode(buffer, child);
+  }
+
+  template<typename T>
+  T get()
+  {
+    if(m_buffer.size() - m_position < sizeof(T))
+      SERIALIZER_EXCEPTION("Unexpected end of binary document " + m_filename.string());
+
+    T value{};
+    std::memcpy(&value, &m_buffer[m_position], sizeof(T));
+    m_position += sizeof(T);
+    return value;
+  }
+
+  size_t getVarint()
+  {
+    size_t value = 0;
+    for(size_t shift = 0; shift < 64; shift += 7)
+    {
+      const auto byte = get<uint8_t>();
+      value |= static_cast<size_t>(byte & 0x7fu) << shift;
+      if((byte & 0x80u) == 0)
+        return value;
+    }
+    SERIALIZER_EXCEPTION("Invalid length in binary document " + m_filename.string());
+  }
+
+  c4::csubstr getString(const bool isNull)
+  {
+    const auto size = getVarint();
+    if(m_buffer.size() - m_position < size)
+      SERIALIZER_EXCEPTION("Unexpected end of binary document " + m_filename.string());
+
+    const auto str = isNull ? c4::csubstr{} : c4::csubstr{&m_buffer[m_position], size};
+    m_position += size;
+    return str;
+  }
+
+  void decodeNode(ryml::NodeRef node, const size_t depth)
+  {
+    if(depth > detail::BinaryDocumentMaxDepth)
+      SERIALIZER_EXCEPTION("Nodes nested too deeply in binary document " + m_filename.string());
+
+    const auto flags = get<uint8_t>();
+    if((flags & HasKey) != 0)
+      node.set_key(getString((flags & NullKey) != 0));
+    if((flags & HasKeyTag) != 0)
+      node.set_key_tag(getString(false));
+
+    if((flags & IsMap) != 0)
+      node |= ryml::MAP;
+    else if((flags & IsSeq) != 0)
+      node |= ryml::SEQ;
+
+    if((flags & HasVal) != 0)
+      node.set_val(getString((flags & NullVal) != 0));
+    if((flags & HasValTag) != 0)
+      node.set_val_tag(getString(false));
+
+    if((flags & (IsMap | IsSeq)) == 0)
+      return;
+
+    const auto childCount = getVarint();
+    for(size_t i = 0; i < childCount; ++i)
+      decodeNode(node.append_child(), depth + 1);
+  }
+
+  void decode()
+  {
+    detail::CustomErrorCallbacks callbacks{};
+
+    if(get<std::array<char, 4>>() != detail::BinaryDocumentMagic)
+      SERIALIZER_EXCEPTION("Not a binary document: " + m_filename.string());
+    if(const auto version = get<uint32_t>(); version != detail::BinaryDocumentVersion)
+      SERIALIZER_EXCEPTION("Unsupported binary document version " + std::to_string(version));
+
+    // every node takes at least one byte, which bounds the reservation for corrupt files
+    m_tree.reserve(std::min<size_t>(get<uint32_t>(), m_buffer.size()));
+    decodeNode(m_tree.rootref(), 0);
+    if(m_position != m_buffer.size())
+      SERIALIZER_EXCEPTION("Trailing data in binary document " + m_filename.string());
+  }
+
+public:
+  explicit BinaryDocument(const std::filesystem::path& filename)
+      : m_filename{filename}
+  {
+    BOOST_LOG_TRIVIAL(info) << "Opening " << filename << ", Loading=" << Loading;
+    if constexpr(Loading)
+    {
+      std::ifstream file{filename, std::ios::in | std::ios::binary};
+      gsl_Assert(file.is_open());
+      file.seekg(0, std::ios::end);
+      const auto size = static_cast<std::streamsize>(file.tellg());
+      file.seekg(0, std::ios::beg);
+
+      m_buffer.resize(size);
+      file.read(m_buffer.data(), size);
+      decode();
+    }
+    else
+    {
+      std::ofstream file{filename, std::ios::out | std::ios::trunc};
+      gsl_Assert(file.is_open());
+      m_tree.rootref() |= ryml::MAP;
+    }
+  }
+
+  /**
+   * @brief Creates a document which is only kept in memory, to be retrieved using encode().
+   */
+  explicit BinaryDocument() requires(!Loading)
+  {
+    m_tree.rootref() |= ryml::MAP;
+  }
+
+  explicit BinaryDocument(std::string data) requires(Loading)
+      : m_buffer{std::move(data)}
+  {
+    decode();
+  }
+
+  // the tree references the buffer, which must not move
+  BinaryDocument(const BinaryDocument&) = delete;
+  BinaryDocument(BinaryDocument&&) = delete;
+  BinaryDocument& operator=(const BinaryDocument&) = delete;
+  BinaryDocument& operator=(BinaryDocument&&) = delete;
+
+  template<typename T, typename TContext>
+  void deserialize(const std::string& key, const gsl_lite::not_null<TContext*>& context, T& data) requires(Loading)
+  {
+    const std::string oldLocale = gsl_lite::not_null{setlocale(LC_NUMERIC, nullptr)}.get();
+    setlocale(LC_NUMERIC, "C");
+
+    detail::CustomErrorCallbacks callbacks{};
+
+    Deserializer<TContext> ser{m_tree.rootref()[c4::to_csubstr(key)], context, nullptr};
+    access::dispatchDeserialize(data, ser);
+    ser.processQueues();
+
+    setlocale(LC_NUMERIC, oldLocale.c_str());
+  }
+
+  template<typename T, typename TContext>
+  void serialize(const std::string& key, const gsl_lite::not_null<TContext*>& context, T& data) requires(!Loading)
+  {
+    const std::string oldLocale = gsl_lite::not_null{setlocale(LC_NUMERIC, nullptr)}.get();
+    setlocale(LC_NUMERIC, "C");
+
+    detail::CustomErrorCallbacks callbacks{};
+
+    Serializer<TContext> ser{m_tree.rootref()[m_tree.copy_to_arena(c4::to_csubstr(key))], context, nullptr};
+    access::dispatchSerialize(data, ser);
+    ser.processQueues();
+
+    setlocale(LC_NUMERIC, oldLocale.c_str());
+  }
+
+  [[nodiscard]] std::string encode() const requires(!Loading)
+  {
+    std::string buffer;
+    buffer.append(detail::BinaryDocumentMagic.data(), detail::BinaryDocumentMagic.size());
+    put(buffer, detail::BinaryDocumentVersion);
+    put(buffer, gsl_lite::narrow<uint32_t>(m_tree.size()));
+    encodeNode(buffer, m_tree.crootref());
+    return buffer;
+  }
+
+  void write() const requires(!Loading)
+  {
+    gsl_Expects(!m_filename.empty());
+    const auto buffer = encode();
+    std::ofstream file{m_filename, std::ios::out | std::ios::trunc | std::ios::binary};
+    gsl_Assert(file.is_open());
+    file.write(buffer.data(), gsl_lite::narrow<std::streamsize>(buffer.size()));
+  }
+
+  /**
+   * @brief Writes the tree as YAML, e.g. for attaching a binary savegame to a bug report in readable form.
+   */
+  void writeYAML(const std::filesystem::path& filename) const requires(Loading)
+  {
+    std::ofstream file{filename, std::ios::out | std::ios::trunc};
+    gsl_Assert(file.is_open());
+    file << m_tree.crootref();
+  }
+
+  ryml::NodeRef getRoot() requires(Loading)
+  {
+    return m_tree.rootref();
+  }
+};
+
+[[nodiscard]] inline bool isBinaryDocument(const std::filesystem::path& filename)
+{
+  std::ifstream file{filename, std::ios::in | std::ios::binary};
+  std::array<char, 4> magic{};
+  return file.read(magic.data(), magic.size()) && magic == detail::BinaryDocumentMagic;
+}
+
+/**
+ * @brief Opens @a filename as a BinaryDocument or YAMLDocument, depending on its contents, and calls @a f with it.
+ */
+template<typename F>
+decltype(auto) withLoadingDocument(const std::filesystem::path& filename, F&& f)
+{
+  if(isBinaryDocument(filename))
+  {
+    BinaryDocument<true> doc{filename};
+    return std::forward<F>(f)(doc);
+  }
+
+  YAMLDocument<true> doc{filename};
+  return std::forward<F>(f)(doc);
+}
+} // namespace serialization
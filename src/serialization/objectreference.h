@@ -41,14 +41,11 @@ struct ObjectReference final
     }
 
     ser.tag("objectref");
-    for(const auto& [objId, obj] : ser.context->getObjectManager().getObjects())
+    if(const auto objId = ser.context->getObjectManager().findId(ptr.get().get()); objId.has_value())
     {
-      if(obj.get() == ptr.get())
-      {
-        engine::ObjectId tmp = objId;
-        ser(S_NV("id", tmp));
-        return;
-      }
+      engine::ObjectId tmp = *objId;
+      ser(S_NV("id", tmp));
+      return;
     }
 
     // this may happen if the object was killed, thus rendering this reference invalid
@@ -57,6 +57,8 @@ struct TypeId
 
 template<bool>
 class YAMLDocument;
+template<bool>
+class BinaryDocument;
 
 template<typename T>
 struct Default;
@@ -78,6 +80,8 @@ public:
 private:
   template<bool>
   friend class YAMLDocument;
+  template<bool>
+  friend class BinaryDocument;
 
   using LazyWithContext = std::function<void()>;
   using LazyQueue = std::queue<LazyWithContext>;
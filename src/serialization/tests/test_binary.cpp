@@ -0,0 +1,200 @@
+#include "serialization/binarydocument.h"
+#include "serialization/map.h"
+#include "serialization/optional.h"
+#include "serialization/serialization.h"
+#include "serialization/vector.h"
+#include "serialization/yamldocument.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gsl-lite/gsl-lite.hpp>
+#include <ios>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace serialization::tests
+{
+struct BinaryContext
+{
+};
+
+struct BinaryConfig
+{
+  std::string name;
+  std::string empty;
+  int32_t count = 0;
+  float ratio = 0;
+  bool enabled = false;
+  std::vector<int> values;
+  std::map<std::string, std::vector<std::string>> groups;
+  std::optional<int> missing;
+  std::optional<int> present;
+
+  void serialize(const Serializer<BinaryContext>& ser) const
+  {
+    ser(S_NV("name", name),
+        S_NV("empty", empty),
+        S_NV("count", count),
+        S_NV("ratio", ratio),
+        S_NV("enabled", enabled),
+        S_NV("values", values),
+        S_NV("groups", groups),
+        S_NV("missing", missing),
+        S_NV("present", present));
+  }
+
+  void deserialize(const Deserializer<BinaryContext>& ser)
+  {
+    ser(S_NV("name", name),
+        S_NV("empty", empty),
+        S_NV("count", count),
+        S_NV("ratio", ratio),
+        S_NV("enabled", enabled),
+        S_NV("values", values),
+        S_NV("groups", groups),
+        S_NV("missing", missing),
+        S_NV("present", present));
+  }
+};
+
+namespace
+{
+std::filesystem::path makeTempPath(const std::string& name)
+{
+  return std::filesystem::temp_directory_path() / ("croftengine-test-" + name);
+}
+
+BinaryConfig makeConfig()
+{
+  return BinaryConfig{.name = "lara",
+                      .empty = "",
+                      .count = -42,
+                      .ratio = 0.25f,
+                      .enabled = true,
+                      .values = {1, 2, 3},
+                      .groups = {{"a", {"x", "y"}}, {"b", {}}},
+                      .missing = std::nullopt,
+                      .present = 7};
+}
+
+void checkEqual(const BinaryConfig& result, const BinaryConfig& expected)
+{
+  BOOST_CHECK_EQUAL(result.name, expected.name);
+  BOOST_CHECK_EQUAL(result.empty, expected.empty);
+  BOOST_CHECK_EQUAL(result.count, expected.count);
+  BOOST_CHECK_EQUAL(result.ratio, expected.ratio);
+  BOOST_CHECK_EQUAL(result.enabled, expected.enabled);
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    result.values.begin(), result.values.end(), expected.values.begin(), expected.values.end());
+  BOOST_CHECK(result.groups == expected.groups);
+  BOOST_CHECK(!result.missing.has_value());
+  BOOST_CHECK(result.present == expected.present);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(binary_serialization_tests)
+
+BOOST_AUTO_TEST_CASE(test_binary_roundtrip)
+{
+  const auto path = makeTempPath("binary-roundtrip.bin");
+  auto data = makeConfig();
+  BinaryContext ctx;
+
+  std::string encoded;
+  {
+    BinaryDocument<false> doc{path};
+    doc.serialize("config", gsl_lite::not_null{&ctx}, data);
+    encoded = doc.encode();
+  }
+  std::filesystem::remove(path);
+
+  BinaryDocument<true> doc{encoded};
+  BinaryConfig result;
+  result.missing = 1;
+  doc.deserialize("config", gsl_lite::not_null{&ctx}, result);
+  checkEqual(result, data);
+}
+
+BOOST_AUTO_TEST_CASE(test_binary_rejects_truncated_data)
+{
+  const auto path = makeTempPath("binary-truncated.bin");
+  auto data = makeConfig();
+  BinaryContext ctx;
+
+  std::string encoded;
+  {
+    BinaryDocument<false> doc{path};
+    doc.serialize("config", gsl_lite::not_null{&ctx}, data);
+    encoded = doc.encode();
+  }
+  std::filesystem::remove(path);
+
+  BOOST_CHECK_THROW(BinaryDocument<true>{encoded.substr(0, encoded.size() - 1)}, Exception);
+  BOOST_CHECK_THROW(BinaryDocument<true>{encoded + "x"}, Exception);
+  BOOST_CHECK_THROW(BinaryDocument<true>{std::string{"config: {}"}}, Exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_binary_rejects_deep_nesting)
+{
+  static constexpr uint32_t Depth = 100000;
+  static constexpr char IsSeq = 1 << 1;
+
+  std::string encoded{detail::BinaryDocumentMagic.data(), detail::BinaryDocumentMagic.size()};
+  const auto put = [&encoded](const uint32_t value)
+  {
+    encoded.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  put(detail::BinaryDocumentVersion);
+  put(Depth + 1);
+  // sequences with a single child each, deep enough to overflow the stack if the depth wasn't limited
+  for(uint32_t i = 0; i < Depth; ++i)
+  {
+    encoded.push_back(IsSeq);
+    encoded.push_back(1);
+  }
+  encoded.push_back(0);
+
+  BOOST_CHECK_THROW(BinaryDocument<true>{encoded}, Exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_loading_document_detects_format)
+{
+  const auto binaryPath = makeTempPath("format-detection.bin");
+  const auto yamlPath = makeTempPath("format-detection.yaml");
+  auto data = makeConfig();
+  BinaryContext ctx;
+
+  {
+    BinaryDocument<false> doc{binaryPath};
+    doc.serialize("config", gsl_lite::not_null{&ctx}, data);
+    doc.write();
+  }
+  {
+    YAMLDocument<false> doc{yamlPath};
+    doc.serialize("config", gsl_lite::not_null{&ctx}, data);
+    doc.write();
+  }
+
+  BOOST_CHECK(isBinaryDocument(binaryPath));
+  BOOST_CHECK(!isBinaryDocument(yamlPath));
+  BOOST_CHECK(std::filesystem::file_size(binaryPath) < std::filesystem::file_size(yamlPath));
+
+  for(const auto& path : {binaryPath, yamlPath})
+  {
+    BinaryConfig result;
+    withLoadingDocument(path,
+                        [&ctx, &result](auto& doc)
+                        {
+                          doc.deserialize("config", gsl_lite::not_null{&ctx}, result);
+                        });
+    checkEqual(result, data);
+    std::filesystem::remove(path);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace serialization::tests
@@ -9,11 +9,46 @@
 #include <fstream>
 #include <gsl-lite/gsl-lite.hpp>
 #include <ryml.hpp>
+#include <sstream>
 #include <string>
 #include <type_traits>
 
 namespace serialization
 {
+namespace detail
+{
+struct CustomErrorCallbacks
+{
+  explicit CustomErrorCallbacks()
+      : m_callbacks{ryml::get_callbacks()}
+  {
+    ryml::set_callbacks(
+      ryml::Callbacks{nullptr,
+                      [](const size_t length, void* /*hint*/, void* /*user_data*/) -> gsl_lite::owner<void*>
+                      {
+                        return new char[length];
+                      },
+                      [](const gsl_lite::owner<void*> mem, size_t /*length*/, void* /*user_data*/)
+                      {
+                        delete[] static_cast<char*>(mem);
+                      },
+                      [](const char* msg, const size_t msg_len, ryml::Location /*location*/, void* /*user_data*/)
+                      {
+                        const std::string msgStr{msg, msg_len};
+                        SERIALIZER_EXCEPTION(msgStr);
+                      }});
+  }
+
+  ~CustomErrorCallbacks()
+  {
+    ryml::set_callbacks(m_callbacks);
+  }
+
+private:
+  ryml::Callbacks m_callbacks;
+};
+} // namespace detail
+
 template<bool Loading>
 class YAMLDocument
 {
@@ -21,42 +56,11 @@ class YAMLDocument
   std::string m_buffer;
   ryml::Tree m_tree;
 
-  struct CustomErrorCallbacks
-  {
-    explicit CustomErrorCallbacks()
-        : m_callbacks{ryml::get_callbacks()}
-    {
-      ryml::set_callbacks(
-        ryml::Callbacks{nullptr,
-                        [](const size_t length, void* /*hint*/, void* /*user_data*/) -> gsl_lite::owner<void*>
-                        {
-                          return new char[length];
-                        },
-                        [](const gsl_lite::owner<void*> mem, size_t /*length*/, void* /*user_data*/)
-                        {
-                          delete[] static_cast<char*>(mem);
-                        },
-                        [](const char* msg, const size_t msg_len, ryml::Location /*location*/, void* /*user_data*/)
-                        {
-                          const std::string msgStr{msg, msg_len};
-                          SERIALIZER_EXCEPTION(msgStr);
-                        }});
-    }
-
-    ~CustomErrorCallbacks()
-    {
-      ryml::set_callbacks(m_callbacks);
-    }
-
-  private:
-    ryml::Callbacks m_callbacks;
-  };
-
 public:
   explicit YAMLDocument(const std::filesystem::path& filename)
       : m_filename{filename}
   {
-    CustomErrorCallbacks callbacks{};
+    detail::CustomErrorCallbacks callbacks{};
     BOOST_LOG_TRIVIAL(info) << "Opening " << filename << ", Loading=" << Loading;
     if constexpr(Loading)
     {
@@ -78,10 +82,18 @@ public:
     }
   }
 
+  /**
+   * @brief Creates a document which is only kept in memory, to be retrieved using encode().
+   */
+  explicit YAMLDocument() requires(!Loading)
+  {
+    m_tree.rootref() |= ryml::MAP;
+  }
+
   explicit YAMLDocument(std::string data) requires(Loading)
       : m_buffer{std::move(data)}
   {
-    CustomErrorCallbacks callbacks{};
+    detail::CustomErrorCallbacks callbacks{};
     m_tree = ryml::parse_in_arena(c4::to_csubstr(m_buffer));
   }
 
@@ -91,7 +103,7 @@ public:
     const std::string oldLocale = gsl_lite::not_null{setlocale(LC_NUMERIC, nullptr)}.get();
     setlocale(LC_NUMERIC, "C");
 
-    CustomErrorCallbacks callbacks{};
+    detail::CustomErrorCallbacks callbacks{};
 
     Deserializer<TContext> ser{m_tree.rootref()[c4::to_csubstr(key)], context, true, nullptr};
     auto result = access::dispatchCreate<T>(ser);
@@ -107,7 +119,7 @@ public:
     const std::string oldLocale = gsl_lite::not_null{setlocale(LC_NUMERIC, nullptr)}.get();
     setlocale(LC_NUMERIC, "C");
 
-    CustomErrorCallbacks callbacks{};
+    detail::CustomErrorCallbacks callbacks{};
 
     Deserializer<TContext> ser{m_tree.rootref()[c4::to_csubstr(key)], context, nullptr};
     access::dispatchDeserialize(data, ser);
@@ -122,7 +134,7 @@ public:
     const std::string oldLocale = gsl_lite::not_null{setlocale(LC_NUMERIC, nullptr)}.get();
     setlocale(LC_NUMERIC, "C");
 
-    CustomErrorCallbacks callbacks{};
+    detail::CustomErrorCallbacks callbacks{};
 
     Serializer<TContext> ser{m_tree.rootref()[m_tree.copy_to_arena(c4::to_csubstr(key))], context, nullptr};
     access::dispatchSerialize(data, ser);
@@ -131,8 +143,16 @@ public:
     setlocale(LC_NUMERIC, oldLocale.c_str());
   }
 
+  [[nodiscard]] std::string encode() const requires(!Loading)
+  {
+    std::ostringstream stream;
+    stream << m_tree.rootref();
+    return stream.str();
+  }
+
   void write() const requires(!Loading)
   {
+    gsl_Expects(!m_filename.empty());
     std::ofstream file{m_filename, std::ios::out | std::ios::trunc};
     gsl_Assert(file.is_open());
     file << m_tree.rootref();
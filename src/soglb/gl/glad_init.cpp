@@ -229,6 +229,11 @@ void gl::initializeGl(void* (*loadProc)(const char* name))
     BOOST_LOG_TRIVIAL(info) << "Anisotropic filtering is supported on this platform, max level "
                             << getMaxAnisotropyLevel();
 
+  if(!hasNativeEtc2Support())
+    BOOST_LOG_TRIVIAL(info) << "ETC2 textures are not natively supported on this platform";
+  else
+    BOOST_LOG_TRIVIAL(info) << "ETC2 textures are natively supported on this platform";
+
   GL_ASSERT(api::enable(api::EnableCap::Multisample));
   GL_ASSERT(api::enable(api::EnableCap::SampleShading));
   GL_ASSERT(api::enable(api::EnableCap::Dither));
@@ -246,4 +251,11 @@ float gl::getMaxAnisotropyLevel()
   float value = 0;
   GL_ASSERT(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value));
   return value;
-}
\ No newline at end of file
+}
+bool gl::hasNativeEtc2Support()
+{
+  int32_t compressed = GL_FALSE;
+  GL_ASSERT(glGetInternalformativ(
+    GL_TEXTURE_2D_ARRAY, GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, GL_TEXTURE_COMPRESSED, 1, &compressed));
+  return compressed == GL_TRUE;
+}
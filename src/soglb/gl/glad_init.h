@@ -5,4 +5,6 @@ namespace gl
 extern void initializeGl(void* (*loadProc)(const char* name));
 extern bool hasAnisotropicFilteringExtension();
 extern float getMaxAnisotropyLevel();
+//! Whether ETC2 textures are kept compressed in video memory instead of being decompressed by the driver.
+extern bool hasNativeEtc2Support();
 } // namespace gl
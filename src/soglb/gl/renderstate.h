@@ -123,6 +123,8 @@ public:
 
   void merge(const RenderState& other);
 
+  [[nodiscard]] bool operator==(const RenderState& rhs) const = default;
+
   void setProgramPointSize(const bool enabled)
   {
     m_programPointSizeEnabled = enabled;
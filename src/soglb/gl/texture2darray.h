@@ -3,6 +3,7 @@
 #include "texture.h"
 
 #include <boost/assert.hpp>
+#include <cstdint>
 #include <gl/glassert.h>
 #include <glm/vec3.hpp>
 #include <gsl-lite/gsl-lite.hpp>
@@ -30,6 +31,26 @@ public:
     GL_ASSERT(api::textureStorage3D(getHandle(), levels, Pixel::SizedInternalFormat, size.x, size.y, size.z));
   }
 
+  /**
+   * @brief Creates a texture stored in a compressed format, which can only be filled using assignCompressed().
+   *
+   * The compressed format must decode to the pixel type of the texture.
+   */
+  explicit Texture2DArray(const glm::ivec3& size,
+                          const std::string_view& label,
+                          int levels,
+                          api::SizedInternalFormat compressedFormat)
+      : TextureImpl<api::TextureTarget::Texture2dArray, _PixelT>{label}
+      , m_size{size}
+  {
+    BOOST_ASSERT(levels > 0);
+    BOOST_ASSERT(size.x > 0);
+    BOOST_ASSERT(size.y > 0);
+    BOOST_ASSERT(size.z > 0);
+
+    GL_ASSERT(api::textureStorage3D(getHandle(), levels, compressedFormat, size.x, size.y, size.z));
+  }
+
   // NOLINTNEXTLINE(*-easily-swappable-parameters)
   Texture2DArray& assign(const gsl_lite::span<const _PixelT>& data, int z, int level = 0)
   {
@@ -44,6 +65,29 @@ public:
     return *this;
   }
 
+  // NOLINTNEXTLINE(*-easily-swappable-parameters)
+  Texture2DArray&
+    assignCompressed(const gsl_lite::span<const uint8_t>& data, api::InternalFormat format, int z, int level = 0)
+  {
+    BOOST_ASSERT(z >= 0 && z < m_size.z);
+
+    const int levelDiv = 1 << level;
+    const auto size = glm::max(glm::ivec3{1, 1, 1}, m_size / levelDiv);
+
+    GL_ASSERT(api::compressedTextureSubImage3D(getHandle(),
+                                               level,
+                                               0,
+                                               0,
+                                               z,
+                                               size.x,
+                                               size.y,
+                                               1,
+                                               format,
+                                               gsl_lite::narrow<api::core::SizeType>(data.size()),
+                                               data.data()));
+    return *this;
+  }
+
 private:
   glm::ivec3 m_size{-1};
 };
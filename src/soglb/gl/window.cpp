@@ -60,9 +60,11 @@ void terminateGlfw()
 
 Window::Window(const std::vector<std::filesystem::path>& logoPaths,
                const glm::ivec2& windowSize,
-               const bool borderlessFullscreen)
+               const bool borderlessFullscreen,
+               const bool hidden)
     : m_windowPos{0, 0}
     , m_windowSize{windowSize}
+    , m_hidden{hidden}
 {
   initGlfw();
 
@@ -87,7 +89,16 @@ Window::Window(const std::vector<std::filesystem::path>& logoPaths,
   glfwWindowHint(GLFW_CONTEXT_NO_ERROR, GLFW_TRUE);
 #endif
 
-  glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+  if(hidden)
+  {
+    // headless runs only need a context, but never present anything
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_FOCUS_ON_SHOW, GLFW_FALSE);
+  }
+  else
+  {
+    glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+  }
   m_window = glfwCreateWindow(windowSize.x, windowSize.y, "CroftEngine", nullptr, nullptr);
 
   if(m_window == nullptr)
@@ -138,12 +149,12 @@ Window::Window(const std::vector<std::filesystem::path>& logoPaths,
   updateWindowSize();
 
 #ifdef NDEBUG
-  if(!borderlessFullscreen)
+  if(!borderlessFullscreen && !hidden)
   {
     glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
   }
 #endif
-  glfwSwapInterval(1);
+  glfwSwapInterval(hidden ? 0 : 1);
 }
 
 void Window::updateWindowSize()
@@ -164,7 +175,7 @@ void Window::swapBuffers() const
 
 void Window::setFullscreen()
 {
-  if(m_isFullscreen)
+  if(m_isFullscreen || m_hidden)
     return;
 
   const auto monitor = glfwGetPrimaryMonitor();
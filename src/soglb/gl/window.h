@@ -14,7 +14,8 @@ class Window final
 public:
   explicit Window(const std::vector<std::filesystem::path>& logoPaths,
                   const glm::ivec2& windowSize,
-                  bool borderlessFullscreen);
+                  bool borderlessFullscreen,
+                  bool hidden = false);
   ~Window();
 
   void updateWindowSize();
@@ -56,11 +57,17 @@ public:
 
   [[nodiscard]] bool hasFocus() const;
 
+  [[nodiscard]] bool isHidden() const noexcept
+  {
+    return m_hidden;
+  }
+
 private:
   GLFWwindow* m_window = nullptr;
   glm::ivec2 m_windowPos{0};
   glm::ivec2 m_windowSize{0};
   glm::ivec2 m_viewport{0};
   bool m_isFullscreen = false;
+  bool m_hidden = false;
 };
 } // namespace gl
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "fsutil.h"
+
+#include <boost/throw_exception.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace util
+{
+void writeFileAtomically(const std::filesystem::path& path, const std::string_view& data)
+{
+  auto tmpPath = path;
+  tmpPath += ".tmp";
+
+#ifdef WIN32
+  FILE* file = _wfopen(tmpPath.c_str(), L"wb");
+#else
+  FILE* file = std::fopen(tmpPath.c_str(), "wb");
+#endif
+  if(file == nullptr)
+    BOOST_THROW_EXCEPTION(std::runtime_error("failed to open " + tmpPath.string() + " for writing"));
+
+  bool success = std::fwrite(data.data(), 1, data.size(), file) == data.size() && std::fflush(file) == 0;
+#ifdef WIN32
+  success = success && _commit(_fileno(file)) == 0;
+#else
+  success = success && fsync(fileno(file)) == 0;
+#endif
+  success = std::fclose(file) == 0 && success;
+  if(!success)
+  {
+    std::error_code ec;
+    std::filesystem::remove(tmpPath, ec);
+    BOOST_THROW_EXCEPTION(std::runtime_error("failed to write " + tmpPath.string()));
+  }
+
+  std::filesystem::rename(tmpPath, path);
+}
+} // namespace util
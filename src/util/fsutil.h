@@ -3,6 +3,7 @@
 #include <boost/log/trivial.hpp>
 #include <boost/predef/os.h>
 #include <filesystem>
+#include <string_view>
 
 #if BOOST_OS_WINDOWS
 #  include <boost/algorithm/string/case_conv.hpp>
@@ -26,4 +27,11 @@ inline void rename(const std::filesystem::path& srcPath, const std::filesystem::
   BOOST_LOG_TRIVIAL(info) << "Rename " << srcPath << " to " << dstPath;
   std::filesystem::rename(srcPath, dstPath);
 }
+
+/**
+ * @brief Writes @a data to a temporary file, flushes it to the disk, and then replaces @a path with it.
+ *
+ * Readers of @a path either see the previous or the new contents, even if the process dies while writing.
+ */
+extern void writeFileAtomically(const std::filesystem::path& path, const std::string_view& data);
 } // namespace util
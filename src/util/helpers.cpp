@@ -173,10 +173,21 @@ int16_t rand15s()
   return static_cast<int16_t>(rand15() - Rand15Max / 2);
 }
 
+namespace
+{
+// the linear congruential generator of the original engine, which is platform-independent in contrast to std::rand
+uint32_t rand15State = 0xd371f947u;
+} // namespace
+
 int16_t rand15()
 {
-  // NOLINTNEXTLINE(cert-msc50-cpp, concurrency-mt-unsafe)
-  return gsl_lite::narrow_cast<int16_t>(std::rand() % Rand15Max);
+  rand15State = rand15State * 0x41c64e6du + 0x3039u;
+  return gsl_lite::narrow_cast<int16_t>((rand15State >> 10u) % Rand15Max);
+}
+
+void seedRand15(const uint32_t seed) noexcept
+{
+  rand15State = seed;
 }
 
 std::string toTimeStr(const core::Seconds& t)
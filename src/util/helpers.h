@@ -26,6 +26,11 @@ constexpr int Rand15Max = 1u << 15u;
  */
 extern int16_t rand15();
 
+/**
+ * Resets the state of the generator behind rand15() and rand15s(), making the following sequence reproducible.
+ */
+extern void seedRand15(uint32_t seed) noexcept;
+
 /**
  * Random value in range 0..(max-1).
  */
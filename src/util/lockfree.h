@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace util
+{
+/**
+ * @brief Fixed-capacity queue between exactly one producer and one consumer thread.
+ *
+ * Elements are filled and read in place: the producer writes into the slot returned by beginPush() and hands it over
+ * with commitPush(), the consumer reads the slot returned by front() and releases it with pop(). Slots are recycled
+ * without being reset, so containers stored in them keep their capacity.
+ */
+template<typename T, size_t Capacity>
+class SpscRing final
+{
+  static_assert(Capacity > 0);
+
+public:
+  /**
+   * @return The slot to fill, or @c nullptr if the queue is full.
+   */
+  [[nodiscard]] T* beginPush() noexcept
+  {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    if(tail - m_head.load(std::memory_order_acquire) == Capacity)
+      return nullptr;
+    return &m_slots[tail % Capacity];
+  }
+
+  void commitPush() noexcept
+  {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @return The oldest committed slot, or @c nullptr if the queue is empty.
+   */
+  [[nodiscard]] T* front() noexcept
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    if(head == m_tail.load(std::memory_order_acquire))
+      return nullptr;
+    return &m_slots[head % Capacity];
+  }
+
+  void pop() noexcept
+  {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+private:
+  std::array<T, Capacity> m_slots{};
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+/**
+ * @brief Hands the most recent value from one producer thread to one consumer thread without blocking either.
+ *
+ * The producer writes a complete value into getBack() and calls publish(). The consumer calls acquire() to get the most
+ * recently published value, which stays unchanged until its next call to acquire(). Values published in between are
+ * skipped.
+ */
+template<typename T>
+class TripleBuffer final
+{
+public:
+  [[nodiscard]] T& getBack() noexcept
+  {
+    return m_buffers[m_back];
+  }
+
+  void publish() noexcept
+  {
+    m_back = m_shared.exchange(static_cast<uint8_t>(m_back | DirtyBit), std::memory_order_acq_rel) & IndexMask;
+  }
+
+  [[nodiscard]] const T& acquire() noexcept
+  {
+    if((m_shared.load(std::memory_order_relaxed) & DirtyBit) != 0)
+      m_front = m_shared.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+    return m_buffers[m_front];
+  }
+
+private:
+  static constexpr uint8_t IndexMask = 0x3u;
+  static constexpr uint8_t DirtyBit = 0x4u;
+
+  std::array<T, 3> m_buffers{};
+  //! @brief Only accessed by the producer.
+  uint8_t m_back = 0;
+  //! @brief The buffer in transit, and whether it holds a value the consumer has not seen yet.
+  std::atomic<uint8_t> m_shared{1};
+  //! @brief Only accessed by the consumer.
+  uint8_t m_front = 2;
+};
+} // namespace util
@@ -0,0 +1,168 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/throw_exception.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace util::profiler
+{
+namespace
+{
+const auto epoch = std::chrono::steady_clock::now();
+
+std::mutex ringsMutex;
+std::vector<std::shared_ptr<ZoneRing>> rings;
+
+void writeJsonString(std::ostream& stream, const std::string_view& str)
+{
+  stream << '"';
+  for(const char c : str)
+  {
+    if(c == '"' || c == '\\')
+      stream << '\\';
+    stream << c;
+  }
+  stream << '"';
+}
+} // namespace
+
+std::vector<Zone> ZoneRing::snapshot() const
+{
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto count = std::min<uint64_t>(head, Capacity);
+
+  std::vector<Zone> result;
+  result.reserve(count);
+  for(auto i = head - count; i < head; ++i)
+    result.emplace_back(m_zones[i % Capacity]);
+
+  // everything at or before the slot the writer may currently be filling is unreliable
+  const auto newHead = m_head.load(std::memory_order_acquire);
+  if(const auto overwritten = newHead >= Capacity ? newHead - Capacity + 1 : 0; overwritten > head - count)
+  {
+    const auto drop = std::min<uint64_t>(overwritten - (head - count), result.size());
+    result.erase(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(drop));
+  }
+
+  return result;
+}
+
+std::chrono::nanoseconds now() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch);
+}
+
+ZoneRing& getThreadRing()
+{
+  thread_local ZoneRing* ring = nullptr;
+  if(ring != nullptr)
+    return *ring;
+
+  // rings are kept alive after their thread exits so that its zones still show up in dumps
+  const std::lock_guard lock{ringsMutex};
+  const auto& created = rings.emplace_back(std::make_shared<ZoneRing>(static_cast<uint32_t>(rings.size())));
+  ring = created.get();
+  return *ring;
+}
+
+std::vector<Zone> collectZones()
+{
+  std::vector<std::shared_ptr<ZoneRing>> currentRings;
+  {
+    const std::lock_guard lock{ringsMutex};
+    currentRings = rings;
+  }
+
+  std::vector<Zone> result;
+  for(const auto& ring : currentRings)
+  {
+    const auto zones = ring->snapshot();
+    result.insert(result.end(), zones.begin(), zones.end());
+  }
+  return result;
+}
+
+std::vector<ZoneStats> summarizeCurrentThread(const std::chrono::nanoseconds window)
+{
+  const auto cutoff = now() - window;
+
+  std::vector<ZoneStats> result;
+  std::vector<std::chrono::nanoseconds> firstBegin;
+  for(const auto& zone : getThreadRing().snapshot())
+  {
+    if(zone.end < cutoff)
+      continue;
+
+    const auto it = std::find_if(result.begin(),
+                                 result.end(),
+                                 [&zone](const ZoneStats& stats)
+                                 {
+                                   return std::string_view{stats.name} == zone.name;
+                                 });
+    if(it == result.end())
+    {
+      result.emplace_back(ZoneStats{zone.name, zone.end - zone.begin, 1, zone.depth});
+      firstBegin.emplace_back(zone.begin);
+      continue;
+    }
+
+    it->total += zone.end - zone.begin;
+    ++it->calls;
+    auto& begin = firstBegin.at(static_cast<size_t>(std::distance(result.begin(), it)));
+    begin = std::min(begin, zone.begin);
+  }
+
+  // zones are pushed when they end, so outer zones come after their children; restore the call order
+  std::vector<size_t> order(result.size());
+  for(size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&firstBegin](const size_t a, const size_t b)
+                   {
+                     return firstBegin[a] < firstBegin[b];
+                   });
+
+  std::vector<ZoneStats> sorted;
+  sorted.reserve(result.size());
+  for(const auto i : order)
+    sorted.emplace_back(result[i]);
+  return sorted;
+}
+
+void writeChromeTrace(const std::filesystem::path& path)
+{
+  std::ofstream file{path, std::ios::out | std::ios::trunc};
+  if(!file.is_open())
+    BOOST_THROW_EXCEPTION(std::runtime_error("failed to open profiler trace file for writing"));
+
+  file << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  bool first = true;
+  for(const auto& zone : collectZones())
+  {
+    if(!first)
+      file << ",";
+    first = false;
+
+    file << "\n{\"name\":";
+    writeJsonString(file, zone.name);
+    file << R"(,"ph":"X","pid":1,"tid":)" << zone.threadId
+         << ",\"ts\":" << std::chrono::duration<double, std::micro>(zone.begin).count()
+         << ",\"dur\":" << std::chrono::duration<double, std::micro>(zone.end - zone.begin).count() << "}";
+  }
+  file << "\n]}\n";
+}
+} // namespace util::profiler
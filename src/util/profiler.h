@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace util::profiler
+{
+#ifndef UTIL_PROFILING
+#  define UTIL_PROFILE_ZONE(name)
+#else
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+#  define _UTIL_PROFILER_PASTE(x, y) x##y
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+#  define _UTIL_PROFILER_CAT(x, y) _UTIL_PROFILER_PASTE(x, y)
+
+/**
+ * @brief Records the time until the end of the enclosing scope as a zone.
+ * @param name A string literal; it is stored by pointer and must outlive the profiler.
+ */
+#  define UTIL_PROFILE_ZONE(name)                                                                    \
+    [[maybe_unused]] const ::util::profiler::ScopedZone _UTIL_PROFILER_CAT(_util_profile_zone_, __LINE__) \
+    {                                                                                                  \
+      name                                                                                             \
+    }
+#endif
+
+constexpr bool Enabled =
+#ifdef UTIL_PROFILING
+  true
+#else
+  false
+#endif
+  ;
+
+struct Zone
+{
+  const char* name = nullptr;
+  std::chrono::nanoseconds begin{0};
+  std::chrono::nanoseconds end{0};
+  uint32_t threadId = 0;
+  uint32_t depth = 0;
+};
+
+/**
+ * @brief Fixed-size ring of the most recent zones of a single thread.
+ *
+ * Only the owning thread writes, any thread may take a snapshot. The writer never blocks; readers detect and drop
+ * entries that were overwritten while copying.
+ */
+class ZoneRing final
+{
+public:
+  static constexpr size_t Capacity = 1u << 14u;
+
+  explicit ZoneRing(uint32_t threadId) noexcept
+      : m_threadId{threadId}
+  {
+  }
+
+  void push(const Zone& zone) noexcept
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    m_zones[head % Capacity] = zone;
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] std::vector<Zone> snapshot() const;
+
+  [[nodiscard]] auto getThreadId() const noexcept
+  {
+    return m_threadId;
+  }
+
+  uint32_t depth = 0;
+
+private:
+  const uint32_t m_threadId;
+  std::atomic<uint64_t> m_head{0};
+  std::array<Zone, Capacity> m_zones{};
+};
+
+struct ZoneStats
+{
+  const char* name = nullptr;
+  std::chrono::nanoseconds total{0};
+  size_t calls = 0;
+  uint32_t depth = 0;
+};
+
+[[nodiscard]] extern std::chrono::nanoseconds now() noexcept;
+
+/**
+ * @brief The ring of the calling thread, registered on first use.
+ */
+[[nodiscard]] extern ZoneRing& getThreadRing();
+
+/**
+ * @brief Snapshots of all threads that ever recorded a zone, ordered by thread id.
+ */
+[[nodiscard]] extern std::vector<Zone> collectZones();
+
+/**
+ * @brief Accumulates the zones of the calling thread which ended within the last @a window, ordered by first
+ *        occurrence.
+ */
+[[nodiscard]] extern std::vector<ZoneStats> summarizeCurrentThread(std::chrono::nanoseconds window);
+
+/**
+ * @brief Writes all recorded zones in the Chrome trace event format, loadable by chrome://tracing or Perfetto.
+ */
+extern void writeChromeTrace(const std::filesystem::path& path);
+
+class ScopedZone final
+{
+public:
+  explicit ScopedZone(const char* name)
+      : m_ring{getThreadRing()}
+      , m_name{name}
+      , m_depth{m_ring.depth++}
+      , m_begin{now()}
+  {
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone(ScopedZone&&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+  ScopedZone& operator=(ScopedZone&&) = delete;
+
+  ~ScopedZone()
+  {
+    m_ring.push(Zone{m_name, m_begin, now(), m_ring.getThreadId(), m_depth});
+    --m_ring.depth;
+  }
+
+private:
+  ZoneRing& m_ring;
+  const char* const m_name;
+  const uint32_t m_depth;
+  const std::chrono::nanoseconds m_begin;
+};
+} // namespace util::profiler
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+/**
+ * @brief Stable LSD radix sort of @a items by an unsigned 64-bit key, in ascending order.
+ *
+ * All byte histograms are gathered in a single pass, and bytes which are the same for all keys are skipped, so keys
+ * using only a few distinct bits are sorted in fewer passes. @a scratch is only used as a buffer and is kept to reuse
+ * its capacity.
+ *
+ * @param key Maps an item to its key; called once per item and pass, so it should be a plain member access.
+ */
+template<typename T, typename TKey>
+void radixSort(std::vector<T>& items, std::vector<T>& scratch, const TKey& key)
+{
+  static constexpr size_t Passes = sizeof(uint64_t);
+  static constexpr size_t Buckets = 256;
+
+  if(items.size() < 2)
+    return;
+
+  std::array<std::array<size_t, Buckets>, Passes> histograms{};
+  for(const auto& item : items)
+  {
+    const uint64_t k = key(item);
+    for(size_t pass = 0; pass < Passes; ++pass)
+      ++histograms[pass][(k >> (pass * 8)) & 0xffu];
+  }
+
+  // copying instead of resizing, so the items don't need to be default-constructible
+  scratch.assign(items.begin(), items.end());
+  for(size_t pass = 0; pass < Passes; ++pass)
+  {
+    auto& histogram = histograms[pass];
+    const uint64_t firstByte = (key(items.front()) >> (pass * 8)) & 0xffu;
+    if(histogram[firstByte] == items.size())
+      continue;
+
+    size_t offset = 0;
+    for(auto& count : histogram)
+      offset += std::exchange(count, offset);
+
+    for(auto& item : items)
+      scratch[histogram[(key(item) >> (pass * 8)) & 0xffu]++] = std::move(item);
+    items.swap(scratch);
+  }
+}
+} // namespace util
@@ -5,8 +5,10 @@
 
 #include <boost/test/unit_test.hpp>
 #include <cmath>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <vector>
 
 namespace util::tests
 {
@@ -212,6 +214,24 @@ BOOST_AUTO_TEST_CASE(test_rand15_bounds)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_rand15_seed_reproducible)
+{
+  seedRand15(1234);
+  std::vector<int16_t> first;
+  for(int i = 0; i < 100; ++i)
+    first.emplace_back(rand15());
+
+  seedRand15(1234);
+  for(int i = 0; i < 100; ++i)
+    BOOST_CHECK_EQUAL(rand15(), first[i]);
+
+  seedRand15(4321);
+  bool anyDifferent = false;
+  for(int i = 0; i < 100; ++i)
+    anyDifferent |= rand15() != first[i];
+  BOOST_CHECK(anyDifferent);
+}
+
 BOOST_AUTO_TEST_CASE(test_rand15s_bounds)
 {
   for(int i = 0; i < 100; ++i)
@@ -0,0 +1,111 @@
+#include "util/lockfree.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace util::tests
+{
+BOOST_AUTO_TEST_SUITE(lockfree_tests)
+
+BOOST_AUTO_TEST_CASE(test_spsc_ring_capacity)
+{
+  SpscRing<int, 2> ring;
+  BOOST_CHECK(ring.front() == nullptr);
+
+  *ring.beginPush() = 1;
+  ring.commitPush();
+  *ring.beginPush() = 2;
+  ring.commitPush();
+  BOOST_CHECK(ring.beginPush() == nullptr);
+
+  BOOST_REQUIRE(ring.front() != nullptr);
+  BOOST_CHECK_EQUAL(*ring.front(), 1);
+  ring.pop();
+  BOOST_REQUIRE(ring.beginPush() != nullptr);
+  BOOST_CHECK_EQUAL(*ring.front(), 2);
+  ring.pop();
+  BOOST_CHECK(ring.front() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_ring_keeps_order_across_threads)
+{
+  static constexpr size_t Count = 100000;
+  SpscRing<std::vector<size_t>, 4> ring;
+
+  std::thread producer{[&ring]()
+                       {
+                         for(size_t i = 0; i < Count; ++i)
+                         {
+                           std::vector<size_t>* slot = nullptr;
+                           while((slot = ring.beginPush()) == nullptr)
+                             std::this_thread::yield();
+                           slot->assign(3, i);
+                           ring.commitPush();
+                         }
+                       }};
+
+  bool inOrder = true;
+  for(size_t i = 0; i < Count; ++i)
+  {
+    std::vector<size_t>* slot = nullptr;
+    while((slot = ring.front()) == nullptr)
+      std::this_thread::yield();
+    inOrder &= *slot == std::vector<size_t>(3, i);
+    ring.pop();
+  }
+  producer.join();
+  BOOST_CHECK(inOrder);
+}
+
+BOOST_AUTO_TEST_CASE(test_triple_buffer_latest_value)
+{
+  TripleBuffer<int> buffer;
+  BOOST_CHECK_EQUAL(buffer.acquire(), 0);
+
+  buffer.getBack() = 1;
+  buffer.publish();
+  buffer.getBack() = 2;
+  buffer.publish();
+  BOOST_CHECK_EQUAL(buffer.acquire(), 2);
+  // nothing new was published
+  BOOST_CHECK_EQUAL(buffer.acquire(), 2);
+
+  buffer.getBack() = 3;
+  buffer.publish();
+  BOOST_CHECK_EQUAL(buffer.acquire(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_triple_buffer_values_are_consistent_across_threads)
+{
+  static constexpr size_t Count = 100000;
+  TripleBuffer<std::vector<size_t>> buffer;
+
+  std::thread producer{[&buffer]()
+                       {
+                         for(size_t i = 1; i <= Count; ++i)
+                         {
+                           buffer.getBack().assign(16, i);
+                           buffer.publish();
+                         }
+                       }};
+
+  bool consistent = true;
+  size_t last = 0;
+  while(last != Count)
+  {
+    const auto& value = buffer.acquire();
+    if(value.empty())
+      continue;
+
+    consistent &= value == std::vector<size_t>(16, value.front());
+    consistent &= value.front() >= last;
+    last = value.front();
+  }
+  producer.join();
+  BOOST_CHECK(consistent);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace util::tests
@@ -0,0 +1,69 @@
+#include "util/profiler.h"
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace util::profiler::tests
+{
+BOOST_AUTO_TEST_SUITE(profiler_tests)
+
+BOOST_AUTO_TEST_CASE(test_ring_keeps_most_recent)
+{
+  const auto ring = std::make_unique<ZoneRing>(0);
+  BOOST_CHECK(ring->snapshot().empty());
+
+  for(size_t i = 0; i < ZoneRing::Capacity + 10; ++i)
+    ring->push(Zone{"zone", std::chrono::nanoseconds{i}, std::chrono::nanoseconds{i + 1}, 0, 0});
+
+  const auto zones = ring->snapshot();
+  // the oldest surviving slot is treated as being overwritten
+  BOOST_REQUIRE_EQUAL(zones.size(), ZoneRing::Capacity - 1);
+  BOOST_CHECK_EQUAL(zones.front().begin.count(), 11);
+  BOOST_CHECK_EQUAL(zones.back().begin.count(), ZoneRing::Capacity + 9);
+}
+
+BOOST_AUTO_TEST_CASE(test_summary_nesting)
+{
+  for(int i = 0; i < 3; ++i)
+  {
+    const ScopedZone outer{"test-outer"};
+    const ScopedZone inner{"test-inner"};
+  }
+
+  const auto stats = summarizeCurrentThread(std::chrono::hours{1});
+  BOOST_REQUIRE_EQUAL(stats.size(), 2);
+  BOOST_CHECK_EQUAL(std::string_view{stats[0].name}, "test-outer");
+  BOOST_CHECK_EQUAL(stats[0].calls, 3);
+  BOOST_CHECK_EQUAL(stats[0].depth, 0);
+  BOOST_CHECK_EQUAL(std::string_view{stats[1].name}, "test-inner");
+  BOOST_CHECK_EQUAL(stats[1].calls, 3);
+  BOOST_CHECK_EQUAL(stats[1].depth, 1);
+  BOOST_CHECK(stats[0].total >= stats[1].total);
+}
+
+BOOST_AUTO_TEST_CASE(test_zones_from_other_threads)
+{
+  std::thread{[]
+              {
+                const ScopedZone zone{"test-worker"};
+              }}
+    .join();
+
+  bool found = false;
+  for(const auto& zone : collectZones())
+  {
+    if(std::string_view{zone.name} == "test-worker")
+    {
+      found = true;
+      BOOST_CHECK_NE(zone.threadId, getThreadRing().getThreadId());
+    }
+  }
+  BOOST_CHECK(found);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace util::profiler::tests
@@ -0,0 +1,98 @@
+#include "util/radixsort.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util::tests
+{
+BOOST_AUTO_TEST_SUITE(radixsort_tests)
+
+namespace
+{
+struct Item
+{
+  uint64_t key;
+  size_t index;
+};
+
+const auto getKey = [](const Item& item)
+{
+  return item.key;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_matches_stable_sort)
+{
+  std::mt19937_64 rng{42};
+  std::vector<Item> items;
+  for(size_t i = 0; i < 1000; ++i)
+  {
+    // few distinct keys to test stability, spread over all bytes
+    const auto k = rng() % 16;
+    items.emplace_back(Item{(k << 60u) | (k << 20u) | (k & 3u), i});
+  }
+
+  auto expected = items;
+  std::ranges::stable_sort(expected,
+                           [](const Item& a, const Item& b)
+                           {
+                             return a.key < b.key;
+                           });
+
+  std::vector<Item> scratch;
+  radixSort(items, scratch, getKey);
+  BOOST_REQUIRE_EQUAL(items.size(), expected.size());
+  for(size_t i = 0; i < items.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(items[i].key, expected[i].key);
+    BOOST_CHECK_EQUAL(items[i].index, expected[i].index);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_equal_keys_keep_order)
+{
+  std::vector<Item> items{{7, 0}, {7, 1}, {7, 2}};
+  std::vector<Item> scratch;
+  radixSort(items, scratch, getKey);
+  BOOST_CHECK_EQUAL(items[0].index, 0);
+  BOOST_CHECK_EQUAL(items[1].index, 1);
+  BOOST_CHECK_EQUAL(items[2].index, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_not_default_constructible)
+{
+  struct Pinned
+  {
+    explicit Pinned(const uint64_t key_, const int* value_)
+        : key{key_}
+        , value{value_}
+    {
+    }
+
+    uint64_t key;
+    const int* value;
+  };
+  static_assert(!std::is_default_constructible_v<Pinned>);
+
+  const int a = 1;
+  const int b = 2;
+  std::vector<Pinned> items{Pinned{0x0200, &a}, Pinned{0x0100, &b}};
+  std::vector<Pinned> scratch;
+  radixSort(items,
+            scratch,
+            [](const Pinned& item)
+            {
+              return item.key;
+            });
+  BOOST_CHECK(items[0].value == &b);
+  BOOST_CHECK(items[1].value == &a);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace util::tests
@@ -0,0 +1,82 @@
+#include "util/threadpool.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace util::tests
+{
+BOOST_AUTO_TEST_SUITE(threadpool_tests)
+
+BOOST_AUTO_TEST_CASE(test_visits_every_index_once)
+{
+  ThreadPool pool{3};
+  for(const size_t count : {0u, 1u, 2u, 7u, 1000u})
+  {
+    std::vector<std::atomic<int>> visits(count);
+    pool.parallelFor(count,
+                     [&visits](const size_t i)
+                     {
+                       ++visits[i];
+                     });
+    for(const auto& visit : visits)
+      BOOST_CHECK_EQUAL(visit.load(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_without_workers)
+{
+  ThreadPool pool{0};
+  std::vector<size_t> order;
+  pool.parallelFor(4,
+                   [&order](const size_t i)
+                   {
+                     order.emplace_back(i);
+                   });
+  BOOST_CHECK((order == std::vector<size_t>{0, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_rethrows_and_finishes)
+{
+  ThreadPool pool{2};
+  std::atomic<size_t> calls = 0;
+  BOOST_CHECK_THROW(pool.parallelFor(100,
+                                     [&calls](const size_t i)
+                                     {
+                                       ++calls;
+                                       if(i == 10)
+                                         throw std::runtime_error("job failed");
+                                     }),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(calls.load(), 100);
+
+  // the pool stays usable
+  calls = 0;
+  pool.parallelFor(10,
+                   [&calls](size_t)
+                   {
+                     ++calls;
+                   });
+  BOOST_CHECK_EQUAL(calls.load(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_calls_run_inline)
+{
+  ThreadPool pool{2};
+  std::atomic<size_t> calls = 0;
+  pool.parallelFor(4,
+                   [&pool, &calls](size_t)
+                   {
+                     pool.parallelFor(4,
+                                      [&calls](size_t)
+                                      {
+                                        ++calls;
+                                      });
+                   });
+  BOOST_CHECK_EQUAL(calls.load(), 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace util::tests
@@ -0,0 +1,134 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <gsl-lite/gsl-lite.hpp>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace util
+{
+namespace
+{
+thread_local bool isRunningJob = false;
+}
+
+ThreadPool::ThreadPool(const size_t workers)
+{
+  m_workers.reserve(workers);
+  for(size_t i = 0; i < workers; ++i)
+    m_workers.emplace_back(&ThreadPool::workerMain, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    const std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_wakeCondition.notify_all();
+  for(auto& worker : m_workers)
+    worker.join();
+}
+
+void ThreadPool::parallelFor(const size_t count, const std::function<void(size_t)>& f)
+{
+  if(m_workers.empty() || count <= 1 || isRunningJob)
+  {
+    for(size_t i = 0; i < count; ++i)
+      f(i);
+    return;
+  }
+
+  const std::lock_guard submitLock{m_submitMutex};
+  {
+    const std::lock_guard lock{m_mutex};
+    m_job = &f;
+    m_count = count;
+    m_nextIndex.store(0, std::memory_order_relaxed);
+    m_busyWorkers = m_workers.size();
+    ++m_jobGeneration;
+  }
+  m_wakeCondition.notify_all();
+
+  runJob();
+
+  std::unique_lock lock{m_mutex};
+  m_doneCondition.wait(lock,
+                       [this]()
+                       {
+                         return m_busyWorkers == 0;
+                       });
+  m_job = nullptr;
+  if(m_error != nullptr)
+    std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+ThreadPool& ThreadPool::getShared()
+{
+  static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1u};
+  return pool;
+}
+
+void ThreadPool::workerMain()
+{
+  uint64_t handledGeneration = 0;
+  while(true)
+  {
+    {
+      std::unique_lock lock{m_mutex};
+      m_wakeCondition.wait(lock,
+                           [this, handledGeneration]()
+                           {
+                             return m_stop || m_jobGeneration != handledGeneration;
+                           });
+      if(m_stop)
+        return;
+      handledGeneration = m_jobGeneration;
+    }
+
+    runJob();
+
+    {
+      const std::lock_guard lock{m_mutex};
+      if(--m_busyWorkers == 0)
+        m_doneCondition.notify_one();
+    }
+  }
+}
+
+void ThreadPool::runJob()
+{
+  // m_job and m_count are only written while no worker is busy, and the wake-up establishes the ordering
+  const auto& job = *m_job;
+  const auto count = m_count;
+  isRunningJob = true;
+  const auto resetRunning = gsl_lite::finally(
+    []()
+    {
+      isRunningJob = false;
+    });
+  while(true)
+  {
+    const auto index = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    if(index >= count)
+      return;
+
+    try
+    {
+      job(index);
+    }
+    catch(...)
+    {
+      const std::lock_guard lock{m_mutex};
+      if(m_error == nullptr)
+        m_error = std::current_exception();
+    }
+  }
+}
+} // namespace util
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+/**
+ * @brief A fixed set of worker threads for fork-join style loops.
+ *
+ * Unlike spawning a thread per task, this is cheap enough to be used once or more per frame.
+ */
+class ThreadPool final
+{
+public:
+  explicit ThreadPool(size_t workers);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /**
+   * @brief Calls @a f for every index in [0, count) and waits until all calls returned.
+   *
+   * The calling thread takes part in the work; indices are handed out in ascending order, but there is no guarantee
+   * about which thread processes which index. If calls throw, the first exception is rethrown after all other calls
+   * are done. Calls from within a job run serially on the calling thread.
+   */
+  void parallelFor(size_t count, const std::function<void(size_t)>& f);
+
+  [[nodiscard]] auto getWorkerCount() const noexcept
+  {
+    return m_workers.size();
+  }
+
+  /**
+   * @brief The process-wide pool, with one worker less than there are hardware threads.
+   */
+  [[nodiscard]] static ThreadPool& getShared();
+
+private:
+  void workerMain();
+  void runJob();
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_submitMutex;
+  std::mutex m_mutex;
+  std::condition_variable m_wakeCondition;
+  std::condition_variable m_doneCondition;
+  const std::function<void(size_t)>* m_job = nullptr;
+  size_t m_count = 0;
+  std::atomic<size_t> m_nextIndex{0};
+  size_t m_busyWorkers = 0;
+  uint64_t m_jobGeneration = 0;
+  bool m_stop = false;
+  std::exception_ptr m_error;
+};
+} // namespace util